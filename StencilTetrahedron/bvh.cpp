@@ -0,0 +1,626 @@
+#include "bvh.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <chrono>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BVH_SSE2 1
+#include <emmintrin.h>
+#endif
+
+
+const unsigned int BVH_BINS = 16;
+const unsigned int BVH_PARALLEL_BINNING = 1 << 16;     // ranges this large are binned across the pool
+const unsigned int BVH_BINNING_GRAIN = 1 << 14;
+const unsigned int BVH_PARALLEL_SUBTREE = 1 << 12;     // ranges this large become jobs
+const unsigned int BVH_PACKET_GRAIN = 1 << 12;
+const unsigned int BVH_RAY_GRAIN = 256;
+// Below this depth nodes split at the median, which halves the largest child,
+// so no inner node sits deeper than BVH_SAH_DEPTH + 32 levels.
+const unsigned int BVH_SAH_DEPTH = 48;
+// A visit pops one entry and pushes up to four, so three per inner level.
+const int BVH_STACK_SIZE = 256;
+static_assert(3 * (BVH_SAH_DEPTH + 32) + BVH_WIDTH <= BVH_STACK_SIZE, "the traversal stack must hold the deepest tree");
+
+
+static Aabb emptyAabb() {
+    Aabb box;
+    box.min = glm::vec3(FLT_MAX);
+    box.max = glm::vec3(-FLT_MAX);
+    return box;
+}
+
+
+static void growAabb(Aabb& box, const Aabb& other) {
+    box.min = glm::min(box.min, other.min);
+    box.max = glm::max(box.max, other.max);
+}
+
+
+static void growAabb(Aabb& box, const glm::vec3& point) {
+    box.min = glm::min(box.min, point);
+    box.max = glm::max(box.max, point);
+}
+
+
+// Half the surface area, which is all the heuristic needs.
+static float halfArea(const Aabb& box) {
+    glm::vec3 extent = glm::max(box.max - box.min, glm::vec3(0.0f));
+    return extent.x * extent.y + extent.y * extent.z + extent.z * extent.x;
+}
+
+
+struct BvhRange {
+    unsigned int first, count;
+    Aabb box, centroids;
+};
+
+struct BvhBins {
+    Aabb box[3][BVH_BINS];
+    unsigned int count[3][BVH_BINS];
+};
+
+// Splits move these rather than indices, so that every pass over a range
+// reads memory in order.
+struct BvhPrimitive {
+    Aabb box;
+    unsigned int index;
+};
+
+struct BvhBuild {
+    WorkerPool* pool;
+    std::vector<BvhPrimitive> primitives;
+    Bvh* bvh;
+    std::atomic<unsigned int> nodeCount{ 0 }, leafCount{ 0 };
+};
+
+
+// Runs task over [first, first + count) in chunks, on the pool when the range
+// is large enough to pay for it, and merges the chunk results into result.
+template <typename Task, typename Merge>
+static void forRangeChunks(BvhBuild& build, unsigned int first, unsigned int count, BvhBins& result,
+                           Task task, Merge merge) {
+    if (count < BVH_PARALLEL_BINNING) {
+        task(first, first + count, result);
+        return;
+    }
+    unsigned int chunks = (count + BVH_BINNING_GRAIN - 1) / BVH_BINNING_GRAIN;
+    std::vector<BvhBins> partial(chunks, result);
+    parallelFor(*build.pool, chunks, 1, [&](unsigned int chunk) {
+        unsigned int begin = first + chunk * BVH_BINNING_GRAIN;
+        task(begin, std::min(begin + BVH_BINNING_GRAIN, first + count), partial[chunk]);
+    });
+    for (const BvhBins& bins : partial)
+        merge(result, bins);
+}
+
+
+// Twice the centroid: the factor cancels out of the binning.
+static glm::vec3 centroid(const BvhPrimitive& primitive) {
+    return primitive.box.min + primitive.box.max;
+}
+
+
+static unsigned int binIndex(float centroid, float origin, float scale, unsigned int binCount) {
+    return std::min(binCount - 1, (unsigned int)((centroid - origin) * scale));
+}
+
+
+// Splits range in two by the binned surface area heuristic over all three
+// axes. Ranges whose centroids coincide, or that bin into one slot, are split
+// at the median instead, as is every range when median is set. Small ranges
+// get one bin per primitive, which keeps the fixed cost of a split near the
+// bottom of the tree low.
+static void splitRange(BvhBuild& build, const BvhRange& range, bool median, BvhRange& left, BvhRange& right) {
+    BvhPrimitive* primitives = build.primitives.data();
+    unsigned int binCount = median ? 1 : std::min(BVH_BINS, range.count);
+
+    BvhBins bins;
+    for (int axis = 0; axis < 3; ++axis) {
+        for (unsigned int b = 0; b < binCount; ++b) {
+            bins.box[axis][b] = emptyAabb();
+            bins.count[axis][b] = 0;
+        }
+    }
+    glm::vec3 origin = range.centroids.min, extent = range.centroids.max - range.centroids.min;
+    glm::vec3 scale(0.0f);
+    for (int axis = 0; axis < 3; ++axis) {
+        if (extent[axis] > 0.0f && !median)
+            scale[axis] = binCount / extent[axis];
+    }
+    forRangeChunks(build, range.first, range.count, bins,
+        [&](unsigned int begin, unsigned int end, BvhBins& chunk) {
+            for (unsigned int i = begin; i < end; ++i) {
+                glm::vec3 c = centroid(primitives[i]);
+                for (int axis = 0; axis < 3; ++axis) {
+                    unsigned int b = binIndex(c[axis], origin[axis], scale[axis], binCount);
+                    growAabb(chunk.box[axis][b], primitives[i].box);
+                    ++chunk.count[axis][b];
+                }
+            }
+        },
+        [&](BvhBins& total, const BvhBins& chunk) {
+            for (int axis = 0; axis < 3; ++axis) {
+                for (unsigned int b = 0; b < binCount; ++b) {
+                    growAabb(total.box[axis][b], chunk.box[axis][b]);
+                    total.count[axis][b] += chunk.count[axis][b];
+                }
+            }
+        });
+
+    // Sweeps from the right keep the costs of the right halves, then the left
+    // sweep weighs each split.
+    int bestAxis = -1;
+    unsigned int bestSplit = 0;
+    float bestCost = FLT_MAX;
+    for (int axis = 0; axis < 3; ++axis) {
+        if (scale[axis] == 0.0f)
+            continue;
+        float rightCost[BVH_BINS];
+        Aabb box = emptyAabb();
+        unsigned int count = 0;
+        for (unsigned int b = binCount - 1; b > 0; --b) {
+            growAabb(box, bins.box[axis][b]);
+            count += bins.count[axis][b];
+            rightCost[b] = count ? halfArea(box) * count : FLT_MAX;
+        }
+        box = emptyAabb();
+        count = 0;
+        for (unsigned int split = 1; split < binCount; ++split) {
+            growAabb(box, bins.box[axis][split - 1]);
+            count += bins.count[axis][split - 1];
+            if (count == 0 || count == range.count)
+                continue;
+            float cost = halfArea(box) * count + rightCost[split];
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestAxis = axis;
+                bestSplit = split;
+            }
+        }
+    }
+
+    BvhPrimitive* begin = primitives + range.first;
+    BvhPrimitive* end = begin + range.count;
+    BvhPrimitive* middle;
+    left.box = left.centroids = emptyAabb();
+    right.box = right.centroids = emptyAabb();
+    if (bestAxis >= 0) {
+        // Partitions in place, gathering the halves' centroid bounds on the
+        // way so that their splits need no pass of their own for them.
+        float axisOrigin = origin[bestAxis], axisScale = scale[bestAxis];
+        auto isLeft = [&](const BvhPrimitive& primitive) {
+            return binIndex(centroid(primitive)[bestAxis], axisOrigin, axisScale, binCount) < bestSplit;
+        };
+        BvhPrimitive* i = begin;
+        BvhPrimitive* j = end;
+        for (;;) {
+            while (i < j && isLeft(*i))
+                growAabb(left.centroids, centroid(*i++));
+            while (i < j && !isLeft(j[-1]))
+                growAabb(right.centroids, centroid(*--j));
+            if (i == j)
+                break;
+            std::swap(*i, *--j);
+            growAabb(left.centroids, centroid(*i++));
+            growAabb(right.centroids, centroid(*j));
+        }
+        middle = i;
+        for (unsigned int b = 0; b < binCount; ++b)
+            growAabb(b < bestSplit ? left.box : right.box, bins.box[bestAxis][b]);
+    }
+    else {
+        int axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : extent.y >= extent.z ? 1 : 2;
+        middle = begin + range.count / 2;
+        std::nth_element(begin, middle, end, [&](const BvhPrimitive& a, const BvhPrimitive& b) {
+            return centroid(a)[axis] < centroid(b)[axis];
+        });
+        for (BvhPrimitive* p = begin; p != end; ++p) {
+            growAabb(p < middle ? left.box : right.box, p->box);
+            growAabb(p < middle ? left.centroids : right.centroids, centroid(*p));
+        }
+    }
+    left.first = range.first;
+    left.count = (unsigned int)(middle - begin);
+    right.first = left.first + left.count;
+    right.count = range.count - left.count;
+}
+
+
+static void buildNode(BvhBuild& build, unsigned int nodeIndex, const BvhRange& range, unsigned int depth) {
+    // The child with the largest box is split until there are four or all of
+    // them fit in a leaf.
+    BvhRange children[BVH_WIDTH];
+    children[0] = range;
+    unsigned int childCount = 1;
+    while (childCount < BVH_WIDTH) {
+        int largest = -1;
+        float largestArea = -1.0f;
+        for (unsigned int k = 0; k < childCount; ++k) {
+            float area = halfArea(children[k].box);
+            if (children[k].count > BVH_LEAF_SIZE && area > largestArea) {
+                largest = (int)k;
+                largestArea = area;
+            }
+        }
+        if (largest < 0)
+            break;
+        BvhRange left, right;
+        splitRange(build, children[largest], depth >= BVH_SAH_DEPTH, left, right);
+        children[largest] = left;
+        children[childCount++] = right;
+    }
+
+    Bvh& bvh = *build.bvh;
+    BvhNode& node = bvh.nodes[nodeIndex];
+    JobCounter subtrees;
+    for (unsigned int k = 0; k < BVH_WIDTH; ++k) {
+        Aabb box = k < childCount ? children[k].box : emptyAabb();
+        node.minX[k] = box.min.x;
+        node.minY[k] = box.min.y;
+        node.minZ[k] = box.min.z;
+        node.maxX[k] = box.max.x;
+        node.maxY[k] = box.max.y;
+        node.maxZ[k] = box.max.z;
+        if (k >= childCount) {
+            node.child[k] = BVH_EMPTY;
+        }
+        else if (children[k].count <= BVH_LEAF_SIZE) {
+            unsigned int leaf = build.leafCount++;
+            bvh.leaves[leaf].first = children[k].first;
+            bvh.leaves[leaf].count = children[k].count;
+            node.child[k] = BVH_LEAF | leaf;
+        }
+        else {
+            unsigned int child = build.nodeCount++;
+            node.child[k] = child;
+            BvhRange childRange = children[k];
+            if (childRange.count >= BVH_PARALLEL_SUBTREE)
+                submitJob(*build.pool, [&build, child, childRange, depth] { buildNode(build, child, childRange, depth + 1); },
+                          &subtrees);
+            else
+                buildNode(build, child, childRange, depth + 1);
+        }
+    }
+    waitForCounter(*build.pool, subtrees);
+}
+
+
+void buildBvh(Bvh& bvh, WorkerPool& pool, const Aabb* boxes, size_t count) {
+    auto start = std::chrono::steady_clock::now();
+    BvhBuild build;
+    build.pool = &pool;
+    build.bvh = &bvh;
+    build.primitives.resize(count);
+
+    // An inner node splits at least in two and a leaf holds at least one
+    // primitive, so count bounds both.
+    bvh.nodes.resize(std::max<size_t>(count, 1));
+    bvh.leaves.resize(count);
+    bvh.order.resize(count);
+    bvh.packets.clear();
+    BvhRange root = { 0, (unsigned int)count, emptyAabb(), emptyAabb() };
+    for (size_t i = 0; i < count; ++i) {
+        build.primitives[i].box = boxes[i];
+        build.primitives[i].index = (unsigned int)i;
+        growAabb(root.box, boxes[i]);
+        growAabb(root.centroids, centroid(build.primitives[i]));
+    }
+
+    build.nodeCount = 1;
+    if (count > 0) {
+        buildNode(build, 0, root, 0);
+    }
+    else {
+        BvhNode& node = bvh.nodes[0];
+        std::fill_n(node.minX, 4, FLT_MAX);
+        std::fill_n(node.minY, 4, FLT_MAX);
+        std::fill_n(node.minZ, 4, FLT_MAX);
+        std::fill_n(node.maxX, 4, -FLT_MAX);
+        std::fill_n(node.maxY, 4, -FLT_MAX);
+        std::fill_n(node.maxZ, 4, -FLT_MAX);
+        std::fill_n(node.child, 4, BVH_EMPTY);
+    }
+    for (size_t i = 0; i < count; ++i)
+        bvh.order[i] = build.primitives[i].index;
+    bvh.nodes.resize(build.nodeCount);
+    bvh.leaves.resize(build.leafCount);
+    bvh.buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+
+void buildTriangleBvh(Bvh& bvh, WorkerPool& pool, const float* vertices, const unsigned int* indices, size_t triangleCount) {
+    auto start = std::chrono::steady_clock::now();
+    auto corner = [&](size_t triangle, int k) {
+        const float* p = vertices + 3 * (size_t)indices[3 * triangle + k];
+        return glm::vec3(p[0], p[1], p[2]);
+    };
+    std::vector<Aabb> boxes(triangleCount);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        boxes[t].min = boxes[t].max = corner(t, 0);
+        growAabb(boxes[t], corner(t, 1));
+        growAabb(boxes[t], corner(t, 2));
+    }
+    buildBvh(bvh, pool, boxes.data(), triangleCount);
+
+    bvh.packets.resize(bvh.leaves.size());
+    unsigned int leafCount = (unsigned int)bvh.leaves.size();
+    parallelFor(pool, leafCount, BVH_PACKET_GRAIN, [&](unsigned int leaf) {
+        BvhTrianglePacket& packet = bvh.packets[leaf];
+        for (unsigned int lane = 0; lane < 4; ++lane) {
+            glm::vec3 v0(0.0f), e1(0.0f), e2(0.0f);
+            packet.triangle[lane] = BVH_MISS;
+            if (lane < bvh.leaves[leaf].count) {
+                unsigned int triangle = bvh.order[bvh.leaves[leaf].first + lane];
+                v0 = corner(triangle, 0);
+                e1 = corner(triangle, 1) - v0;
+                e2 = corner(triangle, 2) - v0;
+                packet.triangle[lane] = triangle;
+            }
+            packet.v0x[lane] = v0.x;
+            packet.v0y[lane] = v0.y;
+            packet.v0z[lane] = v0.z;
+            packet.e1x[lane] = e1.x;
+            packet.e1y[lane] = e1.y;
+            packet.e1z[lane] = e1.z;
+            packet.e2x[lane] = e2.x;
+            packet.e2y[lane] = e2.y;
+            packet.e2z[lane] = e2.z;
+        }
+    });
+    bvh.buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+
+// The ray as the box and triangle tests use it. The slab test reads the near
+// and far planes of each axis from the arrays the direction's sign picks, so
+// that an empty box (min above max) is missed whatever the direction.
+struct TraversalRay {
+    glm::vec3 origin, direction, inverse;
+    float (BvhNode::*nearX)[4];
+    float (BvhNode::*nearY)[4];
+    float (BvhNode::*nearZ)[4];
+    float (BvhNode::*farX)[4];
+    float (BvhNode::*farY)[4];
+    float (BvhNode::*farZ)[4];
+};
+
+
+static TraversalRay traversalRay(const Ray& ray) {
+    TraversalRay r;
+    r.origin = ray.origin;
+    r.direction = ray.direction;
+    // Near-zero components are nudged away from zero, so that no box plane
+    // distance turns into 0 * infinity.
+    for (int axis = 0; axis < 3; ++axis) {
+        float d = ray.direction[axis];
+        if (glm::abs(d) < 1e-20f)
+            d = d < 0.0f ? -1e-20f : 1e-20f;
+        r.inverse[axis] = 1.0f / d;
+    }
+    r.nearX = r.inverse.x >= 0.0f ? &BvhNode::minX : &BvhNode::maxX;
+    r.farX = r.inverse.x >= 0.0f ? &BvhNode::maxX : &BvhNode::minX;
+    r.nearY = r.inverse.y >= 0.0f ? &BvhNode::minY : &BvhNode::maxY;
+    r.farY = r.inverse.y >= 0.0f ? &BvhNode::maxY : &BvhNode::minY;
+    r.nearZ = r.inverse.z >= 0.0f ? &BvhNode::minZ : &BvhNode::maxZ;
+    r.farZ = r.inverse.z >= 0.0f ? &BvhNode::maxZ : &BvhNode::minZ;
+    return r;
+}
+
+
+// Bit k set when the ray enters child k's box before maxDistance; entry
+// distances go to entry.
+static unsigned int intersectChildren(const BvhNode& node, const TraversalRay& ray, float maxDistance, float entry[4]) {
+#if BVH_SSE2
+    __m128 ox = _mm_set1_ps(ray.origin.x), oy = _mm_set1_ps(ray.origin.y), oz = _mm_set1_ps(ray.origin.z);
+    __m128 ix = _mm_set1_ps(ray.inverse.x), iy = _mm_set1_ps(ray.inverse.y), iz = _mm_set1_ps(ray.inverse.z);
+    __m128 nearX = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(node.*ray.nearX), ox), ix);
+    __m128 nearY = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(node.*ray.nearY), oy), iy);
+    __m128 nearZ = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(node.*ray.nearZ), oz), iz);
+    __m128 farX = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(node.*ray.farX), ox), ix);
+    __m128 farY = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(node.*ray.farY), oy), iy);
+    __m128 farZ = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(node.*ray.farZ), oz), iz);
+    __m128 tNear = _mm_max_ps(_mm_max_ps(nearX, nearY), _mm_max_ps(nearZ, _mm_setzero_ps()));
+    __m128 tFar = _mm_min_ps(_mm_min_ps(farX, farY), _mm_min_ps(farZ, _mm_set1_ps(maxDistance)));
+    _mm_storeu_ps(entry, tNear);
+    return (unsigned int)_mm_movemask_ps(_mm_cmple_ps(tNear, tFar));
+#else
+    unsigned int mask = 0;
+    for (int k = 0; k < 4; ++k) {
+        float tNear = glm::max(glm::max(((node.*ray.nearX)[k] - ray.origin.x) * ray.inverse.x,
+                                        ((node.*ray.nearY)[k] - ray.origin.y) * ray.inverse.y),
+                               glm::max(((node.*ray.nearZ)[k] - ray.origin.z) * ray.inverse.z, 0.0f));
+        float tFar = glm::min(glm::min(((node.*ray.farX)[k] - ray.origin.x) * ray.inverse.x,
+                                       ((node.*ray.farY)[k] - ray.origin.y) * ray.inverse.y),
+                              glm::min(((node.*ray.farZ)[k] - ray.origin.z) * ray.inverse.z, maxDistance));
+        entry[k] = tNear;
+        mask |= (tNear <= tFar ? 1u : 0u) << k;
+    }
+    return mask;
+#endif
+}
+
+
+// Moller-Trumbore for the four triangles of a packet, with the operations of
+// glm::intersectRayTriangle: both faces count, edges included. Keeps the
+// nearest hit in (0, hit.distance).
+static void intersectPacket(const BvhTrianglePacket& packet, const TraversalRay& ray, RayHit& hit) {
+    float distance[4], u[4], v[4];
+    unsigned int mask;
+#if BVH_SSE2
+    __m128 dx = _mm_set1_ps(ray.direction.x), dy = _mm_set1_ps(ray.direction.y), dz = _mm_set1_ps(ray.direction.z);
+    __m128 e1x = _mm_loadu_ps(packet.e1x), e1y = _mm_loadu_ps(packet.e1y), e1z = _mm_loadu_ps(packet.e1z);
+    __m128 e2x = _mm_loadu_ps(packet.e2x), e2y = _mm_loadu_ps(packet.e2y), e2z = _mm_loadu_ps(packet.e2z);
+    __m128 px = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(e2y, dz));
+    __m128 py = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(e2z, dx));
+    __m128 pz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(e2x, dy));
+    __m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+    __m128 sx = _mm_sub_ps(_mm_set1_ps(ray.origin.x), _mm_loadu_ps(packet.v0x));
+    __m128 sy = _mm_sub_ps(_mm_set1_ps(ray.origin.y), _mm_loadu_ps(packet.v0y));
+    __m128 sz = _mm_sub_ps(_mm_set1_ps(ray.origin.z), _mm_loadu_ps(packet.v0z));
+    __m128 uDet = _mm_add_ps(_mm_add_ps(_mm_mul_ps(sx, px), _mm_mul_ps(sy, py)), _mm_mul_ps(sz, pz));
+    __m128 qx = _mm_sub_ps(_mm_mul_ps(sy, e1z), _mm_mul_ps(e1y, sz));
+    __m128 qy = _mm_sub_ps(_mm_mul_ps(sz, e1x), _mm_mul_ps(e1z, sx));
+    __m128 qz = _mm_sub_ps(_mm_mul_ps(sx, e1y), _mm_mul_ps(e1x, sy));
+    __m128 vDet = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz));
+    __m128 tDet = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz));
+
+    // Flipping the signs by det's turns both of the scalar code's cases into
+    // the one for det > 0.
+    __m128 sign = _mm_and_ps(det, _mm_set1_ps(-0.0f));
+    __m128 absDet = _mm_xor_ps(det, sign);
+    __m128 uSigned = _mm_xor_ps(uDet, sign), vSigned = _mm_xor_ps(vDet, sign);
+    __m128 inverseDet = _mm_div_ps(_mm_set1_ps(1.0f), det);
+    __m128 t = _mm_mul_ps(tDet, inverseDet);
+    __m128 inside = _mm_and_ps(_mm_cmpgt_ps(absDet, _mm_setzero_ps()),
+        _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(uSigned, _mm_setzero_ps()), _mm_cmpge_ps(vSigned, _mm_setzero_ps())),
+                   _mm_cmple_ps(_mm_add_ps(uSigned, vSigned), absDet)));
+    inside = _mm_and_ps(inside, _mm_and_ps(_mm_cmpgt_ps(t, _mm_setzero_ps()), _mm_cmplt_ps(t, _mm_set1_ps(hit.distance))));
+    mask = (unsigned int)_mm_movemask_ps(inside);
+    if (!mask)
+        return;
+    _mm_storeu_ps(distance, t);
+    _mm_storeu_ps(u, _mm_mul_ps(uDet, inverseDet));
+    _mm_storeu_ps(v, _mm_mul_ps(vDet, inverseDet));
+#else
+    mask = 0;
+    for (int k = 0; k < 4; ++k) {
+        glm::vec3 e1(packet.e1x[k], packet.e1y[k], packet.e1z[k]), e2(packet.e2x[k], packet.e2y[k], packet.e2z[k]);
+        glm::vec3 p = glm::cross(ray.direction, e2);
+        float det = glm::dot(e1, p);
+        glm::vec3 s = ray.origin - glm::vec3(packet.v0x[k], packet.v0y[k], packet.v0z[k]);
+        glm::vec3 q = glm::cross(s, e1);
+        float uDet = glm::dot(s, p), vDet = glm::dot(ray.direction, q);
+        float sign = det < 0.0f ? -1.0f : 1.0f;
+        float absDet = det * sign, uSigned = uDet * sign, vSigned = vDet * sign;
+        if (absDet > 0.0f && uSigned >= 0.0f && vSigned >= 0.0f && uSigned + vSigned <= absDet) {
+            float inverseDet = 1.0f / det;
+            distance[k] = glm::dot(e2, q) * inverseDet;
+            u[k] = uDet * inverseDet;
+            v[k] = vDet * inverseDet;
+            if (distance[k] > 0.0f && distance[k] < hit.distance)
+                mask |= 1u << k;
+        }
+    }
+    if (!mask)
+        return;
+#endif
+    for (int k = 0; k < 4; ++k) {
+        if ((mask >> k & 1) && distance[k] < hit.distance) {
+            hit.distance = distance[k];
+            hit.barycentric = glm::vec2(u[k], v[k]);
+            hit.triangle = packet.triangle[k];
+        }
+    }
+}
+
+
+// Visits the leaves whose boxes the ray enters, nearest box first. leaf may
+// lower maxDistance, which prunes what is left on the stack.
+template <typename Leaf>
+static void traverse(const Bvh& bvh, const TraversalRay& ray, const float& maxDistance, Leaf leaf) {
+    unsigned int stack[BVH_STACK_SIZE];
+    float stackEntry[BVH_STACK_SIZE];
+    int top = 0;
+    stack[top] = 0;
+    stackEntry[top++] = 0.0f;
+    while (top > 0) {
+        --top;
+        if (stackEntry[top] > maxDistance)
+            continue;
+        unsigned int index = stack[top];
+        if (index & BVH_LEAF) {
+            leaf(index & ~BVH_LEAF);
+            continue;
+        }
+        const BvhNode& node = bvh.nodes[index];
+        float entry[4];
+        unsigned int mask = intersectChildren(node, ray, maxDistance, entry);
+
+        // Hits go on the stack farthest first, so the nearest is visited next.
+        unsigned int children[4];
+        float distances[4];
+        int hits = 0;
+        for (int k = 0; k < 4; ++k) {
+            if (!(mask >> k & 1))
+                continue;
+            int slot = hits++;
+            while (slot > 0 && distances[slot - 1] < entry[k]) {
+                children[slot] = children[slot - 1];
+                distances[slot] = distances[slot - 1];
+                --slot;
+            }
+            children[slot] = node.child[k];
+            distances[slot] = entry[k];
+        }
+        for (int h = 0; h < hits; ++h) {
+            stack[top] = children[h];
+            stackEntry[top++] = distances[h];
+        }
+    }
+}
+
+
+bool intersectBvh(const Bvh& bvh, const Ray& ray, RayHit& hit) {
+    hit.distance = ray.maxDistance;
+    hit.barycentric = glm::vec2(0.0f);
+    hit.triangle = BVH_MISS;
+    hit.mesh = hit.instance = 0;
+    TraversalRay r = traversalRay(ray);
+    traverse(bvh, r, hit.distance, [&](unsigned int leaf) { intersectPacket(bvh.packets[leaf], r, hit); });
+    return hit.triangle != BVH_MISS;
+}
+
+
+void intersectBvh(const Bvh& bvh, WorkerPool& pool, const Ray* rays, size_t count, RayHit* hits) {
+    unsigned int chunks = (unsigned int)((count + BVH_RAY_GRAIN - 1) / BVH_RAY_GRAIN);
+    parallelFor(pool, chunks, 1, [&](unsigned int chunk) {
+        size_t end = std::min(count, (size_t)(chunk + 1) * BVH_RAY_GRAIN);
+        for (size_t i = (size_t)chunk * BVH_RAY_GRAIN; i < end; ++i)
+            intersectBvh(bvh, rays[i], hits[i]);
+    });
+}
+
+
+bool intersectInstances(const Bvh& instances, const glm::mat4* inverseModels, const Bvh* meshes, unsigned int meshCount,
+                        const Ray& ray, RayHit& hit) {
+    hit.distance = ray.maxDistance;
+    hit.barycentric = glm::vec2(0.0f);
+    hit.triangle = BVH_MISS;
+    hit.mesh = hit.instance = 0;
+    TraversalRay r = traversalRay(ray);
+    traverse(instances, r, hit.distance, [&](unsigned int leaf) {
+        const BvhLeaf& instanceLeaf = instances.leaves[leaf];
+        for (unsigned int i = 0; i < instanceLeaf.count; ++i) {
+            // The matrices are affine, so distances along the object-space
+            // direction match the world-space ones.
+            unsigned int instance = instances.order[instanceLeaf.first + i];
+            const glm::mat4& inverse = inverseModels[instance];
+            Ray local;
+            local.origin = glm::vec3(inverse * glm::vec4(ray.origin, 1.0f));
+            local.direction = glm::vec3(inverse * glm::vec4(ray.direction, 0.0f));
+            local.maxDistance = hit.distance;
+            for (unsigned int mesh = 0; mesh < meshCount; ++mesh) {
+                RayHit meshHit;
+                if (intersectBvh(meshes[mesh], local, meshHit)) {
+                    hit = meshHit;
+                    hit.mesh = mesh;
+                    hit.instance = instance;
+                    local.maxDistance = hit.distance;
+                }
+            }
+        }
+    });
+    return hit.triangle != BVH_MISS;
+}
+
+
+const char* bvhIsa() {
+#if BVH_SSE2
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "culling.h"
+#include "worker_pool.h"
+
+#include <cstddef>
+#include <vector>
+
+
+// Bounding volume hierarchy for ray queries such as mouse picking. Nodes have
+// four children whose boxes sit in structure-of-arrays layout, so one SSE
+// register tests a ray against all four; triangle leaves hold up to four
+// triangles laid out the same way for a four-wide Moller-Trumbore test. The
+// build bins centroids into 16 slots per axis and splits by the surface area
+// heuristic; large ranges are binned and large subtrees built on the worker pool.
+const unsigned int BVH_WIDTH = 4;
+const unsigned int BVH_LEAF_SIZE = 4;
+const unsigned int BVH_LEAF = 0x80000000u;     // child flag: the rest is a leaf index
+const unsigned int BVH_EMPTY = 0xffffffffu;    // unused child, with a box no ray enters
+const unsigned int BVH_MISS = 0xffffffffu;
+
+struct BvhNode {
+    float minX[4], minY[4], minZ[4];
+    float maxX[4], maxY[4], maxZ[4];
+    unsigned int child[4];      // node index, BVH_LEAF | leaf index, or BVH_EMPTY
+};
+
+// Primitives order[first] to order[first + count - 1].
+struct BvhLeaf {
+    unsigned int first, count;
+};
+
+// A leaf's triangles as vertex 0 and the two edges leaving it, one per lane.
+// Unused lanes have zero edges, which no ray hits.
+struct BvhTrianglePacket {
+    float v0x[4], v0y[4], v0z[4];
+    float e1x[4], e1y[4], e1z[4];
+    float e2x[4], e2y[4], e2z[4];
+    unsigned int triangle[4];   // index of the first index / 3, BVH_MISS in unused lanes
+};
+
+struct Bvh {
+    std::vector<BvhNode> nodes;     // the root first
+    std::vector<BvhLeaf> leaves;
+    std::vector<unsigned int> order;
+    std::vector<BvhTrianglePacket> packets;     // one per leaf, for triangle BVHs
+    double buildMs;
+};
+
+struct Ray {
+    glm::vec3 origin;
+    glm::vec3 direction;        // need not be unit length: distances are in multiples of it
+    float maxDistance;
+};
+
+struct RayHit {
+    float distance;
+    glm::vec2 barycentric;      // weights of vertices 1 and 2 at the hit point
+    unsigned int triangle;      // BVH_MISS when nothing was hit
+    unsigned int mesh, instance;
+};
+
+// Builds over count boxes, primitive i being boxes[i]; leaves index order.
+void buildBvh(Bvh& bvh, WorkerPool& pool, const Aabb* boxes, size_t count);
+
+// Builds over the triangles of an indexed mesh and fills the packets.
+void buildTriangleBvh(Bvh& bvh, WorkerPool& pool, const float* vertices, const unsigned int* indices, size_t triangleCount);
+
+// Nearest hit in (0, ray.maxDistance) with either face of a triangle BVH.
+bool intersectBvh(const Bvh& bvh, const Ray& ray, RayHit& hit);
+
+// Traces count rays across the pool.
+void intersectBvh(const Bvh& bvh, WorkerPool& pool, const Ray* rays, size_t count, RayHit* hits);
+
+// Nearest hit among instances that each draw meshes[0] to meshes[meshCount - 1].
+// instances is built with buildBvh over boxes that hold every instance, and
+// the ray goes into each candidate's object space by its inverse model matrix,
+// which must be affine.
+bool intersectInstances(const Bvh& instances, const glm::mat4* inverseModels, const Bvh* meshes, unsigned int meshCount,
+                        const Ray& ray, RayHit& hit);
+
+const char* bvhIsa();
@@ -0,0 +1,239 @@
+#include "csg.h"
+#include "shader.h"
+
+#include <glm/gtc/type_ptr.hpp>
+
+
+bool createCsgRenderer(CsgRenderer& renderer) {
+    renderer = CsgRenderer();
+    renderer.program = createShaderProgram(vertexShaderSource, fragmentShaderSource);
+    renderer.modelLoc = glGetUniformLocation(renderer.program, "model");
+    renderer.viewLoc = glGetUniformLocation(renderer.program, "view");
+    renderer.projLoc = glGetUniformLocation(renderer.program, "projection");
+    renderer.colorLoc = glGetUniformLocation(renderer.program, "color");
+
+    // Full-screen quad on the far plane, drawn with identity matrices.
+    float quad[] = {
+       -1.0f, -1.0f, 1.0f,
+        1.0f, -1.0f, 1.0f,
+       -1.0f,  1.0f, 1.0f,
+        1.0f,  1.0f, 1.0f
+    };
+    glGenVertexArrays(1, &renderer.quadVAO);
+    glGenBuffers(1, &renderer.quadVBO);
+    glBindVertexArray(renderer.quadVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, renderer.quadVBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(quad), quad, GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glBindVertexArray(0);
+
+    for (CsgComplexityQueries& slot : renderer.complexity)
+        glGenQueries(CSG_MAX_DEPTH_COMPLEXITY, slot.queries);
+    createGpuTimer(renderer.timer);
+
+    return renderer.program != 0;
+}
+
+
+void destroyCsgRenderer(CsgRenderer& renderer) {
+    destroyGpuTimer(renderer.timer);
+    for (CsgComplexityQueries& slot : renderer.complexity)
+        glDeleteQueries(CSG_MAX_DEPTH_COMPLEXITY, slot.queries);
+    glDeleteVertexArrays(1, &renderer.quadVAO);
+    glDeleteBuffers(1, &renderer.quadVBO);
+    glDeleteProgram(renderer.program);
+}
+
+
+static void drawPrimitive(CsgRenderer& renderer, const CsgPrimitive& primitive) {
+    glUniformMatrix4fv(renderer.modelLoc, 1, GL_FALSE, glm::value_ptr(primitive.model));
+    glBindVertexArray(primitive.vao);
+    glDrawElements(GL_TRIANGLES, primitive.indexCount, GL_UNSIGNED_INT,
+                   (void*)(primitive.firstIndex * sizeof(unsigned int)));
+    renderer.stats.passes++;
+}
+
+
+static void drawFullScreenQuad(CsgRenderer& renderer, const glm::mat4& view, const glm::mat4& projection) {
+    glm::mat4 identity(1.0f);
+    glUniformMatrix4fv(renderer.modelLoc, 1, GL_FALSE, glm::value_ptr(identity));
+    glUniformMatrix4fv(renderer.viewLoc, 1, GL_FALSE, glm::value_ptr(identity));
+    glUniformMatrix4fv(renderer.projLoc, 1, GL_FALSE, glm::value_ptr(identity));
+    glBindVertexArray(renderer.quadVAO);
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    glUniformMatrix4fv(renderer.viewLoc, 1, GL_FALSE, glm::value_ptr(view));
+    glUniformMatrix4fv(renderer.projLoc, 1, GL_FALSE, glm::value_ptr(projection));
+    renderer.stats.passes++;
+}
+
+
+// Counts overlapping subtracted primitives per pixel in the stencil buffer and
+// finds the maximum with occlusion queries (Goldfeather et al.). The queries
+// are read GPU_TIMER_LATENCY frames later, so the count is that old; until
+// the first comes back, or when the top level queried still had samples, the
+// number of subtracted primitives bounds it instead. Levels are queried only a
+// few past the last count, rather than up to that bound every frame.
+static unsigned int measureDepthComplexity(CsgRenderer& renderer, const std::vector<const CsgPrimitive*>& subtracted,
+                                           const glm::mat4& view, const glm::mat4& projection) {
+    unsigned int maxComplexity = subtracted.size() < CSG_MAX_DEPTH_COMPLEXITY ? (unsigned int)subtracted.size()
+                                                                               : CSG_MAX_DEPTH_COMPLEXITY;
+    CsgComplexityQueries& slot = renderer.complexity[renderer.complexityFrame++ % GPU_TIMER_LATENCY];
+    unsigned int complexity = maxComplexity;
+    if (slot.levels > 0) {
+        unsigned int measured = 0;
+        while (measured < slot.levels) {
+            GLuint samples = 0;
+            glGetQueryObjectuiv(slot.queries[measured], GL_QUERY_RESULT, &samples);
+            if (samples == 0)
+                break;
+            measured++;
+        }
+        renderer.lastComplexity = measured;
+        renderer.complexityMeasured = true;
+        if (slot.subtractCount == subtracted.size() && measured < slot.levels)
+            complexity = measured;
+    }
+
+    // The mask must be set before the clear, which respects it.
+    glStencilMask(0xFF);
+    glClear(GL_STENCIL_BUFFER_BIT);
+    glDisable(GL_DEPTH_TEST);
+    glStencilFunc(GL_ALWAYS, 0, 0xFF);
+    glStencilOp(GL_KEEP, GL_KEEP, GL_INCR);
+    glCullFace(GL_BACK);
+    for (const CsgPrimitive* primitive : subtracted)
+        drawPrimitive(renderer, *primitive);
+
+    glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+    slot.levels = renderer.complexityMeasured ? glm::min(renderer.lastComplexity + 4, maxComplexity) : maxComplexity;
+    slot.subtractCount = (unsigned int)subtracted.size();
+    for (unsigned int level = 0; level < slot.levels; ++level) {
+        glStencilFunc(GL_LEQUAL, level + 1, 0xFF);
+        glBeginQuery(GL_SAMPLES_PASSED, slot.queries[level]);
+        drawFullScreenQuad(renderer, view, projection);
+        glEndQuery(GL_SAMPLES_PASSED);
+    }
+
+    glEnable(GL_DEPTH_TEST);
+    return complexity;
+}
+
+
+void renderCsg(CsgRenderer& renderer, const std::vector<CsgPrimitive>& primitives,
+               const glm::mat4& view, const glm::mat4& projection) {
+    beginGpuTimer(renderer.timer);
+    renderer.stats.gpuTimeMs = renderer.timer.lastMs;
+
+    std::vector<const CsgPrimitive*> intersected, subtracted;
+    for (const CsgPrimitive& primitive : primitives)
+        (primitive.op == CsgOp::Intersect ? intersected : subtracted).push_back(&primitive);
+
+    CsgStats& stats = renderer.stats;
+    stats.intersectCount = (unsigned int)intersected.size();
+    stats.subtractCount = (unsigned int)subtracted.size();
+    stats.depthComplexity = 0;
+    stats.sequenceLength = 0;
+    stats.passes = 0;
+
+    // An empty intersection leaves nothing to subtract from.
+    if (intersected.empty()) {
+        endGpuTimer(renderer.timer);
+        return;
+    }
+
+    glUseProgram(renderer.program);
+    glUniformMatrix4fv(renderer.viewLoc, 1, GL_FALSE, glm::value_ptr(view));
+    glUniformMatrix4fv(renderer.projLoc, 1, GL_FALSE, glm::value_ptr(projection));
+
+    glEnable(GL_DEPTH_TEST);
+    glEnable(GL_STENCIL_TEST);
+    glEnable(GL_CULL_FACE);
+    glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+
+    // 1. Depth starts at the farthest front face of the intersected primitives.
+    glClearDepth(0.0);
+    glClear(GL_DEPTH_BUFFER_BIT);
+    glClearDepth(1.0);
+    glDepthMask(GL_TRUE);
+    glDepthFunc(GL_GREATER);
+    glStencilMask(0x00);
+    glStencilFunc(GL_ALWAYS, 0, 0xFF);
+    glCullFace(GL_BACK);
+    for (const CsgPrimitive* primitive : intersected)
+        drawPrimitive(renderer, *primitive);
+
+    // 2. Subtraction: each step pushes depth to the back face of a primitive whose
+    // front face lies in front of it. Repeating the list depthComplexity times
+    // embeds every per-pixel ordering of up to depthComplexity overlapping
+    // primitives, so the step count grows with depth complexity, not n^2.
+    if (!subtracted.empty()) {
+        stats.depthComplexity = measureDepthComplexity(renderer, subtracted, view, projection);
+        stats.sequenceLength = stats.depthComplexity * stats.subtractCount;
+
+        glStencilMask(0xFF);
+        glClear(GL_STENCIL_BUFFER_BIT);
+        for (unsigned int repeat = 0; repeat < stats.depthComplexity; ++repeat) {
+            for (const CsgPrimitive* primitive : subtracted) {
+                glDepthMask(GL_FALSE);
+                glDepthFunc(GL_LESS);
+                glStencilFunc(GL_ALWAYS, 1, 0xFF);
+                glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
+                glCullFace(GL_BACK);
+                drawPrimitive(renderer, *primitive);
+
+                // A convex primitive covers the same pixels with its back faces,
+                // so this pass also resets every stencil value set above.
+                glDepthMask(GL_TRUE);
+                glDepthFunc(GL_GREATER);
+                glStencilFunc(GL_EQUAL, 1, 0xFF);
+                glStencilOp(GL_ZERO, GL_ZERO, GL_ZERO);
+                glCullFace(GL_FRONT);
+                drawPrimitive(renderer, *primitive);
+            }
+        }
+    }
+
+    // 3. Clipping: a surface point is inside the result only if it lies in front
+    // of the back face of every intersected primitive.
+    glDepthMask(GL_FALSE);
+    glDepthFunc(GL_GEQUAL);
+    glStencilMask(0xFF);
+    glClear(GL_STENCIL_BUFFER_BIT);
+    glStencilFunc(GL_ALWAYS, 0, 0xFF);
+    glStencilOp(GL_KEEP, GL_KEEP, GL_INCR);
+    glCullFace(GL_FRONT);
+    for (const CsgPrimitive* primitive : intersected)
+        drawPrimitive(renderer, *primitive);
+
+    // 4. Everything else goes back to the far plane.
+    GLint valid = (GLint)intersected.size();
+    glDepthMask(GL_TRUE);
+    glDepthFunc(GL_ALWAYS);
+    glStencilMask(0x00);
+    glStencilFunc(GL_NOTEQUAL, valid, 0xFF);
+    glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+    glDisable(GL_CULL_FACE);
+    drawFullScreenQuad(renderer, view, projection);
+    glEnable(GL_CULL_FACE);
+
+    // 5. Shade the surviving surfaces: intersected front faces and subtracted
+    // back faces that ended up exactly at the resolved depth.
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+    glDepthMask(GL_FALSE);
+    glDepthFunc(GL_EQUAL);
+    glStencilFunc(GL_EQUAL, valid, 0xFF);
+    for (const CsgPrimitive& primitive : primitives) {
+        glCullFace(primitive.op == CsgOp::Intersect ? GL_BACK : GL_FRONT);
+        glUniform4fv(renderer.colorLoc, 1, glm::value_ptr(primitive.color));
+        drawPrimitive(renderer, primitive);
+    }
+
+    glBindVertexArray(0);
+    glDisable(GL_CULL_FACE);
+    glCullFace(GL_BACK);
+    glDepthMask(GL_TRUE);
+    glDepthFunc(GL_LESS);
+    glStencilFunc(GL_ALWAYS, 0, 0xFF);
+    endGpuTimer(renderer.timer);
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "gpu_timer.h"
+
+#include <vector>
+
+
+// Stencil-based CSG using Sequenced Convex Subtraction (Stewart, Leach, John):
+// the product of all Intersect primitives minus every Subtract primitive.
+// All primitives must be closed and convex with outward counter-clockwise
+// winding; non-convex shapes such as tori are split into convex pieces first
+// (see generateTorusHulls), which is only valid for subtracted shapes.
+enum class CsgOp {
+    Intersect,
+    Subtract
+};
+
+struct CsgPrimitive {
+    GLuint vao;
+    GLsizei firstIndex;
+    GLsizei indexCount;
+    glm::mat4 model;
+    glm::vec4 color;
+    CsgOp op;
+};
+
+struct CsgStats {
+    unsigned int intersectCount;
+    unsigned int subtractCount;
+    unsigned int depthComplexity;   // max overlapping subtracted primitives per pixel, a few frames late
+    unsigned int sequenceLength;    // subtraction steps, depthComplexity * subtractCount
+    unsigned int passes;            // geometry and full-screen draws issued
+    double gpuTimeMs;               // GPU time of the last completed frame
+};
+
+// Stencil counts saturate at 8 bits.
+const unsigned int CSG_MAX_DEPTH_COMPLEXITY = 0xFF;
+
+// Depth complexity is measured with one GL_SAMPLES_PASSED query per level, in
+// the GpuTimer's ring of frames, and used once the results come back.
+struct CsgComplexityQueries {
+    GLuint queries[CSG_MAX_DEPTH_COMPLEXITY];
+    unsigned int levels;            // queries issued; 0 when the slot is free
+    unsigned int subtractCount;     // of the frame that issued them
+};
+
+struct CsgRenderer {
+    GLuint program;
+    GLint modelLoc, viewLoc, projLoc, colorLoc;
+    GLuint quadVAO, quadVBO;
+    CsgComplexityQueries complexity[GPU_TIMER_LATENCY];
+    unsigned int complexityFrame;
+    unsigned int lastComplexity;    // last measured value
+    bool complexityMeasured;
+    GpuTimer timer;
+    CsgStats stats;
+};
+
+bool createCsgRenderer(CsgRenderer& renderer);
+void destroyCsgRenderer(CsgRenderer& renderer);
+
+// Must run first in the frame: the depth buffer is rebuilt from scratch and the
+// stencil buffer is used as scratch space. On return depth holds the CSG surface
+// (far plane where empty) so the rest of the scene composites normally.
+void renderCsg(CsgRenderer& renderer, const std::vector<CsgPrimitive>& primitives,
+               const glm::mat4& view, const glm::mat4& projection);
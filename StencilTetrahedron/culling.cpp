@@ -0,0 +1,292 @@
+#include "culling.h"
+
+#include <chrono>
+
+#if defined(__AVX2__)
+#define CULLING_AVX2 1
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CULLING_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+
+BoundingSphere computeBoundingSphere(const std::vector<float>& vertices) {
+    // Centred on the box; not minimal but tight enough for symmetric meshes.
+    Aabb box = computeAabb(vertices);
+    BoundingSphere sphere;
+    sphere.center = 0.5f * (box.min + box.max);
+    sphere.radius = 0.0f;
+    for (size_t i = 0; i + 2 < vertices.size(); i += 3) {
+        glm::vec3 p(vertices[i], vertices[i + 1], vertices[i + 2]);
+        sphere.radius = glm::max(sphere.radius, glm::length(p - sphere.center));
+    }
+    return sphere;
+}
+
+
+Aabb computeAabb(const std::vector<float>& vertices) {
+    Aabb box;
+    box.min = glm::vec3(vertices[0], vertices[1], vertices[2]);
+    box.max = box.min;
+    for (size_t i = 3; i + 2 < vertices.size(); i += 3) {
+        glm::vec3 p(vertices[i], vertices[i + 1], vertices[i + 2]);
+        box.min = glm::min(box.min, p);
+        box.max = glm::max(box.max, p);
+    }
+    return box;
+}
+
+
+Aabb transformAabb(const Aabb& box, const glm::mat4& model) {
+    // Arvo: the new half extent is |M| applied to the old one.
+    glm::vec3 center = glm::vec3(model * glm::vec4(0.5f * (box.min + box.max), 1.0f));
+    glm::vec3 extent = 0.5f * (box.max - box.min);
+    glm::mat3 absolute(glm::abs(glm::vec3(model[0])), glm::abs(glm::vec3(model[1])), glm::abs(glm::vec3(model[2])));
+    glm::vec3 newExtent = absolute * extent;
+
+    Aabb result;
+    result.min = center - newExtent;
+    result.max = center + newExtent;
+    return result;
+}
+
+
+Frustum extractFrustum(const glm::mat4& viewProjection) {
+    glm::vec4 row0(viewProjection[0][0], viewProjection[1][0], viewProjection[2][0], viewProjection[3][0]);
+    glm::vec4 row1(viewProjection[0][1], viewProjection[1][1], viewProjection[2][1], viewProjection[3][1]);
+    glm::vec4 row2(viewProjection[0][2], viewProjection[1][2], viewProjection[2][2], viewProjection[3][2]);
+    glm::vec4 row3(viewProjection[0][3], viewProjection[1][3], viewProjection[2][3], viewProjection[3][3]);
+
+    Frustum frustum;
+    frustum.planes[0] = row3 + row0;    // left
+    frustum.planes[1] = row3 - row0;    // right
+    frustum.planes[2] = row3 + row1;    // bottom
+    frustum.planes[3] = row3 - row1;    // top
+    frustum.planes[4] = row3 + row2;    // near
+    frustum.planes[5] = row3 - row2;    // far
+    for (glm::vec4& plane : frustum.planes)
+        plane /= glm::length(glm::vec3(plane));
+    return frustum;
+}
+
+
+void resizeSphereBatch(SphereBatch& batch, size_t count) {
+    batch.x.resize(count);
+    batch.y.resize(count);
+    batch.z.resize(count);
+    batch.radius.resize(count);
+}
+
+
+void resizeAabbBatch(AabbBatch& batch, size_t count) {
+    batch.centerX.resize(count);
+    batch.centerY.resize(count);
+    batch.centerZ.resize(count);
+    batch.extentX.resize(count);
+    batch.extentY.resize(count);
+    batch.extentZ.resize(count);
+}
+
+
+static inline unsigned int lowestBit(unsigned int mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (unsigned int)index;
+#else
+    return (unsigned int)__builtin_ctz(mask);
+#endif
+}
+
+
+static inline size_t appendVisible(unsigned int mask, size_t base, unsigned int* visible, size_t count) {
+    while (mask) {
+        visible[count++] = (unsigned int)base + lowestBit(mask);
+        mask &= mask - 1;
+    }
+    return count;
+}
+
+
+static inline bool sphereVisible(const Frustum& frustum, float x, float y, float z, float radius) {
+    for (const glm::vec4& plane : frustum.planes) {
+        if (plane.x * x + plane.y * y + plane.z * z + plane.w < -radius)
+            return false;
+    }
+    return true;
+}
+
+
+static inline bool aabbVisible(const Frustum& frustum, float cx, float cy, float cz, float ex, float ey, float ez) {
+    for (const glm::vec4& plane : frustum.planes) {
+        float distance = plane.x * cx + plane.y * cy + plane.z * cz + plane.w;
+        float reach = glm::abs(plane.x) * ex + glm::abs(plane.y) * ey + glm::abs(plane.z) * ez;
+        if (distance + reach < 0.0f)
+            return false;
+    }
+    return true;
+}
+
+
+size_t cullSpheres(const Frustum& frustum, const SphereBatch& batch, unsigned int* visible) {
+    size_t count = batch.x.size();
+    size_t visibleCount = 0;
+    size_t i = 0;
+
+#if CULLING_AVX2
+    __m256 planeX[6], planeY[6], planeZ[6], planeW[6];
+    for (int p = 0; p < 6; ++p) {
+        planeX[p] = _mm256_set1_ps(frustum.planes[p].x);
+        planeY[p] = _mm256_set1_ps(frustum.planes[p].y);
+        planeZ[p] = _mm256_set1_ps(frustum.planes[p].z);
+        planeW[p] = _mm256_set1_ps(frustum.planes[p].w);
+    }
+    for (; i + 8 <= count; i += 8) {
+        __m256 x = _mm256_loadu_ps(&batch.x[i]);
+        __m256 y = _mm256_loadu_ps(&batch.y[i]);
+        __m256 z = _mm256_loadu_ps(&batch.z[i]);
+        __m256 negRadius = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(&batch.radius[i]));
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (int p = 0; p < 6; ++p) {
+            __m256 distance = _mm256_add_ps(
+                _mm256_add_ps(_mm256_mul_ps(planeX[p], x), _mm256_mul_ps(planeY[p], y)),
+                _mm256_add_ps(_mm256_mul_ps(planeZ[p], z), planeW[p]));
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, negRadius, _CMP_GE_OQ));
+        }
+        visibleCount = appendVisible((unsigned int)_mm256_movemask_ps(inside), i, visible, visibleCount);
+    }
+#elif CULLING_SSE2
+    __m128 planeX[6], planeY[6], planeZ[6], planeW[6];
+    for (int p = 0; p < 6; ++p) {
+        planeX[p] = _mm_set1_ps(frustum.planes[p].x);
+        planeY[p] = _mm_set1_ps(frustum.planes[p].y);
+        planeZ[p] = _mm_set1_ps(frustum.planes[p].z);
+        planeW[p] = _mm_set1_ps(frustum.planes[p].w);
+    }
+    for (; i + 4 <= count; i += 4) {
+        __m128 x = _mm_loadu_ps(&batch.x[i]);
+        __m128 y = _mm_loadu_ps(&batch.y[i]);
+        __m128 z = _mm_loadu_ps(&batch.z[i]);
+        __m128 negRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(&batch.radius[i]));
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (int p = 0; p < 6; ++p) {
+            __m128 distance = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(planeX[p], x), _mm_mul_ps(planeY[p], y)),
+                _mm_add_ps(_mm_mul_ps(planeZ[p], z), planeW[p]));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, negRadius));
+        }
+        visibleCount = appendVisible((unsigned int)_mm_movemask_ps(inside), i, visible, visibleCount);
+    }
+#endif
+
+    for (; i < count; ++i) {
+        if (sphereVisible(frustum, batch.x[i], batch.y[i], batch.z[i], batch.radius[i]))
+            visible[visibleCount++] = (unsigned int)i;
+    }
+    return visibleCount;
+}
+
+
+size_t cullAabbs(const Frustum& frustum, const AabbBatch& batch, unsigned int* visible) {
+    size_t count = batch.centerX.size();
+    size_t visibleCount = 0;
+    size_t i = 0;
+
+#if CULLING_AVX2
+    __m256 planeX[6], planeY[6], planeZ[6], planeW[6], absX[6], absY[6], absZ[6];
+    for (int p = 0; p < 6; ++p) {
+        planeX[p] = _mm256_set1_ps(frustum.planes[p].x);
+        planeY[p] = _mm256_set1_ps(frustum.planes[p].y);
+        planeZ[p] = _mm256_set1_ps(frustum.planes[p].z);
+        planeW[p] = _mm256_set1_ps(frustum.planes[p].w);
+        absX[p] = _mm256_set1_ps(glm::abs(frustum.planes[p].x));
+        absY[p] = _mm256_set1_ps(glm::abs(frustum.planes[p].y));
+        absZ[p] = _mm256_set1_ps(glm::abs(frustum.planes[p].z));
+    }
+    for (; i + 8 <= count; i += 8) {
+        __m256 cx = _mm256_loadu_ps(&batch.centerX[i]);
+        __m256 cy = _mm256_loadu_ps(&batch.centerY[i]);
+        __m256 cz = _mm256_loadu_ps(&batch.centerZ[i]);
+        __m256 ex = _mm256_loadu_ps(&batch.extentX[i]);
+        __m256 ey = _mm256_loadu_ps(&batch.extentY[i]);
+        __m256 ez = _mm256_loadu_ps(&batch.extentZ[i]);
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (int p = 0; p < 6; ++p) {
+            __m256 distance = _mm256_add_ps(
+                _mm256_add_ps(_mm256_mul_ps(planeX[p], cx), _mm256_mul_ps(planeY[p], cy)),
+                _mm256_add_ps(_mm256_mul_ps(planeZ[p], cz), planeW[p]));
+            __m256 reach = _mm256_add_ps(
+                _mm256_add_ps(_mm256_mul_ps(absX[p], ex), _mm256_mul_ps(absY[p], ey)),
+                _mm256_mul_ps(absZ[p], ez));
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(_mm256_add_ps(distance, reach), _mm256_setzero_ps(), _CMP_GE_OQ));
+        }
+        visibleCount = appendVisible((unsigned int)_mm256_movemask_ps(inside), i, visible, visibleCount);
+    }
+#elif CULLING_SSE2
+    __m128 planeX[6], planeY[6], planeZ[6], planeW[6], absX[6], absY[6], absZ[6];
+    for (int p = 0; p < 6; ++p) {
+        planeX[p] = _mm_set1_ps(frustum.planes[p].x);
+        planeY[p] = _mm_set1_ps(frustum.planes[p].y);
+        planeZ[p] = _mm_set1_ps(frustum.planes[p].z);
+        planeW[p] = _mm_set1_ps(frustum.planes[p].w);
+        absX[p] = _mm_set1_ps(glm::abs(frustum.planes[p].x));
+        absY[p] = _mm_set1_ps(glm::abs(frustum.planes[p].y));
+        absZ[p] = _mm_set1_ps(glm::abs(frustum.planes[p].z));
+    }
+    for (; i + 4 <= count; i += 4) {
+        __m128 cx = _mm_loadu_ps(&batch.centerX[i]);
+        __m128 cy = _mm_loadu_ps(&batch.centerY[i]);
+        __m128 cz = _mm_loadu_ps(&batch.centerZ[i]);
+        __m128 ex = _mm_loadu_ps(&batch.extentX[i]);
+        __m128 ey = _mm_loadu_ps(&batch.extentY[i]);
+        __m128 ez = _mm_loadu_ps(&batch.extentZ[i]);
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (int p = 0; p < 6; ++p) {
+            __m128 distance = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(planeX[p], cx), _mm_mul_ps(planeY[p], cy)),
+                _mm_add_ps(_mm_mul_ps(planeZ[p], cz), planeW[p]));
+            __m128 reach = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(absX[p], ex), _mm_mul_ps(absY[p], ey)),
+                _mm_mul_ps(absZ[p], ez));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(distance, reach), _mm_setzero_ps()));
+        }
+        visibleCount = appendVisible((unsigned int)_mm_movemask_ps(inside), i, visible, visibleCount);
+    }
+#endif
+
+    for (; i < count; ++i) {
+        if (aabbVisible(frustum, batch.centerX[i], batch.centerY[i], batch.centerZ[i],
+                        batch.extentX[i], batch.extentY[i], batch.extentZ[i]))
+            visible[visibleCount++] = (unsigned int)i;
+    }
+    return visibleCount;
+}
+
+
+size_t cullSpheresTimed(const Frustum& frustum, const SphereBatch& batch, unsigned int* visible, CullStats& stats) {
+    auto start = std::chrono::high_resolution_clock::now();
+    size_t visibleCount = cullSpheres(frustum, batch, visible);
+    auto end = std::chrono::high_resolution_clock::now();
+
+    double microseconds = std::chrono::duration<double, std::micro>(end - start).count();
+    stats.tested = batch.x.size();
+    stats.visible = visibleCount;
+    stats.microsecondsPer1k = stats.tested ? microseconds * 1000.0 / stats.tested : 0.0;
+    return visibleCount;
+}
+
+
+const char* cullingIsa() {
+#if CULLING_AVX2
+    return "AVX2";
+#elif CULLING_SSE2
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <vector>
+
+
+struct BoundingSphere {
+    glm::vec3 center;
+    float radius;
+};
+
+struct Aabb {
+    glm::vec3 min, max;
+};
+
+// Plane i is (n, d) with n pointing into the frustum: a point p is inside when
+// dot(n, p) + d >= 0 for all six planes. Planes are normalised.
+struct Frustum {
+    glm::vec4 planes[6];
+};
+
+// Instance bounds in structure-of-arrays layout so the batch tests can load
+// four or eight instances per register.
+struct SphereBatch {
+    std::vector<float> x, y, z, radius;
+};
+
+struct AabbBatch {
+    std::vector<float> centerX, centerY, centerZ;
+    std::vector<float> extentX, extentY, extentZ;
+};
+
+struct CullStats {
+    size_t tested;
+    size_t visible;
+    double microsecondsPer1k;
+};
+
+BoundingSphere computeBoundingSphere(const std::vector<float>& vertices);
+Aabb computeAabb(const std::vector<float>& vertices);
+Aabb transformAabb(const Aabb& box, const glm::mat4& model);
+
+// Gribb/Hartmann extraction from a GL clip-space matrix (projection * view).
+Frustum extractFrustum(const glm::mat4& viewProjection);
+
+void resizeSphereBatch(SphereBatch& batch, size_t count);
+void resizeAabbBatch(AabbBatch& batch, size_t count);
+
+// Writes the indices of instances that intersect the frustum to visible (which
+// must hold batch-size entries) in ascending order and returns how many there are.
+size_t cullSpheres(const Frustum& frustum, const SphereBatch& batch, unsigned int* visible);
+size_t cullAabbs(const Frustum& frustum, const AabbBatch& batch, unsigned int* visible);
+
+// Runs cullSpheres and measures it.
+size_t cullSpheresTimed(const Frustum& frustum, const SphereBatch& batch, unsigned int* visible, CullStats& stats);
+
+const char* cullingIsa();
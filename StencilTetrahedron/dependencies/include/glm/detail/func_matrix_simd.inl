@@ -56,6 +56,53 @@ namespace detail
 			return Result;
 		}
 	};
+
+#	if GLM_ARCH & GLM_ARCH_AVX_BIT
+	template<qualifier Q, bool Aligned>
+	struct compute_transpose<4, 4, double, Q, Aligned>
+	{
+		GLM_FUNC_QUALIFIER static mat<4, 4, double, Q> call(mat<4, 4, double, Q> const& m)
+		{
+			glm_dvec4 In[4], Out[4];
+			load_dmat4(m, In);
+			glm_dmat4_transpose(In, Out);
+
+			mat<4, 4, double, Q> Result;
+			store_dmat4(Out, Result);
+			return Result;
+		}
+	};
+
+	// Without AVX2's cross-lane permute the swizzles cost more than the
+	// scalar expansion saves.
+#	if GLM_ARCH & GLM_ARCH_AVX2_BIT
+	template<qualifier Q, bool Aligned>
+	struct compute_determinant<4, 4, double, Q, Aligned>
+	{
+		GLM_FUNC_QUALIFIER static double call(mat<4, 4, double, Q> const& m)
+		{
+			glm_dvec4 In[4];
+			load_dmat4(m, In);
+			return glm_dmat4_determinant(In);
+		}
+	};
+#	endif
+
+	template<qualifier Q, bool Aligned>
+	struct compute_inverse<4, 4, double, Q, Aligned>
+	{
+		GLM_FUNC_QUALIFIER static mat<4, 4, double, Q> call(mat<4, 4, double, Q> const& m)
+		{
+			glm_dvec4 In[4], Out[4];
+			load_dmat4(m, In);
+			glm_dmat4_inverse(In, Out);
+
+			mat<4, 4, double, Q> Result;
+			store_dmat4(Out, Result);
+			return Result;
+		}
+	};
+#	endif//GLM_ARCH & GLM_ARCH_AVX_BIT
 }//namespace detail
 
 #	if GLM_CONFIG_ALIGNED_GENTYPES == GLM_ENABLE
@@ -1,6 +1,63 @@
 /// @ref core
 
-namespace glm
+#if GLM_ARCH & GLM_ARCH_AVX_BIT
+
+#include "../simd/matrix.h"
+
+namespace glm{
+namespace detail
 {
+	// Columns of a dmat4 are contiguous whether packed or aligned, and
+	// unaligned AVX loads cost nothing extra on aligned data, so one
+	// specialization serves both.
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void load_dmat4(mat<4, 4, double, Q> const& m, glm_dvec4 out[4])
+	{
+		out[0] = _mm256_loadu_pd(&m[0][0]);
+		out[1] = _mm256_loadu_pd(&m[1][0]);
+		out[2] = _mm256_loadu_pd(&m[2][0]);
+		out[3] = _mm256_loadu_pd(&m[3][0]);
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void store_dmat4(glm_dvec4 const in[4], mat<4, 4, double, Q>& m)
+	{
+		_mm256_storeu_pd(&m[0][0], in[0]);
+		_mm256_storeu_pd(&m[1][0], in[1]);
+		_mm256_storeu_pd(&m[2][0], in[2]);
+		_mm256_storeu_pd(&m[3][0], in[3]);
+	}
+
+	template<qualifier Q, bool Aligned>
+	struct compute_mat4x4_mul_vec4<double, Q, Aligned>
+	{
+		GLM_FUNC_QUALIFIER static vec<4, double, Q> call(mat<4, 4, double, Q> const& m, vec<4, double, Q> const& v)
+		{
+			glm_dvec4 In[4];
+			load_dmat4(m, In);
 
+			vec<4, double, Q> Result;
+			_mm256_storeu_pd(&Result[0], glm_dmat4_mul_dvec4(In, _mm256_loadu_pd(&v[0])));
+			return Result;
+		}
+	};
+
+	template<qualifier Q, bool Aligned>
+	struct compute_mat4x4_mul<double, Q, Aligned>
+	{
+		GLM_FUNC_QUALIFIER static mat<4, 4, double, Q> call(mat<4, 4, double, Q> const& m1, mat<4, 4, double, Q> const& m2)
+		{
+			glm_dvec4 In1[4], In2[4], Out[4];
+			load_dmat4(m1, In1);
+			load_dmat4(m2, In2);
+			glm_dmat4_mul(In1, In2, Out);
+
+			mat<4, 4, double, Q> Result;
+			store_dmat4(Out, Result);
+			return Result;
+		}
+	};
+}//namespace detail
 }//namespace glm
+
+#endif//GLM_ARCH & GLM_ARCH_AVX_BIT
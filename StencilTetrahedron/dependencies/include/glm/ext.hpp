@@ -252,6 +252,9 @@
 #endif
 #include "./gtx/transform.hpp"
 #include "./gtx/transform2.hpp"
+#include "./gtx/transform_batch.hpp"
+#include "./gtx/exponential_batch.hpp"
+#include "./gtx/simd_dispatch.hpp"
 #include "./gtx/vec_swizzle.hpp"
 #include "./gtx/vector_angle.hpp"
 #include "./gtx/vector_query.hpp"
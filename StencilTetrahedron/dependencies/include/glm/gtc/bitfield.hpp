@@ -21,6 +21,7 @@
 #include "../detail/qualifier.hpp"
 #include "../detail/_vectorize.hpp"
 #include "type_precision.hpp"
+#include <cstddef>
 #include <limits>
 
 #if GLM_MESSAGES == GLM_ENABLE && !defined(GLM_EXT_INCLUDED)
@@ -260,6 +261,27 @@ namespace glm
 	/// @see gtc_bitfield
 	GLM_FUNC_DECL uint64 bitfieldInterleave(uint16 x, uint16 y, uint16 z, uint16 w);
 
+	/// Morton codes of Count coordinates: Out[i] is
+	/// bitfieldInterleave(In[i].x, In[i].y, In[i].z) with each coordinate
+	/// cut to its low 21 bits. Packed vectors go through PDEP with BMI2 or
+	/// through an AVX2 kernel, the others one at a time.
+	///
+	/// @see gtc_bitfield
+	template<qualifier Q>
+	GLM_FUNC_DISCARD_DECL void bitfieldInterleave(vec<3, uint32, Q> const* In, uint64* Out, std::size_t Count);
+
+	/// The coordinates of Count Morton codes, undoing the span
+	/// bitfieldInterleave: bits 0, 3, 6... of In[i] go to Out[i].x, bits
+	/// 1, 4, 7... to y and bits 2, 5, 8... to z.
+	///
+	/// @see gtc_bitfield
+	template<qualifier Q>
+	GLM_FUNC_DISCARD_DECL void bitfieldDeinterleave(uint64 const* In, vec<3, uint32, Q>* Out, std::size_t Count);
+
+	/// Name of the instruction set the span functions use: "BMI2", "AVX2" or "scalar".
+	/// @see gtc_bitfield
+	GLM_FUNC_DECL char const* bitfieldIsa();
+
 	/// @}
 } //namespace glm
 
@@ -17,207 +17,398 @@ namespace detail
 	template<>
 	GLM_FUNC_QUALIFIER glm::uint16 bitfieldInterleave(glm::uint8 x, glm::uint8 y)
 	{
-		glm::uint16 REG1(x);
-		glm::uint16 REG2(y);
+#		if GLM_CONFIG_BMI2 == GLM_ENABLE
+			return static_cast<glm::uint16>(_pdep_u32(x, 0x5555u) | _pdep_u32(y, 0xAAAAu));
+#		else
+			glm::uint16 REG1(x);
+			glm::uint16 REG2(y);
 
-		REG1 = ((REG1 <<  4) | REG1) & static_cast<glm::uint16>(0x0F0F);
-		REG2 = ((REG2 <<  4) | REG2) & static_cast<glm::uint16>(0x0F0F);
+			REG1 = ((REG1 <<  4) | REG1) & static_cast<glm::uint16>(0x0F0F);
+			REG2 = ((REG2 <<  4) | REG2) & static_cast<glm::uint16>(0x0F0F);
 
-		REG1 = ((REG1 <<  2) | REG1) & static_cast<glm::uint16>(0x3333);
-		REG2 = ((REG2 <<  2) | REG2) & static_cast<glm::uint16>(0x3333);
+			REG1 = ((REG1 <<  2) | REG1) & static_cast<glm::uint16>(0x3333);
+			REG2 = ((REG2 <<  2) | REG2) & static_cast<glm::uint16>(0x3333);
 
-		REG1 = ((REG1 <<  1) | REG1) & static_cast<glm::uint16>(0x5555);
-		REG2 = ((REG2 <<  1) | REG2) & static_cast<glm::uint16>(0x5555);
+			REG1 = ((REG1 <<  1) | REG1) & static_cast<glm::uint16>(0x5555);
+			REG2 = ((REG2 <<  1) | REG2) & static_cast<glm::uint16>(0x5555);
 
-		return REG1 | static_cast<glm::uint16>(REG2 << 1);
+			return REG1 | static_cast<glm::uint16>(REG2 << 1);
+#		endif
 	}
 
 	template<>
 	GLM_FUNC_QUALIFIER glm::uint32 bitfieldInterleave(glm::uint16 x, glm::uint16 y)
 	{
-		glm::uint32 REG1(x);
-		glm::uint32 REG2(y);
+#		if GLM_CONFIG_BMI2 == GLM_ENABLE
+			return _pdep_u32(x, 0x55555555u) | _pdep_u32(y, 0xAAAAAAAAu);
+#		else
+			glm::uint32 REG1(x);
+			glm::uint32 REG2(y);
 
-		REG1 = ((REG1 <<  8) | REG1) & static_cast<glm::uint32>(0x00FF00FF);
-		REG2 = ((REG2 <<  8) | REG2) & static_cast<glm::uint32>(0x00FF00FF);
+			REG1 = ((REG1 <<  8) | REG1) & static_cast<glm::uint32>(0x00FF00FF);
+			REG2 = ((REG2 <<  8) | REG2) & static_cast<glm::uint32>(0x00FF00FF);
 
-		REG1 = ((REG1 <<  4) | REG1) & static_cast<glm::uint32>(0x0F0F0F0F);
-		REG2 = ((REG2 <<  4) | REG2) & static_cast<glm::uint32>(0x0F0F0F0F);
+			REG1 = ((REG1 <<  4) | REG1) & static_cast<glm::uint32>(0x0F0F0F0F);
+			REG2 = ((REG2 <<  4) | REG2) & static_cast<glm::uint32>(0x0F0F0F0F);
 
-		REG1 = ((REG1 <<  2) | REG1) & static_cast<glm::uint32>(0x33333333);
-		REG2 = ((REG2 <<  2) | REG2) & static_cast<glm::uint32>(0x33333333);
+			REG1 = ((REG1 <<  2) | REG1) & static_cast<glm::uint32>(0x33333333);
+			REG2 = ((REG2 <<  2) | REG2) & static_cast<glm::uint32>(0x33333333);
 
-		REG1 = ((REG1 <<  1) | REG1) & static_cast<glm::uint32>(0x55555555);
-		REG2 = ((REG2 <<  1) | REG2) & static_cast<glm::uint32>(0x55555555);
+			REG1 = ((REG1 <<  1) | REG1) & static_cast<glm::uint32>(0x55555555);
+			REG2 = ((REG2 <<  1) | REG2) & static_cast<glm::uint32>(0x55555555);
 
-		return REG1 | (REG2 << 1);
+			return REG1 | (REG2 << 1);
+#		endif
 	}
 
 	template<>
 	GLM_FUNC_QUALIFIER glm::uint64 bitfieldInterleave(glm::uint32 x, glm::uint32 y)
 	{
-		glm::uint64 REG1(x);
-		glm::uint64 REG2(y);
+#		if GLM_CONFIG_BMI2 == GLM_ENABLE
+			return _pdep_u64(x, 0x5555555555555555ull) | _pdep_u64(y, 0xAAAAAAAAAAAAAAAAull);
+#		else
+			glm::uint64 REG1(x);
+			glm::uint64 REG2(y);
 
-		REG1 = ((REG1 << 16) | REG1) & static_cast<glm::uint64>(0x0000FFFF0000FFFFull);
-		REG2 = ((REG2 << 16) | REG2) & static_cast<glm::uint64>(0x0000FFFF0000FFFFull);
+			REG1 = ((REG1 << 16) | REG1) & static_cast<glm::uint64>(0x0000FFFF0000FFFFull);
+			REG2 = ((REG2 << 16) | REG2) & static_cast<glm::uint64>(0x0000FFFF0000FFFFull);
 
-		REG1 = ((REG1 <<  8) | REG1) & static_cast<glm::uint64>(0x00FF00FF00FF00FFull);
-		REG2 = ((REG2 <<  8) | REG2) & static_cast<glm::uint64>(0x00FF00FF00FF00FFull);
+			REG1 = ((REG1 <<  8) | REG1) & static_cast<glm::uint64>(0x00FF00FF00FF00FFull);
+			REG2 = ((REG2 <<  8) | REG2) & static_cast<glm::uint64>(0x00FF00FF00FF00FFull);
 
-		REG1 = ((REG1 <<  4) | REG1) & static_cast<glm::uint64>(0x0F0F0F0F0F0F0F0Full);
-		REG2 = ((REG2 <<  4) | REG2) & static_cast<glm::uint64>(0x0F0F0F0F0F0F0F0Full);
+			REG1 = ((REG1 <<  4) | REG1) & static_cast<glm::uint64>(0x0F0F0F0F0F0F0F0Full);
+			REG2 = ((REG2 <<  4) | REG2) & static_cast<glm::uint64>(0x0F0F0F0F0F0F0F0Full);
 
-		REG1 = ((REG1 <<  2) | REG1) & static_cast<glm::uint64>(0x3333333333333333ull);
-		REG2 = ((REG2 <<  2) | REG2) & static_cast<glm::uint64>(0x3333333333333333ull);
+			REG1 = ((REG1 <<  2) | REG1) & static_cast<glm::uint64>(0x3333333333333333ull);
+			REG2 = ((REG2 <<  2) | REG2) & static_cast<glm::uint64>(0x3333333333333333ull);
 
-		REG1 = ((REG1 <<  1) | REG1) & static_cast<glm::uint64>(0x5555555555555555ull);
-		REG2 = ((REG2 <<  1) | REG2) & static_cast<glm::uint64>(0x5555555555555555ull);
+			REG1 = ((REG1 <<  1) | REG1) & static_cast<glm::uint64>(0x5555555555555555ull);
+			REG2 = ((REG2 <<  1) | REG2) & static_cast<glm::uint64>(0x5555555555555555ull);
 
-		return REG1 | (REG2 << 1);
+			return REG1 | (REG2 << 1);
+#		endif
 	}
 
 	template<>
 	GLM_FUNC_QUALIFIER glm::uint32 bitfieldInterleave(glm::uint8 x, glm::uint8 y, glm::uint8 z)
 	{
-		glm::uint32 REG1(x);
-		glm::uint32 REG2(y);
-		glm::uint32 REG3(z);
+#		if GLM_CONFIG_BMI2 == GLM_ENABLE
+			return _pdep_u32(x, 0x49249249u) | _pdep_u32(y, 0x92492492u) | _pdep_u32(z, 0x24924924u);
+#		else
+			glm::uint32 REG1(x);
+			glm::uint32 REG2(y);
+			glm::uint32 REG3(z);
 
-		REG1 = ((REG1 << 16) | REG1) & static_cast<glm::uint32>(0xFF0000FFu);
-		REG2 = ((REG2 << 16) | REG2) & static_cast<glm::uint32>(0xFF0000FFu);
-		REG3 = ((REG3 << 16) | REG3) & static_cast<glm::uint32>(0xFF0000FFu);
+			REG1 = ((REG1 << 16) | REG1) & static_cast<glm::uint32>(0xFF0000FFu);
+			REG2 = ((REG2 << 16) | REG2) & static_cast<glm::uint32>(0xFF0000FFu);
+			REG3 = ((REG3 << 16) | REG3) & static_cast<glm::uint32>(0xFF0000FFu);
 
-		REG1 = ((REG1 <<  8) | REG1) & static_cast<glm::uint32>(0x0F00F00Fu);
-		REG2 = ((REG2 <<  8) | REG2) & static_cast<glm::uint32>(0x0F00F00Fu);
-		REG3 = ((REG3 <<  8) | REG3) & static_cast<glm::uint32>(0x0F00F00Fu);
+			REG1 = ((REG1 <<  8) | REG1) & static_cast<glm::uint32>(0x0F00F00Fu);
+			REG2 = ((REG2 <<  8) | REG2) & static_cast<glm::uint32>(0x0F00F00Fu);
+			REG3 = ((REG3 <<  8) | REG3) & static_cast<glm::uint32>(0x0F00F00Fu);
 
-		REG1 = ((REG1 <<  4) | REG1) & static_cast<glm::uint32>(0xC30C30C3u);
-		REG2 = ((REG2 <<  4) | REG2) & static_cast<glm::uint32>(0xC30C30C3u);
-		REG3 = ((REG3 <<  4) | REG3) & static_cast<glm::uint32>(0xC30C30C3u);
+			REG1 = ((REG1 <<  4) | REG1) & static_cast<glm::uint32>(0xC30C30C3u);
+			REG2 = ((REG2 <<  4) | REG2) & static_cast<glm::uint32>(0xC30C30C3u);
+			REG3 = ((REG3 <<  4) | REG3) & static_cast<glm::uint32>(0xC30C30C3u);
 
-		REG1 = ((REG1 <<  2) | REG1) & static_cast<glm::uint32>(0x49249249u);
-		REG2 = ((REG2 <<  2) | REG2) & static_cast<glm::uint32>(0x49249249u);
-		REG3 = ((REG3 <<  2) | REG3) & static_cast<glm::uint32>(0x49249249u);
+			REG1 = ((REG1 <<  2) | REG1) & static_cast<glm::uint32>(0x49249249u);
+			REG2 = ((REG2 <<  2) | REG2) & static_cast<glm::uint32>(0x49249249u);
+			REG3 = ((REG3 <<  2) | REG3) & static_cast<glm::uint32>(0x49249249u);
 
-		return REG1 | (REG2 << 1) | (REG3 << 2);
+			return REG1 | (REG2 << 1) | (REG3 << 2);
+#		endif
 	}
 
 	template<>
 	GLM_FUNC_QUALIFIER glm::uint64 bitfieldInterleave(glm::uint16 x, glm::uint16 y, glm::uint16 z)
 	{
-		glm::uint64 REG1(x);
-		glm::uint64 REG2(y);
-		glm::uint64 REG3(z);
+#		if GLM_CONFIG_BMI2 == GLM_ENABLE
+			return _pdep_u64(x, 0x9249249249249249ull) | _pdep_u64(y, 0x2492492492492492ull) | _pdep_u64(z, 0x4924924924924924ull);
+#		else
+			glm::uint64 REG1(x);
+			glm::uint64 REG2(y);
+			glm::uint64 REG3(z);
 
-		REG1 = ((REG1 << 32) | REG1) & static_cast<glm::uint64>(0xFFFF00000000FFFFull);
-		REG2 = ((REG2 << 32) | REG2) & static_cast<glm::uint64>(0xFFFF00000000FFFFull);
-		REG3 = ((REG3 << 32) | REG3) & static_cast<glm::uint64>(0xFFFF00000000FFFFull);
+			REG1 = ((REG1 << 32) | REG1) & static_cast<glm::uint64>(0xFFFF00000000FFFFull);
+			REG2 = ((REG2 << 32) | REG2) & static_cast<glm::uint64>(0xFFFF00000000FFFFull);
+			REG3 = ((REG3 << 32) | REG3) & static_cast<glm::uint64>(0xFFFF00000000FFFFull);
 
-		REG1 = ((REG1 << 16) | REG1) & static_cast<glm::uint64>(0x00FF0000FF0000FFull);
-		REG2 = ((REG2 << 16) | REG2) & static_cast<glm::uint64>(0x00FF0000FF0000FFull);
-		REG3 = ((REG3 << 16) | REG3) & static_cast<glm::uint64>(0x00FF0000FF0000FFull);
+			REG1 = ((REG1 << 16) | REG1) & static_cast<glm::uint64>(0x00FF0000FF0000FFull);
+			REG2 = ((REG2 << 16) | REG2) & static_cast<glm::uint64>(0x00FF0000FF0000FFull);
+			REG3 = ((REG3 << 16) | REG3) & static_cast<glm::uint64>(0x00FF0000FF0000FFull);
 
-		REG1 = ((REG1 <<  8) | REG1) & static_cast<glm::uint64>(0xF00F00F00F00F00Full);
-		REG2 = ((REG2 <<  8) | REG2) & static_cast<glm::uint64>(0xF00F00F00F00F00Full);
-		REG3 = ((REG3 <<  8) | REG3) & static_cast<glm::uint64>(0xF00F00F00F00F00Full);
+			REG1 = ((REG1 <<  8) | REG1) & static_cast<glm::uint64>(0xF00F00F00F00F00Full);
+			REG2 = ((REG2 <<  8) | REG2) & static_cast<glm::uint64>(0xF00F00F00F00F00Full);
+			REG3 = ((REG3 <<  8) | REG3) & static_cast<glm::uint64>(0xF00F00F00F00F00Full);
 
-		REG1 = ((REG1 <<  4) | REG1) & static_cast<glm::uint64>(0x30C30C30C30C30C3ull);
-		REG2 = ((REG2 <<  4) | REG2) & static_cast<glm::uint64>(0x30C30C30C30C30C3ull);
-		REG3 = ((REG3 <<  4) | REG3) & static_cast<glm::uint64>(0x30C30C30C30C30C3ull);
+			REG1 = ((REG1 <<  4) | REG1) & static_cast<glm::uint64>(0x30C30C30C30C30C3ull);
+			REG2 = ((REG2 <<  4) | REG2) & static_cast<glm::uint64>(0x30C30C30C30C30C3ull);
+			REG3 = ((REG3 <<  4) | REG3) & static_cast<glm::uint64>(0x30C30C30C30C30C3ull);
 
-		REG1 = ((REG1 <<  2) | REG1) & static_cast<glm::uint64>(0x9249249249249249ull);
-		REG2 = ((REG2 <<  2) | REG2) & static_cast<glm::uint64>(0x9249249249249249ull);
-		REG3 = ((REG3 <<  2) | REG3) & static_cast<glm::uint64>(0x9249249249249249ull);
+			REG1 = ((REG1 <<  2) | REG1) & static_cast<glm::uint64>(0x9249249249249249ull);
+			REG2 = ((REG2 <<  2) | REG2) & static_cast<glm::uint64>(0x9249249249249249ull);
+			REG3 = ((REG3 <<  2) | REG3) & static_cast<glm::uint64>(0x9249249249249249ull);
 
-		return REG1 | (REG2 << 1) | (REG3 << 2);
+			return REG1 | (REG2 << 1) | (REG3 << 2);
+#		endif
 	}
 
 	template<>
 	GLM_FUNC_QUALIFIER glm::uint64 bitfieldInterleave(glm::uint32 x, glm::uint32 y, glm::uint32 z)
 	{
-		glm::uint64 REG1(x);
-		glm::uint64 REG2(y);
-		glm::uint64 REG3(z);
+#		if GLM_CONFIG_BMI2 == GLM_ENABLE
+			// The shifts keep 22 bits of x but only 21 of y and z, and so do these masks.
+			return _pdep_u64(x, 0x9249249249249249ull) | _pdep_u64(y, 0x2492492492492492ull) | _pdep_u64(z, 0x4924924924924924ull);
+#		else
+			glm::uint64 REG1(x);
+			glm::uint64 REG2(y);
+			glm::uint64 REG3(z);
 
-		REG1 = ((REG1 << 32) | REG1) & static_cast<glm::uint64>(0xFFFF00000000FFFFull);
-		REG2 = ((REG2 << 32) | REG2) & static_cast<glm::uint64>(0xFFFF00000000FFFFull);
-		REG3 = ((REG3 << 32) | REG3) & static_cast<glm::uint64>(0xFFFF00000000FFFFull);
+			REG1 = ((REG1 << 32) | REG1) & static_cast<glm::uint64>(0xFFFF00000000FFFFull);
+			REG2 = ((REG2 << 32) | REG2) & static_cast<glm::uint64>(0xFFFF00000000FFFFull);
+			REG3 = ((REG3 << 32) | REG3) & static_cast<glm::uint64>(0xFFFF00000000FFFFull);
 
-		REG1 = ((REG1 << 16) | REG1) & static_cast<glm::uint64>(0x00FF0000FF0000FFull);
-		REG2 = ((REG2 << 16) | REG2) & static_cast<glm::uint64>(0x00FF0000FF0000FFull);
-		REG3 = ((REG3 << 16) | REG3) & static_cast<glm::uint64>(0x00FF0000FF0000FFull);
+			REG1 = ((REG1 << 16) | REG1) & static_cast<glm::uint64>(0x00FF0000FF0000FFull);
+			REG2 = ((REG2 << 16) | REG2) & static_cast<glm::uint64>(0x00FF0000FF0000FFull);
+			REG3 = ((REG3 << 16) | REG3) & static_cast<glm::uint64>(0x00FF0000FF0000FFull);
 
-		REG1 = ((REG1 <<  8) | REG1) & static_cast<glm::uint64>(0xF00F00F00F00F00Full);
-		REG2 = ((REG2 <<  8) | REG2) & static_cast<glm::uint64>(0xF00F00F00F00F00Full);
-		REG3 = ((REG3 <<  8) | REG3) & static_cast<glm::uint64>(0xF00F00F00F00F00Full);
+			REG1 = ((REG1 <<  8) | REG1) & static_cast<glm::uint64>(0xF00F00F00F00F00Full);
+			REG2 = ((REG2 <<  8) | REG2) & static_cast<glm::uint64>(0xF00F00F00F00F00Full);
+			REG3 = ((REG3 <<  8) | REG3) & static_cast<glm::uint64>(0xF00F00F00F00F00Full);
 
-		REG1 = ((REG1 <<  4) | REG1) & static_cast<glm::uint64>(0x30C30C30C30C30C3ull);
-		REG2 = ((REG2 <<  4) | REG2) & static_cast<glm::uint64>(0x30C30C30C30C30C3ull);
-		REG3 = ((REG3 <<  4) | REG3) & static_cast<glm::uint64>(0x30C30C30C30C30C3ull);
+			REG1 = ((REG1 <<  4) | REG1) & static_cast<glm::uint64>(0x30C30C30C30C30C3ull);
+			REG2 = ((REG2 <<  4) | REG2) & static_cast<glm::uint64>(0x30C30C30C30C30C3ull);
+			REG3 = ((REG3 <<  4) | REG3) & static_cast<glm::uint64>(0x30C30C30C30C30C3ull);
 
-		REG1 = ((REG1 <<  2) | REG1) & static_cast<glm::uint64>(0x9249249249249249ull);
-		REG2 = ((REG2 <<  2) | REG2) & static_cast<glm::uint64>(0x9249249249249249ull);
-		REG3 = ((REG3 <<  2) | REG3) & static_cast<glm::uint64>(0x9249249249249249ull);
+			REG1 = ((REG1 <<  2) | REG1) & static_cast<glm::uint64>(0x9249249249249249ull);
+			REG2 = ((REG2 <<  2) | REG2) & static_cast<glm::uint64>(0x9249249249249249ull);
+			REG3 = ((REG3 <<  2) | REG3) & static_cast<glm::uint64>(0x9249249249249249ull);
 
-		return REG1 | (REG2 << 1) | (REG3 << 2);
+			return REG1 | (REG2 << 1) | (REG3 << 2);
+#		endif
 	}
 
 	template<>
 	GLM_FUNC_QUALIFIER glm::uint32 bitfieldInterleave(glm::uint8 x, glm::uint8 y, glm::uint8 z, glm::uint8 w)
 	{
-		glm::uint32 REG1(x);
-		glm::uint32 REG2(y);
-		glm::uint32 REG3(z);
-		glm::uint32 REG4(w);
+#		if GLM_CONFIG_BMI2 == GLM_ENABLE
+			return _pdep_u32(x, 0x11111111u) | _pdep_u32(y, 0x22222222u) | _pdep_u32(z, 0x44444444u) | _pdep_u32(w, 0x88888888u);
+#		else
+			glm::uint32 REG1(x);
+			glm::uint32 REG2(y);
+			glm::uint32 REG3(z);
+			glm::uint32 REG4(w);
 
-		REG1 = ((REG1 << 12) | REG1) & static_cast<glm::uint32>(0x000F000Fu);
-		REG2 = ((REG2 << 12) | REG2) & static_cast<glm::uint32>(0x000F000Fu);
-		REG3 = ((REG3 << 12) | REG3) & static_cast<glm::uint32>(0x000F000Fu);
-		REG4 = ((REG4 << 12) | REG4) & static_cast<glm::uint32>(0x000F000Fu);
+			REG1 = ((REG1 << 12) | REG1) & static_cast<glm::uint32>(0x000F000Fu);
+			REG2 = ((REG2 << 12) | REG2) & static_cast<glm::uint32>(0x000F000Fu);
+			REG3 = ((REG3 << 12) | REG3) & static_cast<glm::uint32>(0x000F000Fu);
+			REG4 = ((REG4 << 12) | REG4) & static_cast<glm::uint32>(0x000F000Fu);
 
-		REG1 = ((REG1 <<  6) | REG1) & static_cast<glm::uint32>(0x03030303u);
-		REG2 = ((REG2 <<  6) | REG2) & static_cast<glm::uint32>(0x03030303u);
-		REG3 = ((REG3 <<  6) | REG3) & static_cast<glm::uint32>(0x03030303u);
-		REG4 = ((REG4 <<  6) | REG4) & static_cast<glm::uint32>(0x03030303u);
+			REG1 = ((REG1 <<  6) | REG1) & static_cast<glm::uint32>(0x03030303u);
+			REG2 = ((REG2 <<  6) | REG2) & static_cast<glm::uint32>(0x03030303u);
+			REG3 = ((REG3 <<  6) | REG3) & static_cast<glm::uint32>(0x03030303u);
+			REG4 = ((REG4 <<  6) | REG4) & static_cast<glm::uint32>(0x03030303u);
 
-		REG1 = ((REG1 <<  3) | REG1) & static_cast<glm::uint32>(0x11111111u);
-		REG2 = ((REG2 <<  3) | REG2) & static_cast<glm::uint32>(0x11111111u);
-		REG3 = ((REG3 <<  3) | REG3) & static_cast<glm::uint32>(0x11111111u);
-		REG4 = ((REG4 <<  3) | REG4) & static_cast<glm::uint32>(0x11111111u);
+			REG1 = ((REG1 <<  3) | REG1) & static_cast<glm::uint32>(0x11111111u);
+			REG2 = ((REG2 <<  3) | REG2) & static_cast<glm::uint32>(0x11111111u);
+			REG3 = ((REG3 <<  3) | REG3) & static_cast<glm::uint32>(0x11111111u);
+			REG4 = ((REG4 <<  3) | REG4) & static_cast<glm::uint32>(0x11111111u);
 
-		return REG1 | (REG2 << 1) | (REG3 << 2) | (REG4 << 3);
+			return REG1 | (REG2 << 1) | (REG3 << 2) | (REG4 << 3);
+#		endif
 	}
 
 	template<>
 	GLM_FUNC_QUALIFIER glm::uint64 bitfieldInterleave(glm::uint16 x, glm::uint16 y, glm::uint16 z, glm::uint16 w)
 	{
-		glm::uint64 REG1(x);
-		glm::uint64 REG2(y);
-		glm::uint64 REG3(z);
-		glm::uint64 REG4(w);
+#		if GLM_CONFIG_BMI2 == GLM_ENABLE
+			return _pdep_u64(x, 0x1111111111111111ull) | _pdep_u64(y, 0x2222222222222222ull) | _pdep_u64(z, 0x4444444444444444ull) | _pdep_u64(w, 0x8888888888888888ull);
+#		else
+			glm::uint64 REG1(x);
+			glm::uint64 REG2(y);
+			glm::uint64 REG3(z);
+			glm::uint64 REG4(w);
 
-		REG1 = ((REG1 << 24) | REG1) & static_cast<glm::uint64>(0x000000FF000000FFull);
-		REG2 = ((REG2 << 24) | REG2) & static_cast<glm::uint64>(0x000000FF000000FFull);
-		REG3 = ((REG3 << 24) | REG3) & static_cast<glm::uint64>(0x000000FF000000FFull);
-		REG4 = ((REG4 << 24) | REG4) & static_cast<glm::uint64>(0x000000FF000000FFull);
+			REG1 = ((REG1 << 24) | REG1) & static_cast<glm::uint64>(0x000000FF000000FFull);
+			REG2 = ((REG2 << 24) | REG2) & static_cast<glm::uint64>(0x000000FF000000FFull);
+			REG3 = ((REG3 << 24) | REG3) & static_cast<glm::uint64>(0x000000FF000000FFull);
+			REG4 = ((REG4 << 24) | REG4) & static_cast<glm::uint64>(0x000000FF000000FFull);
 
-		REG1 = ((REG1 << 12) | REG1) & static_cast<glm::uint64>(0x000F000F000F000Full);
-		REG2 = ((REG2 << 12) | REG2) & static_cast<glm::uint64>(0x000F000F000F000Full);
-		REG3 = ((REG3 << 12) | REG3) & static_cast<glm::uint64>(0x000F000F000F000Full);
-		REG4 = ((REG4 << 12) | REG4) & static_cast<glm::uint64>(0x000F000F000F000Full);
+			REG1 = ((REG1 << 12) | REG1) & static_cast<glm::uint64>(0x000F000F000F000Full);
+			REG2 = ((REG2 << 12) | REG2) & static_cast<glm::uint64>(0x000F000F000F000Full);
+			REG3 = ((REG3 << 12) | REG3) & static_cast<glm::uint64>(0x000F000F000F000Full);
+			REG4 = ((REG4 << 12) | REG4) & static_cast<glm::uint64>(0x000F000F000F000Full);
 
-		REG1 = ((REG1 <<  6) | REG1) & static_cast<glm::uint64>(0x0303030303030303ull);
-		REG2 = ((REG2 <<  6) | REG2) & static_cast<glm::uint64>(0x0303030303030303ull);
-		REG3 = ((REG3 <<  6) | REG3) & static_cast<glm::uint64>(0x0303030303030303ull);
-		REG4 = ((REG4 <<  6) | REG4) & static_cast<glm::uint64>(0x0303030303030303ull);
+			REG1 = ((REG1 <<  6) | REG1) & static_cast<glm::uint64>(0x0303030303030303ull);
+			REG2 = ((REG2 <<  6) | REG2) & static_cast<glm::uint64>(0x0303030303030303ull);
+			REG3 = ((REG3 <<  6) | REG3) & static_cast<glm::uint64>(0x0303030303030303ull);
+			REG4 = ((REG4 <<  6) | REG4) & static_cast<glm::uint64>(0x0303030303030303ull);
 
-		REG1 = ((REG1 <<  3) | REG1) & static_cast<glm::uint64>(0x1111111111111111ull);
-		REG2 = ((REG2 <<  3) | REG2) & static_cast<glm::uint64>(0x1111111111111111ull);
-		REG3 = ((REG3 <<  3) | REG3) & static_cast<glm::uint64>(0x1111111111111111ull);
-		REG4 = ((REG4 <<  3) | REG4) & static_cast<glm::uint64>(0x1111111111111111ull);
+			REG1 = ((REG1 <<  3) | REG1) & static_cast<glm::uint64>(0x1111111111111111ull);
+			REG2 = ((REG2 <<  3) | REG2) & static_cast<glm::uint64>(0x1111111111111111ull);
+			REG3 = ((REG3 <<  3) | REG3) & static_cast<glm::uint64>(0x1111111111111111ull);
+			REG4 = ((REG4 <<  3) | REG4) & static_cast<glm::uint64>(0x1111111111111111ull);
 
-		return REG1 | (REG2 << 1) | (REG3 << 2) | (REG4 << 3);
+			return REG1 | (REG2 << 1) | (REG3 << 2) | (REG4 << 3);
+#		endif
+	}
+
+	// The span functions below keep 21 bits of each coordinate, which is where
+	// bitfieldInterleave(uint32, uint32, uint32) and the SIMD lanes agree.
+	GLM_FUNC_QUALIFIER uint64 bitfield_spread3(uint64 x)
+	{
+		x &= 0x00000000001FFFFFull;
+		x = ((x << 32) | x) & 0x001F00000000FFFFull;
+		x = ((x << 16) | x) & 0x001F0000FF0000FFull;
+		x = ((x <<  8) | x) & 0x100F00F00F00F00Full;
+		x = ((x <<  4) | x) & 0x10C30C30C30C30C3ull;
+		return ((x <<  2) | x) & 0x1249249249249249ull;
+	}
+
+	GLM_FUNC_QUALIFIER uint32 bitfield_compact3(uint64 x)
+	{
+		x &= 0x1249249249249249ull;
+		x = ((x >>  2) | x) & 0x10C30C30C30C30C3ull;
+		x = ((x >>  4) | x) & 0x100F00F00F00F00Full;
+		x = ((x >>  8) | x) & 0x001F0000FF0000FFull;
+		x = ((x >> 16) | x) & 0x001F00000000FFFFull;
+		return static_cast<uint32>(((x >> 32) | x) & 0x00000000001FFFFFull);
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void bitfield_interleave_scalar(vec<3, uint32, Q> const* In, uint64* Out, std::size_t First, std::size_t Count)
+	{
+		for(std::size_t i = First; i < Count; ++i)
+			Out[i] = bitfield_spread3(In[i].x) | (bitfield_spread3(In[i].y) << 1) | (bitfield_spread3(In[i].z) << 2);
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void bitfield_deinterleave_scalar(uint64 const* In, vec<3, uint32, Q>* Out, std::size_t First, std::size_t Count)
+	{
+		for(std::size_t i = First; i < Count; ++i)
+			Out[i] = vec<3, uint32, Q>(bitfield_compact3(In[i]), bitfield_compact3(In[i] >> 1), bitfield_compact3(In[i] >> 2));
+	}
+
+	// Like the transform_batch kernels, the Morton kernels take packed uvec3
+	// as raw uint32 and return how many codes they handled; the span
+	// functions finish the rest with the scalar code.
+	typedef std::size_t (*bitfield_interleave_kernel)(uint32 const* in, uint64* out, std::size_t count);
+	typedef std::size_t (*bitfield_deinterleave_kernel)(uint64 const* in, uint32* out, std::size_t count);
+	// Four codes at a time: lane permutes split x, y and z of four uvec3
+	// and put them back. SSE2 has no such kernel: two 64-bit lanes do no
+	// better than the scalar shifts.
+#	if (GLM_ARCH & GLM_ARCH_AVX2_BIT) || (GLM_CONFIG_SIMD_DISPATCH == GLM_ENABLE)
+	struct bitfield_batch_avx2
+	{
+		GLM_TARGET_AVX2 GLM_FUNC_QUALIFIER static __m256i spread(__m256i x)
+		{
+			x = _mm256_and_si256(x, _mm256_set1_epi64x(0x00000000001FFFFFll));
+			x = _mm256_and_si256(_mm256_or_si256(_mm256_slli_epi64(x, 32), x), _mm256_set1_epi64x(0x001F00000000FFFFll));
+			x = _mm256_and_si256(_mm256_or_si256(_mm256_slli_epi64(x, 16), x), _mm256_set1_epi64x(0x001F0000FF0000FFll));
+			x = _mm256_and_si256(_mm256_or_si256(_mm256_slli_epi64(x, 8), x), _mm256_set1_epi64x(0x100F00F00F00F00Fll));
+			x = _mm256_and_si256(_mm256_or_si256(_mm256_slli_epi64(x, 4), x), _mm256_set1_epi64x(0x10C30C30C30C30C3ll));
+			return _mm256_and_si256(_mm256_or_si256(_mm256_slli_epi64(x, 2), x), _mm256_set1_epi64x(0x1249249249249249ll));
+		}
+
+		GLM_TARGET_AVX2 GLM_FUNC_QUALIFIER static __m256i compact(__m256i x)
+		{
+			x = _mm256_and_si256(x, _mm256_set1_epi64x(0x1249249249249249ll));
+			x = _mm256_and_si256(_mm256_or_si256(_mm256_srli_epi64(x, 2), x), _mm256_set1_epi64x(0x10C30C30C30C30C3ll));
+			x = _mm256_and_si256(_mm256_or_si256(_mm256_srli_epi64(x, 4), x), _mm256_set1_epi64x(0x100F00F00F00F00Fll));
+			x = _mm256_and_si256(_mm256_or_si256(_mm256_srli_epi64(x, 8), x), _mm256_set1_epi64x(0x001F0000FF0000FFll));
+			x = _mm256_and_si256(_mm256_or_si256(_mm256_srli_epi64(x, 16), x), _mm256_set1_epi64x(0x001F00000000FFFFll));
+			return _mm256_and_si256(_mm256_or_si256(_mm256_srli_epi64(x, 32), x), _mm256_set1_epi64x(0x00000000001FFFFFll));
+		}
+
+		GLM_TARGET_AVX2 GLM_FUNC_QUALIFIER static std::size_t interleave(uint32 const* in, uint64* out, std::size_t count)
+		{
+			__m256i const PickX = _mm256_setr_epi32(0, 3, 6, 0, 0, 0, 0, 0);
+			__m256i const PickY = _mm256_setr_epi32(1, 4, 7, 0, 0, 0, 0, 0);
+			__m256i const PickZ = _mm256_setr_epi32(2, 5, 0, 0, 0, 0, 0, 0);
+			std::size_t i = 0;
+			for(; i + 4 <= count; i += 4)
+			{
+				__m256i const Lo = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(in + 3 * i));	// x0 y0 z0 x1 y1 z1 x2 y2
+				__m128i const Hi = _mm_loadu_si128(reinterpret_cast<__m128i const*>(in + 3 * i + 8));	// z2 x3 y3 z3
+				__m128i const x = _mm_blend_epi32(_mm256_castsi256_si128(_mm256_permutevar8x32_epi32(Lo, PickX)), _mm_shuffle_epi32(Hi, _MM_SHUFFLE(1, 1, 1, 1)), 0x8);
+				__m128i const y = _mm_blend_epi32(_mm256_castsi256_si128(_mm256_permutevar8x32_epi32(Lo, PickY)), _mm_shuffle_epi32(Hi, _MM_SHUFFLE(2, 2, 2, 2)), 0x8);
+				__m128i const z = _mm_blend_epi32(_mm256_castsi256_si128(_mm256_permutevar8x32_epi32(Lo, PickZ)), _mm_shuffle_epi32(Hi, _MM_SHUFFLE(3, 0, 0, 0)), 0xC);
+				__m256i const Code = _mm256_or_si256(spread(_mm256_cvtepu32_epi64(x)),
+					_mm256_or_si256(_mm256_slli_epi64(spread(_mm256_cvtepu32_epi64(y)), 1), _mm256_slli_epi64(spread(_mm256_cvtepu32_epi64(z)), 2)));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), Code);
+			}
+			return i;
+		}
+
+		GLM_TARGET_AVX2 GLM_FUNC_QUALIFIER static std::size_t deinterleave(uint64 const* in, uint32* out, std::size_t count)
+		{
+			__m256i const LoXY = _mm256_setr_epi32(0, 1, 0, 2, 3, 0, 4, 5);
+			__m256i const LoZ = _mm256_setr_epi32(0, 0, 0, 0, 0, 2, 0, 0);
+			__m256i const HiXY = _mm256_setr_epi32(0, 6, 7, 0, 0, 0, 0, 0);
+			__m256i const HiZ = _mm256_setr_epi32(4, 0, 0, 6, 0, 0, 0, 0);
+			std::size_t i = 0;
+			for(; i + 4 <= count; i += 4)
+			{
+				__m256i const Code = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(in + i));
+				__m256i const XY = _mm256_or_si256(compact(Code), _mm256_slli_epi64(compact(_mm256_srli_epi64(Code, 1)), 32));	// x0 y0 x1 y1 x2 y2 x3 y3
+				__m256i const Z = compact(_mm256_srli_epi64(Code, 2));															// z0 0 z1 0 z2 0 z3 0
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 3 * i), _mm256_blend_epi32(_mm256_permutevar8x32_epi32(XY, LoXY), _mm256_permutevar8x32_epi32(Z, LoZ), 0x24));
+				__m256i const Hi = _mm256_blend_epi32(_mm256_permutevar8x32_epi32(XY, HiXY), _mm256_permutevar8x32_epi32(Z, HiZ), 0x9);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 3 * i + 8), _mm256_castsi256_si128(Hi));
+			}
+			return i;
+		}
+	};
+#	endif
+
+	// One PDEP or PEXT per coordinate. They take 3 cycles on Intel since
+	// Haswell and on AMD since Zen 3, but are microcoded on Zen and Zen 2,
+	// where the shifts of the SIMD kernels are much faster.
+#	if (GLM_CONFIG_BMI2 == GLM_ENABLE) || ((GLM_CONFIG_SIMD_DISPATCH == GLM_ENABLE) && (defined(__x86_64__) || defined(_M_X64)))
+	struct bitfield_batch_bmi2
+	{
+		GLM_TARGET_BMI2 GLM_FUNC_QUALIFIER static std::size_t interleave(uint32 const* in, uint64* out, std::size_t count)
+		{
+			for(std::size_t i = 0; i < count; ++i)
+				out[i] = _pdep_u64(in[3 * i], 0x1249249249249249ull) | _pdep_u64(in[3 * i + 1], 0x2492492492492492ull) | _pdep_u64(in[3 * i + 2], 0x4924924924924924ull);
+			return count;
+		}
+
+		GLM_TARGET_BMI2 GLM_FUNC_QUALIFIER static std::size_t deinterleave(uint64 const* in, uint32* out, std::size_t count)
+		{
+			for(std::size_t i = 0; i < count; ++i)
+			{
+				out[3 * i] = static_cast<uint32>(_pext_u64(in[i], 0x1249249249249249ull));
+				out[3 * i + 1] = static_cast<uint32>(_pext_u64(in[i], 0x2492492492492492ull));
+				out[3 * i + 2] = static_cast<uint32>(_pext_u64(in[i], 0x4924924924924924ull));
+			}
+			return count;
+		}
+	};
+#	endif
+
+#	if GLM_CONFIG_BMI2 == GLM_ENABLE
+	typedef bitfield_batch_bmi2 bitfield_batch_simd;
+#	elif GLM_ARCH & GLM_ARCH_AVX2_BIT
+	typedef bitfield_batch_avx2 bitfield_batch_simd;
+#	endif
+
+	GLM_FUNC_QUALIFIER bitfield_interleave_kernel bitfield_interleave_default()
+	{
+#		if (GLM_CONFIG_BMI2 == GLM_ENABLE) || (GLM_ARCH & GLM_ARCH_AVX2_BIT)
+			return &bitfield_batch_simd::interleave;
+#		else
+			return GLM_NULLPTR;
+#		endif
+	}
+
+	GLM_FUNC_QUALIFIER bitfield_deinterleave_kernel bitfield_deinterleave_default()
+	{
+#		if (GLM_CONFIG_BMI2 == GLM_ENABLE) || (GLM_ARCH & GLM_ARCH_AVX2_BIT)
+			return &bitfield_batch_simd::deinterleave;
+#		else
+			return GLM_NULLPTR;
+#		endif
 	}
 }//namespace detail
 
@@ -339,25 +530,29 @@ namespace detail
 
 	GLM_FUNC_QUALIFIER u8vec2 bitfieldDeinterleave(glm::uint16 x)
 	{
-		uint16 REG1(x);
-		uint16 REG2(x >>= 1);
+#		if GLM_CONFIG_BMI2 == GLM_ENABLE
+			return glm::u8vec2(_pext_u32(x, 0x5555u), _pext_u32(x, 0xAAAAu));
+#		else
+			uint16 REG1(x);
+			uint16 REG2(x >>= 1);
 
-		REG1 = REG1 & static_cast<uint16>(0x5555);
-		REG2 = REG2 & static_cast<uint16>(0x5555);
+			REG1 = REG1 & static_cast<uint16>(0x5555);
+			REG2 = REG2 & static_cast<uint16>(0x5555);
 
-		REG1 = ((REG1 >> 1) | REG1) & static_cast<uint16>(0x3333);
-		REG2 = ((REG2 >> 1) | REG2) & static_cast<uint16>(0x3333);
+			REG1 = ((REG1 >> 1) | REG1) & static_cast<uint16>(0x3333);
+			REG2 = ((REG2 >> 1) | REG2) & static_cast<uint16>(0x3333);
 
-		REG1 = ((REG1 >> 2) | REG1) & static_cast<uint16>(0x0F0F);
-		REG2 = ((REG2 >> 2) | REG2) & static_cast<uint16>(0x0F0F);
+			REG1 = ((REG1 >> 2) | REG1) & static_cast<uint16>(0x0F0F);
+			REG2 = ((REG2 >> 2) | REG2) & static_cast<uint16>(0x0F0F);
 
-		REG1 = ((REG1 >> 4) | REG1) & static_cast<uint16>(0x00FF);
-		REG2 = ((REG2 >> 4) | REG2) & static_cast<uint16>(0x00FF);
+			REG1 = ((REG1 >> 4) | REG1) & static_cast<uint16>(0x00FF);
+			REG2 = ((REG2 >> 4) | REG2) & static_cast<uint16>(0x00FF);
 
-		REG1 = ((REG1 >> 8) | REG1) & static_cast<uint16>(0xFFFF);
-		REG2 = ((REG2 >> 8) | REG2) & static_cast<uint16>(0xFFFF);
+			REG1 = ((REG1 >> 8) | REG1) & static_cast<uint16>(0xFFFF);
+			REG2 = ((REG2 >> 8) | REG2) & static_cast<uint16>(0xFFFF);
 
-		return glm::u8vec2(REG1, REG2);
+			return glm::u8vec2(REG1, REG2);
+#		endif
 	}
 
 	GLM_FUNC_QUALIFIER int32 bitfieldInterleave(int16 x, int16 y)
@@ -393,25 +588,29 @@ namespace detail
 
 	GLM_FUNC_QUALIFIER glm::u16vec2 bitfieldDeinterleave(glm::uint32 x)
 	{
-		glm::uint32 REG1(x);
-		glm::uint32 REG2(x >>= 1);
+#		if GLM_CONFIG_BMI2 == GLM_ENABLE
+			return glm::u16vec2(_pext_u32(x, 0x55555555u), _pext_u32(x, 0xAAAAAAAAu));
+#		else
+			glm::uint32 REG1(x);
+			glm::uint32 REG2(x >>= 1);
 
-		REG1 = REG1 & static_cast<glm::uint32>(0x55555555);
-		REG2 = REG2 & static_cast<glm::uint32>(0x55555555);
+			REG1 = REG1 & static_cast<glm::uint32>(0x55555555);
+			REG2 = REG2 & static_cast<glm::uint32>(0x55555555);
 
-		REG1 = ((REG1 >> 1) | REG1) & static_cast<glm::uint32>(0x33333333);
-		REG2 = ((REG2 >> 1) | REG2) & static_cast<glm::uint32>(0x33333333);
+			REG1 = ((REG1 >> 1) | REG1) & static_cast<glm::uint32>(0x33333333);
+			REG2 = ((REG2 >> 1) | REG2) & static_cast<glm::uint32>(0x33333333);
 
-		REG1 = ((REG1 >> 2) | REG1) & static_cast<glm::uint32>(0x0F0F0F0F);
-		REG2 = ((REG2 >> 2) | REG2) & static_cast<glm::uint32>(0x0F0F0F0F);
+			REG1 = ((REG1 >> 2) | REG1) & static_cast<glm::uint32>(0x0F0F0F0F);
+			REG2 = ((REG2 >> 2) | REG2) & static_cast<glm::uint32>(0x0F0F0F0F);
 
-		REG1 = ((REG1 >> 4) | REG1) & static_cast<glm::uint32>(0x00FF00FF);
-		REG2 = ((REG2 >> 4) | REG2) & static_cast<glm::uint32>(0x00FF00FF);
+			REG1 = ((REG1 >> 4) | REG1) & static_cast<glm::uint32>(0x00FF00FF);
+			REG2 = ((REG2 >> 4) | REG2) & static_cast<glm::uint32>(0x00FF00FF);
 
-		REG1 = ((REG1 >> 8) | REG1) & static_cast<glm::uint32>(0x0000FFFF);
-		REG2 = ((REG2 >> 8) | REG2) & static_cast<glm::uint32>(0x0000FFFF);
+			REG1 = ((REG1 >> 8) | REG1) & static_cast<glm::uint32>(0x0000FFFF);
+			REG2 = ((REG2 >> 8) | REG2) & static_cast<glm::uint32>(0x0000FFFF);
 
-		return glm::u16vec2(REG1, REG2);
+			return glm::u16vec2(REG1, REG2);
+#		endif
 	}
 
 	GLM_FUNC_QUALIFIER int64 bitfieldInterleave(int32 x, int32 y)
@@ -447,28 +646,32 @@ namespace detail
 
 	GLM_FUNC_QUALIFIER glm::u32vec2 bitfieldDeinterleave(glm::uint64 x)
 	{
-		glm::uint64 REG1(x);
-		glm::uint64 REG2(x >>= 1);
+#		if GLM_CONFIG_BMI2 == GLM_ENABLE
+			return glm::u32vec2(_pext_u64(x, 0x5555555555555555ull), _pext_u64(x, 0xAAAAAAAAAAAAAAAAull));
+#		else
+			glm::uint64 REG1(x);
+			glm::uint64 REG2(x >>= 1);
 
-		REG1 = REG1 & static_cast<glm::uint64>(0x5555555555555555ull);
-		REG2 = REG2 & static_cast<glm::uint64>(0x5555555555555555ull);
+			REG1 = REG1 & static_cast<glm::uint64>(0x5555555555555555ull);
+			REG2 = REG2 & static_cast<glm::uint64>(0x5555555555555555ull);
 
-		REG1 = ((REG1 >> 1) | REG1) & static_cast<glm::uint64>(0x3333333333333333ull);
-		REG2 = ((REG2 >> 1) | REG2) & static_cast<glm::uint64>(0x3333333333333333ull);
+			REG1 = ((REG1 >> 1) | REG1) & static_cast<glm::uint64>(0x3333333333333333ull);
+			REG2 = ((REG2 >> 1) | REG2) & static_cast<glm::uint64>(0x3333333333333333ull);
 
-		REG1 = ((REG1 >> 2) | REG1) & static_cast<glm::uint64>(0x0F0F0F0F0F0F0F0Full);
-		REG2 = ((REG2 >> 2) | REG2) & static_cast<glm::uint64>(0x0F0F0F0F0F0F0F0Full);
+			REG1 = ((REG1 >> 2) | REG1) & static_cast<glm::uint64>(0x0F0F0F0F0F0F0F0Full);
+			REG2 = ((REG2 >> 2) | REG2) & static_cast<glm::uint64>(0x0F0F0F0F0F0F0F0Full);
 
-		REG1 = ((REG1 >> 4) | REG1) & static_cast<glm::uint64>(0x00FF00FF00FF00FFull);
-		REG2 = ((REG2 >> 4) | REG2) & static_cast<glm::uint64>(0x00FF00FF00FF00FFull);
+			REG1 = ((REG1 >> 4) | REG1) & static_cast<glm::uint64>(0x00FF00FF00FF00FFull);
+			REG2 = ((REG2 >> 4) | REG2) & static_cast<glm::uint64>(0x00FF00FF00FF00FFull);
 
-		REG1 = ((REG1 >> 8) | REG1) & static_cast<glm::uint64>(0x0000FFFF0000FFFFull);
-		REG2 = ((REG2 >> 8) | REG2) & static_cast<glm::uint64>(0x0000FFFF0000FFFFull);
+			REG1 = ((REG1 >> 8) | REG1) & static_cast<glm::uint64>(0x0000FFFF0000FFFFull);
+			REG2 = ((REG2 >> 8) | REG2) & static_cast<glm::uint64>(0x0000FFFF0000FFFFull);
 
-		REG1 = ((REG1 >> 16) | REG1) & static_cast<glm::uint64>(0x00000000FFFFFFFFull);
-		REG2 = ((REG2 >> 16) | REG2) & static_cast<glm::uint64>(0x00000000FFFFFFFFull);
+			REG1 = ((REG1 >> 16) | REG1) & static_cast<glm::uint64>(0x00000000FFFFFFFFull);
+			REG2 = ((REG2 >> 16) | REG2) & static_cast<glm::uint64>(0x00000000FFFFFFFFull);
 
-		return glm::u32vec2(REG1, REG2);
+			return glm::u32vec2(REG1, REG2);
+#		endif
 	}
 
 	GLM_FUNC_QUALIFIER int32 bitfieldInterleave(int8 x, int8 y, int8 z)
@@ -632,4 +835,35 @@ namespace detail
 	{
 		return detail::bitfieldInterleave<uint16, uint64>(v.x, v.y, v.z, v.w);
 	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void bitfieldInterleave(vec<3, uint32, Q> const* In, uint64* Out, std::size_t Count)
+	{
+		detail::bitfield_interleave_kernel const Kernel = detail::bitfield_interleave_default();
+		std::size_t Done = 0;
+		if(Kernel && sizeof(vec<3, uint32, Q>) == 3 * sizeof(uint32))
+			Done = Kernel(&In[0][0], Out, Count);
+		detail::bitfield_interleave_scalar(In, Out, Done, Count);
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void bitfieldDeinterleave(uint64 const* In, vec<3, uint32, Q>* Out, std::size_t Count)
+	{
+		detail::bitfield_deinterleave_kernel const Kernel = detail::bitfield_deinterleave_default();
+		std::size_t Done = 0;
+		if(Kernel && sizeof(vec<3, uint32, Q>) == 3 * sizeof(uint32))
+			Done = Kernel(In, &Out[0][0], Count);
+		detail::bitfield_deinterleave_scalar(In, Out, Done, Count);
+	}
+
+	GLM_FUNC_QUALIFIER char const* bitfieldIsa()
+	{
+#		if GLM_CONFIG_BMI2 == GLM_ENABLE
+			return "BMI2";
+#		elif GLM_ARCH & GLM_ARCH_AVX2_BIT
+			return "AVX2";
+#		else
+			return "scalar";
+#		endif
+	}
 }//namespace glm
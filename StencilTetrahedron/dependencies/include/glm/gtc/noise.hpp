@@ -26,6 +26,7 @@
 #include "../vec2.hpp"
 #include "../vec3.hpp"
 #include "../vec4.hpp"
+#include <cstddef>
 
 #if GLM_MESSAGES == GLM_ENABLE && !defined(GLM_EXT_INCLUDED)
 #	pragma message("GLM: GLM_GTC_noise extension included")
@@ -55,6 +56,57 @@ namespace glm
 	GLM_FUNC_DECL T simplex(
 		vec<L, T, Q> const& p);
 
+	/// out[i] = perlin(vec2(x[i], y[i])) for count points, four or eight at a
+	/// time with SSE2 or AVX2, whichever GLM_ARCH enables widest. The kernels
+	/// repeat perlin's float operations in the same order, so the results
+	/// equal perlin's, up to the sign of zeros. Builds that let the compiler
+	/// contract multiply-adds into FMA (GCC with -mfma) lose that on either
+	/// side, now and then by much more than rounding where a hash or gradient
+	/// changes; -ffp-contract=off keeps it. GLM_GTX_simd_dispatch's
+	/// dispatchPerlin picks AVX2 at run time.
+	/// @see gtc_noise
+	GLM_FUNC_DISCARD_DECL void perlin(float const* x, float const* y, float* out, std::size_t count);
+
+	/// out[i] = perlin(vec3(x[i], y[i], z[i])) for count points.
+	/// @see gtc_noise
+	GLM_FUNC_DISCARD_DECL void perlin(float const* x, float const* y, float const* z, float* out, std::size_t count);
+
+	/// out[i] = simplex(vec2(x[i], y[i])) for count points.
+	/// @see gtc_noise
+	GLM_FUNC_DISCARD_DECL void simplex(float const* x, float const* y, float* out, std::size_t count);
+
+	/// out[i] = simplex(vec3(x[i], y[i], z[i])) for count points.
+	/// @see gtc_noise
+	GLM_FUNC_DISCARD_DECL void simplex(float const* x, float const* y, float const* z, float* out, std::size_t count);
+
+	/// Perlin noise over a block of a regular grid: out[j * size.x + i] =
+	/// perlin(origin + step * vec2(first + uvec2(i, j))) for i < size.x and
+	/// j < size.y, computed as the span functions do. A sample only depends
+	/// on its index in the whole grid, so threads can fill separate blocks,
+	/// such as bands of rows, and get the same values as one call would.
+	/// @see gtc_noise
+	template<qualifier Q>
+	GLM_FUNC_DISCARD_DECL void perlinGrid(vec<2, float, Q> const& origin, vec<2, float, Q> const& step, vec<2, uint, Q> const& first, vec<2, uint, Q> const& size, float* out);
+
+	/// out[(k * size.y + j) * size.x + i] = perlin(origin + step * vec3(first + uvec3(i, j, k))).
+	/// @see gtc_noise
+	template<qualifier Q>
+	GLM_FUNC_DISCARD_DECL void perlinGrid(vec<3, float, Q> const& origin, vec<3, float, Q> const& step, vec<3, uint, Q> const& first, vec<3, uint, Q> const& size, float* out);
+
+	/// Simplex noise over a block of a regular grid, as perlinGrid.
+	/// @see gtc_noise
+	template<qualifier Q>
+	GLM_FUNC_DISCARD_DECL void simplexGrid(vec<2, float, Q> const& origin, vec<2, float, Q> const& step, vec<2, uint, Q> const& first, vec<2, uint, Q> const& size, float* out);
+
+	/// Simplex noise over a block of a regular grid, as perlinGrid.
+	/// @see gtc_noise
+	template<qualifier Q>
+	GLM_FUNC_DISCARD_DECL void simplexGrid(vec<3, float, Q> const& origin, vec<3, float, Q> const& step, vec<3, uint, Q> const& first, vec<3, uint, Q> const& size, float* out);
+
+	/// Name of the instruction set the noise spans and grids use: "AVX2", "SSE2" or "scalar".
+	/// @see gtc_noise
+	GLM_FUNC_DECL char const* noiseIsa();
+
 	/// @}
 }//namespace glm
 
@@ -5,6 +5,10 @@
 // Following Stefan Gustavson's paper "Simplex noise demystified":
 // http://www.itn.liu.se/~stegu/simplexnoise/simplexnoise.pdf
 
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+#	include "../simd/noise.h"
+#endif
+
 namespace glm{
 namespace detail
 {
@@ -804,4 +808,523 @@ namespace detail
 			(dot(m0 * m0, vec<3, T, Q>(dot(p0, x0), dot(p1, x1), dot(p2, x2))) +
 			dot(m1 * m1, vec<2, T, Q>(dot(p3, x3), dot(p4, x4))));
 	}
+
+namespace detail
+{
+	enum noise_batch_kind
+	{
+		noise_batch_perlin,
+		noise_batch_simplex
+	};
+
+	template<noise_batch_kind K, length_t L>
+	GLM_FUNC_QUALIFIER float noise_batch_point(float x, float y, float z)
+	{
+		if(L == 2)
+			return K == noise_batch_perlin ? perlin(vec<2, float, defaultp>(x, y)) : simplex(vec<2, float, defaultp>(x, y));
+		return K == noise_batch_perlin ? perlin(vec<3, float, defaultp>(x, y, z)) : simplex(vec<3, float, defaultp>(x, y, z));
+	}
+
+	// Reference paths, one point at a time through perlin and simplex. z is
+	// only read in 3D.
+	template<noise_batch_kind K, length_t L>
+	GLM_FUNC_QUALIFIER void noise_batch_scalar(float const* x, float const* y, float const* z, float* out, std::size_t first, std::size_t count)
+	{
+		std::size_t const Rest = count - first;
+		for(std::size_t i = 0; i < Rest; ++i)
+			out[first + i] = noise_batch_point<K, L>(x[first + i], y[first + i], L == 3 ? z[first + i] : 0.0f);
+	}
+
+	// Grid samples from the done-th on, x fastest. Sample (i, j, k) is at
+	// origin + step * (first + (i, j, k)).
+	template<noise_batch_kind K, length_t L>
+	GLM_FUNC_QUALIFIER void noise_batch_scalar_grid(float const* origin, float const* step, unsigned int const* first, unsigned int const* size, float* out, std::size_t done)
+	{
+		std::size_t const Count = static_cast<std::size_t>(size[0]) * size[1] * (L == 3 ? size[2] : 1u);
+		for(std::size_t n = done; n < Count; ++n)
+		{
+			unsigned int const i = static_cast<unsigned int>(n % size[0]);
+			unsigned int const j = static_cast<unsigned int>(n / size[0] % size[1]);
+			unsigned int const k = static_cast<unsigned int>(n / size[0] / size[1]);
+			float const x = origin[0] + step[0] * static_cast<float>(first[0] + i);
+			float const y = origin[1] + step[1] * static_cast<float>(first[1] + j);
+			float const z = L == 3 ? origin[2] + step[2] * static_cast<float>(first[2] + k) : 0.0f;
+			out[n] = noise_batch_point<K, L>(x, y, z);
+		}
+	}
+
+	// Like the exponential_batch kernels, these pad the last few points to a
+	// full register, so every point gets the same arithmetic, and return the
+	// count handled for the GLM_GTX_simd_dispatch table.
+#	if GLM_ARCH & GLM_ARCH_SSE2_BIT
+	struct noise_batch_sse2
+	{
+		static std::size_t const width = 4;
+
+		template<noise_batch_kind K, length_t L>
+		GLM_FUNC_QUALIFIER static __m128 apply(__m128 x, __m128 y, __m128 z)
+		{
+			if(L == 2)
+				return K == noise_batch_perlin ? glm_vec4_perlin2(x, y) : glm_vec4_simplex2(x, y);
+			return K == noise_batch_perlin ? glm_vec4_perlin3(x, y, z) : glm_vec4_simplex3(x, y, z);
+		}
+
+		GLM_FUNC_QUALIFIER static __m128 load(float const* p, std::size_t rest)
+		{
+			float Tail[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+			for(std::size_t j = 0; j < rest && j < width; ++j)
+				Tail[j] = p[j];
+			return _mm_loadu_ps(Tail);
+		}
+
+		GLM_FUNC_QUALIFIER static void store(float* p, __m128 v, std::size_t rest)
+		{
+			float Tail[4];
+			_mm_storeu_ps(Tail, v);
+			for(std::size_t j = 0; j < rest && j < width; ++j)
+				p[j] = Tail[j];
+		}
+
+		template<noise_batch_kind K, length_t L>
+		GLM_FUNC_QUALIFIER static std::size_t span(float const* x, float const* y, float const* z, float* out, std::size_t count)
+		{
+			std::size_t i = 0;
+			for(; i + width <= count; i += width)
+				_mm_storeu_ps(out + i, apply<K, L>(_mm_loadu_ps(x + i), _mm_loadu_ps(y + i), L == 3 ? _mm_loadu_ps(z + i) : _mm_setzero_ps()));
+			if(i < count)
+			{
+				std::size_t const Rest = count - i;
+				store(out + i, apply<K, L>(load(x + i, Rest), load(y + i, Rest), L == 3 ? load(z + i, Rest) : _mm_setzero_ps()), Rest);
+			}
+			return count;
+		}
+
+		template<noise_batch_kind K, length_t L>
+		GLM_FUNC_QUALIFIER static std::size_t grid(float const* origin, float const* step, unsigned int const* first, unsigned int const* size, float* out)
+		{
+			__m128 const OriginX = _mm_set1_ps(origin[0]), StepX = _mm_set1_ps(step[0]);
+			__m128i const Lanes = _mm_setr_epi32(0, 1, 2, 3);
+			unsigned int const Width = size[0], Depth = L == 3 ? size[2] : 1u;
+			for(unsigned int k = 0; k < Depth; ++k)
+			{
+				__m128 const z = _mm_set1_ps(L == 3 ? origin[2] + step[2] * static_cast<float>(first[2] + k) : 0.0f);
+				for(unsigned int j = 0; j < size[1]; ++j)
+				{
+					__m128 const y = _mm_set1_ps(origin[1] + step[1] * static_cast<float>(first[1] + j));
+					float* Row = out + (static_cast<std::size_t>(k) * size[1] + j) * Width;
+					for(unsigned int i = 0; i < Width; i += static_cast<unsigned int>(width))
+					{
+						__m128i const Index = _mm_add_epi32(_mm_set1_epi32(static_cast<int>(first[0] + i)), Lanes);
+						__m128 const x = _mm_add_ps(OriginX, _mm_mul_ps(StepX, _mm_cvtepi32_ps(Index)));
+						if(Width - i >= width)
+							_mm_storeu_ps(Row + i, apply<K, L>(x, y, z));
+						else
+							store(Row + i, apply<K, L>(x, y, z), Width - i);
+					}
+				}
+			}
+			return static_cast<std::size_t>(Width) * size[1] * Depth;
+		}
+	};
+#	endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
+
+	// glm/simd/noise.h eight lanes wide. The kernels are compiled without
+	// FMA: a contracted multiply-add can land a hash or gradient on the
+	// other side of a floor or step and change a sample by much more than
+	// its rounding error.
+#	if (GLM_ARCH & GLM_ARCH_AVX2_BIT) || (GLM_CONFIG_SIMD_DISPATCH == GLM_ENABLE)
+	struct noise_batch_avx2
+	{
+		static std::size_t const width = 8;
+
+		GLM_TARGET_AVX2_NOFMA GLM_FUNC_QUALIFIER static __m256 abs(__m256 x)
+		{
+			return _mm256_and_ps(x, _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff)));
+		}
+
+		GLM_TARGET_AVX2_NOFMA GLM_FUNC_QUALIFIER static __m256 fract(__m256 x)
+		{
+			return _mm256_sub_ps(x, _mm256_floor_ps(x));
+		}
+
+		// x < edge ? 0 : 1
+		GLM_TARGET_AVX2_NOFMA GLM_FUNC_QUALIFIER static __m256 step(__m256 edge, __m256 x)
+		{
+			return _mm256_andnot_ps(_mm256_cmp_ps(x, edge, _CMP_LT_OQ), _mm256_set1_ps(1.0f));
+		}
+
+		GLM_TARGET_AVX2_NOFMA GLM_FUNC_QUALIFIER static __m256 mix(__m256 x, __m256 y, __m256 a)
+		{
+			return _mm256_add_ps(_mm256_mul_ps(x, _mm256_sub_ps(_mm256_set1_ps(1.0f), a)), _mm256_mul_ps(y, a));
+		}
+
+		GLM_TARGET_AVX2_NOFMA GLM_FUNC_QUALIFIER static __m256 mod289(__m256 x)
+		{
+			__m256 const Modulus = _mm256_set1_ps(289.0f);
+			return _mm256_sub_ps(x, _mm256_mul_ps(_mm256_floor_ps(_mm256_mul_ps(x, _mm256_set1_ps(1.0f / 289.0f))), Modulus));
+		}
+
+		GLM_TARGET_AVX2_NOFMA GLM_FUNC_QUALIFIER static __m256 mod289_div(__m256 x)
+		{
+			__m256 const Modulus = _mm256_set1_ps(289.0f);
+			return _mm256_sub_ps(x, _mm256_mul_ps(Modulus, _mm256_floor_ps(_mm256_div_ps(x, Modulus))));
+		}
+
+		GLM_TARGET_AVX2_NOFMA GLM_FUNC_QUALIFIER static __m256 permute(__m256 x)
+		{
+			return mod289(_mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(x, _mm256_set1_ps(34.0f)), _mm256_set1_ps(1.0f)), x));
+		}
+
+		GLM_TARGET_AVX2_NOFMA GLM_FUNC_QUALIFIER static __m256 taylor_inv_sqrt(__m256 r)
+		{
+			return _mm256_sub_ps(_mm256_set1_ps(1.79284291400159f), _mm256_mul_ps(_mm256_set1_ps(0.85373472095314f), r));
+		}
+
+		GLM_TARGET_AVX2_NOFMA GLM_FUNC_QUALIFIER static __m256 fade(__m256 t)
+		{
+			__m256 const t3 = _mm256_mul_ps(_mm256_mul_ps(t, t), t);
+			__m256 const p = _mm256_add_ps(_mm256_mul_ps(t, _mm256_sub_ps(_mm256_mul_ps(t, _mm256_set1_ps(6.0f)), _mm256_set1_ps(15.0f))), _mm256_set1_ps(10.0f));
+			return _mm256_mul_ps(t3, p);
+		}
+
+		GLM_TARGET_AVX2_NOFMA GLM_FUNC_QUALIFIER static __m256 perlin2_corner(__m256 i, __m256 fx, __m256 fy)
+		{
+			__m256 gx = _mm256_sub_ps(_mm256_mul_ps(_mm256_set1_ps(2.0f), fract(_mm256_div_ps(i, _mm256_set1_ps(41.0f)))), _mm256_set1_ps(1.0f));
+			__m256 gy = _mm256_sub_ps(abs(gx), _mm256_set1_ps(0.5f));
+			gx = _mm256_sub_ps(gx, _mm256_floor_ps(_mm256_add_ps(gx, _mm256_set1_ps(0.5f))));
+
+			__m256 const Norm = taylor_inv_sqrt(_mm256_add_ps(_mm256_mul_ps(gx, gx), _mm256_mul_ps(gy, gy)));
+			gx = _mm256_mul_ps(gx, Norm);
+			gy = _mm256_mul_ps(gy, Norm);
+			return _mm256_add_ps(_mm256_mul_ps(gx, fx), _mm256_mul_ps(gy, fy));
+		}
+
+		GLM_TARGET_AVX2_NOFMA GLM_FUNC_QUALIFIER static __m256 perlin2(__m256 x, __m256 y)
+		{
+			__m256 const One = _mm256_set1_ps(1.0f);
+			__m256 const Fx = _mm256_floor_ps(x), Fy = _mm256_floor_ps(y);
+			__m256 const fx0 = _mm256_sub_ps(x, Fx), fy0 = _mm256_sub_ps(y, Fy);
+			__m256 const fx1 = _mm256_sub_ps(fx0, One), fy1 = _mm256_sub_ps(fy0, One);
+			__m256 const X0 = permute(mod289_div(Fx));
+			__m256 const X1 = permute(mod289_div(_mm256_add_ps(Fx, One)));
+			__m256 const Y0 = mod289_div(Fy);
+			__m256 const Y1 = mod289_div(_mm256_add_ps(Fy, One));
+
+			__m256 const n00 = perlin2_corner(permute(_mm256_add_ps(X0, Y0)), fx0, fy0);
+			__m256 const n10 = perlin2_corner(permute(_mm256_add_ps(X1, Y0)), fx1, fy0);
+			__m256 const n01 = perlin2_corner(permute(_mm256_add_ps(X0, Y1)), fx0, fy1);
+			__m256 const n11 = perlin2_corner(permute(_mm256_add_ps(X1, Y1)), fx1, fy1);
+
+			__m256 const u = fade(fx0), v = fade(fy0);
+			return _mm256_mul_ps(_mm256_set1_ps(2.3f), mix(mix(n00, n10, u), mix(n01, n11, u), v));
+		}
+
+		GLM_TARGET_AVX2_NOFMA GLM_FUNC_QUALIFIER static __m256 perlin3_corner(__m256 i, __m256 fx, __m256 fy, __m256 fz)
+		{
+			__m256 const Half = _mm256_set1_ps(0.5f);
+			__m256 const Zero = _mm256_setzero_ps();
+			__m256 gx = _mm256_mul_ps(i, _mm256_set1_ps(static_cast<float>(1.0 / 7.0)));
+			__m256 gy = _mm256_sub_ps(fract(_mm256_mul_ps(_mm256_floor_ps(gx), _mm256_set1_ps(static_cast<float>(1.0 / 7.0)))), Half);
+			gx = fract(gx);
+			__m256 gz = _mm256_sub_ps(_mm256_sub_ps(Half, abs(gx)), abs(gy));
+			__m256 const sz = step(gz, Zero);
+			gx = _mm256_sub_ps(gx, _mm256_mul_ps(sz, _mm256_sub_ps(step(Zero, gx), Half)));
+			gy = _mm256_sub_ps(gy, _mm256_mul_ps(sz, _mm256_sub_ps(step(Zero, gy), Half)));
+
+			__m256 const Norm = taylor_inv_sqrt(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(gx, gx), _mm256_mul_ps(gy, gy)), _mm256_mul_ps(gz, gz)));
+			gx = _mm256_mul_ps(gx, Norm);
+			gy = _mm256_mul_ps(gy, Norm);
+			gz = _mm256_mul_ps(gz, Norm);
+			return _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(gx, fx), _mm256_mul_ps(gy, fy)), _mm256_mul_ps(gz, fz));
+		}
+
+		GLM_TARGET_AVX2_NOFMA GLM_FUNC_QUALIFIER static __m256 perlin3(__m256 x, __m256 y, __m256 z)
+		{
+			__m256 const One = _mm256_set1_ps(1.0f);
+			__m256 const Fx = _mm256_floor_ps(x), Fy = _mm256_floor_ps(y), Fz = _mm256_floor_ps(z);
+			__m256 const fx0 = _mm256_sub_ps(x, Fx), fy0 = _mm256_sub_ps(y, Fy), fz0 = _mm256_sub_ps(z, Fz);
+			__m256 const fx1 = _mm256_sub_ps(fx0, One), fy1 = _mm256_sub_ps(fy0, One), fz1 = _mm256_sub_ps(fz0, One);
+			__m256 const X0 = permute(mod289(Fx));
+			__m256 const X1 = permute(mod289(_mm256_add_ps(Fx, One)));
+			__m256 const Y0 = mod289(Fy), Y1 = mod289(_mm256_add_ps(Fy, One));
+			__m256 const Z0 = mod289(Fz), Z1 = mod289(_mm256_add_ps(Fz, One));
+
+			__m256 const i00 = permute(_mm256_add_ps(X0, Y0));
+			__m256 const i10 = permute(_mm256_add_ps(X1, Y0));
+			__m256 const i01 = permute(_mm256_add_ps(X0, Y1));
+			__m256 const i11 = permute(_mm256_add_ps(X1, Y1));
+
+			__m256 const n000 = perlin3_corner(permute(_mm256_add_ps(i00, Z0)), fx0, fy0, fz0);
+			__m256 const n100 = perlin3_corner(permute(_mm256_add_ps(i10, Z0)), fx1, fy0, fz0);
+			__m256 const n010 = perlin3_corner(permute(_mm256_add_ps(i01, Z0)), fx0, fy1, fz0);
+			__m256 const n110 = perlin3_corner(permute(_mm256_add_ps(i11, Z0)), fx1, fy1, fz0);
+			__m256 const n001 = perlin3_corner(permute(_mm256_add_ps(i00, Z1)), fx0, fy0, fz1);
+			__m256 const n101 = perlin3_corner(permute(_mm256_add_ps(i10, Z1)), fx1, fy0, fz1);
+			__m256 const n011 = perlin3_corner(permute(_mm256_add_ps(i01, Z1)), fx0, fy1, fz1);
+			__m256 const n111 = perlin3_corner(permute(_mm256_add_ps(i11, Z1)), fx1, fy1, fz1);
+
+			__m256 const u = fade(fx0), v = fade(fy0), w = fade(fz0);
+			__m256 const n00 = mix(n000, n001, w);
+			__m256 const n10 = mix(n100, n101, w);
+			__m256 const n01 = mix(n010, n011, w);
+			__m256 const n11 = mix(n110, n111, w);
+			return _mm256_mul_ps(_mm256_set1_ps(2.2f), mix(mix(n00, n01, v), mix(n10, n11, v), u));
+		}
+
+		GLM_TARGET_AVX2_NOFMA GLM_FUNC_QUALIFIER static __m256 simplex2_corner(__m256 p, __m256 x, __m256 y)
+		{
+			__m256 m = _mm256_max_ps(_mm256_setzero_ps(), _mm256_sub_ps(_mm256_set1_ps(0.5f), _mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y))));
+			m = _mm256_mul_ps(m, m);
+			m = _mm256_mul_ps(m, m);
+
+			__m256 const g = _mm256_sub_ps(_mm256_mul_ps(_mm256_set1_ps(2.0f), fract(_mm256_mul_ps(p, _mm256_set1_ps(0.024390243902439f)))), _mm256_set1_ps(1.0f));
+			__m256 const h = _mm256_sub_ps(abs(g), _mm256_set1_ps(0.5f));
+			__m256 const a0 = _mm256_sub_ps(g, _mm256_floor_ps(_mm256_add_ps(g, _mm256_set1_ps(0.5f))));
+			m = _mm256_mul_ps(m, taylor_inv_sqrt(_mm256_add_ps(_mm256_mul_ps(a0, a0), _mm256_mul_ps(h, h))));
+			return _mm256_mul_ps(m, _mm256_add_ps(_mm256_mul_ps(a0, x), _mm256_mul_ps(h, y)));
+		}
+
+		GLM_TARGET_AVX2_NOFMA GLM_FUNC_QUALIFIER static __m256 simplex2(__m256 x, __m256 y)
+		{
+			__m256 const C0 = _mm256_set1_ps(0.211324865405187f);
+			__m256 const C1 = _mm256_set1_ps(0.366025403784439f);
+			__m256 const C2 = _mm256_set1_ps(-0.577350269189626f);
+			__m256 const One = _mm256_set1_ps(1.0f);
+
+			__m256 const s = _mm256_add_ps(_mm256_mul_ps(x, C1), _mm256_mul_ps(y, C1));
+			__m256 Ix = _mm256_floor_ps(_mm256_add_ps(x, s));
+			__m256 Iy = _mm256_floor_ps(_mm256_add_ps(y, s));
+			__m256 const t = _mm256_add_ps(_mm256_mul_ps(Ix, C0), _mm256_mul_ps(Iy, C0));
+			__m256 const x0 = _mm256_add_ps(_mm256_sub_ps(x, Ix), t);
+			__m256 const y0 = _mm256_add_ps(_mm256_sub_ps(y, Iy), t);
+
+			__m256 const Lower = _mm256_cmp_ps(x0, y0, _CMP_GT_OQ);
+			__m256 const i1x = _mm256_and_ps(Lower, One), i1y = _mm256_andnot_ps(Lower, One);
+			__m256 const x1 = _mm256_sub_ps(_mm256_add_ps(x0, C0), i1x);
+			__m256 const y1 = _mm256_sub_ps(_mm256_add_ps(y0, C0), i1y);
+			__m256 const x2 = _mm256_add_ps(x0, C2);
+			__m256 const y2 = _mm256_add_ps(y0, C2);
+
+			Ix = mod289_div(Ix);
+			Iy = mod289_div(Iy);
+			__m256 const p0 = permute(_mm256_add_ps(permute(Iy), Ix));
+			__m256 const p1 = permute(_mm256_add_ps(_mm256_add_ps(permute(_mm256_add_ps(Iy, i1y)), Ix), i1x));
+			__m256 const p2 = permute(_mm256_add_ps(_mm256_add_ps(permute(_mm256_add_ps(Iy, One)), Ix), One));
+
+			__m256 const n = _mm256_add_ps(_mm256_add_ps(simplex2_corner(p0, x0, y0), simplex2_corner(p1, x1, y1)), simplex2_corner(p2, x2, y2));
+			return _mm256_mul_ps(_mm256_set1_ps(130.0f), n);
+		}
+
+		GLM_TARGET_AVX2_NOFMA GLM_FUNC_QUALIFIER static __m256 simplex3_corner(__m256 p, __m256 x, __m256 y, __m256 z)
+		{
+			float const n_ = 0.142857142857f;
+			__m256 const nsx = _mm256_set1_ps(n_ * 2.0f), nsy = _mm256_set1_ps(n_ * 0.5f - 1.0f), nsz = _mm256_set1_ps(n_);
+			__m256 const One = _mm256_set1_ps(1.0f);
+			__m256 const Two = _mm256_set1_ps(2.0f);
+
+			__m256 const j = _mm256_sub_ps(p, _mm256_mul_ps(_mm256_set1_ps(49.0f), _mm256_floor_ps(_mm256_mul_ps(_mm256_mul_ps(p, nsz), nsz))));
+			__m256 const x_ = _mm256_floor_ps(_mm256_mul_ps(j, nsz));
+			__m256 const y_ = _mm256_floor_ps(_mm256_sub_ps(j, _mm256_mul_ps(_mm256_set1_ps(7.0f), x_)));
+			__m256 gx = _mm256_add_ps(_mm256_mul_ps(x_, nsx), nsy);
+			__m256 gy = _mm256_add_ps(_mm256_mul_ps(y_, nsx), nsy);
+			__m256 gz = _mm256_sub_ps(_mm256_sub_ps(One, abs(gx)), abs(gy));
+
+			__m256 const sh = _mm256_xor_ps(step(gz, _mm256_setzero_ps()), _mm256_set1_ps(-0.0f));
+			gx = _mm256_add_ps(gx, _mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_floor_ps(gx), Two), One), sh));
+			gy = _mm256_add_ps(gy, _mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_floor_ps(gy), Two), One), sh));
+
+			__m256 const Norm = taylor_inv_sqrt(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(gx, gx), _mm256_mul_ps(gy, gy)), _mm256_mul_ps(gz, gz)));
+			gx = _mm256_mul_ps(gx, Norm);
+			gy = _mm256_mul_ps(gy, Norm);
+			gz = _mm256_mul_ps(gz, Norm);
+
+			__m256 m = _mm256_max_ps(_mm256_setzero_ps(), _mm256_sub_ps(_mm256_set1_ps(0.6f), _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)), _mm256_mul_ps(z, z))));
+			m = _mm256_mul_ps(m, m);
+			__m256 const d = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(gx, x), _mm256_mul_ps(gy, y)), _mm256_mul_ps(gz, z));
+			return _mm256_mul_ps(_mm256_mul_ps(m, m), d);
+		}
+
+		GLM_TARGET_AVX2_NOFMA GLM_FUNC_QUALIFIER static __m256 simplex3(__m256 x, __m256 y, __m256 z)
+		{
+			__m256 const Cx = _mm256_set1_ps(static_cast<float>(1.0 / 6.0));
+			__m256 const Cy = _mm256_set1_ps(static_cast<float>(1.0 / 3.0));
+			__m256 const Half = _mm256_set1_ps(0.5f);
+			__m256 const One = _mm256_set1_ps(1.0f);
+
+			__m256 const s = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, Cy), _mm256_mul_ps(y, Cy)), _mm256_mul_ps(z, Cy));
+			__m256 Ix = _mm256_floor_ps(_mm256_add_ps(x, s));
+			__m256 Iy = _mm256_floor_ps(_mm256_add_ps(y, s));
+			__m256 Iz = _mm256_floor_ps(_mm256_add_ps(z, s));
+			__m256 const t = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(Ix, Cx), _mm256_mul_ps(Iy, Cx)), _mm256_mul_ps(Iz, Cx));
+			__m256 const x0 = _mm256_add_ps(_mm256_sub_ps(x, Ix), t);
+			__m256 const y0 = _mm256_add_ps(_mm256_sub_ps(y, Iy), t);
+			__m256 const z0 = _mm256_add_ps(_mm256_sub_ps(z, Iz), t);
+
+			__m256 const gx = step(y0, x0), gy = step(z0, y0), gz = step(x0, z0);
+			__m256 const lx = _mm256_sub_ps(One, gx), ly = _mm256_sub_ps(One, gy), lz = _mm256_sub_ps(One, gz);
+			__m256 const i1x = _mm256_min_ps(lz, gx), i1y = _mm256_min_ps(lx, gy), i1z = _mm256_min_ps(ly, gz);
+			__m256 const i2x = _mm256_max_ps(lz, gx), i2y = _mm256_max_ps(lx, gy), i2z = _mm256_max_ps(ly, gz);
+
+			__m256 const x1 = _mm256_add_ps(_mm256_sub_ps(x0, i1x), Cx);
+			__m256 const y1 = _mm256_add_ps(_mm256_sub_ps(y0, i1y), Cx);
+			__m256 const z1 = _mm256_add_ps(_mm256_sub_ps(z0, i1z), Cx);
+			__m256 const x2 = _mm256_add_ps(_mm256_sub_ps(x0, i2x), Cy);
+			__m256 const y2 = _mm256_add_ps(_mm256_sub_ps(y0, i2y), Cy);
+			__m256 const z2 = _mm256_add_ps(_mm256_sub_ps(z0, i2z), Cy);
+			__m256 const x3 = _mm256_sub_ps(x0, Half);
+			__m256 const y3 = _mm256_sub_ps(y0, Half);
+			__m256 const z3 = _mm256_sub_ps(z0, Half);
+
+			Ix = mod289(Ix);
+			Iy = mod289(Iy);
+			Iz = mod289(Iz);
+			__m256 const p0 = permute(_mm256_add_ps(permute(_mm256_add_ps(permute(Iz), Iy)), Ix));
+			__m256 const p1 = permute(_mm256_add_ps(_mm256_add_ps(permute(_mm256_add_ps(_mm256_add_ps(permute(_mm256_add_ps(Iz, i1z)), Iy), i1y)), Ix), i1x));
+			__m256 const p2 = permute(_mm256_add_ps(_mm256_add_ps(permute(_mm256_add_ps(_mm256_add_ps(permute(_mm256_add_ps(Iz, i2z)), Iy), i2y)), Ix), i2x));
+			__m256 const p3 = permute(_mm256_add_ps(_mm256_add_ps(permute(_mm256_add_ps(_mm256_add_ps(permute(_mm256_add_ps(Iz, One)), Iy), One)), Ix), One));
+
+			__m256 const n01 = _mm256_add_ps(simplex3_corner(p0, x0, y0, z0), simplex3_corner(p1, x1, y1, z1));
+			__m256 const n23 = _mm256_add_ps(simplex3_corner(p2, x2, y2, z2), simplex3_corner(p3, x3, y3, z3));
+			return _mm256_mul_ps(_mm256_set1_ps(42.0f), _mm256_add_ps(n01, n23));
+		}
+
+		template<noise_batch_kind K, length_t L>
+		GLM_TARGET_AVX2_NOFMA GLM_FUNC_QUALIFIER static __m256 apply(__m256 x, __m256 y, __m256 z)
+		{
+			if(L == 2)
+				return K == noise_batch_perlin ? perlin2(x, y) : simplex2(x, y);
+			return K == noise_batch_perlin ? perlin3(x, y, z) : simplex3(x, y, z);
+		}
+
+		// Lanes below remaining; the tail is read and written with masks.
+		GLM_TARGET_AVX2_NOFMA GLM_FUNC_QUALIFIER static __m256i tail_mask(std::size_t remaining)
+		{
+			return _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(remaining)), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+		}
+
+		template<noise_batch_kind K, length_t L>
+		GLM_TARGET_AVX2_NOFMA GLM_FUNC_QUALIFIER static std::size_t span(float const* x, float const* y, float const* z, float* out, std::size_t count)
+		{
+			std::size_t i = 0;
+			for(; i + width <= count; i += width)
+				_mm256_storeu_ps(out + i, apply<K, L>(_mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i), L == 3 ? _mm256_loadu_ps(z + i) : _mm256_setzero_ps()));
+			if(i < count)
+			{
+				__m256i const Mask = tail_mask(count - i);
+				__m256 const Z = L == 3 ? _mm256_maskload_ps(z + i, Mask) : _mm256_setzero_ps();
+				_mm256_maskstore_ps(out + i, Mask, apply<K, L>(_mm256_maskload_ps(x + i, Mask), _mm256_maskload_ps(y + i, Mask), Z));
+			}
+			return count;
+		}
+
+		template<noise_batch_kind K, length_t L>
+		GLM_TARGET_AVX2_NOFMA GLM_FUNC_QUALIFIER static std::size_t grid(float const* origin, float const* step, unsigned int const* first, unsigned int const* size, float* out)
+		{
+			__m256 const OriginX = _mm256_set1_ps(origin[0]), StepX = _mm256_set1_ps(step[0]);
+			__m256i const Lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+			unsigned int const Width = size[0], Depth = L == 3 ? size[2] : 1u;
+			for(unsigned int k = 0; k < Depth; ++k)
+			{
+				__m256 const z = _mm256_set1_ps(L == 3 ? origin[2] + step[2] * static_cast<float>(first[2] + k) : 0.0f);
+				for(unsigned int j = 0; j < size[1]; ++j)
+				{
+					__m256 const y = _mm256_set1_ps(origin[1] + step[1] * static_cast<float>(first[1] + j));
+					float* Row = out + (static_cast<std::size_t>(k) * size[1] + j) * Width;
+					for(unsigned int i = 0; i < Width; i += static_cast<unsigned int>(width))
+					{
+						__m256i const Index = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(first[0] + i)), Lanes);
+						__m256 const Noise = apply<K, L>(_mm256_add_ps(OriginX, _mm256_mul_ps(StepX, _mm256_cvtepi32_ps(Index))), y, z);
+						if(Width - i >= width)
+							_mm256_storeu_ps(Row + i, Noise);
+						else
+							_mm256_maskstore_ps(Row + i, tail_mask(Width - i), Noise);
+					}
+				}
+			}
+			return static_cast<std::size_t>(Width) * size[1] * Depth;
+		}
+	};
+#	endif
+
+#	if GLM_ARCH & GLM_ARCH_AVX2_BIT
+	typedef noise_batch_avx2 noise_batch_simd;
+#	elif GLM_ARCH & GLM_ARCH_SSE2_BIT
+	typedef noise_batch_sse2 noise_batch_simd;
+#	endif
+
+	template<noise_batch_kind K, length_t L>
+	GLM_FUNC_QUALIFIER void noise_batch_span(float const* x, float const* y, float const* z, float* out, std::size_t count)
+	{
+		std::size_t Done = 0;
+#		if GLM_ARCH & GLM_ARCH_SSE2_BIT
+			Done = noise_batch_simd::span<K, L>(x, y, z, out, count);
+#		endif
+		noise_batch_scalar<K, L>(x, y, z, out, Done, count);
+	}
+
+	template<noise_batch_kind K, length_t L>
+	GLM_FUNC_QUALIFIER void noise_batch_grid(float const* origin, float const* step, unsigned int const* first, unsigned int const* size, float* out)
+	{
+		std::size_t Done = 0;
+#		if GLM_ARCH & GLM_ARCH_SSE2_BIT
+			Done = noise_batch_simd::grid<K, L>(origin, step, first, size, out);
+#		endif
+		noise_batch_scalar_grid<K, L>(origin, step, first, size, out, Done);
+	}
+}//namespace detail
+
+	GLM_FUNC_QUALIFIER void perlin(float const* x, float const* y, float* out, std::size_t count)
+	{
+		detail::noise_batch_span<detail::noise_batch_perlin, 2>(x, y, GLM_NULLPTR, out, count);
+	}
+
+	GLM_FUNC_QUALIFIER void perlin(float const* x, float const* y, float const* z, float* out, std::size_t count)
+	{
+		detail::noise_batch_span<detail::noise_batch_perlin, 3>(x, y, z, out, count);
+	}
+
+	GLM_FUNC_QUALIFIER void simplex(float const* x, float const* y, float* out, std::size_t count)
+	{
+		detail::noise_batch_span<detail::noise_batch_simplex, 2>(x, y, GLM_NULLPTR, out, count);
+	}
+
+	GLM_FUNC_QUALIFIER void simplex(float const* x, float const* y, float const* z, float* out, std::size_t count)
+	{
+		detail::noise_batch_span<detail::noise_batch_simplex, 3>(x, y, z, out, count);
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void perlinGrid(vec<2, float, Q> const& origin, vec<2, float, Q> const& step, vec<2, uint, Q> const& first, vec<2, uint, Q> const& size, float* out)
+	{
+		detail::noise_batch_grid<detail::noise_batch_perlin, 2>(&origin[0], &step[0], &first[0], &size[0], out);
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void perlinGrid(vec<3, float, Q> const& origin, vec<3, float, Q> const& step, vec<3, uint, Q> const& first, vec<3, uint, Q> const& size, float* out)
+	{
+		detail::noise_batch_grid<detail::noise_batch_perlin, 3>(&origin[0], &step[0], &first[0], &size[0], out);
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void simplexGrid(vec<2, float, Q> const& origin, vec<2, float, Q> const& step, vec<2, uint, Q> const& first, vec<2, uint, Q> const& size, float* out)
+	{
+		detail::noise_batch_grid<detail::noise_batch_simplex, 2>(&origin[0], &step[0], &first[0], &size[0], out);
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void simplexGrid(vec<3, float, Q> const& origin, vec<3, float, Q> const& step, vec<3, uint, Q> const& first, vec<3, uint, Q> const& size, float* out)
+	{
+		detail::noise_batch_grid<detail::noise_batch_simplex, 3>(&origin[0], &step[0], &first[0], &size[0], out);
+	}
+
+	GLM_FUNC_QUALIFIER char const* noiseIsa()
+	{
+#		if GLM_ARCH & GLM_ARCH_AVX2_BIT
+			return "AVX2";
+#		elif GLM_ARCH & GLM_ARCH_SSE2_BIT
+			return "SSE2";
+#		else
+			return "scalar";
+#		endif
+	}
 }//namespace glm
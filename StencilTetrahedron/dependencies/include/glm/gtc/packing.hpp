@@ -16,6 +16,7 @@
 // Dependency:
 #include "type_precision.hpp"
 #include "../ext/vector_packing.hpp"
+#include <cstddef>
 
 #if GLM_MESSAGES == GLM_ENABLE && !defined(GLM_EXT_INCLUDED)
 #	pragma message("GLM: GLM_GTC_packing extension included")
@@ -512,6 +513,26 @@ namespace glm
 	template<length_t L, qualifier Q>
 	GLM_FUNC_DECL vec<L, float, Q> unpackHalf(vec<L, uint16, Q> const& p);
 
+	/// Converts count floats to 16-bit floating-point numbers, bit for bit as packHalf1x16 does.
+	/// Blocks of 8 go through F16C when GLM_ARCH enables AVX2 (every AVX2 CPU has F16C)
+	/// and through SSE2 integer code otherwise; the rest one at a time.
+	/// GLM_GTX_simd_dispatch's dispatchPackHalf picks F16C at run time instead.
+	///
+	/// @see gtc_packing
+	/// @see void unpackHalf(uint16 const* in, float* out, std::size_t count)
+	GLM_FUNC_DISCARD_DECL void packHalf(float const* in, uint16* out, std::size_t count);
+
+	/// Converts count 16-bit floating-point numbers to floats, bit for bit as unpackHalf1x16 does.
+	///
+	/// @see gtc_packing
+	/// @see void packHalf(float const* in, uint16* out, std::size_t count)
+	GLM_FUNC_DISCARD_DECL void unpackHalf(uint16 const* in, float* out, std::size_t count);
+
+	/// Name of the instruction set the half spans use: "F16C", "SSE2" or "scalar".
+	///
+	/// @see gtc_packing
+	GLM_FUNC_DECL char const* packHalfIsa();
+
 	/// Convert each component of the normalized floating-point vector into unsigned integer values.
 	///
 	/// @see gtc_packing
@@ -10,6 +10,10 @@
 #include <cstring>
 #include <limits>
 
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+#	include "../simd/packing.h"
+#endif
+
 namespace glm{
 namespace detail
 {
@@ -350,19 +354,155 @@ namespace detail
 	{
 		GLM_FUNC_QUALIFIER static vec<4, uint16, Q> pack(vec<4, float, Q> const& v)
 		{
-			vec<4, int16, Q> const Unpack(detail::toFloat16(v.x), detail::toFloat16(v.y), detail::toFloat16(v.z), detail::toFloat16(v.w));
-			u16vec4 Packed;
-			memcpy(&Packed, &Unpack, sizeof(Packed));
-			return Packed;
+#			if GLM_ARCH & GLM_ARCH_SSE2_BIT
+				uint64 const Packed = packHalf4x16(vec4(v));
+				vec<4, uint16, Q> Result;
+				memcpy(&Result, &Packed, sizeof(Result));
+				return Result;
+#			else
+				vec<4, int16, Q> const Unpack(detail::toFloat16(v.x), detail::toFloat16(v.y), detail::toFloat16(v.z), detail::toFloat16(v.w));
+				u16vec4 Packed;
+				memcpy(&Packed, &Unpack, sizeof(Packed));
+				return Packed;
+#			endif
 		}
 
 		GLM_FUNC_QUALIFIER static vec<4, float, Q> unpack(vec<4, uint16, Q> const& v)
 		{
-			i16vec4 Unpack;
-			memcpy(&Unpack, &v, sizeof(Unpack));
-			return vec<4, float, Q>(detail::toFloat32(Unpack.x), detail::toFloat32(Unpack.y), detail::toFloat32(Unpack.z), detail::toFloat32(Unpack.w));
+#			if GLM_ARCH & GLM_ARCH_SSE2_BIT
+				uint64 Packed = 0;
+				memcpy(&Packed, &v, sizeof(Packed));
+				return vec<4, float, Q>(unpackHalf4x16(Packed));
+#			else
+				i16vec4 Unpack;
+				memcpy(&Unpack, &v, sizeof(Unpack));
+				return vec<4, float, Q>(detail::toFloat32(Unpack.x), detail::toFloat32(Unpack.y), detail::toFloat32(Unpack.z), detail::toFloat32(Unpack.w));
+#			endif
+		}
+	};
+
+	// Span kernels for packHalf and unpackHalf. Each converts whole blocks of
+	// width values and returns how many it converted; the caller finishes
+	// the rest one at a time. All of them match toFloat16 and toFloat32 bit
+	// for bit.
+	GLM_FUNC_QUALIFIER void half_batch_scalar_pack(float const* in, uint16* out, std::size_t first, std::size_t count)
+	{
+		std::size_t const Rest = count - first;
+		for(std::size_t i = 0; i < Rest; ++i)
+			out[first + i] = static_cast<uint16>(toFloat16(in[first + i]));
+	}
+
+	GLM_FUNC_QUALIFIER void half_batch_scalar_unpack(uint16 const* in, float* out, std::size_t first, std::size_t count)
+	{
+		std::size_t const Rest = count - first;
+		for(std::size_t i = 0; i < Rest; ++i)
+			out[first + i] = toFloat32(static_cast<hdata>(in[first + i]));
+	}
+
+#	if GLM_ARCH & GLM_ARCH_SSE2_BIT
+	struct half_batch_sse2
+	{
+		static std::size_t const width = 8;
+
+		// packs_epi32 saturates, so the halves are sign-extended first.
+		GLM_FUNC_QUALIFIER static __m128i pack(__m128 lo, __m128 hi)
+		{
+			__m128i const Lo = _mm_srai_epi32(_mm_slli_epi32(glm_vec4_packhalf(lo), 16), 16);
+			__m128i const Hi = _mm_srai_epi32(_mm_slli_epi32(glm_vec4_packhalf(hi), 16), 16);
+			return _mm_packs_epi32(Lo, Hi);
+		}
+
+		GLM_FUNC_QUALIFIER static std::size_t pack(float const* in, uint16* out, std::size_t count)
+		{
+			std::size_t i = 0;
+			for(; i + width <= count; i += width)
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), pack(_mm_loadu_ps(in + i), _mm_loadu_ps(in + i + 4)));
+			return i;
+		}
+
+		GLM_FUNC_QUALIFIER static std::size_t unpack(uint16 const* in, float* out, std::size_t count)
+		{
+			std::size_t i = 0;
+			for(; i + width <= count; i += width)
+			{
+				__m128i const h = _mm_loadu_si128(reinterpret_cast<__m128i const*>(in + i));
+				_mm_storeu_ps(out + i, glm_vec4_unpackhalf(_mm_unpacklo_epi16(h, _mm_setzero_si128())));
+				_mm_storeu_ps(out + i + 4, glm_vec4_unpackhalf(_mm_unpackhi_epi16(h, _mm_setzero_si128())));
+			}
+			return i;
 		}
 	};
+#	endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
+
+	// F16C rounds to nearest even where toFloat16 rounds ties away from
+	// zero, so the magnitude gets half a half-precision ULP added and is
+	// then truncated. F16C also quiets signaling NaNs, which toFloat16 and
+	// toFloat32 keep: blocks with a NaN to pack go through the SSE2 code,
+	// and unpacked signaling NaNs get their quiet bit cleared again.
+#	if GLM_CONFIG_SIMD_DISPATCH == GLM_ENABLE
+	struct half_batch_f16c
+	{
+		static std::size_t const width = 8;
+
+		GLM_TARGET_AVX2 GLM_FUNC_QUALIFIER static __m128i pack(__m256 v)
+		{
+			__m256i const i = _mm256_castps_si256(v);
+			__m256i const a = _mm256_and_si256(i, _mm256_set1_epi32(0x7fffffff));
+
+			// Half an ULP of the nearest half: 2^-25 throughout the denormals.
+			__m256i const Exponent = _mm256_max_epi32(_mm256_and_si256(a, _mm256_set1_epi32(0x7f800000)), _mm256_set1_epi32(0x38800000));
+			__m256 const HalfUlp = _mm256_castsi256_ps(_mm256_sub_epi32(Exponent, _mm256_set1_epi32(11 << 23)));
+
+			// Below 2^-25 the result is zero; zeroing those lanes keeps float
+			// denormals out of the add.
+			__m256 const Magnitude = _mm256_castsi256_ps(_mm256_andnot_si256(_mm256_cmpgt_epi32(_mm256_set1_epi32(0x33000000), a), a));
+			__m256 r = _mm256_add_ps(Magnitude, HalfUlp);
+
+			// Truncation stops at 65504, where toFloat16 overflows to infinity.
+			__m256 const Infinity = _mm256_castsi256_ps(_mm256_set1_epi32(0x7f800000));
+			r = _mm256_blendv_ps(r, Infinity, _mm256_cmp_ps(r, _mm256_set1_ps(65536.0f), _CMP_GE_OQ));
+			r = _mm256_or_ps(r, _mm256_castsi256_ps(_mm256_andnot_si256(a, i)));
+			return _mm256_cvtps_ph(r, _MM_FROUND_TO_ZERO);
+		}
+
+		GLM_TARGET_AVX2 GLM_FUNC_QUALIFIER static __m256 unpack(__m128i h)
+		{
+			__m128i const a = _mm_and_si128(h, _mm_set1_epi16(0x7fff));
+			__m128i const Signaling = _mm_and_si128(_mm_cmpgt_epi16(a, _mm_set1_epi16(0x7c00)), _mm_cmplt_epi16(a, _mm_set1_epi16(0x7e00)));
+			__m256i const QuietBit = _mm256_and_si256(_mm256_cvtepi16_epi32(Signaling), _mm256_set1_epi32(0x00400000));
+			return _mm256_xor_ps(_mm256_cvtph_ps(h), _mm256_castsi256_ps(QuietBit));
+		}
+
+		GLM_TARGET_AVX2 GLM_FUNC_QUALIFIER static std::size_t pack(float const* in, uint16* out, std::size_t count)
+		{
+			std::size_t i = 0;
+			for(; i + width <= count; i += width)
+			{
+				__m256 const v = _mm256_loadu_ps(in + i);
+				__m128i const h = _mm256_movemask_ps(_mm256_cmp_ps(v, v, _CMP_UNORD_Q)) == 0
+					? pack(v)
+					: half_batch_sse2::pack(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), h);
+			}
+			return i;
+		}
+
+		GLM_TARGET_AVX2 GLM_FUNC_QUALIFIER static std::size_t unpack(uint16 const* in, float* out, std::size_t count)
+		{
+			std::size_t i = 0;
+			for(; i + width <= count; i += width)
+				_mm256_storeu_ps(out + i, unpack(_mm_loadu_si128(reinterpret_cast<__m128i const*>(in + i))));
+			return i;
+		}
+	};
+#	endif//GLM_CONFIG_SIMD_DISPATCH == GLM_ENABLE
+
+	// Every CPU with AVX2 has F16C.
+#	if (GLM_ARCH & GLM_ARCH_AVX2_BIT) && (GLM_CONFIG_SIMD_DISPATCH == GLM_ENABLE)
+	typedef half_batch_f16c half_batch_simd;
+#	elif GLM_ARCH & GLM_ARCH_SSE2_BIT
+	typedef half_batch_sse2 half_batch_simd;
+#	endif
 }//namespace detail
 
 	GLM_FUNC_QUALIFIER uint8 packUnorm1x8(float v)
@@ -503,25 +643,39 @@ namespace detail
 
 	GLM_FUNC_QUALIFIER uint64 packHalf4x16(glm::vec4 const& v)
 	{
-		i16vec4 const Unpack(
-			detail::toFloat16(v.x),
-			detail::toFloat16(v.y),
-			detail::toFloat16(v.z),
-			detail::toFloat16(v.w));
-		uint64 Packed = 0;
-		memcpy(&Packed, &Unpack, sizeof(Packed));
-		return Packed;
+#		if GLM_ARCH & GLM_ARCH_SSE2_BIT
+			__m128i const Half = _mm_srai_epi32(_mm_slli_epi32(glm_vec4_packhalf(_mm_loadu_ps(&v.x)), 16), 16);
+			uint64 Packed = 0;
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(&Packed), _mm_packs_epi32(Half, Half));
+			return Packed;
+#		else
+			i16vec4 const Unpack(
+				detail::toFloat16(v.x),
+				detail::toFloat16(v.y),
+				detail::toFloat16(v.z),
+				detail::toFloat16(v.w));
+			uint64 Packed = 0;
+			memcpy(&Packed, &Unpack, sizeof(Packed));
+			return Packed;
+#		endif
 	}
 
 	GLM_FUNC_QUALIFIER glm::vec4 unpackHalf4x16(uint64 v)
 	{
-		i16vec4 Unpack;
-		memcpy(&Unpack, &v, sizeof(Unpack));
-		return vec4(
-			detail::toFloat32(Unpack.x),
-			detail::toFloat32(Unpack.y),
-			detail::toFloat32(Unpack.z),
-			detail::toFloat32(Unpack.w));
+#		if GLM_ARCH & GLM_ARCH_SSE2_BIT
+			__m128i const Half = _mm_loadl_epi64(reinterpret_cast<__m128i const*>(&v));
+			vec4 Result;
+			_mm_storeu_ps(&Result.x, glm_vec4_unpackhalf(_mm_unpacklo_epi16(Half, _mm_setzero_si128())));
+			return Result;
+#		else
+			i16vec4 Unpack;
+			memcpy(&Unpack, &v, sizeof(Unpack));
+			return vec4(
+				detail::toFloat32(Unpack.x),
+				detail::toFloat32(Unpack.y),
+				detail::toFloat32(Unpack.z),
+				detail::toFloat32(Unpack.w));
+#		endif
 	}
 
 	GLM_FUNC_QUALIFIER uint32 packI3x10_1x2(ivec4 const& v)
@@ -681,6 +835,35 @@ namespace detail
 		return detail::compute_half<L, Q>::unpack(v);
 	}
 
+	GLM_FUNC_QUALIFIER void packHalf(float const* in, uint16* out, std::size_t count)
+	{
+		std::size_t Done = 0;
+#		if GLM_ARCH & GLM_ARCH_SSE2_BIT
+			Done = detail::half_batch_simd::pack(in, out, count);
+#		endif
+		detail::half_batch_scalar_pack(in, out, Done, count);
+	}
+
+	GLM_FUNC_QUALIFIER void unpackHalf(uint16 const* in, float* out, std::size_t count)
+	{
+		std::size_t Done = 0;
+#		if GLM_ARCH & GLM_ARCH_SSE2_BIT
+			Done = detail::half_batch_simd::unpack(in, out, count);
+#		endif
+		detail::half_batch_scalar_unpack(in, out, Done, count);
+	}
+
+	GLM_FUNC_QUALIFIER char const* packHalfIsa()
+	{
+#		if (GLM_ARCH & GLM_ARCH_AVX2_BIT) && (GLM_CONFIG_SIMD_DISPATCH == GLM_ENABLE)
+			return "F16C";
+#		elif GLM_ARCH & GLM_ARCH_SSE2_BIT
+			return "SSE2";
+#		else
+			return "scalar";
+#		endif
+	}
+
 	template<typename uintType, length_t L, typename floatType, qualifier Q>
 	GLM_FUNC_QUALIFIER vec<L, uintType, Q> packUnorm(vec<L, floatType, Q> const& v)
 	{
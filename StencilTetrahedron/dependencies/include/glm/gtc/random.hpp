@@ -10,6 +10,12 @@
 /// Include <glm/gtc/random.hpp> to use the features of this extension.
 ///
 /// Generate random number from various distribution methods.
+///
+/// Random bits come from Philox4x32-10, a counter-based generator: block n
+/// of a stream is a keyed hash of n, so a stream can start anywhere without
+/// generating what comes before. Each thread draws from its own stream
+/// (randThreadStream), and the span functions fill float arrays from an
+/// explicit rand_stream four or eight blocks at a time with SSE2 or AVX2.
 
 #pragma once
 
@@ -17,6 +23,7 @@
 #include "../ext/scalar_int_sized.hpp"
 #include "../ext/scalar_uint_sized.hpp"
 #include "../detail/qualifier.hpp"
+#include <cstddef>
 
 #if GLM_MESSAGES == GLM_ENABLE && !defined(GLM_EXT_INCLUDED)
 #	pragma message("GLM: GLM_GTC_random extension included")
@@ -27,6 +34,43 @@ namespace glm
 	/// @addtogroup gtc_random
 	/// @{
 
+	/// A stream of random 128-bit blocks: block n of stream Stream under Seed
+	/// is Philox4x32-10 with key Seed and counter (n, Stream). Streams are
+	/// independent, so threads can each take one, and the same seed, stream
+	/// and block always give the same bits.
+	///
+	/// @see gtc_random
+	struct rand_stream
+	{
+		GLM_FUNC_DECL explicit rand_stream(uint64 Seed = 0, uint64 Stream = 0);
+
+		/// The next 32 bits of the stream, a block at a time.
+		GLM_FUNC_DECL uint32 next();
+
+		/// Continues the stream at block Block.
+		GLM_FUNC_DISCARD_DECL void seek(uint64 Block);
+
+		uint32 key[2];
+		uint32 stream[2];
+		uint64 block;		// next block to generate
+		uint32 words[4];	// block - 1, as next() hands it out
+		uint32 used;		// words already handed out
+	};
+
+	/// Reseeds the random functions that take no rand_stream. The calling
+	/// thread restarts its stream; threads that have not drawn yet start
+	/// theirs with Seed, and the others keep the streams they have.
+	///
+	/// @see gtc_random
+	GLM_FUNC_DISCARD_DECL void randSeed(uint64 Seed);
+
+	/// The calling thread's stream, which linearRand, gaussRand and the
+	/// other functions without a rand_stream draw from. Threads get streams
+	/// 0, 1, 2, ... of the current seed in the order they first draw.
+	///
+	/// @see gtc_random
+	GLM_FUNC_DECL rand_stream& randThreadStream();
+
 	/// Generate random numbers in the interval [Min, Max], according a linear distribution
 	///
 	/// @param Min Minimum value included in the sampling
@@ -76,6 +120,52 @@ namespace glm
 	template<typename T>
 	GLM_FUNC_DECL vec<3, T, defaultp> ballRand(T Radius);
 
+	/// Out[i] = Min + u * (Max - Min) for Count values, u uniform in [0, 1)
+	/// with 24 random bits. Every span call starts at the stream's next
+	/// block and ends the stream at the block after its last one, using four
+	/// values per block: Out[i] comes from block Stream.block + i / 4, so
+	/// threads can fill separate parts of a span from copies of one stream
+	/// moved there with seek.
+	///
+	/// The span functions give the same values with SSE2, AVX2 and scalar
+	/// code, unless the compiler contracts multiply-adds into FMA (GCC with
+	/// -mfma, unless -ffp-contract=off).
+	///
+	/// @see gtc_random
+	GLM_FUNC_DISCARD_DECL void linearRand(rand_stream& Stream, float Min, float Max, float* Out, std::size_t Count);
+
+	/// Linear distribution for Count vectors, component c of Out[i] being
+	/// value i * L + c of the float span.
+	///
+	/// @see gtc_random
+	template<length_t L, qualifier Q>
+	GLM_FUNC_DISCARD_DECL void linearRand(rand_stream& Stream, vec<L, float, Q> const& Min, vec<L, float, Q> const& Max, vec<L, float, Q>* Out, std::size_t Count);
+
+	/// Gaussian distribution for Count values, scaled like gaussRand(Mean,
+	/// Deviation): the standard deviation is Deviation squared, so a loop can
+	/// move to the span without changing its distribution. Box-Muller
+	/// transform, two values from each pair of words, four values per block.
+	///
+	/// @see gtc_random
+	GLM_FUNC_DISCARD_DECL void gaussRand(rand_stream& Stream, float Mean, float Deviation, float* Out, std::size_t Count);
+
+	/// Count points evenly distributed on a sphere of radius Radius, two per block.
+	///
+	/// @see gtc_random
+	template<qualifier Q>
+	GLM_FUNC_DISCARD_DECL void sphericalRand(rand_stream& Stream, float Radius, vec<3, float, Q>* Out, std::size_t Count);
+
+	/// Count points evenly distributed within a ball of radius Radius, one per
+	/// block: a point of the sphere scaled by the cube root of a uniform value.
+	///
+	/// @see gtc_random
+	template<qualifier Q>
+	GLM_FUNC_DISCARD_DECL void ballRand(rand_stream& Stream, float Radius, vec<3, float, Q>* Out, std::size_t Count);
+
+	/// Name of the instruction set the span functions use: "AVX2", "SSE2" or "scalar".
+	/// @see gtc_random
+	GLM_FUNC_DECL char const* randIsa();
+
 	/// @}
 }//namespace glm
 
@@ -2,96 +2,67 @@
 #include "../exponential.hpp"
 #include "../trigonometric.hpp"
 #include "../detail/type_vec1.hpp"
-#include <cstdlib>
-#include <ctime>
 #include <cassert>
 #include <cmath>
+#include <cstring>
+#include <limits>
+#if GLM_LANG & GLM_LANG_CXX11_FLAG
+#	include <atomic>
+#endif
+
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+#	include "../simd/random.h"
+#endif
 
 namespace glm{
 namespace detail
 {
-	template <length_t L, typename T, qualifier Q>
-	struct compute_rand
-	{
-		GLM_FUNC_QUALIFIER static vec<L, T, Q> call();
-	};
-
-	template <qualifier P>
-	struct compute_rand<1, uint8, P>
-	{
-		GLM_FUNC_QUALIFIER static vec<1, uint8, P> call()
-		{
-			return vec<1, uint8, P>(
-				static_cast<uint8>(std::rand() % std::numeric_limits<uint8>::max()));
-		}
-	};
-
-	template <qualifier P>
-	struct compute_rand<2, uint8, P>
-	{
-		GLM_FUNC_QUALIFIER static vec<2, uint8, P> call()
-		{
-			return vec<2, uint8, P>(
-				std::rand() % std::numeric_limits<uint8>::max(),
-				std::rand() % std::numeric_limits<uint8>::max());
-		}
-	};
-
-	template <qualifier P>
-	struct compute_rand<3, uint8, P>
+	// Philox4x32-10 (Salmon et al., "Parallel random numbers: as easy as
+	// 1, 2, 3") on the counter (Block, Stream) under Key.
+	GLM_FUNC_QUALIFIER void rand_philox(uint32 const* Key, uint32 const* Stream, uint64 Block, uint32* Words)
 	{
-		GLM_FUNC_QUALIFIER static vec<3, uint8, P> call()
+		uint32 c0 = static_cast<uint32>(Block), c1 = static_cast<uint32>(Block >> 32), c2 = Stream[0], c3 = Stream[1];
+		uint32 k0 = Key[0], k1 = Key[1];
+		for(int Round = 0; Round < 10; ++Round)
 		{
-			return vec<3, uint8, P>(
-				std::rand() % std::numeric_limits<uint8>::max(),
-				std::rand() % std::numeric_limits<uint8>::max(),
-				std::rand() % std::numeric_limits<uint8>::max());
+			uint64 const p0 = static_cast<uint64>(0xD2511F53u) * c0;
+			uint64 const p1 = static_cast<uint64>(0xCD9E8D57u) * c2;
+			c0 = static_cast<uint32>(p1 >> 32) ^ c1 ^ k0;
+			c1 = static_cast<uint32>(p1);
+			c2 = static_cast<uint32>(p0 >> 32) ^ c3 ^ k1;
+			c3 = static_cast<uint32>(p0);
+			k0 += 0x9E3779B9u;
+			k1 += 0xBB67AE85u;
 		}
-	};
-
-	template <qualifier P>
-	struct compute_rand<4, uint8, P>
-	{
-		GLM_FUNC_QUALIFIER static vec<4, uint8, P> call()
-		{
-			return vec<4, uint8, P>(
-				std::rand() % std::numeric_limits<uint8>::max(),
-				std::rand() % std::numeric_limits<uint8>::max(),
-				std::rand() % std::numeric_limits<uint8>::max(),
-				std::rand() % std::numeric_limits<uint8>::max());
-		}
-	};
+		Words[0] = c0;
+		Words[1] = c1;
+		Words[2] = c2;
+		Words[3] = c3;
+	}
 
-	template <length_t L, qualifier Q>
-	struct compute_rand<L, uint16, Q>
+	template<typename T>
+	GLM_FUNC_QUALIFIER T rand_bits(rand_stream& Stream)
 	{
-		GLM_FUNC_QUALIFIER static vec<L, uint16, Q> call()
-		{
-			return
-				(vec<L, uint16, Q>(compute_rand<L, uint8, Q>::call()) << static_cast<uint16>(8)) |
-				(vec<L, uint16, Q>(compute_rand<L, uint8, Q>::call()) << static_cast<uint16>(0));
-		}
-	};
+		return static_cast<T>(Stream.next() >> (32 - 8 * sizeof(T)));
+	}
 
-	template <length_t L, qualifier Q>
-	struct compute_rand<L, uint32, Q>
+	template<>
+	GLM_FUNC_QUALIFIER uint64 rand_bits<uint64>(rand_stream& Stream)
 	{
-		GLM_FUNC_QUALIFIER static vec<L, uint32, Q> call()
-		{
-			return
-				(vec<L, uint32, Q>(compute_rand<L, uint16, Q>::call()) << static_cast<uint32>(16)) |
-				(vec<L, uint32, Q>(compute_rand<L, uint16, Q>::call()) << static_cast<uint32>(0));
-		}
-	};
+		uint64 const High = Stream.next();
+		return (High << 32) | Stream.next();
+	}
 
-	template <length_t L, qualifier Q>
-	struct compute_rand<L, uint64, Q>
+	template <length_t L, typename T, qualifier Q>
+	struct compute_rand
 	{
-		GLM_FUNC_QUALIFIER static vec<L, uint64, Q> call()
+		GLM_FUNC_QUALIFIER static vec<L, T, Q> call()
 		{
-			return
-				(vec<L, uint64, Q>(compute_rand<L, uint32, Q>::call()) << static_cast<uint64>(32)) |
-				(vec<L, uint64, Q>(compute_rand<L, uint32, Q>::call()) << static_cast<uint64>(0));
+			rand_stream& Stream = randThreadStream();
+			vec<L, T, Q> Result(static_cast<T>(0));
+			for(length_t i = 0; i < L; ++i)
+				Result[i] = rand_bits<T>(Stream);
+			return Result;
 		}
 	};
 
@@ -300,4 +271,616 @@ namespace detail
 
 		return vec<3, T, defaultp>(x, y, z) * Radius;
 	}
+
+	GLM_FUNC_QUALIFIER rand_stream::rand_stream(uint64 Seed, uint64 Stream)
+		: block(0)
+		, used(4)
+	{
+		key[0] = static_cast<uint32>(Seed);
+		key[1] = static_cast<uint32>(Seed >> 32);
+		stream[0] = static_cast<uint32>(Stream);
+		stream[1] = static_cast<uint32>(Stream >> 32);
+		words[0] = words[1] = words[2] = words[3] = 0;
+	}
+
+	GLM_FUNC_QUALIFIER uint32 rand_stream::next()
+	{
+		if(used == 4)
+		{
+			detail::rand_philox(key, stream, block, words);
+			++block;
+			used = 0;
+		}
+		return words[used++];
+	}
+
+	GLM_FUNC_QUALIFIER void rand_stream::seek(uint64 Block)
+	{
+		block = Block;
+		used = 4;
+	}
+
+namespace detail
+{
+#	if GLM_LANG & GLM_LANG_CXX11_FLAG
+	GLM_FUNC_QUALIFIER std::atomic<uint64>& rand_seed()
+	{
+		static std::atomic<uint64> Seed(0);
+		return Seed;
+	}
+
+	GLM_FUNC_QUALIFIER uint64 rand_thread_index()
+	{
+		static std::atomic<uint64> Threads(0);
+		static thread_local uint64 const Index = Threads++;
+		return Index;
+	}
+#	else
+	GLM_FUNC_QUALIFIER uint64& rand_seed()
+	{
+		static uint64 Seed(0);
+		return Seed;
+	}
+
+	GLM_FUNC_QUALIFIER uint64 rand_thread_index()
+	{
+		return 0;
+	}
+#	endif
+}//namespace detail
+
+	GLM_FUNC_QUALIFIER rand_stream& randThreadStream()
+	{
+#		if GLM_LANG & GLM_LANG_CXX11_FLAG
+			static thread_local rand_stream Stream(detail::rand_seed(), detail::rand_thread_index());
+#		else
+			static rand_stream Stream(detail::rand_seed(), 0);
+#		endif
+		return Stream;
+	}
+
+	GLM_FUNC_QUALIFIER void randSeed(uint64 Seed)
+	{
+		detail::rand_seed() = Seed;
+		randThreadStream() = rand_stream(Seed, detail::rand_thread_index());
+	}
+
+namespace detail
+{
+	enum rand_batch_kind
+	{
+		rand_batch_linear,
+		rand_batch_gauss,
+		rand_batch_sphere,
+		rand_batch_ball
+	};
+
+	// Values each block of the stream makes: four from single words, two
+	// points from pairs of words, one point from three words.
+	template<rand_batch_kind K>
+	struct rand_batch_per_block
+	{
+		static std::size_t const value = K == rand_batch_sphere ? 2 : K == rand_batch_ball ? 1 : 4;
+	};
+
+	// Span kernels: a and b are Min and Max - Min, Mean and standard deviation, or the
+	// radius; points go to x, y and z. They return the count handled, a
+	// multiple of their width in blocks, and rand_batch_scalar does the rest.
+	typedef std::size_t (*rand_batch_kernel)(uint32 const* key, uint32 const* stream, uint64 block, float a, float b, float* x, float* y, float* z, std::size_t count);
+
+	// The scalar twins of glm/simd/random.h, operation for operation.
+	GLM_FUNC_QUALIFIER float rand_float_bits(uint32 Bits)
+	{
+		float Result;
+		std::memcpy(&Result, &Bits, sizeof(Result));
+		return Result;
+	}
+
+	GLM_FUNC_QUALIFIER uint32 rand_uint_bits(float Value)
+	{
+		uint32 Result;
+		std::memcpy(&Result, &Value, sizeof(Result));
+		return Result;
+	}
+
+	GLM_FUNC_QUALIFIER float rand_unit(uint32 Bits)
+	{
+		return static_cast<float>(static_cast<int>(Bits >> 8)) * 5.9604644775390625e-8f;
+	}
+
+	GLM_FUNC_QUALIFIER float rand_unit_open(uint32 Bits)
+	{
+		return static_cast<float>(static_cast<int>((Bits >> 8) + 1)) * 5.9604644775390625e-8f;
+	}
+
+	GLM_FUNC_QUALIFIER float rand_log(float x)
+	{
+		uint32 const i = rand_uint_bits(x);
+		int e = static_cast<int>(i >> 23) - 127;
+		float m = rand_float_bits((i & 0x007fffffu) | 0x3f800000u);
+		if(m > 1.41421356f)
+		{
+			m = m * 0.5f;
+			e += 1;
+		}
+
+		float const t = (m - 1.0f) / (m + 1.0f);
+		float const t2 = t * t;
+		float p = t2 * (1.0f / 9.0f) + 1.0f / 7.0f;
+		p = p * t2 + 1.0f / 5.0f;
+		p = p * t2 + 1.0f / 3.0f;
+		p = p * t2 + 1.0f;
+		float const f = static_cast<float>(e);
+		float const Lo = f * -2.12194440e-4f + (t + t) * p;
+		return f * 0.693359375f + Lo;
+	}
+
+	GLM_FUNC_QUALIFIER void rand_sincos(float Turns, float& s, float& c)
+	{
+		float const Quarters = Turns * 4.0f;
+		int const q = static_cast<int>(Quarters + 0.5f);
+		float const x = (Quarters - static_cast<float>(q)) * 1.57079632679489662f;
+		float const x2 = x * x;
+
+		float ps = x2 * (1.0f / 362880.0f) + -1.0f / 5040.0f;
+		ps = ps * x2 + 1.0f / 120.0f;
+		ps = ps * x2 + -1.0f / 6.0f;
+		float const Sin = x + x * x2 * ps;
+
+		float pc = x2 * (-1.0f / 3628800.0f) + 1.0f / 40320.0f;
+		pc = pc * x2 + -1.0f / 720.0f;
+		pc = pc * x2 + 1.0f / 24.0f;
+		pc = pc * x2 + -0.5f;
+		float const Cos = pc * x2 + 1.0f;
+
+		s = q & 1 ? Cos : Sin;
+		c = q & 1 ? Sin : Cos;
+		if(q & 2)
+			s = -s;
+		if((q + 1) & 2)
+			c = -c;
+	}
+
+	GLM_FUNC_QUALIFIER float rand_cbrt(float x)
+	{
+		int const Guess = static_cast<int>(static_cast<float>(static_cast<int>(rand_uint_bits(x))) * (1.0f / 3.0f));
+		float y = rand_float_bits(static_cast<uint32>(Guess + 709958130));
+		for(int Step = 0; Step < 3; ++Step)
+			y = (y + y + x / (y * y)) * (1.0f / 3.0f);
+		return y;
+	}
+
+	// Value j of a block's words.
+	template<rand_batch_kind K>
+	GLM_FUNC_QUALIFIER void rand_batch_value(uint32 const* Words, std::size_t j, float a, float b, float* x, float* y, float* z, std::size_t i)
+	{
+		if(K == rand_batch_linear)
+		{
+			x[i] = a + rand_unit(Words[j]) * b;
+		}
+		else if(K == rand_batch_gauss)
+		{
+			float const r = std::sqrt(-2.0f * rand_log(rand_unit_open(Words[j & 2])));
+			float s, c;
+			rand_sincos(rand_unit(Words[(j & 2) + 1]), s, c);
+			x[i] = a + b * (j & 1 ? r * s : r * c);
+		}
+		else
+		{
+			std::size_t const Word = K == rand_batch_sphere ? 2 * j : 0;
+			float const Height = 1.0f - 2.0f * rand_unit(Words[Word]);
+			float const r = std::sqrt((1.0f - Height) * (1.0f + Height));
+			float s, c;
+			rand_sincos(rand_unit(Words[Word + 1]), s, c);
+			float const Scale = K == rand_batch_sphere ? a : a * rand_cbrt(rand_unit_open(Words[2]));
+			x[i] = r * c * Scale;
+			y[i] = r * s * Scale;
+			z[i] = Height * Scale;
+		}
+	}
+
+	// Values first to count, first being a whole number of blocks.
+	template<rand_batch_kind K>
+	GLM_FUNC_QUALIFIER void rand_batch_scalar(uint32 const* key, uint32 const* stream, uint64 block, float a, float b, float* x, float* y, float* z, std::size_t first, std::size_t count)
+	{
+		std::size_t const PerBlock = rand_batch_per_block<K>::value;
+		for(std::size_t i = first; i < count;)
+		{
+			uint32 Words[4];
+			rand_philox(key, stream, block + i / PerBlock, Words);
+			for(std::size_t j = 0; j < PerBlock && i < count; ++j, ++i)
+				rand_batch_value<K>(Words, j, a, b, x, y, z, i);
+		}
+	}
+
+#	if GLM_ARCH & GLM_ARCH_SSE2_BIT
+	struct rand_batch_sse2
+	{
+		static std::size_t const width = 4;
+
+		GLM_FUNC_QUALIFIER static void counters(uint32 const* stream, uint64 block, __m128i c[4])
+		{
+			c[0] = _mm_setr_epi32(static_cast<int>(block), static_cast<int>(block + 1), static_cast<int>(block + 2), static_cast<int>(block + 3));
+			c[1] = _mm_setr_epi32(static_cast<int>(block >> 32), static_cast<int>((block + 1) >> 32), static_cast<int>((block + 2) >> 32), static_cast<int>((block + 3) >> 32));
+			c[2] = _mm_set1_epi32(static_cast<int>(stream[0]));
+			c[3] = _mm_set1_epi32(static_cast<int>(stream[1]));
+		}
+
+		// Points from the height word h and the angle word h + 1.
+		GLM_FUNC_QUALIFIER static void sphere(__m128i h, __m128i angle, __m128 scale, __m128& x, __m128& y, __m128& z)
+		{
+			__m128 const One = _mm_set1_ps(1.0f);
+			__m128 const Height = _mm_sub_ps(One, _mm_mul_ps(_mm_set1_ps(2.0f), glm_vec4_rand_unit(h)));
+			__m128 const r = _mm_sqrt_ps(_mm_mul_ps(_mm_sub_ps(One, Height), _mm_add_ps(One, Height)));
+			__m128 s, c;
+			glm_vec4_rand_sincos(glm_vec4_rand_unit(angle), s, c);
+			x = _mm_mul_ps(_mm_mul_ps(r, c), scale);
+			y = _mm_mul_ps(_mm_mul_ps(r, s), scale);
+			z = _mm_mul_ps(Height, scale);
+		}
+
+		template<rand_batch_kind K>
+		GLM_FUNC_QUALIFIER static std::size_t span(uint32 const* key, uint32 const* stream, uint64 block, float a, float b, float* x, float* y, float* z, std::size_t count)
+		{
+			std::size_t const Group = width * rand_batch_per_block<K>::value;
+			__m128 const A = _mm_set1_ps(a), B = _mm_set1_ps(b);
+			std::size_t i = 0;
+			for(; i + Group <= count; i += Group, block += width)
+			{
+				__m128i c[4];
+				counters(stream, block, c);
+				glm_vec4_rand_philox(c, key[0], key[1]);
+				if(K == rand_batch_linear || K == rand_batch_gauss)
+				{
+					__m128 v[4];
+					if(K == rand_batch_linear)
+					{
+						for(int j = 0; j < 4; ++j)
+							v[j] = _mm_add_ps(A, _mm_mul_ps(glm_vec4_rand_unit(c[j]), B));
+					}
+					else
+					{
+						for(int j = 0; j < 4; j += 2)
+						{
+							__m128 const r = _mm_sqrt_ps(_mm_mul_ps(_mm_set1_ps(-2.0f), glm_vec4_rand_log(glm_vec4_rand_unit_open(c[j]))));
+							__m128 s, co;
+							glm_vec4_rand_sincos(glm_vec4_rand_unit(c[j + 1]), s, co);
+							v[j] = _mm_add_ps(A, _mm_mul_ps(B, _mm_mul_ps(r, co)));
+							v[j + 1] = _mm_add_ps(A, _mm_mul_ps(B, _mm_mul_ps(r, s)));
+						}
+					}
+					glm_vec4_rand_transpose(v);
+					for(int j = 0; j < 4; ++j)
+						_mm_storeu_ps(x + i + 4 * j, v[j]);
+				}
+				else if(K == rand_batch_sphere)
+				{
+					__m128 x0, y0, z0, x1, y1, z1;
+					sphere(c[0], c[1], A, x0, y0, z0);
+					sphere(c[2], c[3], A, x1, y1, z1);
+					_mm_storeu_ps(x + i, _mm_unpacklo_ps(x0, x1));
+					_mm_storeu_ps(x + i + 4, _mm_unpackhi_ps(x0, x1));
+					_mm_storeu_ps(y + i, _mm_unpacklo_ps(y0, y1));
+					_mm_storeu_ps(y + i + 4, _mm_unpackhi_ps(y0, y1));
+					_mm_storeu_ps(z + i, _mm_unpacklo_ps(z0, z1));
+					_mm_storeu_ps(z + i + 4, _mm_unpackhi_ps(z0, z1));
+				}
+				else
+				{
+					__m128 Px, Py, Pz;
+					sphere(c[0], c[1], _mm_mul_ps(A, glm_vec4_rand_cbrt(glm_vec4_rand_unit_open(c[2]))), Px, Py, Pz);
+					_mm_storeu_ps(x + i, Px);
+					_mm_storeu_ps(y + i, Py);
+					_mm_storeu_ps(z + i, Pz);
+				}
+			}
+			return i;
+		}
+	};
+#	endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
+
+	// glm/simd/random.h eight blocks at a time, without FMA so that the
+	// values stay those of the scalar code.
+#	if (GLM_ARCH & GLM_ARCH_AVX2_BIT) || (GLM_CONFIG_SIMD_DISPATCH == GLM_ENABLE)
+	struct rand_batch_avx2
+	{
+		static std::size_t const width = 8;
+
+		GLM_TARGET_AVX2_NOFMA GLM_FUNC_QUALIFIER static __m256i mulhilo(__m256i a, __m256i b, __m256i& hi)
+		{
+			__m256i const Even = _mm256_mul_epu32(a, b);
+			__m256i const Odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+			hi = _mm256_unpacklo_epi32(_mm256_shuffle_epi32(Even, _MM_SHUFFLE(3, 1, 3, 1)), _mm256_shuffle_epi32(Odd, _MM_SHUFFLE(3, 1, 3, 1)));
+			return _mm256_unpacklo_epi32(_mm256_shuffle_epi32(Even, _MM_SHUFFLE(2, 0, 2, 0)), _mm256_shuffle_epi32(Odd, _MM_SHUFFLE(2, 0, 2, 0)));
+		}
+
+		GLM_TARGET_AVX2_NOFMA GLM_FUNC_QUALIFIER static void philox(__m256i c[4], uint32 k0, uint32 k1)
+		{
+			__m256i const M0 = _mm256_set1_epi32(static_cast<int>(0xD2511F53u));
+			__m256i const M1 = _mm256_set1_epi32(static_cast<int>(0xCD9E8D57u));
+			__m256i Key0 = _mm256_set1_epi32(static_cast<int>(k0));
+			__m256i Key1 = _mm256_set1_epi32(static_cast<int>(k1));
+			for(int Round = 0; Round < 10; ++Round)
+			{
+				__m256i Hi0, Hi1;
+				__m256i const Lo0 = mulhilo(c[0], M0, Hi0);
+				__m256i const Lo1 = mulhilo(c[2], M1, Hi1);
+				c[0] = _mm256_xor_si256(_mm256_xor_si256(Hi1, c[1]), Key0);
+				c[1] = Lo1;
+				c[2] = _mm256_xor_si256(_mm256_xor_si256(Hi0, c[3]), Key1);
+				c[3] = Lo0;
+				Key0 = _mm256_add_epi32(Key0, _mm256_set1_epi32(static_cast<int>(0x9E3779B9u)));
+				Key1 = _mm256_add_epi32(Key1, _mm256_set1_epi32(static_cast<int>(0xBB67AE85u)));
+			}
+		}
+
+		GLM_TARGET_AVX2_NOFMA GLM_FUNC_QUALIFIER static void counters(uint32 const* stream, uint64 block, __m256i c[4])
+		{
+			int Lo[8], Hi[8];
+			for(int j = 0; j < 8; ++j)
+			{
+				Lo[j] = static_cast<int>(block + j);
+				Hi[j] = static_cast<int>((block + j) >> 32);
+			}
+			c[0] = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(Lo));
+			c[1] = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(Hi));
+			c[2] = _mm256_set1_epi32(static_cast<int>(stream[0]));
+			c[3] = _mm256_set1_epi32(static_cast<int>(stream[1]));
+		}
+
+		GLM_TARGET_AVX2_NOFMA GLM_FUNC_QUALIFIER static __m256 unit(__m256i bits)
+		{
+			return _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(bits, 8)), _mm256_set1_ps(5.9604644775390625e-8f));
+		}
+
+		GLM_TARGET_AVX2_NOFMA GLM_FUNC_QUALIFIER static __m256 unit_open(__m256i bits)
+		{
+			return _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_add_epi32(_mm256_srli_epi32(bits, 8), _mm256_set1_epi32(1))), _mm256_set1_ps(5.9604644775390625e-8f));
+		}
+
+		GLM_TARGET_AVX2_NOFMA GLM_FUNC_QUALIFIER static __m256 log(__m256 x)
+		{
+			__m256i const i = _mm256_castps_si256(x);
+			__m256i e = _mm256_sub_epi32(_mm256_srli_epi32(i, 23), _mm256_set1_epi32(127));
+			__m256 m = _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(i, _mm256_set1_epi32(0x007fffff)), _mm256_set1_epi32(0x3f800000)));
+			__m256 const Big = _mm256_cmp_ps(m, _mm256_set1_ps(1.41421356f), _CMP_GT_OQ);
+			m = _mm256_blendv_ps(m, _mm256_mul_ps(m, _mm256_set1_ps(0.5f)), Big);
+			e = _mm256_sub_epi32(e, _mm256_castps_si256(Big));
+
+			__m256 const t = _mm256_div_ps(_mm256_sub_ps(m, _mm256_set1_ps(1.0f)), _mm256_add_ps(m, _mm256_set1_ps(1.0f)));
+			__m256 const t2 = _mm256_mul_ps(t, t);
+			__m256 p = _mm256_add_ps(_mm256_mul_ps(t2, _mm256_set1_ps(1.0f / 9.0f)), _mm256_set1_ps(1.0f / 7.0f));
+			p = _mm256_add_ps(_mm256_mul_ps(p, t2), _mm256_set1_ps(1.0f / 5.0f));
+			p = _mm256_add_ps(_mm256_mul_ps(p, t2), _mm256_set1_ps(1.0f / 3.0f));
+			p = _mm256_add_ps(_mm256_mul_ps(p, t2), _mm256_set1_ps(1.0f));
+			__m256 const f = _mm256_cvtepi32_ps(e);
+			__m256 const Lo = _mm256_add_ps(_mm256_mul_ps(f, _mm256_set1_ps(-2.12194440e-4f)), _mm256_mul_ps(_mm256_add_ps(t, t), p));
+			return _mm256_add_ps(_mm256_mul_ps(f, _mm256_set1_ps(0.693359375f)), Lo);
+		}
+
+		GLM_TARGET_AVX2_NOFMA GLM_FUNC_QUALIFIER static void sincos(__m256 turns, __m256& s, __m256& c)
+		{
+			__m256 const Quarters = _mm256_mul_ps(turns, _mm256_set1_ps(4.0f));
+			__m256i const q = _mm256_cvttps_epi32(_mm256_add_ps(Quarters, _mm256_set1_ps(0.5f)));
+			__m256 const x = _mm256_mul_ps(_mm256_sub_ps(Quarters, _mm256_cvtepi32_ps(q)), _mm256_set1_ps(1.57079632679489662f));
+			__m256 const x2 = _mm256_mul_ps(x, x);
+
+			__m256 ps = _mm256_add_ps(_mm256_mul_ps(x2, _mm256_set1_ps(1.0f / 362880.0f)), _mm256_set1_ps(-1.0f / 5040.0f));
+			ps = _mm256_add_ps(_mm256_mul_ps(ps, x2), _mm256_set1_ps(1.0f / 120.0f));
+			ps = _mm256_add_ps(_mm256_mul_ps(ps, x2), _mm256_set1_ps(-1.0f / 6.0f));
+			__m256 const Sin = _mm256_add_ps(x, _mm256_mul_ps(_mm256_mul_ps(x, x2), ps));
+
+			__m256 pc = _mm256_add_ps(_mm256_mul_ps(x2, _mm256_set1_ps(-1.0f / 3628800.0f)), _mm256_set1_ps(1.0f / 40320.0f));
+			pc = _mm256_add_ps(_mm256_mul_ps(pc, x2), _mm256_set1_ps(-1.0f / 720.0f));
+			pc = _mm256_add_ps(_mm256_mul_ps(pc, x2), _mm256_set1_ps(1.0f / 24.0f));
+			pc = _mm256_add_ps(_mm256_mul_ps(pc, x2), _mm256_set1_ps(-0.5f));
+			__m256 const Cos = _mm256_add_ps(_mm256_mul_ps(pc, x2), _mm256_set1_ps(1.0f));
+
+			__m256 const Swap = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(q, _mm256_set1_epi32(1)), _mm256_set1_epi32(1)));
+			s = _mm256_blendv_ps(Sin, Cos, Swap);
+			c = _mm256_blendv_ps(Cos, Sin, Swap);
+			s = _mm256_xor_ps(s, _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(q, _mm256_set1_epi32(2)), 30)));
+			c = _mm256_xor_ps(c, _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(_mm256_add_epi32(q, _mm256_set1_epi32(1)), _mm256_set1_epi32(2)), 30)));
+		}
+
+		GLM_TARGET_AVX2_NOFMA GLM_FUNC_QUALIFIER static __m256 cbrt(__m256 x)
+		{
+			__m256i const Guess = _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_castps_si256(x)), _mm256_set1_ps(1.0f / 3.0f)));
+			__m256 y = _mm256_castsi256_ps(_mm256_add_epi32(Guess, _mm256_set1_epi32(709958130)));
+			for(int Step = 0; Step < 3; ++Step)
+				y = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(y, y), _mm256_div_ps(x, _mm256_mul_ps(y, y))), _mm256_set1_ps(1.0f / 3.0f));
+			return y;
+		}
+
+		GLM_TARGET_AVX2_NOFMA GLM_FUNC_QUALIFIER static void sphere(__m256i h, __m256i angle, __m256 scale, __m256& x, __m256& y, __m256& z)
+		{
+			__m256 const One = _mm256_set1_ps(1.0f);
+			__m256 const Height = _mm256_sub_ps(One, _mm256_mul_ps(_mm256_set1_ps(2.0f), unit(h)));
+			__m256 const r = _mm256_sqrt_ps(_mm256_mul_ps(_mm256_sub_ps(One, Height), _mm256_add_ps(One, Height)));
+			__m256 s, c;
+			sincos(unit(angle), s, c);
+			x = _mm256_mul_ps(_mm256_mul_ps(r, c), scale);
+			y = _mm256_mul_ps(_mm256_mul_ps(r, s), scale);
+			z = _mm256_mul_ps(Height, scale);
+		}
+
+		// Lane j of v to block j's four values: blocks j and j + 4 share a register.
+		GLM_TARGET_AVX2_NOFMA GLM_FUNC_QUALIFIER static void store_blocks(float* out, __m256 const v[4])
+		{
+			__m256 const t0 = _mm256_unpacklo_ps(v[0], v[1]);
+			__m256 const t1 = _mm256_unpacklo_ps(v[2], v[3]);
+			__m256 const t2 = _mm256_unpackhi_ps(v[0], v[1]);
+			__m256 const t3 = _mm256_unpackhi_ps(v[2], v[3]);
+			__m256 const r0 = _mm256_castpd_ps(_mm256_unpacklo_pd(_mm256_castps_pd(t0), _mm256_castps_pd(t1)));
+			__m256 const r1 = _mm256_castpd_ps(_mm256_unpackhi_pd(_mm256_castps_pd(t0), _mm256_castps_pd(t1)));
+			__m256 const r2 = _mm256_castpd_ps(_mm256_unpacklo_pd(_mm256_castps_pd(t2), _mm256_castps_pd(t3)));
+			__m256 const r3 = _mm256_castpd_ps(_mm256_unpackhi_pd(_mm256_castps_pd(t2), _mm256_castps_pd(t3)));
+			_mm256_storeu_ps(out, _mm256_permute2f128_ps(r0, r1, 0x20));
+			_mm256_storeu_ps(out + 8, _mm256_permute2f128_ps(r2, r3, 0x20));
+			_mm256_storeu_ps(out + 16, _mm256_permute2f128_ps(r0, r1, 0x31));
+			_mm256_storeu_ps(out + 24, _mm256_permute2f128_ps(r2, r3, 0x31));
+		}
+
+		// Points of blocks 0-7 from words 0-1 in a and 2-3 in b, in order.
+		GLM_TARGET_AVX2_NOFMA GLM_FUNC_QUALIFIER static void store_pairs(float* out, __m256 a, __m256 b)
+		{
+			__m256 const Lo = _mm256_unpacklo_ps(a, b);
+			__m256 const Hi = _mm256_unpackhi_ps(a, b);
+			_mm256_storeu_ps(out, _mm256_permute2f128_ps(Lo, Hi, 0x20));
+			_mm256_storeu_ps(out + 8, _mm256_permute2f128_ps(Lo, Hi, 0x31));
+		}
+
+		template<rand_batch_kind K>
+		GLM_TARGET_AVX2_NOFMA GLM_FUNC_QUALIFIER static std::size_t span(uint32 const* key, uint32 const* stream, uint64 block, float a, float b, float* x, float* y, float* z, std::size_t count)
+		{
+			std::size_t const Group = width * rand_batch_per_block<K>::value;
+			__m256 const A = _mm256_set1_ps(a), B = _mm256_set1_ps(b);
+			std::size_t i = 0;
+			for(; i + Group <= count; i += Group, block += width)
+			{
+				__m256i c[4];
+				counters(stream, block, c);
+				philox(c, key[0], key[1]);
+				if(K == rand_batch_linear || K == rand_batch_gauss)
+				{
+					__m256 v[4];
+					if(K == rand_batch_linear)
+					{
+						for(int j = 0; j < 4; ++j)
+							v[j] = _mm256_add_ps(A, _mm256_mul_ps(unit(c[j]), B));
+					}
+					else
+					{
+						for(int j = 0; j < 4; j += 2)
+						{
+							__m256 const r = _mm256_sqrt_ps(_mm256_mul_ps(_mm256_set1_ps(-2.0f), log(unit_open(c[j]))));
+							__m256 s, co;
+							sincos(unit(c[j + 1]), s, co);
+							v[j] = _mm256_add_ps(A, _mm256_mul_ps(B, _mm256_mul_ps(r, co)));
+							v[j + 1] = _mm256_add_ps(A, _mm256_mul_ps(B, _mm256_mul_ps(r, s)));
+						}
+					}
+					store_blocks(x + i, v);
+				}
+				else if(K == rand_batch_sphere)
+				{
+					__m256 x0, y0, z0, x1, y1, z1;
+					sphere(c[0], c[1], A, x0, y0, z0);
+					sphere(c[2], c[3], A, x1, y1, z1);
+					store_pairs(x + i, x0, x1);
+					store_pairs(y + i, y0, y1);
+					store_pairs(z + i, z0, z1);
+				}
+				else
+				{
+					__m256 Px, Py, Pz;
+					sphere(c[0], c[1], _mm256_mul_ps(A, cbrt(unit_open(c[2]))), Px, Py, Pz);
+					_mm256_storeu_ps(x + i, Px);
+					_mm256_storeu_ps(y + i, Py);
+					_mm256_storeu_ps(z + i, Pz);
+				}
+			}
+			return i;
+		}
+	};
+#	endif
+
+#	if GLM_ARCH & GLM_ARCH_AVX2_BIT
+	typedef rand_batch_avx2 rand_batch_simd;
+#	elif GLM_ARCH & GLM_ARCH_SSE2_BIT
+	typedef rand_batch_sse2 rand_batch_simd;
+#	endif
+
+	template<rand_batch_kind K>
+	GLM_FUNC_QUALIFIER rand_batch_kernel rand_batch_default()
+	{
+#		if GLM_ARCH & GLM_ARCH_SSE2_BIT
+			return &rand_batch_simd::span<K>;
+#		else
+			return GLM_NULLPTR;
+#		endif
+	}
+
+	// Runs Kernel, finishes with scalar code and moves the stream past the
+	// blocks used.
+	template<rand_batch_kind K>
+	GLM_FUNC_QUALIFIER void rand_batch(rand_batch_kernel Kernel, rand_stream& Stream, float a, float b, float* x, float* y, float* z, std::size_t count)
+	{
+		std::size_t const PerBlock = rand_batch_per_block<K>::value;
+		std::size_t const Done = Kernel ? Kernel(Stream.key, Stream.stream, Stream.block, a, b, x, y, z, count) : 0;
+		rand_batch_scalar<K>(Stream.key, Stream.stream, Stream.block, a, b, x, y, z, Done, count);
+		Stream.seek(Stream.block + (count + PerBlock - 1) / PerBlock);
+	}
+
+	// Vector spans go through a buffer, a whole number of blocks at a time,
+	// so that any qualifier's layout works.
+	template<length_t L, qualifier Q>
+	GLM_FUNC_QUALIFIER void rand_batch_linear_vec(rand_batch_kernel Kernel, rand_stream& Stream, vec<L, float, Q> const& Min, vec<L, float, Q> const& Max, vec<L, float, Q>* Out, std::size_t Count)
+	{
+		std::size_t const Chunk = 64;
+		float Unit[Chunk * 4];
+		vec<L, float, Q> const Range = Max - Min;
+		for(std::size_t First = 0; First < Count; First += Chunk)
+		{
+			std::size_t const n = Count - First < Chunk ? Count - First : Chunk;
+			rand_batch<rand_batch_linear>(Kernel, Stream, 0.0f, 1.0f, Unit, GLM_NULLPTR, GLM_NULLPTR, n * L);
+			for(std::size_t i = 0; i < n; ++i)
+				for(length_t c = 0; c < L; ++c)
+					Out[First + i][c] = Min[c] + Unit[i * L + c] * Range[c];
+		}
+	}
+
+	template<rand_batch_kind K, qualifier Q>
+	GLM_FUNC_QUALIFIER void rand_batch_points(rand_batch_kernel Kernel, rand_stream& Stream, float Radius, vec<3, float, Q>* Out, std::size_t Count)
+	{
+		std::size_t const Chunk = 64;
+		float x[Chunk], y[Chunk], z[Chunk];
+		for(std::size_t First = 0; First < Count; First += Chunk)
+		{
+			std::size_t const n = Count - First < Chunk ? Count - First : Chunk;
+			rand_batch<K>(Kernel, Stream, Radius, 0.0f, x, y, z, n);
+			for(std::size_t i = 0; i < n; ++i)
+				Out[First + i] = vec<3, float, Q>(x[i], y[i], z[i]);
+		}
+	}
+}//namespace detail
+
+	GLM_FUNC_QUALIFIER void linearRand(rand_stream& Stream, float Min, float Max, float* Out, std::size_t Count)
+	{
+		detail::rand_batch<detail::rand_batch_linear>(detail::rand_batch_default<detail::rand_batch_linear>(), Stream, Min, Max - Min, Out, GLM_NULLPTR, GLM_NULLPTR, Count);
+	}
+
+	template<length_t L, qualifier Q>
+	GLM_FUNC_QUALIFIER void linearRand(rand_stream& Stream, vec<L, float, Q> const& Min, vec<L, float, Q> const& Max, vec<L, float, Q>* Out, std::size_t Count)
+	{
+		detail::rand_batch_linear_vec(detail::rand_batch_default<detail::rand_batch_linear>(), Stream, Min, Max, Out, Count);
+	}
+
+	GLM_FUNC_QUALIFIER void gaussRand(rand_stream& Stream, float Mean, float Deviation, float* Out, std::size_t Count)
+	{
+		detail::rand_batch<detail::rand_batch_gauss>(detail::rand_batch_default<detail::rand_batch_gauss>(), Stream, Mean, Deviation * Deviation, Out, GLM_NULLPTR, GLM_NULLPTR, Count);
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void sphericalRand(rand_stream& Stream, float Radius, vec<3, float, Q>* Out, std::size_t Count)
+	{
+		detail::rand_batch_points<detail::rand_batch_sphere>(detail::rand_batch_default<detail::rand_batch_sphere>(), Stream, Radius, Out, Count);
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void ballRand(rand_stream& Stream, float Radius, vec<3, float, Q>* Out, std::size_t Count)
+	{
+		detail::rand_batch_points<detail::rand_batch_ball>(detail::rand_batch_default<detail::rand_batch_ball>(), Stream, Radius, Out, Count);
+	}
+
+	GLM_FUNC_QUALIFIER char const* randIsa()
+	{
+#		if GLM_ARCH & GLM_ARCH_AVX2_BIT
+			return "AVX2";
+#		elif GLM_ARCH & GLM_ARCH_SSE2_BIT
+			return "SSE2";
+#		else
+			return "scalar";
+#		endif
+	}
 }//namespace glm
@@ -0,0 +1,75 @@
+/// @ref gtx_exponential_batch
+/// @file glm/gtx/exponential_batch.hpp
+///
+/// @see core (dependence)
+///
+/// @defgroup gtx_exponential_batch GLM_GTX_exponential_batch
+/// @ingroup gtx
+///
+/// Include <glm/gtx/exponential_batch.hpp> to use the features of this extension.
+///
+/// exp, exp2, log, log2 and pow over spans of scalars. For float, the spans
+/// are processed 4 or 8 at a time with the SSE2 or AVX2 (with FMA)
+/// polynomials of glm/simd/exponential.h, whichever is the widest enabled by
+/// GLM_ARCH, and every element goes through the same kernel, the tail
+/// included; other types and configurations loop over the std:: functions.
+///
+/// The qualifier picks the accuracy: highp and mediump stay within 2 ULPs of
+/// libm, matching its zeros, infinities and NaNs, and lowp trades that for a
+/// relative error below 1e-4. glm::exp and friends on vec4 use the
+/// full-accuracy kernels whatever the vector's qualifier. Full-accuracy pow
+/// loops over std::pow unless AVX2 is enabled, as four lanes are slower than
+/// libm. GLM_GTX_simd_dispatch picks the kernels at run time instead.
+///
+/// Input and output may be the same array but must not partially overlap.
+
+#pragma once
+
+// Dependency:
+#include "../glm.hpp"
+#include <cstddef>
+
+#ifndef GLM_ENABLE_EXPERIMENTAL
+#	error "GLM: GLM_GTX_exponential_batch is an experimental extension and may change in the future. Use #define GLM_ENABLE_EXPERIMENTAL before including it, if you really want to use it."
+#elif GLM_MESSAGES == GLM_ENABLE && !defined(GLM_EXT_INCLUDED)
+#	pragma message("GLM: GLM_GTX_exponential_batch extension included")
+#endif
+
+namespace glm
+{
+	/// @addtogroup gtx_exponential_batch
+	/// @{
+
+	/// out[i] = exp(in[i]) for count values, expBatch<lowp> for the faster tier.
+	/// From GLM_GTX_exponential_batch extension.
+	template<qualifier Q = defaultp, typename T>
+	GLM_FUNC_DISCARD_DECL void expBatch(T const* in, T* out, std::size_t count);
+
+	/// out[i] = exp2(in[i]) for count values.
+	/// From GLM_GTX_exponential_batch extension.
+	template<qualifier Q = defaultp, typename T>
+	GLM_FUNC_DISCARD_DECL void exp2Batch(T const* in, T* out, std::size_t count);
+
+	/// out[i] = log(in[i]) for count values.
+	/// From GLM_GTX_exponential_batch extension.
+	template<qualifier Q = defaultp, typename T>
+	GLM_FUNC_DISCARD_DECL void logBatch(T const* in, T* out, std::size_t count);
+
+	/// out[i] = log2(in[i]) for count values.
+	/// From GLM_GTX_exponential_batch extension.
+	template<qualifier Q = defaultp, typename T>
+	GLM_FUNC_DISCARD_DECL void log2Batch(T const* in, T* out, std::size_t count);
+
+	/// out[i] = pow(base[i], exponent[i]) for count values.
+	/// From GLM_GTX_exponential_batch extension.
+	template<qualifier Q = defaultp, typename T>
+	GLM_FUNC_DISCARD_DECL void powBatch(T const* base, T const* exponent, T* out, std::size_t count);
+
+	/// Name of the instruction set the float spans use: "AVX2", "SSE2" or "scalar".
+	/// From GLM_GTX_exponential_batch extension.
+	GLM_FUNC_DECL char const* exponentialBatchIsa();
+
+	/// @}
+}//namespace glm
+
+#include "exponential_batch.inl"
@@ -0,0 +1,464 @@
+/// @ref gtx_exponential_batch
+
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+#	include "../simd/exponential.h"
+#endif
+
+namespace glm{
+namespace detail
+{
+	enum exponential_batch_kind
+	{
+		exponential_batch_exp,
+		exponential_batch_exp2,
+		exponential_batch_log,
+		exponential_batch_log2
+	};
+
+	// Reference path for any type, through the std:: functions.
+	template<exponential_batch_kind K, typename T>
+	GLM_FUNC_QUALIFIER void exponential_batch_scalar(T const* in, T* out, std::size_t first, std::size_t count)
+	{
+		for(std::size_t i = first; i < count; ++i)
+		{
+			if(K == exponential_batch_exp)
+				out[i] = std::exp(in[i]);
+			else if(K == exponential_batch_exp2)
+				out[i] = exp2(in[i]);
+			else if(K == exponential_batch_log)
+				out[i] = std::log(in[i]);
+			else
+				out[i] = log2(in[i]);
+		}
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void exponential_batch_scalar_pow(T const* base, T const* exponent, T* out, std::size_t first, std::size_t count)
+	{
+		for(std::size_t i = first; i < count; ++i)
+			out[i] = std::pow(base[i], exponent[i]);
+	}
+
+	// Unlike the transform_batch kernels, these handle the whole span: the
+	// last few elements are padded to a full register so that every element
+	// gets the same approximation. They still return the count handled, for
+	// the GLM_GTX_simd_dispatch table.
+#	if GLM_ARCH & GLM_ARCH_SSE2_BIT
+	struct exponential_batch_sse2
+	{
+		static std::size_t const width = 4;
+
+		template<exponential_batch_kind K, bool Lowp>
+		GLM_FUNC_QUALIFIER static __m128 apply(__m128 x)
+		{
+			if(K == exponential_batch_exp)
+				return Lowp ? glm_vec4_exp_lowp(x) : glm_vec4_exp(x);
+			if(K == exponential_batch_exp2)
+				return Lowp ? glm_vec4_exp2_lowp(x) : glm_vec4_exp2(x);
+			if(K == exponential_batch_log)
+				return Lowp ? glm_vec4_log_lowp(x) : glm_vec4_log(x);
+			return Lowp ? glm_vec4_log2_lowp(x) : glm_vec4_log2(x);
+		}
+
+		template<exponential_batch_kind K, bool Lowp>
+		GLM_FUNC_QUALIFIER static std::size_t unary(float const* in, float* out, std::size_t count)
+		{
+			std::size_t i = 0;
+			for(; i + width <= count; i += width)
+				_mm_storeu_ps(out + i, apply<K, Lowp>(_mm_loadu_ps(in + i)));
+			if(i < count)
+			{
+				std::size_t const Rest = count - i;
+				float Tail[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+				for(std::size_t j = 0; j < Rest && j < width; ++j)
+					Tail[j] = in[i + j];
+				_mm_storeu_ps(Tail, apply<K, Lowp>(_mm_loadu_ps(Tail)));
+				for(std::size_t j = 0; j < Rest && j < width; ++j)
+					out[i + j] = Tail[j];
+			}
+			return count;
+		}
+
+		// The full-accuracy pow is slower than libm four lanes wide, double
+		// precision and all, so it loops over std::pow here.
+		template<bool Lowp>
+		GLM_FUNC_QUALIFIER static std::size_t pow(float const* base, float const* exponent, float* out, std::size_t count)
+		{
+			if(!Lowp)
+			{
+				exponential_batch_scalar_pow(base, exponent, out, 0, count);
+				return count;
+			}
+			std::size_t i = 0;
+			for(; i + width <= count; i += width)
+			{
+				__m128 const x = _mm_loadu_ps(base + i), y = _mm_loadu_ps(exponent + i);
+				_mm_storeu_ps(out + i, Lowp ? glm_vec4_pow_lowp(x, y) : glm_vec4_pow(x, y));
+			}
+			if(i < count)
+			{
+				std::size_t const Rest = count - i;
+				float TailX[4] = {1.0f, 1.0f, 1.0f, 1.0f}, TailY[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+				for(std::size_t j = 0; j < Rest && j < width; ++j)
+				{
+					TailX[j] = base[i + j];
+					TailY[j] = exponent[i + j];
+				}
+				__m128 const x = _mm_loadu_ps(TailX), y = _mm_loadu_ps(TailY);
+				_mm_storeu_ps(TailX, Lowp ? glm_vec4_pow_lowp(x, y) : glm_vec4_pow(x, y));
+				for(std::size_t j = 0; j < Rest && j < width; ++j)
+					out[i + j] = TailX[j];
+			}
+			return count;
+		}
+	};
+#	endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
+
+	// The algorithms of glm/simd/exponential.h eight lanes wide, with FMA.
+#	if (GLM_ARCH & GLM_ARCH_AVX2_BIT) || (GLM_CONFIG_SIMD_DISPATCH == GLM_ENABLE)
+	struct exponential_batch_avx2
+	{
+		static std::size_t const width = 8;
+
+		GLM_TARGET_AVX2 GLM_FUNC_QUALIFIER static __m256 ldexp_normal(__m256 p, __m256i n)
+		{
+			__m256i const n1 = _mm256_srai_epi32(n, 1);
+			__m256i const n2 = _mm256_sub_epi32(n, n1);
+			__m256 const s1 = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(n1, _mm256_set1_epi32(127)), 23));
+			__m256 const s2 = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(n2, _mm256_set1_epi32(127)), 23));
+			return _mm256_mul_ps(_mm256_mul_ps(p, s1), s2);
+		}
+
+		// Denormal results from their bit pattern, as glm_vec4_ldexp.
+		GLM_TARGET_AVX2 GLM_FUNC_QUALIFIER static __m256 ldexp(__m256 p, __m256i n)
+		{
+			__m256i const Low = _mm256_set1_epi32(-125);
+			__m256i const Small = _mm256_cmpgt_epi32(Low, n);
+			if(_mm256_testz_si256(Small, Small))
+				return ldexp_normal(p, n);
+
+			__m256 const sd = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(_mm256_min_epi32(n, Low), _mm256_set1_epi32(149 + 127)), 23));
+			__m256 const d = _mm256_castsi256_ps(_mm256_cvtps_epi32(_mm256_mul_ps(p, sd)));
+			__m256 const Mask = _mm256_and_ps(_mm256_castsi256_ps(Small), _mm256_cmp_ps(p, p, _CMP_ORD_Q));
+			return _mm256_blendv_ps(ldexp_normal(p, _mm256_max_epi32(n, Low)), d, Mask);
+		}
+
+		template<bool Lowp>
+		GLM_TARGET_AVX2 GLM_FUNC_QUALIFIER static __m256 exp2(__m256 x)
+		{
+			__m256 const c = _mm256_max_ps(_mm256_set1_ps(-151.0f), _mm256_min_ps(_mm256_set1_ps(130.0f), x));
+			__m256i const n = _mm256_cvtps_epi32(c);
+			__m256 const f = _mm256_sub_ps(c, _mm256_cvtepi32_ps(n));
+			__m256 p;
+			if(Lowp)
+			{
+				p = _mm256_set1_ps(9.6567102885e-3f);
+				p = _mm256_fmadd_ps(p, f, _mm256_set1_ps(5.5838282946e-2f));
+				p = _mm256_fmadd_ps(p, f, _mm256_set1_ps(2.4022530097e-1f));
+				p = _mm256_fmadd_ps(p, f, _mm256_set1_ps(6.9313673388e-1f));
+			}
+			else
+			{
+				p = _mm256_set1_ps(1.535336188319500e-4f);
+				p = _mm256_fmadd_ps(p, f, _mm256_set1_ps(1.339887440266574e-3f));
+				p = _mm256_fmadd_ps(p, f, _mm256_set1_ps(9.618437357674640e-3f));
+				p = _mm256_fmadd_ps(p, f, _mm256_set1_ps(5.550332471162809e-2f));
+				p = _mm256_fmadd_ps(p, f, _mm256_set1_ps(2.402264791363012e-1f));
+				p = _mm256_fmadd_ps(p, f, _mm256_set1_ps(6.931472028550421e-1f));
+			}
+			return ldexp(_mm256_fmadd_ps(p, f, _mm256_set1_ps(1.0f)), n);
+		}
+
+		template<bool Lowp>
+		GLM_TARGET_AVX2 GLM_FUNC_QUALIFIER static __m256 exp(__m256 x)
+		{
+			if(Lowp)
+				return exp2<true>(_mm256_mul_ps(x, _mm256_set1_ps(1.44269504088896341f)));
+
+			__m256 const c = _mm256_max_ps(_mm256_set1_ps(-105.0f), _mm256_min_ps(_mm256_set1_ps(90.0f), x));
+			__m256i const n = _mm256_cvtps_epi32(_mm256_mul_ps(c, _mm256_set1_ps(1.44269504088896341f)));
+			__m256 const nf = _mm256_cvtepi32_ps(n);
+			__m256 r = _mm256_fnmadd_ps(nf, _mm256_set1_ps(0.693359375f), c);
+			r = _mm256_fnmadd_ps(nf, _mm256_set1_ps(-2.12194440e-4f), r);
+
+			__m256 p = _mm256_set1_ps(1.9875691500e-4f);
+			p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(1.3981999507e-3f));
+			p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(8.3334519073e-3f));
+			p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(4.1665795894e-2f));
+			p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(1.6666665459e-1f));
+			p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(5.0000001201e-1f));
+			p = _mm256_fmadd_ps(p, _mm256_mul_ps(r, r), _mm256_add_ps(r, _mm256_set1_ps(1.0f)));
+			return ldexp(p, n);
+		}
+
+		// See glm_vec4_log_reduce
+		GLM_TARGET_AVX2 GLM_FUNC_QUALIFIER static __m256 log_reduce(__m256 x, __m256& m)
+		{
+			__m256 const denormal = _mm256_cmp_ps(x, _mm256_set1_ps(1.17549435e-38f), _CMP_LT_OQ);
+			__m256 const scaled = _mm256_blendv_ps(x, _mm256_mul_ps(x, _mm256_set1_ps(33554432.0f)), denormal);
+			__m256i const bits = _mm256_sub_epi32(_mm256_castps_si256(scaled), _mm256_set1_epi32(0x3f3504f3));
+			__m256i const e = _mm256_sub_epi32(_mm256_srai_epi32(bits, 23), _mm256_and_si256(_mm256_castps_si256(denormal), _mm256_set1_epi32(25)));
+			m = _mm256_castsi256_ps(_mm256_add_epi32(_mm256_and_si256(bits, _mm256_set1_epi32(0x007fffff)), _mm256_set1_epi32(0x3f3504f3)));
+			return _mm256_cvtepi32_ps(e);
+		}
+
+		GLM_TARGET_AVX2 GLM_FUNC_QUALIFIER static __m256 log_special(__m256 x, __m256 r)
+		{
+			__m256 const zero = _mm256_setzero_ps();
+			__m256 const inf = _mm256_castsi256_ps(_mm256_set1_epi32(0x7f800000));
+			r = _mm256_blendv_ps(r, _mm256_sub_ps(zero, inf), _mm256_cmp_ps(x, zero, _CMP_EQ_OQ));
+			r = _mm256_blendv_ps(r, inf, _mm256_cmp_ps(x, inf, _CMP_EQ_OQ));
+			return _mm256_or_ps(r, _mm256_cmp_ps(x, zero, _CMP_NGE_UQ));
+		}
+
+		template<bool Lowp>
+		GLM_TARGET_AVX2 GLM_FUNC_QUALIFIER static __m256 log2(__m256 x)
+		{
+			__m256 m;
+			__m256 const e = log_reduce(x, m);
+			__m256 const one = _mm256_set1_ps(1.0f);
+			if(Lowp)
+			{
+				__m256 const s = _mm256_div_ps(_mm256_sub_ps(m, one), _mm256_add_ps(m, one));
+				__m256 const s2 = _mm256_mul_ps(s, s);
+				__m256 p = _mm256_fmadd_ps(s2, _mm256_set1_ps(5.9575960690e-1f), _mm256_set1_ps(9.6158894669e-1f));
+				p = _mm256_fmadd_ps(s2, p, _mm256_set1_ps(2.8853904220f));
+				return log_special(x, _mm256_fmadd_ps(s, p, e));
+			}
+
+			__m256 const t = _mm256_sub_ps(m, one);
+			__m256 const t2 = _mm256_mul_ps(t, t);
+			__m256 const y = _mm256_fmadd_ps(t2, _mm256_set1_ps(-0.5f), log_poly(t, t2));
+			__m256 const Log2eMinusOne = _mm256_set1_ps(0.44269504088896340736f);
+			__m256 r = _mm256_fmadd_ps(y, Log2eMinusOne, _mm256_fmadd_ps(t, Log2eMinusOne, y));
+			r = _mm256_add_ps(_mm256_add_ps(r, t), e);
+			return log_special(x, r);
+		}
+
+		template<bool Lowp>
+		GLM_TARGET_AVX2 GLM_FUNC_QUALIFIER static __m256 log(__m256 x)
+		{
+			if(Lowp)
+				return _mm256_mul_ps(log2<true>(x), _mm256_set1_ps(0.69314718055994531f));
+
+			__m256 m;
+			__m256 const e = log_reduce(x, m);
+			__m256 const t = _mm256_sub_ps(m, _mm256_set1_ps(1.0f));
+			__m256 const t2 = _mm256_mul_ps(t, t);
+			__m256 y = log_poly(t, t2);
+			y = _mm256_fmadd_ps(e, _mm256_set1_ps(-2.12194440e-4f), y);
+			y = _mm256_fmadd_ps(t2, _mm256_set1_ps(-0.5f), y);
+			return log_special(x, _mm256_fmadd_ps(e, _mm256_set1_ps(0.693359375f), _mm256_add_ps(t, y)));
+		}
+
+		GLM_TARGET_AVX2 GLM_FUNC_QUALIFIER static __m256 log_poly(__m256 t, __m256 t2)
+		{
+			__m256 p = _mm256_set1_ps(7.0376836292e-2f);
+			p = _mm256_fmadd_ps(p, t, _mm256_set1_ps(-1.1514610310e-1f));
+			p = _mm256_fmadd_ps(p, t, _mm256_set1_ps(1.1676998740e-1f));
+			p = _mm256_fmadd_ps(p, t, _mm256_set1_ps(-1.2420140846e-1f));
+			p = _mm256_fmadd_ps(p, t, _mm256_set1_ps(1.4249322787e-1f));
+			p = _mm256_fmadd_ps(p, t, _mm256_set1_ps(-1.6668057665e-1f));
+			p = _mm256_fmadd_ps(p, t, _mm256_set1_ps(2.0000714765e-1f));
+			p = _mm256_fmadd_ps(p, t, _mm256_set1_ps(-2.4999993993e-1f));
+			p = _mm256_fmadd_ps(p, t, _mm256_set1_ps(3.3333331174e-1f));
+			return _mm256_mul_ps(_mm256_mul_ps(p, t), t2);
+		}
+
+		// See glm_vec4_pow_special
+		GLM_TARGET_AVX2 GLM_FUNC_QUALIFIER static __m256 pow_special(__m256 x, __m256 y, __m256 r)
+		{
+			__m256 const zero = _mm256_setzero_ps();
+			__m256 const one = _mm256_set1_ps(1.0f);
+			__m256 const inf = _mm256_castsi256_ps(_mm256_set1_epi32(0x7f800000));
+			__m256 const absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+			__m256 const ax = _mm256_and_ps(x, absMask);
+			__m256 const ay = _mm256_and_ps(y, absMask);
+
+			__m256i const iy = _mm256_cvttps_epi32(y);
+			__m256 const integer = _mm256_or_ps(_mm256_cmp_ps(ay, _mm256_set1_ps(8388608.0f), _CMP_GE_OQ), _mm256_cmp_ps(_mm256_cvtepi32_ps(iy), y, _CMP_EQ_OQ));
+			__m256 const odd = _mm256_and_ps(_mm256_and_ps(integer, _mm256_cmp_ps(ay, _mm256_set1_ps(16777216.0f), _CMP_LT_OQ)),
+				_mm256_castsi256_ps(_mm256_slli_epi32(iy, 31)));
+			__m256 const yNegative = _mm256_cmp_ps(y, zero, _CMP_LT_OQ);
+
+			r = _mm256_blendv_ps(r, _mm256_and_ps(yNegative, inf), _mm256_cmp_ps(ax, zero, _CMP_EQ_OQ));
+			r = _mm256_blendv_ps(r, _mm256_andnot_ps(yNegative, inf), _mm256_cmp_ps(ax, inf, _CMP_EQ_OQ));
+			r = _mm256_blendv_ps(r, one, _mm256_cmp_ps(ax, one, _CMP_EQ_OQ));
+			r = _mm256_xor_ps(r, _mm256_and_ps(_mm256_and_ps(x, odd), _mm256_set1_ps(-0.0f)));
+			r = _mm256_or_ps(r, _mm256_andnot_ps(integer, _mm256_and_ps(_mm256_cmp_ps(x, zero, _CMP_LT_OQ), _mm256_cmp_ps(x, _mm256_sub_ps(zero, inf), _CMP_GT_OQ))));
+			r = _mm256_or_ps(r, _mm256_cmp_ps(x, y, _CMP_UNORD_Q));
+			return _mm256_blendv_ps(r, one, _mm256_or_ps(_mm256_cmp_ps(y, zero, _CMP_EQ_OQ), _mm256_cmp_ps(x, one, _CMP_EQ_OQ)));
+		}
+
+		// See glm_vec2_pow_f64
+		GLM_TARGET_AVX2 GLM_FUNC_QUALIFIER static __m128 pow_f64(__m128 m, __m128 e, __m128 y)
+		{
+			__m256d const one = _mm256_set1_pd(1.0);
+			__m256d const md = _mm256_cvtps_pd(m);
+			__m256d const s = _mm256_div_pd(_mm256_sub_pd(md, one), _mm256_add_pd(md, one));
+			__m256d const s2 = _mm256_mul_pd(s, s);
+			__m256d p = _mm256_set1_pd(3.4071204157e-1);
+			p = _mm256_fmadd_pd(p, s2, _mm256_set1_pd(4.1167376624e-1));
+			p = _mm256_fmadd_pd(p, s2, _mm256_set1_pd(5.7708356600e-1));
+			p = _mm256_fmadd_pd(p, s2, _mm256_set1_pd(9.6179667345e-1));
+			p = _mm256_fmadd_pd(p, s2, _mm256_set1_pd(2.8853900818));
+			__m256d t = _mm256_mul_pd(_mm256_cvtps_pd(y), _mm256_fmadd_pd(s, p, _mm256_cvtps_pd(e)));
+			t = _mm256_max_pd(_mm256_set1_pd(-160.0), _mm256_min_pd(_mm256_set1_pd(160.0), t));
+
+			__m128i const n = _mm256_cvtpd_epi32(t);
+			__m256d const f = _mm256_sub_pd(t, _mm256_cvtepi32_pd(n));
+			__m256d q = _mm256_set1_pd(1.3250805518e-6);
+			q = _mm256_fmadd_pd(q, f, _mm256_set1_pd(1.5303700711e-5));
+			q = _mm256_fmadd_pd(q, f, _mm256_set1_pd(1.5403475187e-4));
+			q = _mm256_fmadd_pd(q, f, _mm256_set1_pd(1.3333478474e-3));
+			q = _mm256_fmadd_pd(q, f, _mm256_set1_pd(9.6181291352e-3));
+			q = _mm256_fmadd_pd(q, f, _mm256_set1_pd(5.5504109063e-2));
+			q = _mm256_fmadd_pd(q, f, _mm256_set1_pd(2.4022650696e-1));
+			q = _mm256_fmadd_pd(q, f, _mm256_set1_pd(6.9314718056e-1));
+			q = _mm256_fmadd_pd(q, f, one);
+			__m256i const bits = _mm256_slli_epi64(_mm256_cvtepi32_epi64(_mm_add_epi32(n, _mm_set1_epi32(1023))), 52);
+			return _mm256_cvtpd_ps(_mm256_mul_pd(q, _mm256_castsi256_pd(bits)));
+		}
+
+		template<bool Lowp>
+		GLM_TARGET_AVX2 GLM_FUNC_QUALIFIER static __m256 pow(__m256 x, __m256 y)
+		{
+			__m256 const ax = _mm256_and_ps(x, _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff)));
+			if(Lowp)
+				return pow_special(x, y, exp2<true>(_mm256_mul_ps(y, log2<true>(ax))));
+
+			__m256 m;
+			__m256 const e = log_reduce(ax, m);
+			__m128 const lo = pow_f64(_mm256_castps256_ps128(m), _mm256_castps256_ps128(e), _mm256_castps256_ps128(y));
+			__m128 const hi = pow_f64(_mm256_extractf128_ps(m, 1), _mm256_extractf128_ps(e, 1), _mm256_extractf128_ps(y, 1));
+			return pow_special(x, y, _mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1));
+		}
+
+		template<exponential_batch_kind K, bool Lowp>
+		GLM_TARGET_AVX2 GLM_FUNC_QUALIFIER static __m256 apply(__m256 x)
+		{
+			if(K == exponential_batch_exp)
+				return exp<Lowp>(x);
+			if(K == exponential_batch_exp2)
+				return exp2<Lowp>(x);
+			if(K == exponential_batch_log)
+				return log<Lowp>(x);
+			return log2<Lowp>(x);
+		}
+
+		// Lanes below remaining; the tail is read and written with masks.
+		GLM_TARGET_AVX2 GLM_FUNC_QUALIFIER static __m256i tail_mask(std::size_t remaining)
+		{
+			return _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(remaining)), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+		}
+
+		template<exponential_batch_kind K, bool Lowp>
+		GLM_TARGET_AVX2 GLM_FUNC_QUALIFIER static std::size_t unary(float const* in, float* out, std::size_t count)
+		{
+			std::size_t i = 0;
+			for(; i + width <= count; i += width)
+				_mm256_storeu_ps(out + i, apply<K, Lowp>(_mm256_loadu_ps(in + i)));
+			if(i < count)
+			{
+				__m256i const mask = tail_mask(count - i);
+				_mm256_maskstore_ps(out + i, mask, apply<K, Lowp>(_mm256_maskload_ps(in + i, mask)));
+			}
+			return count;
+		}
+
+		template<bool Lowp>
+		GLM_TARGET_AVX2 GLM_FUNC_QUALIFIER static std::size_t pow(float const* base, float const* exponent, float* out, std::size_t count)
+		{
+			std::size_t i = 0;
+			for(; i + width <= count; i += width)
+				_mm256_storeu_ps(out + i, pow<Lowp>(_mm256_loadu_ps(base + i), _mm256_loadu_ps(exponent + i)));
+			if(i < count)
+			{
+				__m256i const mask = tail_mask(count - i);
+				_mm256_maskstore_ps(out + i, mask, pow<Lowp>(_mm256_maskload_ps(base + i, mask), _mm256_maskload_ps(exponent + i, mask)));
+			}
+			return count;
+		}
+	};
+#	endif
+
+#	if GLM_ARCH & GLM_ARCH_AVX2_BIT
+	typedef exponential_batch_avx2 exponential_batch_simd;
+#	elif GLM_ARCH & GLM_ARCH_SSE2_BIT
+	typedef exponential_batch_sse2 exponential_batch_simd;
+#	endif
+
+	template<typename T, qualifier Q>
+	struct compute_exponential_batch
+	{
+		template<exponential_batch_kind K>
+		GLM_FUNC_QUALIFIER static void unary(T const* in, T* out, std::size_t count)
+		{
+			exponential_batch_scalar<K>(in, out, 0, count);
+		}
+
+		GLM_FUNC_QUALIFIER static void pow(T const* base, T const* exponent, T* out, std::size_t count)
+		{
+			exponential_batch_scalar_pow(base, exponent, out, 0, count);
+		}
+	};
+
+#	if GLM_ARCH & GLM_ARCH_SSE2_BIT
+	template<qualifier Q>
+	struct compute_exponential_batch<float, Q>
+	{
+		template<exponential_batch_kind K>
+		GLM_FUNC_QUALIFIER static void unary(float const* in, float* out, std::size_t count)
+		{
+			exponential_batch_simd::unary<K, exponential_lowp<Q>::value>(in, out, count);
+		}
+
+		GLM_FUNC_QUALIFIER static void pow(float const* base, float const* exponent, float* out, std::size_t count)
+		{
+			exponential_batch_simd::pow<exponential_lowp<Q>::value>(base, exponent, out, count);
+		}
+	};
+#	endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
+}//namespace detail
+
+	template<qualifier Q, typename T>
+	GLM_FUNC_QUALIFIER void expBatch(T const* in, T* out, std::size_t count)
+	{
+		detail::compute_exponential_batch<T, Q>::template unary<detail::exponential_batch_exp>(in, out, count);
+	}
+
+	template<qualifier Q, typename T>
+	GLM_FUNC_QUALIFIER void exp2Batch(T const* in, T* out, std::size_t count)
+	{
+		detail::compute_exponential_batch<T, Q>::template unary<detail::exponential_batch_exp2>(in, out, count);
+	}
+
+	template<qualifier Q, typename T>
+	GLM_FUNC_QUALIFIER void logBatch(T const* in, T* out, std::size_t count)
+	{
+		detail::compute_exponential_batch<T, Q>::template unary<detail::exponential_batch_log>(in, out, count);
+	}
+
+	template<qualifier Q, typename T>
+	GLM_FUNC_QUALIFIER void log2Batch(T const* in, T* out, std::size_t count)
+	{
+		detail::compute_exponential_batch<T, Q>::template unary<detail::exponential_batch_log2>(in, out, count);
+	}
+
+	template<qualifier Q, typename T>
+	GLM_FUNC_QUALIFIER void powBatch(T const* base, T const* exponent, T* out, std::size_t count)
+	{
+		detail::compute_exponential_batch<T, Q>::pow(base, exponent, out, count);
+	}
+
+	GLM_FUNC_QUALIFIER char const* exponentialBatchIsa()
+	{
+#		if GLM_ARCH & GLM_ARCH_AVX2_BIT
+			return "AVX2";
+#		elif GLM_ARCH & GLM_ARCH_SSE2_BIT
+			return "SSE2";
+#		else
+			return "scalar";
+#		endif
+	}
+}//namespace glm
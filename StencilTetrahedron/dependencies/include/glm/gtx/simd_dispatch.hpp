@@ -0,0 +1,237 @@
+/// @ref gtx_simd_dispatch
+/// @file glm/gtx/simd_dispatch.hpp
+///
+/// @see core (dependence)
+/// @see gtx_transform_batch (dependence)
+/// @see gtx_exponential_batch (dependence)
+/// @see gtc_packing (dependence)
+/// @see gtc_noise (dependence)
+/// @see gtc_random (dependence)
+/// @see gtc_bitfield (dependence)
+///
+/// @defgroup gtx_simd_dispatch GLM_GTX_simd_dispatch
+/// @ingroup gtx
+///
+/// Include <glm/gtx/simd_dispatch.hpp> to use the features of this extension.
+///
+/// Span kernels chosen at run time. GLM_ARCH fixes the instruction set when
+/// the program is compiled, so a baseline SSE2 build never runs AVX2 even on
+/// CPUs that have it. The functions here check CPUID once, on first use, and
+/// call the widest kernels the CPU supports: AVX-512, AVX2 with FMA, or SSE2
+/// (the exponential, half, noise and random kernels stop at AVX2). Morton
+/// codes take PDEP and PEXT from BMI2 where they are fast, AVX2 shifts
+/// where they are not, and scalar shifts below AVX2.
+/// The wider kernels are compiled with per-function target attributes (GCC,
+/// Clang) or plain intrinsics (MSVC), so no part of the build needs /arch or
+/// -m flags above the baseline, and no inline GLM function is compiled for
+/// two instruction sets.
+///
+/// x86 builds with GLM_FORCE_INTRINSICS only (GLM_CONFIG_SIMD_DISPATCH);
+/// elsewhere every function here runs the scalar code.
+
+#pragma once
+
+// Dependency:
+#include "../glm.hpp"
+#include "transform_batch.hpp"
+#include "exponential_batch.hpp"
+#include "../gtc/packing.hpp"
+#include "../gtc/noise.hpp"
+#include "../gtc/random.hpp"
+#include "../gtc/bitfield.hpp"
+#include <cstddef>
+
+#ifndef GLM_ENABLE_EXPERIMENTAL
+#	error "GLM: GLM_GTX_simd_dispatch is an experimental extension and may change in the future. Use #define GLM_ENABLE_EXPERIMENTAL before including it, if you really want to use it."
+#elif GLM_MESSAGES == GLM_ENABLE && !defined(GLM_EXT_INCLUDED)
+#	pragma message("GLM: GLM_GTX_simd_dispatch extension included")
+#endif
+
+namespace glm
+{
+	/// @addtogroup gtx_simd_dispatch
+	/// @{
+
+	/// Instruction sets the dispatched kernels come in, narrowest first.
+	enum simd_isa
+	{
+		simd_scalar,
+		simd_sse2,
+		simd_avx2,		// with FMA and F16C
+		simd_avx512		// AVX-512F, with AVX2, FMA and F16C
+	};
+
+	/// Widest simd_isa this CPU and operating system support, from CPUID.
+	/// From GLM_GTX_simd_dispatch extension.
+	GLM_FUNC_DECL simd_isa simdSupportedIsa();
+
+	/// Instruction set the dispatched kernels use: simdSupportedIsa() unless
+	/// simdDispatchSelect changed it.
+	/// From GLM_GTX_simd_dispatch extension.
+	GLM_FUNC_DECL simd_isa simdDispatchIsa();
+
+	/// Switches the dispatched kernels to isa, for tests and benchmarks. Returns
+	/// false and changes nothing if the CPU lacks isa. Not thread safe: call it
+	/// while no dispatched kernel runs.
+	/// From GLM_GTX_simd_dispatch extension.
+	GLM_FUNC_DISCARD_DECL bool simdDispatchSelect(simd_isa isa);
+
+	/// "AVX-512", "AVX2", "SSE2" or "scalar".
+	/// From GLM_GTX_simd_dispatch extension.
+	GLM_FUNC_DECL char const* simdIsaName(simd_isa isa);
+
+	/// transformPositions through the dispatched kernels.
+	/// From GLM_GTX_simd_dispatch extension.
+	template<qualifier Q>
+	GLM_FUNC_DISCARD_DECL void dispatchTransformPositions(mat<4, 4, float, Q> const& m, vec<3, float, Q> const* in, vec<3, float, Q>* out, std::size_t count);
+
+	/// transformDirections through the dispatched kernels.
+	/// From GLM_GTX_simd_dispatch extension.
+	template<qualifier Q>
+	GLM_FUNC_DISCARD_DECL void dispatchTransformDirections(mat<4, 4, float, Q> const& m, vec<3, float, Q> const* in, vec<3, float, Q>* out, std::size_t count);
+
+	/// transformProjective through the dispatched kernels.
+	/// From GLM_GTX_simd_dispatch extension.
+	template<qualifier Q>
+	GLM_FUNC_DISCARD_DECL void dispatchTransformProjective(mat<4, 4, float, Q> const& m, vec<3, float, Q> const* in, vec<3, float, Q>* out, std::size_t count);
+
+	/// transformVectors through the dispatched kernels.
+	/// From GLM_GTX_simd_dispatch extension.
+	template<qualifier Q>
+	GLM_FUNC_DISCARD_DECL void dispatchTransformVectors(mat<4, 4, float, Q> const& m, vec<4, float, Q> const* in, vec<4, float, Q>* out, std::size_t count);
+
+	/// SoA transformPositions through the dispatched kernels.
+	/// From GLM_GTX_simd_dispatch extension.
+	template<qualifier Q>
+	GLM_FUNC_DISCARD_DECL void dispatchTransformPositions(mat<4, 4, float, Q> const& m, float const* x, float const* y, float const* z, float* outX, float* outY, float* outZ, std::size_t count);
+
+	/// SoA transformDirections through the dispatched kernels.
+	/// From GLM_GTX_simd_dispatch extension.
+	template<qualifier Q>
+	GLM_FUNC_DISCARD_DECL void dispatchTransformDirections(mat<4, 4, float, Q> const& m, float const* x, float const* y, float const* z, float* outX, float* outY, float* outZ, std::size_t count);
+
+	/// SoA transformProjective through the dispatched kernels.
+	/// From GLM_GTX_simd_dispatch extension.
+	template<qualifier Q>
+	GLM_FUNC_DISCARD_DECL void dispatchTransformProjective(mat<4, 4, float, Q> const& m, float const* x, float const* y, float const* z, float* outX, float* outY, float* outZ, std::size_t count);
+
+	/// out[i] = a[i] * b[i] for count matrices. out may be a or b.
+	/// From GLM_GTX_simd_dispatch extension.
+	template<qualifier Q>
+	GLM_FUNC_DISCARD_DECL void dispatchMultiply(mat<4, 4, float, Q> const* a, mat<4, 4, float, Q> const* b, mat<4, 4, float, Q>* out, std::size_t count);
+
+	/// out[i] = inverse(in[i]) for count matrices. out may be in.
+	/// From GLM_GTX_simd_dispatch extension.
+	template<qualifier Q>
+	GLM_FUNC_DISCARD_DECL void dispatchInverse(mat<4, 4, float, Q> const* in, mat<4, 4, float, Q>* out, std::size_t count);
+
+	/// expBatch through the dispatched kernels, dispatchExp<lowp> for the faster tier.
+	/// From GLM_GTX_simd_dispatch extension.
+	template<qualifier Q = defaultp>
+	GLM_FUNC_DISCARD_DECL void dispatchExp(float const* in, float* out, std::size_t count);
+
+	/// exp2Batch through the dispatched kernels.
+	/// From GLM_GTX_simd_dispatch extension.
+	template<qualifier Q = defaultp>
+	GLM_FUNC_DISCARD_DECL void dispatchExp2(float const* in, float* out, std::size_t count);
+
+	/// logBatch through the dispatched kernels.
+	/// From GLM_GTX_simd_dispatch extension.
+	template<qualifier Q = defaultp>
+	GLM_FUNC_DISCARD_DECL void dispatchLog(float const* in, float* out, std::size_t count);
+
+	/// log2Batch through the dispatched kernels.
+	/// From GLM_GTX_simd_dispatch extension.
+	template<qualifier Q = defaultp>
+	GLM_FUNC_DISCARD_DECL void dispatchLog2(float const* in, float* out, std::size_t count);
+
+	/// powBatch through the dispatched kernels.
+	/// From GLM_GTX_simd_dispatch extension.
+	template<qualifier Q = defaultp>
+	GLM_FUNC_DISCARD_DECL void dispatchPow(float const* base, float const* exponent, float* out, std::size_t count);
+
+	/// packHalf through the dispatched kernels: F16C from simd_avx2 up.
+	/// From GLM_GTX_simd_dispatch extension.
+	GLM_FUNC_DISCARD_DECL void dispatchPackHalf(float const* in, uint16* out, std::size_t count);
+
+	/// unpackHalf through the dispatched kernels.
+	/// From GLM_GTX_simd_dispatch extension.
+	GLM_FUNC_DISCARD_DECL void dispatchUnpackHalf(uint16 const* in, float* out, std::size_t count);
+
+	/// 2D perlin spans through the dispatched kernels, equal to perlin at every level.
+	/// From GLM_GTX_simd_dispatch extension.
+	GLM_FUNC_DISCARD_DECL void dispatchPerlin(float const* x, float const* y, float* out, std::size_t count);
+
+	/// 3D perlin spans through the dispatched kernels.
+	/// From GLM_GTX_simd_dispatch extension.
+	GLM_FUNC_DISCARD_DECL void dispatchPerlin(float const* x, float const* y, float const* z, float* out, std::size_t count);
+
+	/// 2D simplex spans through the dispatched kernels.
+	/// From GLM_GTX_simd_dispatch extension.
+	GLM_FUNC_DISCARD_DECL void dispatchSimplex(float const* x, float const* y, float* out, std::size_t count);
+
+	/// 3D simplex spans through the dispatched kernels.
+	/// From GLM_GTX_simd_dispatch extension.
+	GLM_FUNC_DISCARD_DECL void dispatchSimplex(float const* x, float const* y, float const* z, float* out, std::size_t count);
+
+	/// perlinGrid through the dispatched kernels.
+	/// From GLM_GTX_simd_dispatch extension.
+	template<qualifier Q>
+	GLM_FUNC_DISCARD_DECL void dispatchPerlinGrid(vec<2, float, Q> const& origin, vec<2, float, Q> const& step, vec<2, uint, Q> const& first, vec<2, uint, Q> const& size, float* out);
+
+	/// perlinGrid through the dispatched kernels.
+	/// From GLM_GTX_simd_dispatch extension.
+	template<qualifier Q>
+	GLM_FUNC_DISCARD_DECL void dispatchPerlinGrid(vec<3, float, Q> const& origin, vec<3, float, Q> const& step, vec<3, uint, Q> const& first, vec<3, uint, Q> const& size, float* out);
+
+	/// simplexGrid through the dispatched kernels.
+	/// From GLM_GTX_simd_dispatch extension.
+	template<qualifier Q>
+	GLM_FUNC_DISCARD_DECL void dispatchSimplexGrid(vec<2, float, Q> const& origin, vec<2, float, Q> const& step, vec<2, uint, Q> const& first, vec<2, uint, Q> const& size, float* out);
+
+	/// simplexGrid through the dispatched kernels.
+	/// From GLM_GTX_simd_dispatch extension.
+	template<qualifier Q>
+	GLM_FUNC_DISCARD_DECL void dispatchSimplexGrid(vec<3, float, Q> const& origin, vec<3, float, Q> const& step, vec<3, uint, Q> const& first, vec<3, uint, Q> const& size, float* out);
+
+	/// linearRand spans through the dispatched kernels, equal to linearRand at every level.
+	/// From GLM_GTX_simd_dispatch extension.
+	GLM_FUNC_DISCARD_DECL void dispatchLinearRand(rand_stream& Stream, float Min, float Max, float* Out, std::size_t Count);
+
+	/// linearRand vector spans through the dispatched kernels.
+	/// From GLM_GTX_simd_dispatch extension.
+	template<length_t L, qualifier Q>
+	GLM_FUNC_DISCARD_DECL void dispatchLinearRand(rand_stream& Stream, vec<L, float, Q> const& Min, vec<L, float, Q> const& Max, vec<L, float, Q>* Out, std::size_t Count);
+
+	/// gaussRand spans through the dispatched kernels, scaled by Deviation squared as well.
+	/// From GLM_GTX_simd_dispatch extension.
+	GLM_FUNC_DISCARD_DECL void dispatchGaussRand(rand_stream& Stream, float Mean, float Deviation, float* Out, std::size_t Count);
+
+	/// sphericalRand spans through the dispatched kernels.
+	/// From GLM_GTX_simd_dispatch extension.
+	template<qualifier Q>
+	GLM_FUNC_DISCARD_DECL void dispatchSphericalRand(rand_stream& Stream, float Radius, vec<3, float, Q>* Out, std::size_t Count);
+
+	/// ballRand spans through the dispatched kernels.
+	/// From GLM_GTX_simd_dispatch extension.
+	template<qualifier Q>
+	GLM_FUNC_DISCARD_DECL void dispatchBallRand(rand_stream& Stream, float Radius, vec<3, float, Q>* Out, std::size_t Count);
+
+	/// bitfieldInterleave spans of uvec3 through the dispatched kernels.
+	/// From GLM_GTX_simd_dispatch extension.
+	template<qualifier Q>
+	GLM_FUNC_DISCARD_DECL void dispatchBitfieldInterleave(vec<3, uint32, Q> const* In, uint64* Out, std::size_t Count);
+
+	/// bitfieldDeinterleave spans of uvec3 through the dispatched kernels.
+	/// From GLM_GTX_simd_dispatch extension.
+	template<qualifier Q>
+	GLM_FUNC_DISCARD_DECL void dispatchBitfieldDeinterleave(uint64 const* In, vec<3, uint32, Q>* Out, std::size_t Count);
+
+	/// Instructions the dispatched Morton kernels use: "BMI2", "AVX2" or "scalar".
+	/// From GLM_GTX_simd_dispatch extension.
+	GLM_FUNC_DECL char const* dispatchBitfieldIsa();
+
+	/// @}
+}//namespace glm
+
+#include "simd_dispatch.inl"
@@ -0,0 +1,728 @@
+/// @ref gtx_simd_dispatch
+
+#if GLM_CONFIG_SIMD_DISPATCH == GLM_ENABLE
+#	include "../simd/matrix.h"
+#	if GLM_COMPILER & GLM_COMPILER_VC
+#		include <intrin.h>
+#	endif
+#endif
+
+namespace glm{
+namespace detail
+{
+	// Like the transform_batch kernels, the span kernels work on raw
+	// column-major floats and return how many elements they handled; the
+	// dispatching function finishes the rest with the scalar code.
+	struct simd_dispatch_table
+	{
+		simd_isa isa;
+		std::size_t (*positions)(float const* m, float const* in, float* out, std::size_t count);
+		std::size_t (*directions)(float const* m, float const* in, float* out, std::size_t count);
+		std::size_t (*projective)(float const* m, float const* in, float* out, std::size_t count);
+		std::size_t (*positionsSoA)(float const* m, float const* x, float const* y, float const* z, float* outX, float* outY, float* outZ, std::size_t count);
+		std::size_t (*directionsSoA)(float const* m, float const* x, float const* y, float const* z, float* outX, float* outY, float* outZ, std::size_t count);
+		std::size_t (*projectiveSoA)(float const* m, float const* x, float const* y, float const* z, float* outX, float* outY, float* outZ, std::size_t count);
+		std::size_t (*vectors)(float const* m, float const* in, float* out, std::size_t count);
+		std::size_t (*multiply)(float const* a, float const* b, float* out, std::size_t count);
+		std::size_t (*inverse)(float const* in, float* out, std::size_t count);
+		std::size_t (*exponential[2][4])(float const* in, float* out, std::size_t count);	// [lowp][exponential_batch_kind]
+		std::size_t (*pow[2])(float const* base, float const* exponent, float* out, std::size_t count);	// [lowp]
+		std::size_t (*packHalf)(float const* in, uint16* out, std::size_t count);
+		std::size_t (*unpackHalf)(uint16 const* in, float* out, std::size_t count);
+		std::size_t (*noise[2][2])(float const* x, float const* y, float const* z, float* out, std::size_t count);	// [noise_batch_kind][dimensions - 2]
+		std::size_t (*noiseGrid[2][2])(float const* origin, float const* step, unsigned int const* first, unsigned int const* size, float* out);
+		rand_batch_kernel random[4];	// [rand_batch_kind]
+		bitfield_interleave_kernel interleave;		// Morton codes of packed uvec3
+		bitfield_deinterleave_kernel deinterleave;
+	};
+
+	// Handles nothing, so everything goes to the scalar code.
+	struct simd_dispatch_scalar
+	{
+		template<transform_batch_kind K>
+		GLM_FUNC_QUALIFIER static std::size_t aos3(float const*, float const*, float*, std::size_t)
+		{
+			return 0;
+		}
+
+		template<transform_batch_kind K>
+		GLM_FUNC_QUALIFIER static std::size_t soa3(float const*, float const*, float const*, float const*, float*, float*, float*, std::size_t)
+		{
+			return 0;
+		}
+
+		GLM_FUNC_QUALIFIER static std::size_t aos4(float const*, float const*, float*, std::size_t)
+		{
+			return 0;
+		}
+
+		GLM_FUNC_QUALIFIER static std::size_t multiply(float const*, float const*, float*, std::size_t)
+		{
+			return 0;
+		}
+
+		GLM_FUNC_QUALIFIER static std::size_t inverse(float const*, float*, std::size_t)
+		{
+			return 0;
+		}
+
+		template<exponential_batch_kind K, bool Lowp>
+		GLM_FUNC_QUALIFIER static std::size_t unary(float const*, float*, std::size_t)
+		{
+			return 0;
+		}
+
+		template<bool Lowp>
+		GLM_FUNC_QUALIFIER static std::size_t pow(float const*, float const*, float*, std::size_t)
+		{
+			return 0;
+		}
+
+		GLM_FUNC_QUALIFIER static std::size_t pack(float const*, uint16*, std::size_t)
+		{
+			return 0;
+		}
+
+		GLM_FUNC_QUALIFIER static std::size_t unpack(uint16 const*, float*, std::size_t)
+		{
+			return 0;
+		}
+
+		template<noise_batch_kind K, length_t L>
+		GLM_FUNC_QUALIFIER static std::size_t span(float const*, float const*, float const*, float*, std::size_t)
+		{
+			return 0;
+		}
+
+		template<noise_batch_kind K, length_t L>
+		GLM_FUNC_QUALIFIER static std::size_t grid(float const*, float const*, unsigned int const*, unsigned int const*, float*)
+		{
+			return 0;
+		}
+
+		template<rand_batch_kind K>
+		GLM_FUNC_QUALIFIER static std::size_t span(uint32 const*, uint32 const*, uint64, float, float, float*, float*, float*, std::size_t)
+		{
+			return 0;
+		}
+
+		GLM_FUNC_QUALIFIER static std::size_t interleave(uint32 const*, uint64*, std::size_t)
+		{
+			return 0;
+		}
+
+		GLM_FUNC_QUALIFIER static std::size_t deinterleave(uint64 const*, uint32*, std::size_t)
+		{
+			return 0;
+		}
+	};
+
+#	if GLM_CONFIG_SIMD_DISPATCH == GLM_ENABLE
+	// One matrix at a time through the SSE2 code the mat4 operators use.
+	struct simd_dispatch_sse2
+	{
+		GLM_FUNC_QUALIFIER static void load(float const* p, glm_vec4 m[4])
+		{
+			m[0] = _mm_loadu_ps(p);
+			m[1] = _mm_loadu_ps(p + 4);
+			m[2] = _mm_loadu_ps(p + 8);
+			m[3] = _mm_loadu_ps(p + 12);
+		}
+
+		GLM_FUNC_QUALIFIER static void store(glm_vec4 const m[4], float* p)
+		{
+			_mm_storeu_ps(p, m[0]);
+			_mm_storeu_ps(p + 4, m[1]);
+			_mm_storeu_ps(p + 8, m[2]);
+			_mm_storeu_ps(p + 12, m[3]);
+		}
+
+		GLM_FUNC_QUALIFIER static std::size_t multiply(float const* a, float const* b, float* out, std::size_t count)
+		{
+			for(std::size_t i = 0; i < count; ++i)
+			{
+				glm_vec4 A[4], B[4], Result[4];
+				load(a + 16 * i, A);
+				load(b + 16 * i, B);
+				glm_mat4_mul(A, B, Result);
+				store(Result, out + 16 * i);
+			}
+			return count;
+		}
+
+		GLM_FUNC_QUALIFIER static std::size_t inverse(float const* in, float* out, std::size_t count)
+		{
+			for(std::size_t i = 0; i < count; ++i)
+			{
+				glm_vec4 In[4], Result[4];
+				load(in + 16 * i, In);
+				glm_mat4_inverse(In, Result);
+				store(Result, out + 16 * i);
+			}
+			return count;
+		}
+	};
+
+	struct simd_dispatch_avx2
+	{
+		// Two columns of the product per register: a's columns repeated in
+		// both lanes against a column pair of b, each element broadcast within
+		// its own lane. Sums in operator*'s order.
+		GLM_TARGET_AVX2 GLM_FUNC_QUALIFIER static __m256 mul_columns(__m256 const a[4], __m256 b)
+		{
+			__m256 r = _mm256_mul_ps(a[0], _mm256_permute_ps(b, _MM_SHUFFLE(0, 0, 0, 0)));
+			r = _mm256_fmadd_ps(a[1], _mm256_permute_ps(b, _MM_SHUFFLE(1, 1, 1, 1)), r);
+			r = _mm256_fmadd_ps(a[2], _mm256_permute_ps(b, _MM_SHUFFLE(2, 2, 2, 2)), r);
+			return _mm256_fmadd_ps(a[3], _mm256_permute_ps(b, _MM_SHUFFLE(3, 3, 3, 3)), r);
+		}
+
+		GLM_TARGET_AVX2 GLM_FUNC_QUALIFIER static std::size_t multiply(float const* a, float const* b, float* out, std::size_t count)
+		{
+			for(std::size_t i = 0; i < count; ++i)
+			{
+				float const* pa = a + 16 * i;
+				__m256 const A[4] = {
+					_mm256_broadcast_ps(reinterpret_cast<__m128 const*>(pa)),
+					_mm256_broadcast_ps(reinterpret_cast<__m128 const*>(pa + 4)),
+					_mm256_broadcast_ps(reinterpret_cast<__m128 const*>(pa + 8)),
+					_mm256_broadcast_ps(reinterpret_cast<__m128 const*>(pa + 12))};
+				__m256 const B01 = _mm256_loadu_ps(b + 16 * i);
+				__m256 const B23 = _mm256_loadu_ps(b + 16 * i + 8);
+				_mm256_storeu_ps(out + 16 * i, mul_columns(A, B01));
+				_mm256_storeu_ps(out + 16 * i + 8, mul_columns(A, B23));
+			}
+			return count;
+		}
+
+		// Two matrices at a time, one per 128-bit lane, through the cofactor
+		// expansion of compute_inverse<4, 4> (see glm_dmat4_adjugate). Every
+		// shuffle stays within its lane.
+		GLM_TARGET_AVX2 GLM_FUNC_QUALIFIER static void inverse_pair(__m256 const c[4], __m256 out[4])
+		{
+			// Rows: (m[0][r], m[1][r], m[2][r], m[3][r]) in each lane
+			__m256 const t0 = _mm256_unpacklo_ps(c[0], c[1]);
+			__m256 const t1 = _mm256_unpacklo_ps(c[2], c[3]);
+			__m256 const t2 = _mm256_unpackhi_ps(c[0], c[1]);
+			__m256 const t3 = _mm256_unpackhi_ps(c[2], c[3]);
+			__m256 const Row[4] = {
+				_mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0)),
+				_mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2)),
+				_mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0)),
+				_mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2))};
+
+			__m256 A[4], B[4], Vec[4];
+			for(int r = 0; r < 4; ++r)
+			{
+				A[r] = _mm256_permute_ps(Row[r], _MM_SHUFFLE(1, 1, 2, 2));
+				B[r] = _mm256_permute_ps(Row[r], _MM_SHUFFLE(2, 3, 3, 3));
+				Vec[r] = _mm256_permute_ps(Row[r], _MM_SHUFFLE(0, 0, 0, 1));
+			}
+
+			__m256 const Fac0 = _mm256_fmsub_ps(A[2], B[3], _mm256_mul_ps(B[2], A[3]));
+			__m256 const Fac1 = _mm256_fmsub_ps(A[1], B[3], _mm256_mul_ps(B[1], A[3]));
+			__m256 const Fac2 = _mm256_fmsub_ps(A[1], B[2], _mm256_mul_ps(B[1], A[2]));
+			__m256 const Fac3 = _mm256_fmsub_ps(A[0], B[3], _mm256_mul_ps(B[0], A[3]));
+			__m256 const Fac4 = _mm256_fmsub_ps(A[0], B[2], _mm256_mul_ps(B[0], A[2]));
+			__m256 const Fac5 = _mm256_fmsub_ps(A[0], B[1], _mm256_mul_ps(B[0], A[1]));
+
+			__m256 const Inv0 = _mm256_fmadd_ps(Vec[3], Fac2, _mm256_fmsub_ps(Vec[1], Fac0, _mm256_mul_ps(Vec[2], Fac1)));
+			__m256 const Inv1 = _mm256_fmadd_ps(Vec[3], Fac4, _mm256_fmsub_ps(Vec[0], Fac0, _mm256_mul_ps(Vec[2], Fac3)));
+			__m256 const Inv2 = _mm256_fmadd_ps(Vec[3], Fac5, _mm256_fmsub_ps(Vec[0], Fac1, _mm256_mul_ps(Vec[1], Fac3)));
+			__m256 const Inv3 = _mm256_fmadd_ps(Vec[2], Fac5, _mm256_fmsub_ps(Vec[0], Fac2, _mm256_mul_ps(Vec[1], Fac4)));
+
+			__m256 const SignA = _mm256_setr_ps(0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f);
+			__m256 const SignB = _mm256_setr_ps(-0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f);
+			__m256 const Adj0 = _mm256_xor_ps(Inv0, SignA);
+			__m256 const Adj1 = _mm256_xor_ps(Inv1, SignB);
+			__m256 const Adj2 = _mm256_xor_ps(Inv2, SignA);
+			__m256 const Adj3 = _mm256_xor_ps(Inv3, SignB);
+
+			// Determinant as (x + y) + (z + w) of m[0] times the adjugate's first row
+			__m256 const Row0 = _mm256_shuffle_ps(_mm256_unpacklo_ps(Adj0, Adj1), _mm256_unpacklo_ps(Adj2, Adj3), _MM_SHUFFLE(1, 0, 1, 0));
+			__m256 const Dot0 = _mm256_mul_ps(c[0], Row0);
+			__m256 const Dot1 = _mm256_hadd_ps(Dot0, Dot0);
+			__m256 const OneOverDeterminant = _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_hadd_ps(Dot1, Dot1));
+
+			out[0] = _mm256_mul_ps(Adj0, OneOverDeterminant);
+			out[1] = _mm256_mul_ps(Adj1, OneOverDeterminant);
+			out[2] = _mm256_mul_ps(Adj2, OneOverDeterminant);
+			out[3] = _mm256_mul_ps(Adj3, OneOverDeterminant);
+		}
+
+		GLM_TARGET_AVX2 GLM_FUNC_QUALIFIER static std::size_t inverse(float const* in, float* out, std::size_t count)
+		{
+			std::size_t i = 0;
+			for(; i + 2 <= count; i += 2)
+			{
+				float const* p = in + 16 * i;
+				__m256 const M01 = _mm256_loadu_ps(p), M23 = _mm256_loadu_ps(p + 8);
+				__m256 const N01 = _mm256_loadu_ps(p + 16), N23 = _mm256_loadu_ps(p + 24);
+				__m256 const Columns[4] = {
+					_mm256_permute2f128_ps(M01, N01, 0x20),
+					_mm256_permute2f128_ps(M01, N01, 0x31),
+					_mm256_permute2f128_ps(M23, N23, 0x20),
+					_mm256_permute2f128_ps(M23, N23, 0x31)};
+
+				__m256 Result[4];
+				inverse_pair(Columns, Result);
+
+				float* q = out + 16 * i;
+				_mm256_storeu_ps(q, _mm256_permute2f128_ps(Result[0], Result[1], 0x20));
+				_mm256_storeu_ps(q + 8, _mm256_permute2f128_ps(Result[2], Result[3], 0x20));
+				_mm256_storeu_ps(q + 16, _mm256_permute2f128_ps(Result[0], Result[1], 0x31));
+				_mm256_storeu_ps(q + 24, _mm256_permute2f128_ps(Result[2], Result[3], 0x31));
+			}
+			return i;
+		}
+	};
+
+	struct simd_dispatch_avx512
+	{
+		// A whole product per register, as in simd_dispatch_avx2::mul_columns.
+		// The zero-masked broadcast avoids a GCC 12 -Wmaybe-uninitialized, see
+		// transform_batch_avx512::aos4.
+		GLM_TARGET_AVX512 GLM_FUNC_QUALIFIER static std::size_t multiply(float const* a, float const* b, float* out, std::size_t count)
+		{
+			for(std::size_t i = 0; i < count; ++i)
+			{
+				float const* pa = a + 16 * i;
+				__m512 const b0123 = _mm512_loadu_ps(b + 16 * i);
+				__m512 r = _mm512_mul_ps(_mm512_maskz_broadcast_f32x4(0xFFFF, _mm_loadu_ps(pa)), _mm512_shuffle_ps(b0123, b0123, _MM_SHUFFLE(0, 0, 0, 0)));
+				r = _mm512_fmadd_ps(_mm512_maskz_broadcast_f32x4(0xFFFF, _mm_loadu_ps(pa + 4)), _mm512_shuffle_ps(b0123, b0123, _MM_SHUFFLE(1, 1, 1, 1)), r);
+				r = _mm512_fmadd_ps(_mm512_maskz_broadcast_f32x4(0xFFFF, _mm_loadu_ps(pa + 8)), _mm512_shuffle_ps(b0123, b0123, _MM_SHUFFLE(2, 2, 2, 2)), r);
+				r = _mm512_fmadd_ps(_mm512_maskz_broadcast_f32x4(0xFFFF, _mm_loadu_ps(pa + 12)), _mm512_shuffle_ps(b0123, b0123, _MM_SHUFFLE(3, 3, 3, 3)), r);
+				_mm512_storeu_ps(out + 16 * i, r);
+			}
+			return count;
+		}
+
+		// The inverse is shuffle bound; four lanes gain little over two.
+		GLM_TARGET_AVX512 GLM_FUNC_QUALIFIER static std::size_t inverse(float const* in, float* out, std::size_t count)
+		{
+			return simd_dispatch_avx2::inverse(in, out, count);
+		}
+	};
+#	endif//GLM_CONFIG_SIMD_DISPATCH == GLM_ENABLE
+
+	template<typename Exponential, bool Lowp>
+	GLM_FUNC_QUALIFIER void simd_dispatch_exponential(simd_dispatch_table& Table)
+	{
+		Table.exponential[Lowp][exponential_batch_exp] = &Exponential::template unary<exponential_batch_exp, Lowp>;
+		Table.exponential[Lowp][exponential_batch_exp2] = &Exponential::template unary<exponential_batch_exp2, Lowp>;
+		Table.exponential[Lowp][exponential_batch_log] = &Exponential::template unary<exponential_batch_log, Lowp>;
+		Table.exponential[Lowp][exponential_batch_log2] = &Exponential::template unary<exponential_batch_log2, Lowp>;
+		Table.pow[Lowp] = &Exponential::template pow<Lowp>;
+	}
+
+	template<typename Noise, noise_batch_kind K>
+	GLM_FUNC_QUALIFIER void simd_dispatch_noise(simd_dispatch_table& Table)
+	{
+		Table.noise[K][0] = &Noise::template span<K, 2>;
+		Table.noise[K][1] = &Noise::template span<K, 3>;
+		Table.noiseGrid[K][0] = &Noise::template grid<K, 2>;
+		Table.noiseGrid[K][1] = &Noise::template grid<K, 3>;
+	}
+
+	template<typename Batch, typename Span, typename Exponential, typename Half, typename Noise, typename Random, typename Bitfield>
+	GLM_FUNC_QUALIFIER simd_dispatch_table simd_dispatch_kernels(simd_isa isa)
+	{
+		simd_dispatch_table Table;
+		Table.isa = isa;
+		Table.positions = &Batch::template aos3<transform_batch_position>;
+		Table.directions = &Batch::template aos3<transform_batch_direction>;
+		Table.projective = &Batch::template aos3<transform_batch_projective>;
+		Table.positionsSoA = &Batch::template soa3<transform_batch_position>;
+		Table.directionsSoA = &Batch::template soa3<transform_batch_direction>;
+		Table.projectiveSoA = &Batch::template soa3<transform_batch_projective>;
+		Table.vectors = &Batch::aos4;
+		Table.multiply = &Span::multiply;
+		Table.inverse = &Span::inverse;
+		simd_dispatch_exponential<Exponential, false>(Table);
+		simd_dispatch_exponential<Exponential, true>(Table);
+		Table.packHalf = &Half::pack;
+		Table.unpackHalf = &Half::unpack;
+		simd_dispatch_noise<Noise, noise_batch_perlin>(Table);
+		simd_dispatch_noise<Noise, noise_batch_simplex>(Table);
+		Table.random[rand_batch_linear] = &Random::template span<rand_batch_linear>;
+		Table.random[rand_batch_gauss] = &Random::template span<rand_batch_gauss>;
+		Table.random[rand_batch_sphere] = &Random::template span<rand_batch_sphere>;
+		Table.random[rand_batch_ball] = &Random::template span<rand_batch_ball>;
+		Table.interleave = &Bitfield::interleave;
+		Table.deinterleave = &Bitfield::deinterleave;
+		return Table;
+	}
+
+	// PDEP is 3 cycles on Intel since Haswell and AMD since Zen 3, microcode on
+	// Excavator, Zen and Zen 2.
+	GLM_FUNC_QUALIFIER bool simd_dispatch_fast_pdep()
+	{
+#		if (GLM_CONFIG_SIMD_DISPATCH == GLM_ENABLE) && (GLM_COMPILER & GLM_COMPILER_VC)
+			int Info[4];
+			__cpuid(Info, 0);
+			bool const Amd = Info[1] == 0x68747541 && Info[3] == 0x69746E65 && Info[2] == 0x444D4163;	// AuthenticAMD
+			if(Info[0] < 7)
+				return false;
+			__cpuid(Info, 1);
+			int const Family = ((Info[0] >> 8) & 0xF) + ((Info[0] >> 20) & 0xFF);
+			__cpuidex(Info, 7, 0);
+			return (Info[1] & (1 << 8)) != 0 && !(Amd && Family < 0x19);
+#		elif GLM_CONFIG_SIMD_DISPATCH == GLM_ENABLE
+			__builtin_cpu_init();
+			return __builtin_cpu_supports("bmi2") && !__builtin_cpu_is("amdfam15h") && !__builtin_cpu_is("amdfam17h");
+#		else
+			return false;
+#		endif
+	}
+
+	// The AVX2 and AVX-512 levels take bitfield_batch_bmi2 over the AVX2
+	// shifts, which it runs twice as fast as, wherever PDEP is fast.
+	GLM_FUNC_QUALIFIER void simd_dispatch_bitfield(simd_dispatch_table& Table)
+	{
+#		if (GLM_CONFIG_SIMD_DISPATCH == GLM_ENABLE) && (defined(__x86_64__) || defined(_M_X64))
+			if(simd_dispatch_fast_pdep())
+			{
+				Table.interleave = &bitfield_batch_bmi2::interleave;
+				Table.deinterleave = &bitfield_batch_bmi2::deinterleave;
+			}
+#		else
+			static_cast<void>(Table);
+#		endif
+	}
+
+	GLM_FUNC_QUALIFIER simd_dispatch_table simd_dispatch_kernels(simd_isa isa)
+	{
+		switch(isa)
+		{
+#		if GLM_CONFIG_SIMD_DISPATCH == GLM_ENABLE
+		case simd_avx512:
+		{
+			// The masked lane loads and stores of the AVX-512 vec3 AoS kernels
+			// cost more than the wider registers save; AVX2 measures faster.
+			// The exponential, half, noise, random and Morton spans have no AVX-512 kernels.
+			simd_dispatch_table Table = simd_dispatch_kernels<transform_batch_avx512, simd_dispatch_avx512, exponential_batch_avx2, half_batch_f16c, noise_batch_avx2, rand_batch_avx2, bitfield_batch_avx2>(isa);
+			Table.positions = &transform_batch_avx2::aos3<transform_batch_position>;
+			Table.directions = &transform_batch_avx2::aos3<transform_batch_direction>;
+			Table.projective = &transform_batch_avx2::aos3<transform_batch_projective>;
+			simd_dispatch_bitfield(Table);
+			return Table;
+		}
+		case simd_avx2:
+		{
+			simd_dispatch_table Table = simd_dispatch_kernels<transform_batch_avx2, simd_dispatch_avx2, exponential_batch_avx2, half_batch_f16c, noise_batch_avx2, rand_batch_avx2, bitfield_batch_avx2>(isa);
+			simd_dispatch_bitfield(Table);
+			return Table;
+		}
+		case simd_sse2:
+			// Morton codes have no SSE2 kernel, see bitfield_batch_avx2.
+			return simd_dispatch_kernels<transform_batch_sse2, simd_dispatch_sse2, exponential_batch_sse2, half_batch_sse2, noise_batch_sse2, rand_batch_sse2, simd_dispatch_scalar>(isa);
+#		endif
+		default:
+			return simd_dispatch_kernels<simd_dispatch_scalar, simd_dispatch_scalar, simd_dispatch_scalar, simd_dispatch_scalar, simd_dispatch_scalar, simd_dispatch_scalar, simd_dispatch_scalar>(simd_scalar);
+		}
+	}
+
+	// AVX needs the OS to save the YMM registers and AVX-512 the ZMM and mask
+	// registers too; __builtin_cpu_supports checks XCR0 itself.
+	GLM_FUNC_QUALIFIER simd_isa simd_dispatch_detect()
+	{
+#		if (GLM_CONFIG_SIMD_DISPATCH == GLM_ENABLE) && (GLM_COMPILER & GLM_COMPILER_VC)
+			int Info[4];
+			__cpuid(Info, 0);
+			int const MaxLeaf = Info[0];
+			__cpuid(Info, 1);
+			bool const Fma = (Info[2] & (1 << 12)) != 0;
+			bool const OsXsave = (Info[2] & (1 << 27)) != 0;
+			bool const F16c = (Info[2] & (1 << 29)) != 0;
+			if(MaxLeaf < 7 || !Fma || !OsXsave || !F16c)
+				return simd_sse2;
+
+			unsigned long long const Xcr0 = _xgetbv(0);
+			__cpuidex(Info, 7, 0);
+			bool const Avx2 = (Info[1] & (1 << 5)) != 0 && (Xcr0 & 0x06) == 0x06;
+			bool const Avx512 = Avx2 && (Info[1] & (1 << 16)) != 0 && (Xcr0 & 0xE6) == 0xE6;
+			return Avx512 ? simd_avx512 : Avx2 ? simd_avx2 : simd_sse2;
+#		elif GLM_CONFIG_SIMD_DISPATCH == GLM_ENABLE
+			__builtin_cpu_init();
+			bool const Avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") && __builtin_cpu_supports("f16c");
+			bool const Avx512 = Avx2 && __builtin_cpu_supports("avx512f");
+			return Avx512 ? simd_avx512 : Avx2 ? simd_avx2 : simd_sse2;
+#		else
+			return simd_scalar;
+#		endif
+	}
+
+	GLM_FUNC_QUALIFIER simd_isa simd_dispatch_supported()
+	{
+		static simd_isa const Supported = simd_dispatch_detect();
+		return Supported;
+	}
+
+	GLM_FUNC_QUALIFIER simd_dispatch_table& simd_dispatch_current()
+	{
+		static simd_dispatch_table Table = simd_dispatch_kernels(simd_dispatch_supported());
+		return Table;
+	}
+}//namespace detail
+
+	GLM_FUNC_QUALIFIER simd_isa simdSupportedIsa()
+	{
+		return detail::simd_dispatch_supported();
+	}
+
+	GLM_FUNC_QUALIFIER simd_isa simdDispatchIsa()
+	{
+		return detail::simd_dispatch_current().isa;
+	}
+
+	GLM_FUNC_QUALIFIER bool simdDispatchSelect(simd_isa isa)
+	{
+		if(isa > detail::simd_dispatch_supported())
+			return false;
+		detail::simd_dispatch_current() = detail::simd_dispatch_kernels(isa);
+		return true;
+	}
+
+	GLM_FUNC_QUALIFIER char const* simdIsaName(simd_isa isa)
+	{
+		switch(isa)
+		{
+		case simd_avx512:
+			return "AVX-512";
+		case simd_avx2:
+			return "AVX2";
+		case simd_sse2:
+			return "SSE2";
+		default:
+			return "scalar";
+		}
+	}
+
+	// Aligned vec3 is padded to 16 bytes, so only packed vec3 arrays go to the
+	// AoS kernels, as in compute_transform_batch.
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void dispatchTransformPositions(mat<4, 4, float, Q> const& m, vec<3, float, Q> const* in, vec<3, float, Q>* out, std::size_t count)
+	{
+		std::size_t done = 0;
+		if(sizeof(vec<3, float, Q>) == 3 * sizeof(float))
+			done = detail::simd_dispatch_current().positions(&m[0][0], &in[0][0], &out[0][0], count);
+		detail::transform_batch_scalar_aos3<detail::transform_batch_position>(m, in, out, done, count);
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void dispatchTransformDirections(mat<4, 4, float, Q> const& m, vec<3, float, Q> const* in, vec<3, float, Q>* out, std::size_t count)
+	{
+		std::size_t done = 0;
+		if(sizeof(vec<3, float, Q>) == 3 * sizeof(float))
+			done = detail::simd_dispatch_current().directions(&m[0][0], &in[0][0], &out[0][0], count);
+		detail::transform_batch_scalar_aos3<detail::transform_batch_direction>(m, in, out, done, count);
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void dispatchTransformProjective(mat<4, 4, float, Q> const& m, vec<3, float, Q> const* in, vec<3, float, Q>* out, std::size_t count)
+	{
+		std::size_t done = 0;
+		if(sizeof(vec<3, float, Q>) == 3 * sizeof(float))
+			done = detail::simd_dispatch_current().projective(&m[0][0], &in[0][0], &out[0][0], count);
+		detail::transform_batch_scalar_aos3<detail::transform_batch_projective>(m, in, out, done, count);
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void dispatchTransformVectors(mat<4, 4, float, Q> const& m, vec<4, float, Q> const* in, vec<4, float, Q>* out, std::size_t count)
+	{
+		std::size_t const done = detail::simd_dispatch_current().vectors(&m[0][0], &in[0][0], &out[0][0], count);
+		detail::transform_batch_scalar_aos4(m, in, out, done, count);
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void dispatchTransformPositions(mat<4, 4, float, Q> const& m, float const* x, float const* y, float const* z, float* outX, float* outY, float* outZ, std::size_t count)
+	{
+		std::size_t const done = detail::simd_dispatch_current().positionsSoA(&m[0][0], x, y, z, outX, outY, outZ, count);
+		detail::transform_batch_scalar_soa3<detail::transform_batch_position>(m, x, y, z, outX, outY, outZ, done, count);
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void dispatchTransformDirections(mat<4, 4, float, Q> const& m, float const* x, float const* y, float const* z, float* outX, float* outY, float* outZ, std::size_t count)
+	{
+		std::size_t const done = detail::simd_dispatch_current().directionsSoA(&m[0][0], x, y, z, outX, outY, outZ, count);
+		detail::transform_batch_scalar_soa3<detail::transform_batch_direction>(m, x, y, z, outX, outY, outZ, done, count);
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void dispatchTransformProjective(mat<4, 4, float, Q> const& m, float const* x, float const* y, float const* z, float* outX, float* outY, float* outZ, std::size_t count)
+	{
+		std::size_t const done = detail::simd_dispatch_current().projectiveSoA(&m[0][0], x, y, z, outX, outY, outZ, count);
+		detail::transform_batch_scalar_soa3<detail::transform_batch_projective>(m, x, y, z, outX, outY, outZ, done, count);
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void dispatchMultiply(mat<4, 4, float, Q> const* a, mat<4, 4, float, Q> const* b, mat<4, 4, float, Q>* out, std::size_t count)
+	{
+		std::size_t const done = count ? detail::simd_dispatch_current().multiply(&a[0][0][0], &b[0][0][0], &out[0][0][0], count) : 0;
+		for(std::size_t i = done; i < count; ++i)
+			out[i] = a[i] * b[i];
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void dispatchInverse(mat<4, 4, float, Q> const* in, mat<4, 4, float, Q>* out, std::size_t count)
+	{
+		std::size_t const done = count ? detail::simd_dispatch_current().inverse(&in[0][0][0], &out[0][0][0], count) : 0;
+		for(std::size_t i = done; i < count; ++i)
+			out[i] = inverse(in[i]);
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void dispatchExp(float const* in, float* out, std::size_t count)
+	{
+		std::size_t const done = detail::simd_dispatch_current().exponential[detail::exponential_lowp<Q>::value][detail::exponential_batch_exp](in, out, count);
+		detail::exponential_batch_scalar<detail::exponential_batch_exp>(in, out, done, count);
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void dispatchExp2(float const* in, float* out, std::size_t count)
+	{
+		std::size_t const done = detail::simd_dispatch_current().exponential[detail::exponential_lowp<Q>::value][detail::exponential_batch_exp2](in, out, count);
+		detail::exponential_batch_scalar<detail::exponential_batch_exp2>(in, out, done, count);
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void dispatchLog(float const* in, float* out, std::size_t count)
+	{
+		std::size_t const done = detail::simd_dispatch_current().exponential[detail::exponential_lowp<Q>::value][detail::exponential_batch_log](in, out, count);
+		detail::exponential_batch_scalar<detail::exponential_batch_log>(in, out, done, count);
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void dispatchLog2(float const* in, float* out, std::size_t count)
+	{
+		std::size_t const done = detail::simd_dispatch_current().exponential[detail::exponential_lowp<Q>::value][detail::exponential_batch_log2](in, out, count);
+		detail::exponential_batch_scalar<detail::exponential_batch_log2>(in, out, done, count);
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void dispatchPow(float const* base, float const* exponent, float* out, std::size_t count)
+	{
+		std::size_t const done = detail::simd_dispatch_current().pow[detail::exponential_lowp<Q>::value](base, exponent, out, count);
+		detail::exponential_batch_scalar_pow(base, exponent, out, done, count);
+	}
+
+	GLM_FUNC_QUALIFIER void dispatchPackHalf(float const* in, uint16* out, std::size_t count)
+	{
+		std::size_t const done = detail::simd_dispatch_current().packHalf(in, out, count);
+		detail::half_batch_scalar_pack(in, out, done, count);
+	}
+
+	GLM_FUNC_QUALIFIER void dispatchUnpackHalf(uint16 const* in, float* out, std::size_t count)
+	{
+		std::size_t const done = detail::simd_dispatch_current().unpackHalf(in, out, count);
+		detail::half_batch_scalar_unpack(in, out, done, count);
+	}
+
+	GLM_FUNC_QUALIFIER void dispatchPerlin(float const* x, float const* y, float* out, std::size_t count)
+	{
+		std::size_t const done = detail::simd_dispatch_current().noise[detail::noise_batch_perlin][0](x, y, GLM_NULLPTR, out, count);
+		detail::noise_batch_scalar<detail::noise_batch_perlin, 2>(x, y, GLM_NULLPTR, out, done, count);
+	}
+
+	GLM_FUNC_QUALIFIER void dispatchPerlin(float const* x, float const* y, float const* z, float* out, std::size_t count)
+	{
+		std::size_t const done = detail::simd_dispatch_current().noise[detail::noise_batch_perlin][1](x, y, z, out, count);
+		detail::noise_batch_scalar<detail::noise_batch_perlin, 3>(x, y, z, out, done, count);
+	}
+
+	GLM_FUNC_QUALIFIER void dispatchSimplex(float const* x, float const* y, float* out, std::size_t count)
+	{
+		std::size_t const done = detail::simd_dispatch_current().noise[detail::noise_batch_simplex][0](x, y, GLM_NULLPTR, out, count);
+		detail::noise_batch_scalar<detail::noise_batch_simplex, 2>(x, y, GLM_NULLPTR, out, done, count);
+	}
+
+	GLM_FUNC_QUALIFIER void dispatchSimplex(float const* x, float const* y, float const* z, float* out, std::size_t count)
+	{
+		std::size_t const done = detail::simd_dispatch_current().noise[detail::noise_batch_simplex][1](x, y, z, out, count);
+		detail::noise_batch_scalar<detail::noise_batch_simplex, 3>(x, y, z, out, done, count);
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void dispatchPerlinGrid(vec<2, float, Q> const& origin, vec<2, float, Q> const& step, vec<2, uint, Q> const& first, vec<2, uint, Q> const& size, float* out)
+	{
+		std::size_t const done = detail::simd_dispatch_current().noiseGrid[detail::noise_batch_perlin][0](&origin[0], &step[0], &first[0], &size[0], out);
+		detail::noise_batch_scalar_grid<detail::noise_batch_perlin, 2>(&origin[0], &step[0], &first[0], &size[0], out, done);
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void dispatchPerlinGrid(vec<3, float, Q> const& origin, vec<3, float, Q> const& step, vec<3, uint, Q> const& first, vec<3, uint, Q> const& size, float* out)
+	{
+		std::size_t const done = detail::simd_dispatch_current().noiseGrid[detail::noise_batch_perlin][1](&origin[0], &step[0], &first[0], &size[0], out);
+		detail::noise_batch_scalar_grid<detail::noise_batch_perlin, 3>(&origin[0], &step[0], &first[0], &size[0], out, done);
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void dispatchSimplexGrid(vec<2, float, Q> const& origin, vec<2, float, Q> const& step, vec<2, uint, Q> const& first, vec<2, uint, Q> const& size, float* out)
+	{
+		std::size_t const done = detail::simd_dispatch_current().noiseGrid[detail::noise_batch_simplex][0](&origin[0], &step[0], &first[0], &size[0], out);
+		detail::noise_batch_scalar_grid<detail::noise_batch_simplex, 2>(&origin[0], &step[0], &first[0], &size[0], out, done);
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void dispatchSimplexGrid(vec<3, float, Q> const& origin, vec<3, float, Q> const& step, vec<3, uint, Q> const& first, vec<3, uint, Q> const& size, float* out)
+	{
+		std::size_t const done = detail::simd_dispatch_current().noiseGrid[detail::noise_batch_simplex][1](&origin[0], &step[0], &first[0], &size[0], out);
+		detail::noise_batch_scalar_grid<detail::noise_batch_simplex, 3>(&origin[0], &step[0], &first[0], &size[0], out, done);
+	}
+
+	GLM_FUNC_QUALIFIER void dispatchLinearRand(rand_stream& Stream, float Min, float Max, float* Out, std::size_t Count)
+	{
+		detail::rand_batch<detail::rand_batch_linear>(detail::simd_dispatch_current().random[detail::rand_batch_linear], Stream, Min, Max - Min, Out, GLM_NULLPTR, GLM_NULLPTR, Count);
+	}
+
+	template<length_t L, qualifier Q>
+	GLM_FUNC_QUALIFIER void dispatchLinearRand(rand_stream& Stream, vec<L, float, Q> const& Min, vec<L, float, Q> const& Max, vec<L, float, Q>* Out, std::size_t Count)
+	{
+		detail::rand_batch_linear_vec(detail::simd_dispatch_current().random[detail::rand_batch_linear], Stream, Min, Max, Out, Count);
+	}
+
+	GLM_FUNC_QUALIFIER void dispatchGaussRand(rand_stream& Stream, float Mean, float Deviation, float* Out, std::size_t Count)
+	{
+		detail::rand_batch<detail::rand_batch_gauss>(detail::simd_dispatch_current().random[detail::rand_batch_gauss], Stream, Mean, Deviation * Deviation, Out, GLM_NULLPTR, GLM_NULLPTR, Count);
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void dispatchSphericalRand(rand_stream& Stream, float Radius, vec<3, float, Q>* Out, std::size_t Count)
+	{
+		detail::rand_batch_points<detail::rand_batch_sphere>(detail::simd_dispatch_current().random[detail::rand_batch_sphere], Stream, Radius, Out, Count);
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void dispatchBallRand(rand_stream& Stream, float Radius, vec<3, float, Q>* Out, std::size_t Count)
+	{
+		detail::rand_batch_points<detail::rand_batch_ball>(detail::simd_dispatch_current().random[detail::rand_batch_ball], Stream, Radius, Out, Count);
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void dispatchBitfieldInterleave(vec<3, uint32, Q> const* In, uint64* Out, std::size_t Count)
+	{
+		std::size_t Done = 0;
+		if(sizeof(vec<3, uint32, Q>) == 3 * sizeof(uint32))
+			Done = detail::simd_dispatch_current().interleave(&In[0][0], Out, Count);
+		detail::bitfield_interleave_scalar(In, Out, Done, Count);
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void dispatchBitfieldDeinterleave(uint64 const* In, vec<3, uint32, Q>* Out, std::size_t Count)
+	{
+		std::size_t Done = 0;
+		if(sizeof(vec<3, uint32, Q>) == 3 * sizeof(uint32))
+			Done = detail::simd_dispatch_current().deinterleave(In, &Out[0][0], Count);
+		detail::bitfield_deinterleave_scalar(In, Out, Done, Count);
+	}
+
+	GLM_FUNC_QUALIFIER char const* dispatchBitfieldIsa()
+	{
+		if(detail::simd_dispatch_current().isa < simd_avx2)
+			return "scalar";
+#		if defined(__x86_64__) || defined(_M_X64)
+			return detail::simd_dispatch_fast_pdep() ? "BMI2" : "AVX2";
+#		else
+			return "AVX2";
+#		endif
+	}
+}//namespace glm
@@ -0,0 +1,82 @@
+/// @ref gtx_transform_batch
+/// @file glm/gtx/transform_batch.hpp
+///
+/// @see core (dependence)
+///
+/// @defgroup gtx_transform_batch GLM_GTX_transform_batch
+/// @ingroup gtx
+///
+/// Include <glm/gtx/transform_batch.hpp> to use the features of this extension.
+///
+/// Transforms spans of points by a single 4x4 matrix, from arrays of vec3 or
+/// vec4 (AoS) or from separate x, y and z arrays (SoA). For float, the spans
+/// are processed 4, 8 or 16 points at a time with SSE2, AVX2 or AVX-512,
+/// whichever is the widest enabled by GLM_ARCH (AVX-512 by __AVX512F__);
+/// other types and configurations loop over operator*. The AVX2 kernels use
+/// FMA. GLM_GTX_simd_dispatch picks the kernels at run time instead.
+///
+/// Input and output may be the same array but must not partially overlap.
+/// Results can differ from operator* in the last bit where AVX2 and AVX-512
+/// contract multiply-adds into FMA.
+
+#pragma once
+
+// Dependency:
+#include "../glm.hpp"
+#include <cstddef>
+
+#ifndef GLM_ENABLE_EXPERIMENTAL
+#	error "GLM: GLM_GTX_transform_batch is an experimental extension and may change in the future. Use #define GLM_ENABLE_EXPERIMENTAL before including it, if you really want to use it."
+#elif GLM_MESSAGES == GLM_ENABLE && !defined(GLM_EXT_INCLUDED)
+#	pragma message("GLM: GLM_GTX_transform_batch extension included")
+#endif
+
+namespace glm
+{
+	/// @addtogroup gtx_transform_batch
+	/// @{
+
+	/// out[i] = vec3(m * vec4(in[i], 1)) for count points.
+	/// From GLM_GTX_transform_batch extension.
+	template<typename T, qualifier Q>
+	GLM_FUNC_DISCARD_DECL void transformPositions(mat<4, 4, T, Q> const& m, vec<3, T, Q> const* in, vec<3, T, Q>* out, std::size_t count);
+
+	/// out[i] = vec3(m * vec4(in[i], 0)) for count directions.
+	/// From GLM_GTX_transform_batch extension.
+	template<typename T, qualifier Q>
+	GLM_FUNC_DISCARD_DECL void transformDirections(mat<4, 4, T, Q> const& m, vec<3, T, Q> const* in, vec<3, T, Q>* out, std::size_t count);
+
+	/// Full projective transform with perspective divide:
+	/// out[i] = vec3(m * vec4(in[i], 1)) / (m * vec4(in[i], 1)).w for count points.
+	/// From GLM_GTX_transform_batch extension.
+	template<typename T, qualifier Q>
+	GLM_FUNC_DISCARD_DECL void transformProjective(mat<4, 4, T, Q> const& m, vec<3, T, Q> const* in, vec<3, T, Q>* out, std::size_t count);
+
+	/// out[i] = m * in[i] for count vectors.
+	/// From GLM_GTX_transform_batch extension.
+	template<typename T, qualifier Q>
+	GLM_FUNC_DISCARD_DECL void transformVectors(mat<4, 4, T, Q> const& m, vec<4, T, Q> const* in, vec<4, T, Q>* out, std::size_t count);
+
+	/// SoA form of transformPositions over separate coordinate arrays.
+	/// From GLM_GTX_transform_batch extension.
+	template<typename T, qualifier Q>
+	GLM_FUNC_DISCARD_DECL void transformPositions(mat<4, 4, T, Q> const& m, T const* x, T const* y, T const* z, T* outX, T* outY, T* outZ, std::size_t count);
+
+	/// SoA form of transformDirections over separate coordinate arrays.
+	/// From GLM_GTX_transform_batch extension.
+	template<typename T, qualifier Q>
+	GLM_FUNC_DISCARD_DECL void transformDirections(mat<4, 4, T, Q> const& m, T const* x, T const* y, T const* z, T* outX, T* outY, T* outZ, std::size_t count);
+
+	/// SoA form of transformProjective over separate coordinate arrays.
+	/// From GLM_GTX_transform_batch extension.
+	template<typename T, qualifier Q>
+	GLM_FUNC_DISCARD_DECL void transformProjective(mat<4, 4, T, Q> const& m, T const* x, T const* y, T const* z, T* outX, T* outY, T* outZ, std::size_t count);
+
+	/// Name of the instruction set the float spans use: "AVX-512", "AVX2", "SSE2" or "scalar".
+	/// From GLM_GTX_transform_batch extension.
+	GLM_FUNC_DECL char const* transformBatchIsa();
+
+	/// @}
+}//namespace glm
+
+#include "transform_batch.inl"
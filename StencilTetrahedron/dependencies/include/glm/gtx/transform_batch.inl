@@ -0,0 +1,528 @@
+/// @ref gtx_transform_batch
+
+namespace glm{
+namespace detail
+{
+	enum transform_batch_kind
+	{
+		transform_batch_position,		// w = 1
+		transform_batch_direction,		// w = 0
+		transform_batch_projective		// w = 1, then divide by the transformed w
+	};
+
+	// Reference path for any type and qualifier, and the tail of the SIMD loops.
+	template<transform_batch_kind K, typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER vec<3, T, Q> transform_batch_point(mat<4, 4, T, Q> const& m, vec<3, T, Q> const& p)
+	{
+		if(K == transform_batch_direction)
+			return vec<3, T, Q>(m * vec<4, T, Q>(p, static_cast<T>(0)));
+		vec<4, T, Q> const r = m * vec<4, T, Q>(p, static_cast<T>(1));
+		if(K == transform_batch_projective)
+			return vec<3, T, Q>(r) / r.w;
+		return vec<3, T, Q>(r);
+	}
+
+	template<transform_batch_kind K, typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void transform_batch_scalar_aos3(mat<4, 4, T, Q> const& m, vec<3, T, Q> const* in, vec<3, T, Q>* out, std::size_t first, std::size_t count)
+	{
+		for(std::size_t i = first; i < count; ++i)
+			out[i] = transform_batch_point<K>(m, in[i]);
+	}
+
+	template<transform_batch_kind K, typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void transform_batch_scalar_soa3(mat<4, 4, T, Q> const& m, T const* x, T const* y, T const* z, T* outX, T* outY, T* outZ, std::size_t first, std::size_t count)
+	{
+		for(std::size_t i = first; i < count; ++i)
+		{
+			vec<3, T, Q> const r = transform_batch_point<K>(m, vec<3, T, Q>(x[i], y[i], z[i]));
+			outX[i] = r.x;
+			outY[i] = r.y;
+			outZ[i] = r.z;
+		}
+	}
+
+	template<typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void transform_batch_scalar_aos4(mat<4, 4, T, Q> const& m, vec<4, T, Q> const* in, vec<4, T, Q>* out, std::size_t first, std::size_t count)
+	{
+		for(std::size_t i = first; i < count; ++i)
+			out[i] = m * in[i];
+	}
+
+	// The SIMD kernels work on raw column-major floats and return how many
+	// points they handled, always a multiple of their width; the caller
+	// finishes the rest. vec3 arrays are deinterleaved four points (three
+	// registers) at a time per 128-bit lane and interleaved back the same way.
+#	if GLM_ARCH & GLM_ARCH_SSE2_BIT
+	struct transform_batch_sse2
+	{
+		static std::size_t const width = 4;
+
+		GLM_FUNC_QUALIFIER static void broadcast(float const* m, __m128* e)
+		{
+			for(int i = 0; i < 16; ++i)
+				e[i] = _mm_set1_ps(m[i]);
+		}
+
+		template<transform_batch_kind K>
+		GLM_FUNC_QUALIFIER static void apply(__m128 const* e, __m128 x, __m128 y, __m128 z, __m128& ox, __m128& oy, __m128& oz)
+		{
+			ox = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e[0], x), _mm_mul_ps(e[4], y)), _mm_mul_ps(e[8], z));
+			oy = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e[1], x), _mm_mul_ps(e[5], y)), _mm_mul_ps(e[9], z));
+			oz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e[2], x), _mm_mul_ps(e[6], y)), _mm_mul_ps(e[10], z));
+			if(K == transform_batch_direction)
+				return;
+			ox = _mm_add_ps(ox, e[12]);
+			oy = _mm_add_ps(oy, e[13]);
+			oz = _mm_add_ps(oz, e[14]);
+			if(K == transform_batch_projective)
+			{
+				__m128 const w = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e[3], x), _mm_mul_ps(e[7], y)), _mm_mul_ps(e[11], z)), e[15]);
+				ox = _mm_div_ps(ox, w);
+				oy = _mm_div_ps(oy, w);
+				oz = _mm_div_ps(oz, w);
+			}
+		}
+
+		// a = x0 y0 z0 x1, b = y1 z1 x2 y2, c = z2 x3 y3 z3
+		GLM_FUNC_QUALIFIER static void deinterleave(__m128 a, __m128 b, __m128 c, __m128& x, __m128& y, __m128& z)
+		{
+			__m128 const xy = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 1, 3, 2));	// x2 y2 x3 y3
+			__m128 const yz = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 2, 1));	// y0 z0 y1 z1
+			x = _mm_shuffle_ps(a, xy, _MM_SHUFFLE(2, 0, 3, 0));
+			y = _mm_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+			z = _mm_shuffle_ps(yz, c, _MM_SHUFFLE(3, 0, 3, 1));
+		}
+
+		GLM_FUNC_QUALIFIER static void interleave(__m128 x, __m128 y, __m128 z, __m128& a, __m128& b, __m128& c)
+		{
+			__m128 const xy = _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 0, 2, 0));	// x0 x2 y0 y2
+			__m128 const yz = _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 1, 3, 1));	// y1 y3 z1 z3
+			__m128 const zx = _mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 1, 2, 0));	// z0 z2 x1 x3
+			a = _mm_shuffle_ps(xy, zx, _MM_SHUFFLE(2, 0, 2, 0));
+			b = _mm_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+			c = _mm_shuffle_ps(zx, yz, _MM_SHUFFLE(3, 1, 3, 1));
+		}
+
+		template<transform_batch_kind K>
+		GLM_FUNC_QUALIFIER static std::size_t aos3(float const* m, float const* in, float* out, std::size_t count)
+		{
+			__m128 e[16];
+			broadcast(m, e);
+			std::size_t i = 0;
+			for(; i + width <= count; i += width)
+			{
+				__m128 x, y, z, ox, oy, oz, a, b, c;
+				deinterleave(_mm_loadu_ps(in + 3 * i), _mm_loadu_ps(in + 3 * i + 4), _mm_loadu_ps(in + 3 * i + 8), x, y, z);
+				apply<K>(e, x, y, z, ox, oy, oz);
+				interleave(ox, oy, oz, a, b, c);
+				_mm_storeu_ps(out + 3 * i, a);
+				_mm_storeu_ps(out + 3 * i + 4, b);
+				_mm_storeu_ps(out + 3 * i + 8, c);
+			}
+			return i;
+		}
+
+		template<transform_batch_kind K>
+		GLM_FUNC_QUALIFIER static std::size_t soa3(float const* m, float const* x, float const* y, float const* z, float* outX, float* outY, float* outZ, std::size_t count)
+		{
+			__m128 e[16];
+			broadcast(m, e);
+			std::size_t i = 0;
+			for(; i + width <= count; i += width)
+			{
+				__m128 ox, oy, oz;
+				apply<K>(e, _mm_loadu_ps(x + i), _mm_loadu_ps(y + i), _mm_loadu_ps(z + i), ox, oy, oz);
+				_mm_storeu_ps(outX + i, ox);
+				_mm_storeu_ps(outY + i, oy);
+				_mm_storeu_ps(outZ + i, oz);
+			}
+			return i;
+		}
+
+		GLM_FUNC_QUALIFIER static std::size_t aos4(float const* m, float const* in, float* out, std::size_t count)
+		{
+			__m128 const c0 = _mm_loadu_ps(m);
+			__m128 const c1 = _mm_loadu_ps(m + 4);
+			__m128 const c2 = _mm_loadu_ps(m + 8);
+			__m128 const c3 = _mm_loadu_ps(m + 12);
+			for(std::size_t i = 0; i < count; ++i)
+			{
+				__m128 const v = _mm_loadu_ps(in + 4 * i);
+				__m128 const r01 = _mm_add_ps(_mm_mul_ps(c0, _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0))), _mm_mul_ps(c1, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1))));
+				__m128 const r23 = _mm_add_ps(_mm_mul_ps(c2, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2))), _mm_mul_ps(c3, _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3))));
+				_mm_storeu_ps(out + 4 * i, _mm_add_ps(r01, r23));
+			}
+			return count;
+		}
+	};
+#	endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
+
+#	if (GLM_ARCH & GLM_ARCH_AVX2_BIT) || (GLM_CONFIG_SIMD_DISPATCH == GLM_ENABLE)
+	// Built with GLM_TARGET_AVX2, which also enables FMA: every AVX2 CPU has it.
+	struct transform_batch_avx2
+	{
+		static std::size_t const width = 8;
+
+		GLM_TARGET_AVX2 GLM_FUNC_QUALIFIER static void broadcast(float const* m, __m256* e)
+		{
+			for(int i = 0; i < 16; ++i)
+				e[i] = _mm256_set1_ps(m[i]);
+		}
+
+		template<transform_batch_kind K>
+		GLM_TARGET_AVX2 GLM_FUNC_QUALIFIER static void apply(__m256 const* e, __m256 x, __m256 y, __m256 z, __m256& ox, __m256& oy, __m256& oz)
+		{
+			if(K == transform_batch_direction)
+			{
+				ox = _mm256_mul_ps(e[8], z);
+				oy = _mm256_mul_ps(e[9], z);
+				oz = _mm256_mul_ps(e[10], z);
+			}
+			else
+			{
+				ox = _mm256_fmadd_ps(e[8], z, e[12]);
+				oy = _mm256_fmadd_ps(e[9], z, e[13]);
+				oz = _mm256_fmadd_ps(e[10], z, e[14]);
+			}
+			ox = _mm256_fmadd_ps(e[0], x, _mm256_fmadd_ps(e[4], y, ox));
+			oy = _mm256_fmadd_ps(e[1], x, _mm256_fmadd_ps(e[5], y, oy));
+			oz = _mm256_fmadd_ps(e[2], x, _mm256_fmadd_ps(e[6], y, oz));
+			if(K == transform_batch_projective)
+			{
+				__m256 w = _mm256_fmadd_ps(e[11], z, e[15]);
+				w = _mm256_fmadd_ps(e[3], x, _mm256_fmadd_ps(e[7], y, w));
+				ox = _mm256_div_ps(ox, w);
+				oy = _mm256_div_ps(oy, w);
+				oz = _mm256_div_ps(oz, w);
+			}
+		}
+
+		// Same shuffles as SSE2 within each 128-bit lane; lane 1 holds points 4 to 7.
+		GLM_TARGET_AVX2 GLM_FUNC_QUALIFIER static void deinterleave(__m256 a, __m256 b, __m256 c, __m256& x, __m256& y, __m256& z)
+		{
+			__m256 const xy = _mm256_shuffle_ps(b, c, _MM_SHUFFLE(2, 1, 3, 2));
+			__m256 const yz = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 2, 1));
+			x = _mm256_shuffle_ps(a, xy, _MM_SHUFFLE(2, 0, 3, 0));
+			y = _mm256_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+			z = _mm256_shuffle_ps(yz, c, _MM_SHUFFLE(3, 0, 3, 1));
+		}
+
+		GLM_TARGET_AVX2 GLM_FUNC_QUALIFIER static void interleave(__m256 x, __m256 y, __m256 z, __m256& a, __m256& b, __m256& c)
+		{
+			__m256 const xy = _mm256_shuffle_ps(x, y, _MM_SHUFFLE(2, 0, 2, 0));
+			__m256 const yz = _mm256_shuffle_ps(y, z, _MM_SHUFFLE(3, 1, 3, 1));
+			__m256 const zx = _mm256_shuffle_ps(z, x, _MM_SHUFFLE(3, 1, 2, 0));
+			a = _mm256_shuffle_ps(xy, zx, _MM_SHUFFLE(2, 0, 2, 0));
+			b = _mm256_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+			c = _mm256_shuffle_ps(zx, yz, _MM_SHUFFLE(3, 1, 3, 1));
+		}
+
+		GLM_TARGET_AVX2 GLM_FUNC_QUALIFIER static __m256 load_lanes(float const* p)
+		{
+			return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p)), _mm_loadu_ps(p + 12), 1);
+		}
+
+		GLM_TARGET_AVX2 GLM_FUNC_QUALIFIER static void store_lanes(float* p, __m256 v)
+		{
+			_mm_storeu_ps(p, _mm256_castps256_ps128(v));
+			_mm_storeu_ps(p + 12, _mm256_extractf128_ps(v, 1));
+		}
+
+		template<transform_batch_kind K>
+		GLM_TARGET_AVX2 GLM_FUNC_QUALIFIER static std::size_t aos3(float const* m, float const* in, float* out, std::size_t count)
+		{
+			__m256 e[16];
+			broadcast(m, e);
+			std::size_t i = 0;
+			for(; i + width <= count; i += width)
+			{
+				float const* p = in + 3 * i;
+				__m256 x, y, z, ox, oy, oz, a, b, c;
+				deinterleave(load_lanes(p), load_lanes(p + 4), load_lanes(p + 8), x, y, z);
+				apply<K>(e, x, y, z, ox, oy, oz);
+				interleave(ox, oy, oz, a, b, c);
+				store_lanes(out + 3 * i, a);
+				store_lanes(out + 3 * i + 4, b);
+				store_lanes(out + 3 * i + 8, c);
+			}
+			return i;
+		}
+
+		template<transform_batch_kind K>
+		GLM_TARGET_AVX2 GLM_FUNC_QUALIFIER static std::size_t soa3(float const* m, float const* x, float const* y, float const* z, float* outX, float* outY, float* outZ, std::size_t count)
+		{
+			__m256 e[16];
+			broadcast(m, e);
+			std::size_t i = 0;
+			for(; i + width <= count; i += width)
+			{
+				__m256 ox, oy, oz;
+				apply<K>(e, _mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i), _mm256_loadu_ps(z + i), ox, oy, oz);
+				_mm256_storeu_ps(outX + i, ox);
+				_mm256_storeu_ps(outY + i, oy);
+				_mm256_storeu_ps(outZ + i, oz);
+			}
+			return i;
+		}
+
+		// Two vectors per register, each broadcast within its own lane.
+		GLM_TARGET_AVX2 GLM_FUNC_QUALIFIER static std::size_t aos4(float const* m, float const* in, float* out, std::size_t count)
+		{
+			__m256 const c0 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(m));
+			__m256 const c1 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(m + 4));
+			__m256 const c2 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(m + 8));
+			__m256 const c3 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(m + 12));
+			std::size_t i = 0;
+			for(; i + 2 <= count; i += 2)
+			{
+				__m256 const v = _mm256_loadu_ps(in + 4 * i);
+				__m256 r = _mm256_mul_ps(c3, _mm256_permute_ps(v, _MM_SHUFFLE(3, 3, 3, 3)));
+				r = _mm256_fmadd_ps(c2, _mm256_permute_ps(v, _MM_SHUFFLE(2, 2, 2, 2)), r);
+				r = _mm256_fmadd_ps(c1, _mm256_permute_ps(v, _MM_SHUFFLE(1, 1, 1, 1)), r);
+				r = _mm256_fmadd_ps(c0, _mm256_permute_ps(v, _MM_SHUFFLE(0, 0, 0, 0)), r);
+				_mm256_storeu_ps(out + 4 * i, r);
+			}
+			return i;
+		}
+	};
+#	endif
+
+#	if ((GLM_ARCH & GLM_ARCH_AVX2_BIT) && defined(__AVX512F__)) || (GLM_CONFIG_SIMD_DISPATCH == GLM_ENABLE)
+	struct transform_batch_avx512
+	{
+		static std::size_t const width = 16;
+
+		GLM_TARGET_AVX512 GLM_FUNC_QUALIFIER static void broadcast(float const* m, __m512* e)
+		{
+			for(int i = 0; i < 16; ++i)
+				e[i] = _mm512_set1_ps(m[i]);
+		}
+
+		template<transform_batch_kind K>
+		GLM_TARGET_AVX512 GLM_FUNC_QUALIFIER static void apply(__m512 const* e, __m512 x, __m512 y, __m512 z, __m512& ox, __m512& oy, __m512& oz)
+		{
+			if(K == transform_batch_direction)
+			{
+				ox = _mm512_mul_ps(e[8], z);
+				oy = _mm512_mul_ps(e[9], z);
+				oz = _mm512_mul_ps(e[10], z);
+			}
+			else
+			{
+				ox = _mm512_fmadd_ps(e[8], z, e[12]);
+				oy = _mm512_fmadd_ps(e[9], z, e[13]);
+				oz = _mm512_fmadd_ps(e[10], z, e[14]);
+			}
+			ox = _mm512_fmadd_ps(e[0], x, _mm512_fmadd_ps(e[4], y, ox));
+			oy = _mm512_fmadd_ps(e[1], x, _mm512_fmadd_ps(e[5], y, oy));
+			oz = _mm512_fmadd_ps(e[2], x, _mm512_fmadd_ps(e[6], y, oz));
+			if(K == transform_batch_projective)
+			{
+				__m512 w = _mm512_fmadd_ps(e[11], z, e[15]);
+				w = _mm512_fmadd_ps(e[3], x, _mm512_fmadd_ps(e[7], y, w));
+				ox = _mm512_div_ps(ox, w);
+				oy = _mm512_div_ps(oy, w);
+				oz = _mm512_div_ps(oz, w);
+			}
+		}
+
+		// Four groups of four points, one per 128-bit lane. Lane k holds the floats
+		// at p + 12 * k, which are elements 4 * k on from p + 8 * k; masking keeps
+		// the other elements from being touched.
+		GLM_TARGET_AVX512 GLM_FUNC_QUALIFIER static __m512 load_lanes(float const* p)
+		{
+			__m512 v = _mm512_maskz_loadu_ps(0x000F, p);
+			v = _mm512_mask_loadu_ps(v, 0x00F0, p + 8);
+			v = _mm512_mask_loadu_ps(v, 0x0F00, p + 16);
+			return _mm512_mask_loadu_ps(v, 0xF000, p + 24);
+		}
+
+		GLM_TARGET_AVX512 GLM_FUNC_QUALIFIER static void store_lanes(float* p, __m512 v)
+		{
+			_mm512_mask_storeu_ps(p, 0x000F, v);
+			_mm512_mask_storeu_ps(p + 8, 0x00F0, v);
+			_mm512_mask_storeu_ps(p + 16, 0x0F00, v);
+			_mm512_mask_storeu_ps(p + 24, 0xF000, v);
+		}
+
+		template<transform_batch_kind K>
+		GLM_TARGET_AVX512 GLM_FUNC_QUALIFIER static std::size_t aos3(float const* m, float const* in, float* out, std::size_t count)
+		{
+			__m512 e[16];
+			broadcast(m, e);
+			std::size_t i = 0;
+			for(; i + width <= count; i += width)
+			{
+				float const* p = in + 3 * i;
+				__m512 const a = load_lanes(p), b = load_lanes(p + 4), c = load_lanes(p + 8);
+				__m512 const xy = _mm512_shuffle_ps(b, c, _MM_SHUFFLE(2, 1, 3, 2));
+				__m512 const yz = _mm512_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 2, 1));
+				__m512 ox, oy, oz;
+				apply<K>(e, _mm512_shuffle_ps(a, xy, _MM_SHUFFLE(2, 0, 3, 0)), _mm512_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0)),
+					_mm512_shuffle_ps(yz, c, _MM_SHUFFLE(3, 0, 3, 1)), ox, oy, oz);
+
+				__m512 const rxy = _mm512_shuffle_ps(ox, oy, _MM_SHUFFLE(2, 0, 2, 0));
+				__m512 const ryz = _mm512_shuffle_ps(oy, oz, _MM_SHUFFLE(3, 1, 3, 1));
+				__m512 const rzx = _mm512_shuffle_ps(oz, ox, _MM_SHUFFLE(3, 1, 2, 0));
+				store_lanes(out + 3 * i, _mm512_shuffle_ps(rxy, rzx, _MM_SHUFFLE(2, 0, 2, 0)));
+				store_lanes(out + 3 * i + 4, _mm512_shuffle_ps(ryz, rxy, _MM_SHUFFLE(3, 1, 2, 0)));
+				store_lanes(out + 3 * i + 8, _mm512_shuffle_ps(rzx, ryz, _MM_SHUFFLE(3, 1, 3, 1)));
+			}
+			return i;
+		}
+
+		template<transform_batch_kind K>
+		GLM_TARGET_AVX512 GLM_FUNC_QUALIFIER static std::size_t soa3(float const* m, float const* x, float const* y, float const* z, float* outX, float* outY, float* outZ, std::size_t count)
+		{
+			__m512 e[16];
+			broadcast(m, e);
+			std::size_t i = 0;
+			for(; i + width <= count; i += width)
+			{
+				__m512 ox, oy, oz;
+				apply<K>(e, _mm512_loadu_ps(x + i), _mm512_loadu_ps(y + i), _mm512_loadu_ps(z + i), ox, oy, oz);
+				_mm512_storeu_ps(outX + i, ox);
+				_mm512_storeu_ps(outY + i, oy);
+				_mm512_storeu_ps(outZ + i, oz);
+			}
+			return i;
+		}
+
+		// Written with the zero-masked broadcast and shuffle because the plain
+		// broadcast and permute trip -Wmaybe-uninitialized in the GCC 12 headers.
+		GLM_TARGET_AVX512 GLM_FUNC_QUALIFIER static std::size_t aos4(float const* m, float const* in, float* out, std::size_t count)
+		{
+			__m512 const c0 = _mm512_maskz_broadcast_f32x4(0xFFFF, _mm_loadu_ps(m));
+			__m512 const c1 = _mm512_maskz_broadcast_f32x4(0xFFFF, _mm_loadu_ps(m + 4));
+			__m512 const c2 = _mm512_maskz_broadcast_f32x4(0xFFFF, _mm_loadu_ps(m + 8));
+			__m512 const c3 = _mm512_maskz_broadcast_f32x4(0xFFFF, _mm_loadu_ps(m + 12));
+			std::size_t i = 0;
+			for(; i + 4 <= count; i += 4)
+			{
+				__m512 const v = _mm512_loadu_ps(in + 4 * i);
+				__m512 r = _mm512_mul_ps(c3, _mm512_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)));
+				r = _mm512_fmadd_ps(c2, _mm512_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2)), r);
+				r = _mm512_fmadd_ps(c1, _mm512_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)), r);
+				r = _mm512_fmadd_ps(c0, _mm512_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0)), r);
+				_mm512_storeu_ps(out + 4 * i, r);
+			}
+			return i;
+		}
+	};
+#	endif
+
+#	if (GLM_ARCH & GLM_ARCH_AVX2_BIT) && defined(__AVX512F__)
+	typedef transform_batch_avx512 transform_batch_simd;
+#	elif GLM_ARCH & GLM_ARCH_AVX2_BIT
+	typedef transform_batch_avx2 transform_batch_simd;
+#	elif GLM_ARCH & GLM_ARCH_SSE2_BIT
+	typedef transform_batch_sse2 transform_batch_simd;
+#	endif
+
+	template<typename T, qualifier Q>
+	struct compute_transform_batch
+	{
+		template<transform_batch_kind K>
+		GLM_FUNC_QUALIFIER static void aos3(mat<4, 4, T, Q> const& m, vec<3, T, Q> const* in, vec<3, T, Q>* out, std::size_t count)
+		{
+			transform_batch_scalar_aos3<K>(m, in, out, 0, count);
+		}
+
+		template<transform_batch_kind K>
+		GLM_FUNC_QUALIFIER static void soa3(mat<4, 4, T, Q> const& m, T const* x, T const* y, T const* z, T* outX, T* outY, T* outZ, std::size_t count)
+		{
+			transform_batch_scalar_soa3<K>(m, x, y, z, outX, outY, outZ, 0, count);
+		}
+
+		GLM_FUNC_QUALIFIER static void aos4(mat<4, 4, T, Q> const& m, vec<4, T, Q> const* in, vec<4, T, Q>* out, std::size_t count)
+		{
+			transform_batch_scalar_aos4(m, in, out, 0, count);
+		}
+	};
+
+#	if GLM_ARCH & GLM_ARCH_SSE2_BIT
+	// Aligned vec3 is padded to 16 bytes, so only packed vec3 arrays are read as
+	// runs of floats.
+	template<qualifier Q>
+	struct compute_transform_batch<float, Q>
+	{
+		template<transform_batch_kind K>
+		GLM_FUNC_QUALIFIER static void aos3(mat<4, 4, float, Q> const& m, vec<3, float, Q> const* in, vec<3, float, Q>* out, std::size_t count)
+		{
+			std::size_t done = 0;
+			if(sizeof(vec<3, float, Q>) == 3 * sizeof(float))
+				done = transform_batch_simd::aos3<K>(&m[0][0], &in[0][0], &out[0][0], count);
+			transform_batch_scalar_aos3<K>(m, in, out, done, count);
+		}
+
+		template<transform_batch_kind K>
+		GLM_FUNC_QUALIFIER static void soa3(mat<4, 4, float, Q> const& m, float const* x, float const* y, float const* z, float* outX, float* outY, float* outZ, std::size_t count)
+		{
+			std::size_t const done = transform_batch_simd::soa3<K>(&m[0][0], x, y, z, outX, outY, outZ, count);
+			transform_batch_scalar_soa3<K>(m, x, y, z, outX, outY, outZ, done, count);
+		}
+
+		GLM_FUNC_QUALIFIER static void aos4(mat<4, 4, float, Q> const& m, vec<4, float, Q> const* in, vec<4, float, Q>* out, std::size_t count)
+		{
+			std::size_t const done = transform_batch_simd::aos4(&m[0][0], &in[0][0], &out[0][0], count);
+			transform_batch_scalar_aos4(m, in, out, done, count);
+		}
+	};
+#	endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
+}//namespace detail
+
+	template<typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void transformPositions(mat<4, 4, T, Q> const& m, vec<3, T, Q> const* in, vec<3, T, Q>* out, std::size_t count)
+	{
+		detail::compute_transform_batch<T, Q>::template aos3<detail::transform_batch_position>(m, in, out, count);
+	}
+
+	template<typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void transformDirections(mat<4, 4, T, Q> const& m, vec<3, T, Q> const* in, vec<3, T, Q>* out, std::size_t count)
+	{
+		detail::compute_transform_batch<T, Q>::template aos3<detail::transform_batch_direction>(m, in, out, count);
+	}
+
+	template<typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void transformProjective(mat<4, 4, T, Q> const& m, vec<3, T, Q> const* in, vec<3, T, Q>* out, std::size_t count)
+	{
+		detail::compute_transform_batch<T, Q>::template aos3<detail::transform_batch_projective>(m, in, out, count);
+	}
+
+	template<typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void transformVectors(mat<4, 4, T, Q> const& m, vec<4, T, Q> const* in, vec<4, T, Q>* out, std::size_t count)
+	{
+		detail::compute_transform_batch<T, Q>::aos4(m, in, out, count);
+	}
+
+	template<typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void transformPositions(mat<4, 4, T, Q> const& m, T const* x, T const* y, T const* z, T* outX, T* outY, T* outZ, std::size_t count)
+	{
+		detail::compute_transform_batch<T, Q>::template soa3<detail::transform_batch_position>(m, x, y, z, outX, outY, outZ, count);
+	}
+
+	template<typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void transformDirections(mat<4, 4, T, Q> const& m, T const* x, T const* y, T const* z, T* outX, T* outY, T* outZ, std::size_t count)
+	{
+		detail::compute_transform_batch<T, Q>::template soa3<detail::transform_batch_direction>(m, x, y, z, outX, outY, outZ, count);
+	}
+
+	template<typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void transformProjective(mat<4, 4, T, Q> const& m, T const* x, T const* y, T const* z, T* outX, T* outY, T* outZ, std::size_t count)
+	{
+		detail::compute_transform_batch<T, Q>::template soa3<detail::transform_batch_projective>(m, x, y, z, outX, outY, outZ, count);
+	}
+
+	GLM_FUNC_QUALIFIER char const* transformBatchIsa()
+	{
+#		if (GLM_ARCH & GLM_ARCH_AVX2_BIT) && defined(__AVX512F__)
+			return "AVX-512";
+#		elif GLM_ARCH & GLM_ARCH_AVX2_BIT
+			return "AVX2";
+#		elif GLM_ARCH & GLM_ARCH_SSE2_BIT
+			return "SSE2";
+#		else
+			return "scalar";
+#		endif
+	}
+}//namespace glm
@@ -3,7 +3,7 @@
 
 #pragma once
 
-#include "platform.h"
+#include "common.h"
 
 #if GLM_ARCH & GLM_ARCH_SSE2_BIT
 
@@ -17,4 +17,272 @@ GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_sqrt_lowp(glm_f32vec4 x)
 	return _mm_mul_ps(_mm_rsqrt_ps(x), x);
 }
 
+// exp2, exp, log2, log and pow. The plain functions stay within 2 ULPs of
+// libm and follow it for zeros, infinities, NaNs and denormals; the _lowp
+// ones use shorter polynomials for a relative error below 1e-4. The
+// polynomials are Cephes' for exp, exp2 and log, and minimax fits for the
+// rest.
+
+// Lanes of a where mask is set, of b elsewhere.
+GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_select(glm_f32vec4 mask, glm_f32vec4 a, glm_f32vec4 b)
+{
+	return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+// p * 2^n for n in [-125, 130], in two steps, each by a normal power of
+// two, so that the result can overflow to infinity.
+GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_ldexp_normal(glm_f32vec4 p, glm_i32vec4 n)
+{
+	glm_i32vec4 const n1 = _mm_srai_epi32(n, 1);
+	glm_i32vec4 const n2 = _mm_sub_epi32(n, n1);
+	glm_f32vec4 const s1 = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(n1, _mm_set1_epi32(127)), 23));
+	glm_f32vec4 const s2 = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(n2, _mm_set1_epi32(127)), 23));
+	return _mm_mul_ps(_mm_mul_ps(p, s1), s2);
+}
+
+// p * 2^n for p in [0.5, 2) and n in [-151, 130]. Multiplying into the
+// denormals costs a microcode assist of a hundred cycles or more on most x86
+// CPUs, so lanes with n below -125 are built from their bit pattern instead:
+// p * 2^(n + 149) rounded to an integer below 2^24, which is also the bit
+// pattern of the smallest normals. NaN lanes of p stay NaN.
+GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_ldexp(glm_f32vec4 p, glm_i32vec4 n)
+{
+	glm_i32vec4 const Low = _mm_set1_epi32(-125);
+	glm_i32vec4 const Small = _mm_cmplt_epi32(n, Low);
+	if(_mm_movemask_epi8(Small) == 0)
+		return glm_vec4_ldexp_normal(p, n);
+
+	glm_i32vec4 const Normal = _mm_or_si128(_mm_andnot_si128(Small, n), _mm_and_si128(Small, Low));
+	glm_i32vec4 const Denormal = _mm_or_si128(_mm_and_si128(Small, n), _mm_andnot_si128(Small, Low));
+	glm_f32vec4 const sd = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(Denormal, _mm_set1_epi32(149 + 127)), 23));
+	glm_f32vec4 const d = _mm_castsi128_ps(_mm_cvtps_epi32(_mm_mul_ps(p, sd)));
+	return glm_vec4_select(_mm_and_ps(_mm_castsi128_ps(Small), _mm_cmpord_ps(p, p)), d, glm_vec4_ldexp_normal(p, Normal));
+}
+
+// 2^f for f in [-0.5, 0.5]
+GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_exp2_poly(glm_f32vec4 f)
+{
+	glm_f32vec4 p = _mm_set1_ps(1.535336188319500e-4f);
+	p = glm_vec4_fma(p, f, _mm_set1_ps(1.339887440266574e-3f));
+	p = glm_vec4_fma(p, f, _mm_set1_ps(9.618437357674640e-3f));
+	p = glm_vec4_fma(p, f, _mm_set1_ps(5.550332471162809e-2f));
+	p = glm_vec4_fma(p, f, _mm_set1_ps(2.402264791363012e-1f));
+	p = glm_vec4_fma(p, f, _mm_set1_ps(6.931472028550421e-1f));
+	return glm_vec4_fma(p, f, _mm_set1_ps(1.0f));
+}
+
+GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_exp2_poly_lowp(glm_f32vec4 f)
+{
+	glm_f32vec4 p = _mm_set1_ps(9.6567102885e-3f);
+	p = glm_vec4_fma(p, f, _mm_set1_ps(5.5838282946e-2f));
+	p = glm_vec4_fma(p, f, _mm_set1_ps(2.4022530097e-1f));
+	p = glm_vec4_fma(p, f, _mm_set1_ps(6.9313673388e-1f));
+	return glm_vec4_fma(p, f, _mm_set1_ps(1.0f));
+}
+
+// x clamped to [-151, 130], where the result is already 0 or infinite.
+// min and max return their second operand for NaN, so NaN passes through.
+GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_exp2_clamp(glm_f32vec4 x)
+{
+	return _mm_max_ps(_mm_set1_ps(-151.0f), _mm_min_ps(_mm_set1_ps(130.0f), x));
+}
+
+GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_exp2(glm_f32vec4 x)
+{
+	glm_f32vec4 const c = glm_vec4_exp2_clamp(x);
+	glm_i32vec4 const n = _mm_cvtps_epi32(c);
+	glm_f32vec4 const f = _mm_sub_ps(c, _mm_cvtepi32_ps(n));
+	return glm_vec4_ldexp(glm_vec4_exp2_poly(f), n);
+}
+
+GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_exp2_lowp(glm_f32vec4 x)
+{
+	glm_f32vec4 const c = glm_vec4_exp2_clamp(x);
+	glm_i32vec4 const n = _mm_cvtps_epi32(c);
+	glm_f32vec4 const f = _mm_sub_ps(c, _mm_cvtepi32_ps(n));
+	return glm_vec4_ldexp(glm_vec4_exp2_poly_lowp(f), n);
+}
+
+// x = n ln2 + r with ln2 split in two (Cody and Waite), so r is exact
+// enough for the polynomial.
+GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_exp(glm_f32vec4 x)
+{
+	glm_f32vec4 const c = _mm_max_ps(_mm_set1_ps(-105.0f), _mm_min_ps(_mm_set1_ps(90.0f), x));
+	glm_i32vec4 const n = _mm_cvtps_epi32(_mm_mul_ps(c, _mm_set1_ps(1.44269504088896341f)));
+	glm_f32vec4 const nf = _mm_cvtepi32_ps(n);
+	glm_f32vec4 r = _mm_sub_ps(c, _mm_mul_ps(nf, _mm_set1_ps(0.693359375f)));
+	r = _mm_sub_ps(r, _mm_mul_ps(nf, _mm_set1_ps(-2.12194440e-4f)));
+
+	glm_f32vec4 p = _mm_set1_ps(1.9875691500e-4f);
+	p = glm_vec4_fma(p, r, _mm_set1_ps(1.3981999507e-3f));
+	p = glm_vec4_fma(p, r, _mm_set1_ps(8.3334519073e-3f));
+	p = glm_vec4_fma(p, r, _mm_set1_ps(4.1665795894e-2f));
+	p = glm_vec4_fma(p, r, _mm_set1_ps(1.6666665459e-1f));
+	p = glm_vec4_fma(p, r, _mm_set1_ps(5.0000001201e-1f));
+	p = glm_vec4_fma(p, _mm_mul_ps(r, r), _mm_add_ps(r, _mm_set1_ps(1.0f)));
+	return glm_vec4_ldexp(p, n);
+}
+
+GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_exp_lowp(glm_f32vec4 x)
+{
+	return glm_vec4_exp2_lowp(_mm_mul_ps(x, _mm_set1_ps(1.44269504088896341f)));
+}
+
+// Splits positive x into 2^e * m with m in [sqrt(1/2), sqrt(2)); denormals
+// are scaled into the normal range first. Zeros, infinities, NaNs and
+// negative numbers give garbage, for glm_vec4_log_special to replace.
+GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_log_reduce(glm_f32vec4 x, glm_f32vec4& m)
+{
+	glm_f32vec4 const denormal = _mm_cmplt_ps(x, _mm_set1_ps(1.17549435e-38f));
+	glm_f32vec4 const scaled = glm_vec4_select(denormal, _mm_mul_ps(x, _mm_set1_ps(33554432.0f)), x);
+	glm_i32vec4 const bits = _mm_sub_epi32(_mm_castps_si128(scaled), _mm_set1_epi32(0x3f3504f3));
+	glm_i32vec4 const e = _mm_sub_epi32(_mm_srai_epi32(bits, 23), _mm_and_si128(_mm_castps_si128(denormal), _mm_set1_epi32(25)));
+	m = _mm_castsi128_ps(_mm_add_epi32(_mm_and_si128(bits, _mm_set1_epi32(0x007fffff)), _mm_set1_epi32(0x3f3504f3)));
+	return _mm_cvtepi32_ps(e);
+}
+
+// log of 0 is -inf, of +inf +inf, of negative numbers and NaN NaN.
+GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_log_special(glm_f32vec4 x, glm_f32vec4 r)
+{
+	glm_f32vec4 const inf = _mm_castsi128_ps(_mm_set1_epi32(0x7f800000));
+	r = glm_vec4_select(_mm_cmpeq_ps(x, _mm_setzero_ps()), _mm_sub_ps(_mm_setzero_ps(), inf), r);
+	r = glm_vec4_select(_mm_cmpeq_ps(x, inf), inf, r);
+	return _mm_or_ps(r, _mm_cmpnge_ps(x, _mm_setzero_ps()));
+}
+
+// log(1 + t) - t + t^2 / 2 for t = m - 1
+GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_log_poly(glm_f32vec4 t, glm_f32vec4 t2)
+{
+	glm_f32vec4 p = _mm_set1_ps(7.0376836292e-2f);
+	p = glm_vec4_fma(p, t, _mm_set1_ps(-1.1514610310e-1f));
+	p = glm_vec4_fma(p, t, _mm_set1_ps(1.1676998740e-1f));
+	p = glm_vec4_fma(p, t, _mm_set1_ps(-1.2420140846e-1f));
+	p = glm_vec4_fma(p, t, _mm_set1_ps(1.4249322787e-1f));
+	p = glm_vec4_fma(p, t, _mm_set1_ps(-1.6668057665e-1f));
+	p = glm_vec4_fma(p, t, _mm_set1_ps(2.0000714765e-1f));
+	p = glm_vec4_fma(p, t, _mm_set1_ps(-2.4999993993e-1f));
+	p = glm_vec4_fma(p, t, _mm_set1_ps(3.3333331174e-1f));
+	return _mm_mul_ps(_mm_mul_ps(p, t), t2);
+}
+
+GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_log(glm_f32vec4 x)
+{
+	glm_f32vec4 m;
+	glm_f32vec4 const e = glm_vec4_log_reduce(x, m);
+	glm_f32vec4 const t = _mm_sub_ps(m, _mm_set1_ps(1.0f));
+	glm_f32vec4 const t2 = _mm_mul_ps(t, t);
+	glm_f32vec4 y = glm_vec4_log_poly(t, t2);
+	y = glm_vec4_fma(e, _mm_set1_ps(-2.12194440e-4f), y);
+	y = glm_vec4_fma(t2, _mm_set1_ps(-0.5f), y);
+	glm_f32vec4 const r = glm_vec4_fma(e, _mm_set1_ps(0.693359375f), _mm_add_ps(t, y));
+	return glm_vec4_log_special(x, r);
+}
+
+// log2(e) - 1 scales the small terms so that e and t are added unscaled.
+GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_log2(glm_f32vec4 x)
+{
+	glm_f32vec4 m;
+	glm_f32vec4 const e = glm_vec4_log_reduce(x, m);
+	glm_f32vec4 const t = _mm_sub_ps(m, _mm_set1_ps(1.0f));
+	glm_f32vec4 const t2 = _mm_mul_ps(t, t);
+	glm_f32vec4 const y = glm_vec4_fma(t2, _mm_set1_ps(-0.5f), glm_vec4_log_poly(t, t2));
+	glm_f32vec4 const Log2eMinusOne = _mm_set1_ps(0.44269504088896340736f);
+	glm_f32vec4 r = glm_vec4_fma(y, Log2eMinusOne, glm_vec4_fma(t, Log2eMinusOne, y));
+	r = _mm_add_ps(_mm_add_ps(r, t), e);
+	return glm_vec4_log_special(x, r);
+}
+
+// log2(m) = s * P(s^2) with s = (m - 1) / (m + 1)
+GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_log2_lowp(glm_f32vec4 x)
+{
+	glm_f32vec4 m;
+	glm_f32vec4 const e = glm_vec4_log_reduce(x, m);
+	glm_f32vec4 const one = _mm_set1_ps(1.0f);
+	glm_f32vec4 const s = _mm_div_ps(_mm_sub_ps(m, one), _mm_add_ps(m, one));
+	glm_f32vec4 const s2 = _mm_mul_ps(s, s);
+	glm_f32vec4 p = glm_vec4_fma(s2, _mm_set1_ps(5.9575960690e-1f), _mm_set1_ps(9.6158894669e-1f));
+	p = glm_vec4_fma(s2, p, _mm_set1_ps(2.8853904220f));
+	return glm_vec4_log_special(x, glm_vec4_fma(s, p, e));
+}
+
+GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_log_lowp(glm_f32vec4 x)
+{
+	return _mm_mul_ps(glm_vec4_log2_lowp(x), _mm_set1_ps(0.69314718055994531f));
+}
+
+// The cases of std::pow that 2^(y log2|x|) gets wrong: zero and infinite
+// bases, a base of +-1, negative bases, NaNs and a zero exponent.
+GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_pow_special(glm_f32vec4 x, glm_f32vec4 y, glm_f32vec4 r)
+{
+	glm_f32vec4 const zero = _mm_setzero_ps();
+	glm_f32vec4 const one = _mm_set1_ps(1.0f);
+	glm_f32vec4 const inf = _mm_castsi128_ps(_mm_set1_epi32(0x7f800000));
+	glm_f32vec4 const ax = glm_vec4_abs(x);
+	glm_f32vec4 const ay = glm_vec4_abs(y);
+
+	// Floats from 2^23 up are integers, and from 2^24 up even.
+	glm_i32vec4 const iy = _mm_cvttps_epi32(y);
+	glm_f32vec4 const integer = _mm_or_ps(_mm_cmpge_ps(ay, _mm_set1_ps(8388608.0f)), _mm_cmpeq_ps(_mm_cvtepi32_ps(iy), y));
+	glm_f32vec4 const odd = _mm_and_ps(_mm_and_ps(integer, _mm_cmplt_ps(ay, _mm_set1_ps(16777216.0f))),
+		_mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(iy, _mm_set1_epi32(1)), _mm_set1_epi32(1))));
+	glm_f32vec4 const negative = _mm_castsi128_ps(_mm_srai_epi32(_mm_castps_si128(x), 31));
+	glm_f32vec4 const yNegative = _mm_cmplt_ps(y, zero);
+
+	r = glm_vec4_select(_mm_cmpeq_ps(ax, zero), _mm_and_ps(yNegative, inf), r);
+	r = glm_vec4_select(_mm_cmpeq_ps(ax, inf), _mm_andnot_ps(yNegative, inf), r);
+	r = glm_vec4_select(_mm_cmpeq_ps(ax, one), one, r);
+	r = _mm_xor_ps(r, _mm_and_ps(_mm_and_ps(negative, odd), _mm_set1_ps(-0.0f)));
+	r = _mm_or_ps(r, _mm_andnot_ps(integer, _mm_and_ps(_mm_cmplt_ps(x, zero), _mm_cmpgt_ps(x, _mm_sub_ps(zero, inf)))));
+	r = _mm_or_ps(r, _mm_cmpunord_ps(x, y));
+	return glm_vec4_select(_mm_or_ps(_mm_cmpeq_ps(y, zero), _mm_cmpeq_ps(x, one)), one, r);
+}
+
+// y log2|x| needs more than float precision once it grows past a few units,
+// so pow runs the logarithm and the exponential in double, two lanes at a
+// time, and rounds once when converting back. The result stays within 1 ULP.
+GLM_FUNC_QUALIFIER glm_f64vec2 glm_vec2_pow_f64(glm_f64vec2 m, glm_f64vec2 e, glm_f64vec2 y)
+{
+	glm_f64vec2 const one = _mm_set1_pd(1.0);
+	glm_f64vec2 const s = _mm_div_pd(_mm_sub_pd(m, one), _mm_add_pd(m, one));
+	glm_f64vec2 const s2 = _mm_mul_pd(s, s);
+	glm_f64vec2 p = _mm_set1_pd(3.4071204157e-1);
+	p = _mm_add_pd(_mm_mul_pd(p, s2), _mm_set1_pd(4.1167376624e-1));
+	p = _mm_add_pd(_mm_mul_pd(p, s2), _mm_set1_pd(5.7708356600e-1));
+	p = _mm_add_pd(_mm_mul_pd(p, s2), _mm_set1_pd(9.6179667345e-1));
+	p = _mm_add_pd(_mm_mul_pd(p, s2), _mm_set1_pd(2.8853900818));
+	glm_f64vec2 t = _mm_mul_pd(y, _mm_add_pd(e, _mm_mul_pd(s, p)));
+	t = _mm_max_pd(_mm_set1_pd(-160.0), _mm_min_pd(_mm_set1_pd(160.0), t));
+
+	glm_i32vec4 const n = _mm_cvtpd_epi32(t);
+	glm_f64vec2 const f = _mm_sub_pd(t, _mm_cvtepi32_pd(n));
+	glm_f64vec2 q = _mm_set1_pd(1.3250805518e-6);
+	q = _mm_add_pd(_mm_mul_pd(q, f), _mm_set1_pd(1.5303700711e-5));
+	q = _mm_add_pd(_mm_mul_pd(q, f), _mm_set1_pd(1.5403475187e-4));
+	q = _mm_add_pd(_mm_mul_pd(q, f), _mm_set1_pd(1.3333478474e-3));
+	q = _mm_add_pd(_mm_mul_pd(q, f), _mm_set1_pd(9.6181291352e-3));
+	q = _mm_add_pd(_mm_mul_pd(q, f), _mm_set1_pd(5.5504109063e-2));
+	q = _mm_add_pd(_mm_mul_pd(q, f), _mm_set1_pd(2.4022650696e-1));
+	q = _mm_add_pd(_mm_mul_pd(q, f), _mm_set1_pd(6.9314718056e-1));
+	q = _mm_add_pd(_mm_mul_pd(q, f), one);
+	glm_i32vec4 const bits = _mm_slli_epi64(_mm_unpacklo_epi32(_mm_add_epi32(n, _mm_set1_epi32(1023)), _mm_setzero_si128()), 52);
+	return _mm_mul_pd(q, _mm_castsi128_pd(bits));
+}
+
+GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_pow(glm_f32vec4 x, glm_f32vec4 y)
+{
+	glm_f32vec4 m;
+	glm_f32vec4 const e = glm_vec4_log_reduce(glm_vec4_abs(x), m);
+	glm_f64vec2 const lo = glm_vec2_pow_f64(_mm_cvtps_pd(m), _mm_cvtps_pd(e), _mm_cvtps_pd(y));
+	glm_f64vec2 const hi = glm_vec2_pow_f64(_mm_cvtps_pd(_mm_movehl_ps(m, m)), _mm_cvtps_pd(_mm_movehl_ps(e, e)), _mm_cvtps_pd(_mm_movehl_ps(y, y)));
+	return glm_vec4_pow_special(x, y, _mm_movelh_ps(_mm_cvtpd_ps(lo), _mm_cvtpd_ps(hi)));
+}
+
+// The logarithm is accurate enough that y log2|x| keeps the error below
+// 1e-4 over the whole float range.
+GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_pow_lowp(glm_f32vec4 x, glm_f32vec4 y)
+{
+	glm_f32vec4 const r = glm_vec4_exp2_lowp(_mm_mul_ps(y, glm_vec4_log2_lowp(glm_vec4_abs(x))));
+	return glm_vec4_pow_special(x, y, r);
+}
+
 #endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
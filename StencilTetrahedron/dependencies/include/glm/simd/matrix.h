@@ -1025,4 +1025,175 @@ GLM_FUNC_QUALIFIER void glm_mat4_outerProduct(__m128 const& c, __m128 const& r,
 	out[3] = _mm_mul_ps(c, _mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 3, 3, 3)));
 }
 
+#if GLM_ARCH & GLM_ARCH_AVX_BIT
+
+// a * b + c, fused when the compiler may emit FMA. AVX2 does not imply FMA
+// on GCC and Clang, which only allow it with -mfma.
+GLM_FUNC_QUALIFIER glm_dvec4 glm_dvec4_fma(glm_dvec4 a, glm_dvec4 b, glm_dvec4 c)
+{
+#	if (GLM_ARCH & GLM_ARCH_AVX2_BIT) && (defined(__FMA__) || (GLM_COMPILER & GLM_COMPILER_VC))
+		return _mm256_fmadd_pd(a, b, c);
+#	else
+		return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+#	endif
+}
+
+// The three lane patterns the cofactor expansions below are built from. AVX
+// has no shuffle across the 128-bit halves, so it takes two instructions.
+GLM_FUNC_QUALIFIER glm_dvec4 glm_dvec4_swizzle_yxxx(glm_dvec4 v)
+{
+#	if GLM_ARCH & GLM_ARCH_AVX2_BIT
+		return _mm256_permute4x64_pd(v, _MM_SHUFFLE(0, 0, 0, 1));
+#	else
+		return _mm256_permute_pd(_mm256_permute2f128_pd(v, v, 0x00), 0x1);
+#	endif
+}
+
+GLM_FUNC_QUALIFIER glm_dvec4 glm_dvec4_swizzle_zzyy(glm_dvec4 v)
+{
+#	if GLM_ARCH & GLM_ARCH_AVX2_BIT
+		return _mm256_permute4x64_pd(v, _MM_SHUFFLE(1, 1, 2, 2));
+#	else
+		return _mm256_permute_pd(_mm256_permute2f128_pd(v, v, 0x01), 0xC);
+#	endif
+}
+
+GLM_FUNC_QUALIFIER glm_dvec4 glm_dvec4_swizzle_wwwz(glm_dvec4 v)
+{
+#	if GLM_ARCH & GLM_ARCH_AVX2_BIT
+		return _mm256_permute4x64_pd(v, _MM_SHUFFLE(2, 3, 3, 3));
+#	else
+		return _mm256_permute_pd(_mm256_permute2f128_pd(v, v, 0x11), 0x7);
+#	endif
+}
+
+GLM_FUNC_QUALIFIER glm_dvec4 glm_dmat4_mul_dvec4(glm_dvec4 const m[4], glm_dvec4 v)
+{
+	glm_dvec4 const lo = _mm256_permute2f128_pd(v, v, 0x00);
+	glm_dvec4 const hi = _mm256_permute2f128_pd(v, v, 0x11);
+
+	glm_dvec4 const add0 = glm_dvec4_fma(m[1], _mm256_permute_pd(lo, 0xF), _mm256_mul_pd(m[0], _mm256_permute_pd(lo, 0x0)));
+	glm_dvec4 const add1 = glm_dvec4_fma(m[3], _mm256_permute_pd(hi, 0xF), _mm256_mul_pd(m[2], _mm256_permute_pd(hi, 0x0)));
+	return _mm256_add_pd(add0, add1);
+}
+
+GLM_FUNC_QUALIFIER void glm_dmat4_mul(glm_dvec4 const in1[4], glm_dvec4 const in2[4], glm_dvec4 out[4])
+{
+	glm_dvec4 const Result0 = glm_dmat4_mul_dvec4(in1, in2[0]);
+	glm_dvec4 const Result1 = glm_dmat4_mul_dvec4(in1, in2[1]);
+	glm_dvec4 const Result2 = glm_dmat4_mul_dvec4(in1, in2[2]);
+	glm_dvec4 const Result3 = glm_dmat4_mul_dvec4(in1, in2[3]);
+
+	out[0] = Result0;
+	out[1] = Result1;
+	out[2] = Result2;
+	out[3] = Result3;
+}
+
+GLM_FUNC_QUALIFIER void glm_dmat4_transpose(glm_dvec4 const in[4], glm_dvec4 out[4])
+{
+	glm_dvec4 const tmp0 = _mm256_unpacklo_pd(in[0], in[1]);
+	glm_dvec4 const tmp1 = _mm256_unpackhi_pd(in[0], in[1]);
+	glm_dvec4 const tmp2 = _mm256_unpacklo_pd(in[2], in[3]);
+	glm_dvec4 const tmp3 = _mm256_unpackhi_pd(in[2], in[3]);
+
+	out[0] = _mm256_permute2f128_pd(tmp0, tmp2, 0x20);
+	out[1] = _mm256_permute2f128_pd(tmp1, tmp3, 0x20);
+	out[2] = _mm256_permute2f128_pd(tmp0, tmp2, 0x31);
+	out[3] = _mm256_permute2f128_pd(tmp1, tmp3, 0x31);
+}
+
+// Adjugate of in, laid out as compute_inverse<4, 4> builds it before the
+// division: Fac, Vec and Inv are that code's vectors, one row of in at a
+// time. Returns the determinant in every lane.
+GLM_FUNC_QUALIFIER glm_dvec4 glm_dmat4_adjugate(glm_dvec4 const in[4], glm_dvec4 out[4])
+{
+	glm_dvec4 Row[4];
+	glm_dmat4_transpose(in, Row);
+
+	// For row r: A = (m[2][r], m[2][r], m[1][r], m[1][r]),
+	// B = (m[3][r], m[3][r], m[3][r], m[2][r]), Vec = (m[1][r], m[0][r], m[0][r], m[0][r]).
+	glm_dvec4 const A0 = glm_dvec4_swizzle_zzyy(Row[0]);
+	glm_dvec4 const A1 = glm_dvec4_swizzle_zzyy(Row[1]);
+	glm_dvec4 const A2 = glm_dvec4_swizzle_zzyy(Row[2]);
+	glm_dvec4 const A3 = glm_dvec4_swizzle_zzyy(Row[3]);
+
+	glm_dvec4 const B0 = glm_dvec4_swizzle_wwwz(Row[0]);
+	glm_dvec4 const B1 = glm_dvec4_swizzle_wwwz(Row[1]);
+	glm_dvec4 const B2 = glm_dvec4_swizzle_wwwz(Row[2]);
+	glm_dvec4 const B3 = glm_dvec4_swizzle_wwwz(Row[3]);
+
+	glm_dvec4 const Vec0 = glm_dvec4_swizzle_yxxx(Row[0]);
+	glm_dvec4 const Vec1 = glm_dvec4_swizzle_yxxx(Row[1]);
+	glm_dvec4 const Vec2 = glm_dvec4_swizzle_yxxx(Row[2]);
+	glm_dvec4 const Vec3 = glm_dvec4_swizzle_yxxx(Row[3]);
+
+	glm_dvec4 const Fac0 = _mm256_sub_pd(_mm256_mul_pd(A2, B3), _mm256_mul_pd(B2, A3));
+	glm_dvec4 const Fac1 = _mm256_sub_pd(_mm256_mul_pd(A1, B3), _mm256_mul_pd(B1, A3));
+	glm_dvec4 const Fac2 = _mm256_sub_pd(_mm256_mul_pd(A1, B2), _mm256_mul_pd(B1, A2));
+	glm_dvec4 const Fac3 = _mm256_sub_pd(_mm256_mul_pd(A0, B3), _mm256_mul_pd(B0, A3));
+	glm_dvec4 const Fac4 = _mm256_sub_pd(_mm256_mul_pd(A0, B2), _mm256_mul_pd(B0, A2));
+	glm_dvec4 const Fac5 = _mm256_sub_pd(_mm256_mul_pd(A0, B1), _mm256_mul_pd(B0, A1));
+
+	glm_dvec4 const Inv0 = glm_dvec4_fma(Vec3, Fac2, _mm256_sub_pd(_mm256_mul_pd(Vec1, Fac0), _mm256_mul_pd(Vec2, Fac1)));
+	glm_dvec4 const Inv1 = glm_dvec4_fma(Vec3, Fac4, _mm256_sub_pd(_mm256_mul_pd(Vec0, Fac0), _mm256_mul_pd(Vec2, Fac3)));
+	glm_dvec4 const Inv2 = glm_dvec4_fma(Vec3, Fac5, _mm256_sub_pd(_mm256_mul_pd(Vec0, Fac1), _mm256_mul_pd(Vec1, Fac3)));
+	glm_dvec4 const Inv3 = glm_dvec4_fma(Vec2, Fac5, _mm256_sub_pd(_mm256_mul_pd(Vec0, Fac2), _mm256_mul_pd(Vec1, Fac4)));
+
+	// SignA (+1, -1, +1, -1) and SignB (-1, +1, -1, +1) as sign bit flips
+	glm_dvec4 const SignA = _mm256_set_pd(-0.0, 0.0, -0.0, 0.0);
+	glm_dvec4 const SignB = _mm256_set_pd(0.0, -0.0, 0.0, -0.0);
+	out[0] = _mm256_xor_pd(Inv0, SignA);
+	out[1] = _mm256_xor_pd(Inv1, SignB);
+	out[2] = _mm256_xor_pd(Inv2, SignA);
+	out[3] = _mm256_xor_pd(Inv3, SignB);
+
+	// Dot of in[0] with the first row of the adjugate, summed as (x + y) + (z + w)
+	glm_dvec4 const Row0 = _mm256_permute2f128_pd(_mm256_unpacklo_pd(out[0], out[1]), _mm256_unpacklo_pd(out[2], out[3]), 0x20);
+	glm_dvec4 const Dot0 = _mm256_mul_pd(in[0], Row0);
+	glm_dvec4 const Dot1 = _mm256_hadd_pd(Dot0, Dot0);
+	return _mm256_add_pd(Dot1, _mm256_permute2f128_pd(Dot1, Dot1, 0x01));
+}
+
+// compute_determinant<4, 4>: cofactors of the first column from the 2x2
+// minors of the last two, dotted with the first.
+GLM_FUNC_QUALIFIER double glm_dmat4_determinant(glm_dvec4 const in[4])
+{
+	glm_dvec4 const V1 = glm_dvec4_swizzle_yxxx(in[1]);
+	glm_dvec4 const V2 = glm_dvec4_swizzle_yxxx(in[2]);
+	glm_dvec4 const V3 = glm_dvec4_swizzle_yxxx(in[3]);
+	glm_dvec4 const A1 = glm_dvec4_swizzle_zzyy(in[1]);
+	glm_dvec4 const A2 = glm_dvec4_swizzle_zzyy(in[2]);
+	glm_dvec4 const A3 = glm_dvec4_swizzle_zzyy(in[3]);
+	glm_dvec4 const B1 = glm_dvec4_swizzle_wwwz(in[1]);
+	glm_dvec4 const B2 = glm_dvec4_swizzle_wwwz(in[2]);
+	glm_dvec4 const B3 = glm_dvec4_swizzle_wwwz(in[3]);
+
+	// SubFactor (00, 00, 01, 02), (01, 03, 03, 04) and (02, 04, 05, 05)
+	glm_dvec4 const SubFactorX = _mm256_sub_pd(_mm256_mul_pd(A2, B3), _mm256_mul_pd(A3, B2));
+	glm_dvec4 const SubFactorY = _mm256_sub_pd(_mm256_mul_pd(V2, B3), _mm256_mul_pd(V3, B2));
+	glm_dvec4 const SubFactorZ = _mm256_sub_pd(_mm256_mul_pd(V2, A3), _mm256_mul_pd(V3, A2));
+
+	glm_dvec4 const Cof = glm_dvec4_fma(B1, SubFactorZ, _mm256_sub_pd(_mm256_mul_pd(V1, SubFactorX), _mm256_mul_pd(A1, SubFactorY)));
+	glm_dvec4 const DetCof = _mm256_xor_pd(Cof, _mm256_set_pd(-0.0, 0.0, -0.0, 0.0));
+
+	glm_dvec4 const Dot0 = _mm256_mul_pd(in[0], DetCof);
+	glm_dvec4 const Dot1 = _mm256_hadd_pd(Dot0, Dot0);
+	return _mm_cvtsd_f64(_mm_add_sd(_mm256_castpd256_pd128(Dot1), _mm256_extractf128_pd(Dot1, 1)));
+}
+
+GLM_FUNC_QUALIFIER void glm_dmat4_inverse(glm_dvec4 const in[4], glm_dvec4 out[4])
+{
+	glm_dvec4 Adjugate[4];
+	glm_dvec4 const Det = glm_dmat4_adjugate(in, Adjugate);
+	glm_dvec4 const OneOverDeterminant = _mm256_div_pd(_mm256_set1_pd(1.0), Det);
+
+	out[0] = _mm256_mul_pd(Adjugate[0], OneOverDeterminant);
+	out[1] = _mm256_mul_pd(Adjugate[1], OneOverDeterminant);
+	out[2] = _mm256_mul_pd(Adjugate[2], OneOverDeterminant);
+	out[3] = _mm256_mul_pd(Adjugate[3], OneOverDeterminant);
+}
+
+#endif//GLM_ARCH & GLM_ARCH_AVX_BIT
+
 #endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
@@ -0,0 +1,293 @@
+/// @ref simd
+/// @file glm/simd/noise.h
+
+#pragma once
+
+#include "common.h"
+
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+
+// glm::perlin and glm::simplex in 2D and 3D for four points at once, one
+// coordinate per register. Each step is the float operation gtc/noise.inl
+// performs, in the same order, so the results are those of the scalar
+// functions unless the compiler contracts multiply-adds into FMA on one
+// side only. Zeros may differ in sign.
+
+// floor for any float: glm_vec4_floor only holds below 2^23, above which
+// every float is an integer already.
+GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_floor_any(glm_f32vec4 x)
+{
+#	if GLM_ARCH & GLM_ARCH_SSE41_BIT
+		return _mm_floor_ps(x);
+#	else
+		glm_f32vec4 const Integer = _mm_cmpge_ps(glm_vec4_abs(x), _mm_set1_ps(8388608.0f));
+		return _mm_or_ps(_mm_and_ps(Integer, x), _mm_andnot_ps(Integer, glm_vec4_floor(x)));
+#	endif
+}
+
+GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_noise_fract(glm_f32vec4 x)
+{
+	return _mm_sub_ps(x, glm_vec4_floor_any(x));
+}
+
+// x < edge ? 0 : 1
+GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_noise_step(glm_f32vec4 edge, glm_f32vec4 x)
+{
+	return _mm_andnot_ps(_mm_cmplt_ps(x, edge), _mm_set1_ps(1.0f));
+}
+
+GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_noise_mix(glm_f32vec4 x, glm_f32vec4 y, glm_f32vec4 a)
+{
+	return _mm_add_ps(_mm_mul_ps(x, _mm_sub_ps(_mm_set1_ps(1.0f), a)), _mm_mul_ps(y, a));
+}
+
+// detail::mod289 and glm::mod(x, 289), which divides instead.
+GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_mod289(glm_f32vec4 x)
+{
+	glm_f32vec4 const Modulus = _mm_set1_ps(289.0f);
+	return _mm_sub_ps(x, _mm_mul_ps(glm_vec4_floor_any(_mm_mul_ps(x, _mm_set1_ps(1.0f / 289.0f))), Modulus));
+}
+
+GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_mod289_div(glm_f32vec4 x)
+{
+	glm_f32vec4 const Modulus = _mm_set1_ps(289.0f);
+	return _mm_sub_ps(x, _mm_mul_ps(Modulus, glm_vec4_floor_any(_mm_div_ps(x, Modulus))));
+}
+
+GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_permute(glm_f32vec4 x)
+{
+	return glm_vec4_mod289(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(34.0f)), _mm_set1_ps(1.0f)), x));
+}
+
+GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_taylor_inv_sqrt(glm_f32vec4 r)
+{
+	return _mm_sub_ps(_mm_set1_ps(1.79284291400159f), _mm_mul_ps(_mm_set1_ps(0.85373472095314f), r));
+}
+
+GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_fade(glm_f32vec4 t)
+{
+	glm_f32vec4 const t3 = _mm_mul_ps(_mm_mul_ps(t, t), t);
+	glm_f32vec4 const p = _mm_add_ps(_mm_mul_ps(t, _mm_sub_ps(_mm_mul_ps(t, _mm_set1_ps(6.0f)), _mm_set1_ps(15.0f))), _mm_set1_ps(10.0f));
+	return _mm_mul_ps(t3, p);
+}
+
+// One corner of 2D perlin noise: the gradient picked by the hash i, dotted
+// with the offset (fx, fy) from the corner.
+GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_perlin2_corner(glm_f32vec4 i, glm_f32vec4 fx, glm_f32vec4 fy)
+{
+	glm_f32vec4 gx = _mm_sub_ps(_mm_mul_ps(_mm_set1_ps(2.0f), glm_vec4_noise_fract(_mm_div_ps(i, _mm_set1_ps(41.0f)))), _mm_set1_ps(1.0f));
+	glm_f32vec4 gy = _mm_sub_ps(glm_vec4_abs(gx), _mm_set1_ps(0.5f));
+	gx = _mm_sub_ps(gx, glm_vec4_floor_any(_mm_add_ps(gx, _mm_set1_ps(0.5f))));
+
+	glm_f32vec4 const Norm = glm_vec4_taylor_inv_sqrt(_mm_add_ps(_mm_mul_ps(gx, gx), _mm_mul_ps(gy, gy)));
+	gx = _mm_mul_ps(gx, Norm);
+	gy = _mm_mul_ps(gy, Norm);
+	return _mm_add_ps(_mm_mul_ps(gx, fx), _mm_mul_ps(gy, fy));
+}
+
+GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_perlin2(glm_f32vec4 x, glm_f32vec4 y)
+{
+	glm_f32vec4 const One = _mm_set1_ps(1.0f);
+	glm_f32vec4 const Fx = glm_vec4_floor_any(x), Fy = glm_vec4_floor_any(y);
+	glm_f32vec4 const fx0 = _mm_sub_ps(x, Fx), fy0 = _mm_sub_ps(y, Fy);
+	glm_f32vec4 const fx1 = _mm_sub_ps(fx0, One), fy1 = _mm_sub_ps(fy0, One);
+	glm_f32vec4 const X0 = glm_vec4_permute(glm_vec4_mod289_div(Fx));
+	glm_f32vec4 const X1 = glm_vec4_permute(glm_vec4_mod289_div(_mm_add_ps(Fx, One)));
+	glm_f32vec4 const Y0 = glm_vec4_mod289_div(Fy);
+	glm_f32vec4 const Y1 = glm_vec4_mod289_div(_mm_add_ps(Fy, One));
+
+	glm_f32vec4 const n00 = glm_vec4_perlin2_corner(glm_vec4_permute(_mm_add_ps(X0, Y0)), fx0, fy0);
+	glm_f32vec4 const n10 = glm_vec4_perlin2_corner(glm_vec4_permute(_mm_add_ps(X1, Y0)), fx1, fy0);
+	glm_f32vec4 const n01 = glm_vec4_perlin2_corner(glm_vec4_permute(_mm_add_ps(X0, Y1)), fx0, fy1);
+	glm_f32vec4 const n11 = glm_vec4_perlin2_corner(glm_vec4_permute(_mm_add_ps(X1, Y1)), fx1, fy1);
+
+	glm_f32vec4 const u = glm_vec4_fade(fx0), v = glm_vec4_fade(fy0);
+	glm_f32vec4 const n = glm_vec4_noise_mix(glm_vec4_noise_mix(n00, n10, u), glm_vec4_noise_mix(n01, n11, u), v);
+	return _mm_mul_ps(_mm_set1_ps(2.3f), n);
+}
+
+// One corner of 3D perlin noise, as glm_vec4_perlin2_corner.
+GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_perlin3_corner(glm_f32vec4 i, glm_f32vec4 fx, glm_f32vec4 fy, glm_f32vec4 fz)
+{
+	glm_f32vec4 const Half = _mm_set1_ps(0.5f);
+	glm_f32vec4 const Zero = _mm_setzero_ps();
+	glm_f32vec4 gx = _mm_mul_ps(i, _mm_set1_ps(static_cast<float>(1.0 / 7.0)));
+	glm_f32vec4 gy = _mm_sub_ps(glm_vec4_noise_fract(_mm_mul_ps(glm_vec4_floor_any(gx), _mm_set1_ps(static_cast<float>(1.0 / 7.0)))), Half);
+	gx = glm_vec4_noise_fract(gx);
+	glm_f32vec4 gz = _mm_sub_ps(_mm_sub_ps(Half, glm_vec4_abs(gx)), glm_vec4_abs(gy));
+	glm_f32vec4 const sz = glm_vec4_noise_step(gz, Zero);
+	gx = _mm_sub_ps(gx, _mm_mul_ps(sz, _mm_sub_ps(glm_vec4_noise_step(Zero, gx), Half)));
+	gy = _mm_sub_ps(gy, _mm_mul_ps(sz, _mm_sub_ps(glm_vec4_noise_step(Zero, gy), Half)));
+
+	glm_f32vec4 const Norm = glm_vec4_taylor_inv_sqrt(_mm_add_ps(_mm_add_ps(_mm_mul_ps(gx, gx), _mm_mul_ps(gy, gy)), _mm_mul_ps(gz, gz)));
+	gx = _mm_mul_ps(gx, Norm);
+	gy = _mm_mul_ps(gy, Norm);
+	gz = _mm_mul_ps(gz, Norm);
+	return _mm_add_ps(_mm_add_ps(_mm_mul_ps(gx, fx), _mm_mul_ps(gy, fy)), _mm_mul_ps(gz, fz));
+}
+
+GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_perlin3(glm_f32vec4 x, glm_f32vec4 y, glm_f32vec4 z)
+{
+	glm_f32vec4 const One = _mm_set1_ps(1.0f);
+	glm_f32vec4 const Fx = glm_vec4_floor_any(x), Fy = glm_vec4_floor_any(y), Fz = glm_vec4_floor_any(z);
+	glm_f32vec4 const fx0 = _mm_sub_ps(x, Fx), fy0 = _mm_sub_ps(y, Fy), fz0 = _mm_sub_ps(z, Fz);
+	glm_f32vec4 const fx1 = _mm_sub_ps(fx0, One), fy1 = _mm_sub_ps(fy0, One), fz1 = _mm_sub_ps(fz0, One);
+	glm_f32vec4 const X0 = glm_vec4_permute(glm_vec4_mod289(Fx));
+	glm_f32vec4 const X1 = glm_vec4_permute(glm_vec4_mod289(_mm_add_ps(Fx, One)));
+	glm_f32vec4 const Y0 = glm_vec4_mod289(Fy), Y1 = glm_vec4_mod289(_mm_add_ps(Fy, One));
+	glm_f32vec4 const Z0 = glm_vec4_mod289(Fz), Z1 = glm_vec4_mod289(_mm_add_ps(Fz, One));
+
+	glm_f32vec4 const i00 = glm_vec4_permute(_mm_add_ps(X0, Y0));
+	glm_f32vec4 const i10 = glm_vec4_permute(_mm_add_ps(X1, Y0));
+	glm_f32vec4 const i01 = glm_vec4_permute(_mm_add_ps(X0, Y1));
+	glm_f32vec4 const i11 = glm_vec4_permute(_mm_add_ps(X1, Y1));
+
+	glm_f32vec4 const n000 = glm_vec4_perlin3_corner(glm_vec4_permute(_mm_add_ps(i00, Z0)), fx0, fy0, fz0);
+	glm_f32vec4 const n100 = glm_vec4_perlin3_corner(glm_vec4_permute(_mm_add_ps(i10, Z0)), fx1, fy0, fz0);
+	glm_f32vec4 const n010 = glm_vec4_perlin3_corner(glm_vec4_permute(_mm_add_ps(i01, Z0)), fx0, fy1, fz0);
+	glm_f32vec4 const n110 = glm_vec4_perlin3_corner(glm_vec4_permute(_mm_add_ps(i11, Z0)), fx1, fy1, fz0);
+	glm_f32vec4 const n001 = glm_vec4_perlin3_corner(glm_vec4_permute(_mm_add_ps(i00, Z1)), fx0, fy0, fz1);
+	glm_f32vec4 const n101 = glm_vec4_perlin3_corner(glm_vec4_permute(_mm_add_ps(i10, Z1)), fx1, fy0, fz1);
+	glm_f32vec4 const n011 = glm_vec4_perlin3_corner(glm_vec4_permute(_mm_add_ps(i01, Z1)), fx0, fy1, fz1);
+	glm_f32vec4 const n111 = glm_vec4_perlin3_corner(glm_vec4_permute(_mm_add_ps(i11, Z1)), fx1, fy1, fz1);
+
+	glm_f32vec4 const u = glm_vec4_fade(fx0), v = glm_vec4_fade(fy0), w = glm_vec4_fade(fz0);
+	glm_f32vec4 const n00 = glm_vec4_noise_mix(n000, n001, w);
+	glm_f32vec4 const n10 = glm_vec4_noise_mix(n100, n101, w);
+	glm_f32vec4 const n01 = glm_vec4_noise_mix(n010, n011, w);
+	glm_f32vec4 const n11 = glm_vec4_noise_mix(n110, n111, w);
+	glm_f32vec4 const n = glm_vec4_noise_mix(glm_vec4_noise_mix(n00, n01, v), glm_vec4_noise_mix(n10, n11, v), u);
+	return _mm_mul_ps(_mm_set1_ps(2.2f), n);
+}
+
+// One corner of 2D simplex noise: its falloff m, the gradient picked by the
+// hash p and its dot product with the offset (x, y).
+GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_simplex2_corner(glm_f32vec4 p, glm_f32vec4 x, glm_f32vec4 y)
+{
+	glm_f32vec4 m = _mm_max_ps(_mm_setzero_ps(), _mm_sub_ps(_mm_set1_ps(0.5f), _mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y))));
+	m = _mm_mul_ps(m, m);
+	m = _mm_mul_ps(m, m);
+
+	glm_f32vec4 const g = _mm_sub_ps(_mm_mul_ps(_mm_set1_ps(2.0f), glm_vec4_noise_fract(_mm_mul_ps(p, _mm_set1_ps(0.024390243902439f)))), _mm_set1_ps(1.0f));
+	glm_f32vec4 const h = _mm_sub_ps(glm_vec4_abs(g), _mm_set1_ps(0.5f));
+	glm_f32vec4 const a0 = _mm_sub_ps(g, glm_vec4_floor_any(_mm_add_ps(g, _mm_set1_ps(0.5f))));
+	m = _mm_mul_ps(m, glm_vec4_taylor_inv_sqrt(_mm_add_ps(_mm_mul_ps(a0, a0), _mm_mul_ps(h, h))));
+	return _mm_mul_ps(m, _mm_add_ps(_mm_mul_ps(a0, x), _mm_mul_ps(h, y)));
+}
+
+GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_simplex2(glm_f32vec4 x, glm_f32vec4 y)
+{
+	glm_f32vec4 const C0 = _mm_set1_ps(0.211324865405187f);
+	glm_f32vec4 const C1 = _mm_set1_ps(0.366025403784439f);
+	glm_f32vec4 const C2 = _mm_set1_ps(-0.577350269189626f);
+	glm_f32vec4 const One = _mm_set1_ps(1.0f);
+
+	// First corner and the offsets to the other two.
+	glm_f32vec4 const s = _mm_add_ps(_mm_mul_ps(x, C1), _mm_mul_ps(y, C1));
+	glm_f32vec4 Ix = glm_vec4_floor_any(_mm_add_ps(x, s));
+	glm_f32vec4 Iy = glm_vec4_floor_any(_mm_add_ps(y, s));
+	glm_f32vec4 const t = _mm_add_ps(_mm_mul_ps(Ix, C0), _mm_mul_ps(Iy, C0));
+	glm_f32vec4 const x0 = _mm_add_ps(_mm_sub_ps(x, Ix), t);
+	glm_f32vec4 const y0 = _mm_add_ps(_mm_sub_ps(y, Iy), t);
+
+	glm_f32vec4 const Lower = _mm_cmpgt_ps(x0, y0);
+	glm_f32vec4 const i1x = _mm_and_ps(Lower, One), i1y = _mm_andnot_ps(Lower, One);
+	glm_f32vec4 const x1 = _mm_sub_ps(_mm_add_ps(x0, C0), i1x);
+	glm_f32vec4 const y1 = _mm_sub_ps(_mm_add_ps(y0, C0), i1y);
+	glm_f32vec4 const x2 = _mm_add_ps(x0, C2);
+	glm_f32vec4 const y2 = _mm_add_ps(y0, C2);
+
+	Ix = glm_vec4_mod289_div(Ix);
+	Iy = glm_vec4_mod289_div(Iy);
+	glm_f32vec4 const p0 = glm_vec4_permute(_mm_add_ps(glm_vec4_permute(Iy), Ix));
+	glm_f32vec4 const p1 = glm_vec4_permute(_mm_add_ps(_mm_add_ps(glm_vec4_permute(_mm_add_ps(Iy, i1y)), Ix), i1x));
+	glm_f32vec4 const p2 = glm_vec4_permute(_mm_add_ps(_mm_add_ps(glm_vec4_permute(_mm_add_ps(Iy, One)), Ix), One));
+
+	glm_f32vec4 const n0 = glm_vec4_simplex2_corner(p0, x0, y0);
+	glm_f32vec4 const n1 = glm_vec4_simplex2_corner(p1, x1, y1);
+	glm_f32vec4 const n2 = glm_vec4_simplex2_corner(p2, x2, y2);
+	return _mm_mul_ps(_mm_set1_ps(130.0f), _mm_add_ps(_mm_add_ps(n0, n1), n2));
+}
+
+// One corner of 3D simplex noise: (m * m)^2 times the dot product of the
+// gradient picked by the hash p with the offset (x, y, z).
+GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_simplex3_corner(glm_f32vec4 p, glm_f32vec4 x, glm_f32vec4 y, glm_f32vec4 z)
+{
+	float const n_ = 0.142857142857f;
+	glm_f32vec4 const nsx = _mm_set1_ps(n_ * 2.0f), nsy = _mm_set1_ps(n_ * 0.5f - 1.0f), nsz = _mm_set1_ps(n_);
+	glm_f32vec4 const One = _mm_set1_ps(1.0f);
+	glm_f32vec4 const Two = _mm_set1_ps(2.0f);
+
+	// Gradients: 7x7 points over a square, mapped onto an octahedron.
+	glm_f32vec4 const j = _mm_sub_ps(p, _mm_mul_ps(_mm_set1_ps(49.0f), glm_vec4_floor_any(_mm_mul_ps(_mm_mul_ps(p, nsz), nsz))));
+	glm_f32vec4 const x_ = glm_vec4_floor_any(_mm_mul_ps(j, nsz));
+	glm_f32vec4 const y_ = glm_vec4_floor_any(_mm_sub_ps(j, _mm_mul_ps(_mm_set1_ps(7.0f), x_)));
+	glm_f32vec4 gx = _mm_add_ps(_mm_mul_ps(x_, nsx), nsy);
+	glm_f32vec4 gy = _mm_add_ps(_mm_mul_ps(y_, nsx), nsy);
+	glm_f32vec4 gz = _mm_sub_ps(_mm_sub_ps(One, glm_vec4_abs(gx)), glm_vec4_abs(gy));
+
+	glm_f32vec4 const sh = _mm_xor_ps(glm_vec4_noise_step(gz, _mm_setzero_ps()), _mm_set1_ps(-0.0f));
+	gx = _mm_add_ps(gx, _mm_mul_ps(_mm_add_ps(_mm_mul_ps(glm_vec4_floor_any(gx), Two), One), sh));
+	gy = _mm_add_ps(gy, _mm_mul_ps(_mm_add_ps(_mm_mul_ps(glm_vec4_floor_any(gy), Two), One), sh));
+
+	glm_f32vec4 const Norm = glm_vec4_taylor_inv_sqrt(_mm_add_ps(_mm_add_ps(_mm_mul_ps(gx, gx), _mm_mul_ps(gy, gy)), _mm_mul_ps(gz, gz)));
+	gx = _mm_mul_ps(gx, Norm);
+	gy = _mm_mul_ps(gy, Norm);
+	gz = _mm_mul_ps(gz, Norm);
+
+	glm_f32vec4 m = _mm_max_ps(_mm_setzero_ps(), _mm_sub_ps(_mm_set1_ps(0.6f), _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z))));
+	m = _mm_mul_ps(m, m);
+	glm_f32vec4 const d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(gx, x), _mm_mul_ps(gy, y)), _mm_mul_ps(gz, z));
+	return _mm_mul_ps(_mm_mul_ps(m, m), d);
+}
+
+GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_simplex3(glm_f32vec4 x, glm_f32vec4 y, glm_f32vec4 z)
+{
+	glm_f32vec4 const Cx = _mm_set1_ps(static_cast<float>(1.0 / 6.0));
+	glm_f32vec4 const Cy = _mm_set1_ps(static_cast<float>(1.0 / 3.0));
+	glm_f32vec4 const Half = _mm_set1_ps(0.5f);
+	glm_f32vec4 const One = _mm_set1_ps(1.0f);
+
+	// First corner.
+	glm_f32vec4 const s = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, Cy), _mm_mul_ps(y, Cy)), _mm_mul_ps(z, Cy));
+	glm_f32vec4 Ix = glm_vec4_floor_any(_mm_add_ps(x, s));
+	glm_f32vec4 Iy = glm_vec4_floor_any(_mm_add_ps(y, s));
+	glm_f32vec4 Iz = glm_vec4_floor_any(_mm_add_ps(z, s));
+	glm_f32vec4 const t = _mm_add_ps(_mm_add_ps(_mm_mul_ps(Ix, Cx), _mm_mul_ps(Iy, Cx)), _mm_mul_ps(Iz, Cx));
+	glm_f32vec4 const x0 = _mm_add_ps(_mm_sub_ps(x, Ix), t);
+	glm_f32vec4 const y0 = _mm_add_ps(_mm_sub_ps(y, Iy), t);
+	glm_f32vec4 const z0 = _mm_add_ps(_mm_sub_ps(z, Iz), t);
+
+	// Other corners.
+	glm_f32vec4 const gx = glm_vec4_noise_step(y0, x0), gy = glm_vec4_noise_step(z0, y0), gz = glm_vec4_noise_step(x0, z0);
+	glm_f32vec4 const lx = _mm_sub_ps(One, gx), ly = _mm_sub_ps(One, gy), lz = _mm_sub_ps(One, gz);
+	glm_f32vec4 const i1x = _mm_min_ps(lz, gx), i1y = _mm_min_ps(lx, gy), i1z = _mm_min_ps(ly, gz);
+	glm_f32vec4 const i2x = _mm_max_ps(lz, gx), i2y = _mm_max_ps(lx, gy), i2z = _mm_max_ps(ly, gz);
+
+	glm_f32vec4 const x1 = _mm_add_ps(_mm_sub_ps(x0, i1x), Cx);
+	glm_f32vec4 const y1 = _mm_add_ps(_mm_sub_ps(y0, i1y), Cx);
+	glm_f32vec4 const z1 = _mm_add_ps(_mm_sub_ps(z0, i1z), Cx);
+	glm_f32vec4 const x2 = _mm_add_ps(_mm_sub_ps(x0, i2x), Cy);
+	glm_f32vec4 const y2 = _mm_add_ps(_mm_sub_ps(y0, i2y), Cy);
+	glm_f32vec4 const z2 = _mm_add_ps(_mm_sub_ps(z0, i2z), Cy);
+	glm_f32vec4 const x3 = _mm_sub_ps(x0, Half);
+	glm_f32vec4 const y3 = _mm_sub_ps(y0, Half);
+	glm_f32vec4 const z3 = _mm_sub_ps(z0, Half);
+
+	// Permutations.
+	Ix = glm_vec4_mod289(Ix);
+	Iy = glm_vec4_mod289(Iy);
+	Iz = glm_vec4_mod289(Iz);
+	glm_f32vec4 const p0 = glm_vec4_permute(_mm_add_ps(glm_vec4_permute(_mm_add_ps(glm_vec4_permute(Iz), Iy)), Ix));
+	glm_f32vec4 const p1 = glm_vec4_permute(_mm_add_ps(_mm_add_ps(glm_vec4_permute(_mm_add_ps(_mm_add_ps(glm_vec4_permute(_mm_add_ps(Iz, i1z)), Iy), i1y)), Ix), i1x));
+	glm_f32vec4 const p2 = glm_vec4_permute(_mm_add_ps(_mm_add_ps(glm_vec4_permute(_mm_add_ps(_mm_add_ps(glm_vec4_permute(_mm_add_ps(Iz, i2z)), Iy), i2y)), Ix), i2x));
+	glm_f32vec4 const p3 = glm_vec4_permute(_mm_add_ps(_mm_add_ps(glm_vec4_permute(_mm_add_ps(_mm_add_ps(glm_vec4_permute(_mm_add_ps(Iz, One)), Iy), One)), Ix), One));
+
+	glm_f32vec4 const n0 = glm_vec4_simplex3_corner(p0, x0, y0, z0);
+	glm_f32vec4 const n1 = glm_vec4_simplex3_corner(p1, x1, y1, z1);
+	glm_f32vec4 const n2 = glm_vec4_simplex3_corner(p2, x2, y2, z2);
+	glm_f32vec4 const n3 = glm_vec4_simplex3_corner(p3, x3, y3, z3);
+	return _mm_mul_ps(_mm_set1_ps(42.0f), _mm_add_ps(_mm_add_ps(n0, n1), _mm_add_ps(n2, n3)));
+}
+
+#endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
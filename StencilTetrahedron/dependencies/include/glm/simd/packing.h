@@ -5,4 +5,61 @@
 
 #if GLM_ARCH & GLM_ARCH_SSE2_BIT
 
+// Lanes of a where mask is set, of b elsewhere.
+GLM_FUNC_QUALIFIER glm_i32vec4 glm_i32vec4_select(glm_i32vec4 mask, glm_i32vec4 a, glm_i32vec4 b)
+{
+	return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+// Four floats to halves in the low 16 bits of each lane, bit for bit as
+// glm::detail::toFloat16: to nearest with ties away from zero, overflow to
+// infinity, and NaNs keeping their sign and top 10 payload bits, at least
+// one of them set.
+GLM_FUNC_QUALIFIER glm_i32vec4 glm_vec4_packhalf(glm_f32vec4 v)
+{
+	glm_i32vec4 const i = _mm_castps_si128(v);
+	glm_i32vec4 const Sign = _mm_and_si128(_mm_srli_epi32(i, 16), _mm_set1_epi32(0x8000));
+	glm_i32vec4 const a = _mm_and_si128(i, _mm_set1_epi32(0x7fffffff));
+
+	// Normal halves: rebias the exponent and round on the 13 dropped bits.
+	// A carry out of the significand bumps the exponent, as it should.
+	glm_i32vec4 const Normal = _mm_srli_epi32(_mm_add_epi32(a, _mm_set1_epi32(0x1000 - (112 << 23))), 13);
+
+	// Denormal halves are |v| * 2^24 rounded half up, which is exact in
+	// float. Below 2^-25 the result is zero, so those lanes are zeroed first
+	// to keep float denormals, and their microcode assists, out of the
+	// multiply.
+	glm_i32vec4 const Small = _mm_cmplt_epi32(a, _mm_set1_epi32(0x38800000));
+	glm_i32vec4 const Tiny = _mm_cmplt_epi32(a, _mm_set1_epi32(0x33000000));
+	glm_f32vec4 const d = _mm_castsi128_ps(_mm_andnot_si128(Tiny, a));
+	glm_i32vec4 const Denormal = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(d, _mm_set1_ps(16777216.0f)), _mm_set1_ps(0.5f)));
+	glm_i32vec4 h = glm_i32vec4_select(Small, Denormal, Normal);
+
+	// From 65520 up, infinities included, the result is infinite.
+	h = glm_i32vec4_select(_mm_cmpgt_epi32(a, _mm_set1_epi32(0x477fefff)), _mm_set1_epi32(0x7c00), h);
+
+	glm_i32vec4 const Payload = _mm_and_si128(_mm_srli_epi32(a, 13), _mm_set1_epi32(0x3ff));
+	glm_i32vec4 const Nan = _mm_or_si128(_mm_or_si128(Payload, _mm_set1_epi32(0x7c00)), _mm_and_si128(_mm_cmpeq_epi32(Payload, _mm_setzero_si128()), _mm_set1_epi32(1)));
+	h = glm_i32vec4_select(_mm_cmpgt_epi32(a, _mm_set1_epi32(0x7f800000)), Nan, h);
+	return _mm_or_si128(h, Sign);
+}
+
+// Four halves in the low 16 bits of each lane to floats, bit for bit as
+// glm::detail::toFloat32: exact, NaN payloads kept as they are.
+GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_unpackhalf(glm_i32vec4 h)
+{
+	glm_i32vec4 const Sign = _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x8000)), 16);
+	glm_i32vec4 const a = _mm_and_si128(h, _mm_set1_epi32(0x7fff));
+
+	// Rebias the exponent, twice for infinities and NaNs so that 31 becomes 255.
+	glm_i32vec4 const Bias = _mm_set1_epi32(112 << 23);
+	glm_i32vec4 f = _mm_add_epi32(_mm_slli_epi32(a, 13), Bias);
+	f = _mm_add_epi32(f, _mm_and_si128(_mm_cmpgt_epi32(a, _mm_set1_epi32(0x7bff)), Bias));
+
+	// Zeros and denormals are their significand times 2^-24, a normal float.
+	glm_f32vec4 const Denormal = _mm_mul_ps(_mm_cvtepi32_ps(a), _mm_set1_ps(5.9604644775390625e-8f));
+	f = glm_i32vec4_select(_mm_cmplt_epi32(a, _mm_set1_epi32(0x400)), _mm_castps_si128(Denormal), f);
+	return _mm_castsi128_ps(_mm_or_si128(f, Sign));
+}
+
 #endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
@@ -438,6 +438,48 @@
 #	include "neon.h"
 #endif//GLM_ARCH
 
+// Kernels for a wider instruction set than GLM_ARCH, called only after a
+// CPUID check (GLM_GTX_simd_dispatch). GCC and Clang compile them through
+// per-function target attributes; MSVC intrinsics never depend on /arch.
+// The AVX2 level includes FMA and F16C, which every AVX2 CPU has.
+// GLM_TARGET_AVX2_NOFMA leaves FMA out, for kernels that must round every
+// multiply and add as the scalar code does.
+#if (GLM_ARCH & GLM_ARCH_SSE2_BIT) && (GLM_COMPILER & (GLM_COMPILER_GCC | GLM_COMPILER_CLANG))
+#	define GLM_CONFIG_SIMD_DISPATCH GLM_ENABLE
+#	define GLM_TARGET_AVX2 __attribute__((target("avx2,fma,f16c")))
+#	define GLM_TARGET_AVX2_NOFMA __attribute__((target("avx2")))
+#	define GLM_TARGET_AVX512 __attribute__((target("avx512f,avx2,fma,f16c")))
+#	define GLM_TARGET_BMI2 __attribute__((target("bmi2")))
+#elif (GLM_ARCH & GLM_ARCH_SSE2_BIT) && (GLM_COMPILER & GLM_COMPILER_VC)
+#	define GLM_CONFIG_SIMD_DISPATCH GLM_ENABLE
+#	define GLM_TARGET_AVX2
+#	define GLM_TARGET_AVX2_NOFMA
+#	define GLM_TARGET_AVX512
+#	define GLM_TARGET_BMI2
+#else
+#	define GLM_CONFIG_SIMD_DISPATCH GLM_DISABLE
+#	define GLM_TARGET_AVX2
+#	define GLM_TARGET_AVX2_NOFMA
+#	define GLM_TARGET_AVX512
+#	define GLM_TARGET_BMI2
+#endif
+
+// PDEP and PEXT (BMI2) for GLM_GTC_bitfield. Every AVX2 CPU has them, but
+// GCC and Clang only take them with -mbmi2 or an -march that includes it.
+// The 64-bit forms need x86-64. Zen and Zen 2 run them in microcode, slower
+// than the shifts they replace, so -march=znver1 and znver2 keep the shifts.
+#if defined(__BMI2__) && defined(__x86_64__) && !defined(__znver1__) && !defined(__znver2__)
+#	define GLM_CONFIG_BMI2 GLM_ENABLE
+#elif (GLM_ARCH & GLM_ARCH_AVX2_BIT) && (GLM_COMPILER & GLM_COMPILER_VC) && defined(_M_X64)
+#	define GLM_CONFIG_BMI2 GLM_ENABLE
+#else
+#	define GLM_CONFIG_BMI2 GLM_DISABLE
+#endif
+
+#if ((GLM_CONFIG_SIMD_DISPATCH == GLM_ENABLE) || (GLM_CONFIG_BMI2 == GLM_ENABLE)) && !(GLM_ARCH & GLM_ARCH_AVX_BIT)
+#	include <immintrin.h>
+#endif
+
 #if GLM_ARCH & GLM_ARCH_SSE2_BIT
 	typedef __m128			glm_f32vec4;
 	typedef __m128i			glm_i32vec4;
@@ -0,0 +1,133 @@
+/// @ref simd
+/// @file glm/simd/random.h
+
+#pragma once
+
+#include "common.h"
+
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+
+// Philox4x32-10 for four blocks at once and the float transforms the
+// gtc/random span functions apply to its words, one block per lane. Every
+// step is a correctly rounded float operation that detail::rand_* in
+// gtc/random.inl repeats in the same order, so the spans give the same
+// values with and without SIMD, unless the compiler contracts multiply-adds
+// into FMA on one side only.
+
+// 32 x 32 -> 64 bit products of a and b: the low halves, and the high ones in hi.
+GLM_FUNC_QUALIFIER glm_i32vec4 glm_vec4_rand_mulhilo(glm_i32vec4 a, glm_i32vec4 b, glm_i32vec4& hi)
+{
+	glm_i32vec4 const Even = _mm_mul_epu32(a, b);
+	glm_i32vec4 const Odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+	hi = _mm_unpacklo_epi32(_mm_shuffle_epi32(Even, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_epi32(Odd, _MM_SHUFFLE(3, 1, 3, 1)));
+	return _mm_unpacklo_epi32(_mm_shuffle_epi32(Even, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_epi32(Odd, _MM_SHUFFLE(2, 0, 2, 0)));
+}
+
+// Ten Philox rounds on the counters c[0..3], word j of four blocks in c[j].
+GLM_FUNC_QUALIFIER void glm_vec4_rand_philox(glm_i32vec4 c[4], unsigned int k0, unsigned int k1)
+{
+	glm_i32vec4 const M0 = _mm_set1_epi32(static_cast<int>(0xD2511F53u));
+	glm_i32vec4 const M1 = _mm_set1_epi32(static_cast<int>(0xCD9E8D57u));
+	glm_i32vec4 Key0 = _mm_set1_epi32(static_cast<int>(k0));
+	glm_i32vec4 Key1 = _mm_set1_epi32(static_cast<int>(k1));
+	for(int Round = 0; Round < 10; ++Round)
+	{
+		glm_i32vec4 Hi0, Hi1;
+		glm_i32vec4 const Lo0 = glm_vec4_rand_mulhilo(c[0], M0, Hi0);
+		glm_i32vec4 const Lo1 = glm_vec4_rand_mulhilo(c[2], M1, Hi1);
+		c[0] = _mm_xor_si128(_mm_xor_si128(Hi1, c[1]), Key0);
+		c[1] = Lo1;
+		c[2] = _mm_xor_si128(_mm_xor_si128(Hi0, c[3]), Key1);
+		c[3] = Lo0;
+		Key0 = _mm_add_epi32(Key0, _mm_set1_epi32(static_cast<int>(0x9E3779B9u)));
+		Key1 = _mm_add_epi32(Key1, _mm_set1_epi32(static_cast<int>(0xBB67AE85u)));
+	}
+}
+
+// The top 24 bits of each word as a float in [0, 1).
+GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_rand_unit(glm_i32vec4 bits)
+{
+	return _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(bits, 8)), _mm_set1_ps(5.9604644775390625e-8f));
+}
+
+// The top 24 bits of each word as a float in (0, 1], for log and cbrt.
+GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_rand_unit_open(glm_i32vec4 bits)
+{
+	return _mm_mul_ps(_mm_cvtepi32_ps(_mm_add_epi32(_mm_srli_epi32(bits, 8), _mm_set1_epi32(1))), _mm_set1_ps(5.9604644775390625e-8f));
+}
+
+// Natural logarithm of a normal positive x: the mantissa is taken to
+// [sqrt(1/2), sqrt(2)) and expanded as 2 atanh((m - 1) / (m + 1)).
+GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_rand_log(glm_f32vec4 x)
+{
+	glm_i32vec4 const i = _mm_castps_si128(x);
+	glm_i32vec4 e = _mm_sub_epi32(_mm_srli_epi32(i, 23), _mm_set1_epi32(127));
+	glm_f32vec4 m = _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(i, _mm_set1_epi32(0x007fffff)), _mm_set1_epi32(0x3f800000)));
+	glm_f32vec4 const Big = _mm_cmpgt_ps(m, _mm_set1_ps(1.41421356f));
+	m = _mm_or_ps(_mm_and_ps(Big, _mm_mul_ps(m, _mm_set1_ps(0.5f))), _mm_andnot_ps(Big, m));
+	e = _mm_sub_epi32(e, _mm_castps_si128(Big));
+
+	glm_f32vec4 const t = _mm_div_ps(_mm_sub_ps(m, _mm_set1_ps(1.0f)), _mm_add_ps(m, _mm_set1_ps(1.0f)));
+	glm_f32vec4 const t2 = _mm_mul_ps(t, t);
+	glm_f32vec4 p = _mm_add_ps(_mm_mul_ps(t2, _mm_set1_ps(1.0f / 9.0f)), _mm_set1_ps(1.0f / 7.0f));
+	p = _mm_add_ps(_mm_mul_ps(p, t2), _mm_set1_ps(1.0f / 5.0f));
+	p = _mm_add_ps(_mm_mul_ps(p, t2), _mm_set1_ps(1.0f / 3.0f));
+	p = _mm_add_ps(_mm_mul_ps(p, t2), _mm_set1_ps(1.0f));
+	glm_f32vec4 const f = _mm_cvtepi32_ps(e);
+	glm_f32vec4 const Lo = _mm_add_ps(_mm_mul_ps(f, _mm_set1_ps(-2.12194440e-4f)), _mm_mul_ps(_mm_add_ps(t, t), p));
+	return _mm_add_ps(_mm_mul_ps(f, _mm_set1_ps(0.693359375f)), Lo);
+}
+
+// sin and cos of 2 pi turns for turns in [0, 1): the nearest quarter turn
+// is taken out and the rest, within pi / 4, goes through Taylor polynomials.
+GLM_FUNC_QUALIFIER void glm_vec4_rand_sincos(glm_f32vec4 turns, glm_f32vec4& s, glm_f32vec4& c)
+{
+	glm_f32vec4 const Quarters = _mm_mul_ps(turns, _mm_set1_ps(4.0f));
+	glm_i32vec4 const q = _mm_cvttps_epi32(_mm_add_ps(Quarters, _mm_set1_ps(0.5f)));
+	glm_f32vec4 const x = _mm_mul_ps(_mm_sub_ps(Quarters, _mm_cvtepi32_ps(q)), _mm_set1_ps(1.57079632679489662f));
+	glm_f32vec4 const x2 = _mm_mul_ps(x, x);
+
+	glm_f32vec4 ps = _mm_add_ps(_mm_mul_ps(x2, _mm_set1_ps(1.0f / 362880.0f)), _mm_set1_ps(-1.0f / 5040.0f));
+	ps = _mm_add_ps(_mm_mul_ps(ps, x2), _mm_set1_ps(1.0f / 120.0f));
+	ps = _mm_add_ps(_mm_mul_ps(ps, x2), _mm_set1_ps(-1.0f / 6.0f));
+	glm_f32vec4 const Sin = _mm_add_ps(x, _mm_mul_ps(_mm_mul_ps(x, x2), ps));
+
+	glm_f32vec4 pc = _mm_add_ps(_mm_mul_ps(x2, _mm_set1_ps(-1.0f / 3628800.0f)), _mm_set1_ps(1.0f / 40320.0f));
+	pc = _mm_add_ps(_mm_mul_ps(pc, x2), _mm_set1_ps(-1.0f / 720.0f));
+	pc = _mm_add_ps(_mm_mul_ps(pc, x2), _mm_set1_ps(1.0f / 24.0f));
+	pc = _mm_add_ps(_mm_mul_ps(pc, x2), _mm_set1_ps(-0.5f));
+	glm_f32vec4 const Cos = _mm_add_ps(_mm_mul_ps(pc, x2), _mm_set1_ps(1.0f));
+
+	// Odd quarters swap sin and cos; the signs follow the quadrant.
+	glm_f32vec4 const Swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(q, _mm_set1_epi32(1)), _mm_set1_epi32(1)));
+	s = _mm_or_ps(_mm_and_ps(Swap, Cos), _mm_andnot_ps(Swap, Sin));
+	c = _mm_or_ps(_mm_and_ps(Swap, Sin), _mm_andnot_ps(Swap, Cos));
+	s = _mm_xor_ps(s, _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(q, _mm_set1_epi32(2)), 30)));
+	c = _mm_xor_ps(c, _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(q, _mm_set1_epi32(1)), _mm_set1_epi32(2)), 30)));
+}
+
+// Cube root of x in (0, 1]: a guess from the exponent bits divided by
+// three, then three Newton steps.
+GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_rand_cbrt(glm_f32vec4 x)
+{
+	glm_i32vec4 const Guess = _mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(_mm_castps_si128(x)), _mm_set1_ps(1.0f / 3.0f)));
+	glm_f32vec4 y = _mm_castsi128_ps(_mm_add_epi32(Guess, _mm_set1_epi32(709958130)));
+	for(int Step = 0; Step < 3; ++Step)
+		y = _mm_mul_ps(_mm_add_ps(_mm_add_ps(y, y), _mm_div_ps(x, _mm_mul_ps(y, y))), _mm_set1_ps(1.0f / 3.0f));
+	return y;
+}
+
+// Lane j of v[0..3] to v[j]: four values of one block made consecutive.
+GLM_FUNC_QUALIFIER void glm_vec4_rand_transpose(glm_f32vec4 v[4])
+{
+	glm_f32vec4 const t0 = _mm_unpacklo_ps(v[0], v[1]);
+	glm_f32vec4 const t1 = _mm_unpacklo_ps(v[2], v[3]);
+	glm_f32vec4 const t2 = _mm_unpackhi_ps(v[0], v[1]);
+	glm_f32vec4 const t3 = _mm_unpackhi_ps(v[2], v[3]);
+	v[0] = _mm_movelh_ps(t0, t1);
+	v[1] = _mm_movehl_ps(t1, t0);
+	v[2] = _mm_movelh_ps(t2, t3);
+	v[3] = _mm_movehl_ps(t3, t2);
+}
+
+#endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
@@ -0,0 +1,155 @@
+#include "dynamic_resolution.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+
+// Scales are kept on a grid so small timing noise cannot produce a new
+// framebuffer size every frame.
+const float DYNAMIC_RESOLUTION_STEP = 1.0f / 32.0f;
+
+// GPU times within this band around the target leave the scale alone.
+const double DYNAMIC_RESOLUTION_LOW = 0.85, DYNAMIC_RESOLUTION_HIGH = 1.05;
+
+
+bool parseDynamicResolutionOptions(int argc, char** argv, DynamicResolutionSettings& settings) {
+    settings.targetMs = 1000.0 / 60.0;
+    settings.minScale = 0.5f;
+    settings.maxScale = 1.0f;
+
+    bool enabled = false;
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::strcmp(argv[i], "--target-ms") == 0) {
+            settings.targetMs = std::atof(argv[++i]);
+            enabled = true;
+        } else if (std::strcmp(argv[i], "--min-scale") == 0) {
+            settings.minScale = (float)std::atof(argv[++i]);
+            enabled = true;
+        } else if (std::strcmp(argv[i], "--max-scale") == 0) {
+            settings.maxScale = (float)std::atof(argv[++i]);
+            enabled = true;
+        }
+    }
+    if (settings.targetMs <= 0.0 || settings.minScale <= 0.0f || settings.maxScale < settings.minScale
+        || settings.maxScale > 2.0f) {
+        std::cerr << "Invalid dynamic resolution settings, expected --target-ms > 0 and "
+            "0 < --min-scale <= --max-scale <= 2" << std::endl;
+        settings.targetMs = 1000.0 / 60.0;
+        settings.minScale = 0.5f;
+        settings.maxScale = 1.0f;
+    }
+    return enabled;
+}
+
+
+bool createDynamicResolution(DynamicResolution& resolution, const DynamicResolutionSettings& settings) {
+    resolution = DynamicResolution();
+    resolution.settings = settings;
+    resolution.scale = std::min(1.0f, settings.maxScale);
+    glGenFramebuffers(1, &resolution.framebuffer);
+    glGenRenderbuffers(1, &resolution.color);
+    glGenRenderbuffers(1, &resolution.depthStencil);
+    createGpuSpanTimer(resolution.timer);
+    return resolution.framebuffer != 0;
+}
+
+
+void destroyDynamicResolution(DynamicResolution& resolution) {
+    destroyGpuSpanTimer(resolution.timer);
+    glDeleteRenderbuffers(1, &resolution.depthStencil);
+    glDeleteRenderbuffers(1, &resolution.color);
+    glDeleteFramebuffers(1, &resolution.framebuffer);
+}
+
+
+// Storage is sized for maxScale, so changing the scale only changes the
+// viewport and the blit rectangle; only a window resize reallocates. On
+// failure allocatedWidth is 0 and frames go to the default framebuffer
+// until the next resize.
+static void allocateTargets(DynamicResolution& resolution, int windowWidth, int windowHeight) {
+    resolution.windowWidth = windowWidth;
+    resolution.windowHeight = windowHeight;
+    resolution.allocatedWidth = std::max(1, (int)std::ceil(windowWidth * resolution.settings.maxScale));
+    resolution.allocatedHeight = std::max(1, (int)std::ceil(windowHeight * resolution.settings.maxScale));
+
+    glBindRenderbuffer(GL_RENDERBUFFER, resolution.color);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, resolution.allocatedWidth, resolution.allocatedHeight);
+    glBindRenderbuffer(GL_RENDERBUFFER, resolution.depthStencil);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, resolution.allocatedWidth, resolution.allocatedHeight);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, resolution.framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, resolution.color);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, resolution.depthStencil);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "Dynamic resolution framebuffer is incomplete at " << resolution.allocatedWidth << "x"
+            << resolution.allocatedHeight << std::endl;
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        resolution.allocatedWidth = resolution.allocatedHeight = 0;
+    }
+}
+
+
+// Fill cost grows with the pixel count, so the scale that would have met the
+// target is the measured frame's scale times sqrt(target / measured). The step
+// towards it is halved because the measurement is a few frames old and the
+// fixed per-frame cost does not shrink with the resolution.
+static void applyGpuTime(DynamicResolution& resolution, float renderedScale, double gpuMs) {
+    const DynamicResolutionSettings& settings = resolution.settings;
+    if (gpuMs <= 0.0 || (gpuMs > settings.targetMs * DYNAMIC_RESOLUTION_LOW
+                         && gpuMs < settings.targetMs * DYNAMIC_RESOLUTION_HIGH))
+        return;
+
+    float ideal = renderedScale * (float)std::sqrt(settings.targetMs / gpuMs);
+    float scale = resolution.scale + 0.5f * (ideal - resolution.scale);
+    scale = std::round(scale / DYNAMIC_RESOLUTION_STEP) * DYNAMIC_RESOLUTION_STEP;
+    scale = std::clamp(scale, settings.minScale, settings.maxScale);
+    if (scale == resolution.scale)
+        return;
+
+    std::cout << "Dynamic resolution: scale " << resolution.scale << " -> " << scale << " ("
+        << (int)std::lround(resolution.windowWidth * scale) << "x" << (int)std::lround(resolution.windowHeight * scale)
+        << "), GPU " << gpuMs << " ms at scale " << renderedScale << " for a target of " << settings.targetMs
+        << " ms" << std::endl;
+    resolution.scale = scale;
+    resolution.changes++;
+}
+
+
+void beginDynamicResolution(DynamicResolution& resolution, int windowWidth, int windowHeight) {
+    unsigned int slot = resolution.timer.frame % GPU_TIMER_LATENCY;
+    if (beginGpuSpan(resolution.timer))
+        applyGpuTime(resolution, resolution.slotScale[slot], resolution.timer.lastMs);
+    resolution.slotScale[slot] = resolution.scale;
+
+    if (windowWidth != resolution.windowWidth || windowHeight != resolution.windowHeight)
+        allocateTargets(resolution, windowWidth, windowHeight);
+    if (resolution.allocatedWidth == 0) {
+        resolution.width = windowWidth;
+        resolution.height = windowHeight;
+        glViewport(0, 0, windowWidth, windowHeight);
+        return;
+    }
+
+    resolution.width = std::clamp((int)std::lround(windowWidth * resolution.scale), 1, resolution.allocatedWidth);
+    resolution.height = std::clamp((int)std::lround(windowHeight * resolution.scale), 1, resolution.allocatedHeight);
+    glBindFramebuffer(GL_FRAMEBUFFER, resolution.framebuffer);
+    glViewport(0, 0, resolution.width, resolution.height);
+}
+
+
+void endDynamicResolution(DynamicResolution& resolution) {
+    // Without targets the frame went straight to the default framebuffer.
+    if (resolution.allocatedWidth > 0) {
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, resolution.framebuffer);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+        glBlitFramebuffer(0, 0, resolution.width, resolution.height,
+                          0, 0, resolution.windowWidth, resolution.windowHeight, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glViewport(0, 0, resolution.windowWidth, resolution.windowHeight);
+    }
+    endGpuSpan(resolution.timer);
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include "gpu_timer.h"
+
+
+// Dynamic resolution: the scene is rendered into an offscreen framebuffer at
+// a fraction of the window size and upscaled into the default framebuffer,
+// with the fraction steered so the GPU time per frame stays at a target. The
+// GPU time comes from timestamp queries read GPU_TIMER_LATENCY frames late,
+// and each result is paired with the scale its frame was rendered at.
+struct DynamicResolutionSettings {
+    double targetMs;                // GPU time per frame to hold
+    float minScale, maxScale;       // of the window's width and height
+};
+
+struct DynamicResolution {
+    DynamicResolutionSettings settings;
+    GLuint framebuffer, color, depthStencil;
+    int windowWidth, windowHeight;
+    int allocatedWidth, allocatedHeight;    // the window size at maxScale
+    int width, height;                      // rendered this frame
+    float scale;
+    float slotScale[GPU_TIMER_LATENCY];     // scale of the frame in each timer slot
+    GpuSpanTimer timer;
+    unsigned int changes;
+};
+
+// --target-ms t, --min-scale s and --max-scale s; any of them turns dynamic
+// resolution on at startup, which the return value reports.
+bool parseDynamicResolutionOptions(int argc, char** argv, DynamicResolutionSettings& settings);
+
+bool createDynamicResolution(DynamicResolution& resolution, const DynamicResolutionSettings& settings);
+void destroyDynamicResolution(DynamicResolution& resolution);
+
+// Applies the newest GPU time to the scale, then binds the offscreen
+// framebuffer and sets the viewport to the scaled size of a window this big.
+void beginDynamicResolution(DynamicResolution& resolution, int windowWidth, int windowHeight);
+
+// Upscales the frame into the default framebuffer, which is left bound.
+void endDynamicResolution(DynamicResolution& resolution);
@@ -0,0 +1,103 @@
+#include "frame_capture.h"
+
+#include <chrono>
+
+
+static double millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+
+// Waits for the slot's copy, maps it and passes the mapping to the consumer.
+static void deliverSlot(FrameCapture& capture, CaptureSlot& slot) {
+    if (!slot.fence)
+        return;
+
+    auto start = std::chrono::steady_clock::now();
+    GLenum status = glClientWaitSync(slot.fence, 0, 0);
+    if (status == GL_TIMEOUT_EXPIRED) {
+        capture.stats.stalls++;
+        status = glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+    }
+    glDeleteSync(slot.fence);
+    slot.fence = NULL;
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+    size_t stride = (size_t)slot.width * 4;
+    const unsigned char* pixels = (const unsigned char*)glMapBufferRange(
+        GL_PIXEL_PACK_BUFFER, 0, (GLsizeiptr)(stride * slot.height), GL_MAP_READ_BIT);
+    capture.stats.mapMs += millisecondsSince(start);
+
+    if (pixels && status != GL_WAIT_FAILED) {
+        start = std::chrono::steady_clock::now();
+        CapturedFrame frame = { pixels, slot.width, slot.height, stride, slot.index };
+        capture.consumer(frame);
+        capture.stats.consumerMs += millisecondsSince(start);
+        capture.stats.frames++;
+    }
+    if (pixels)
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+
+void createFrameCapture(FrameCapture& capture, CaptureConsumer consumer, unsigned int depth) {
+    capture.slots.assign(depth < 2 ? 2 : depth, CaptureSlot());
+    for (CaptureSlot& slot : capture.slots)
+        glGenBuffers(1, &slot.pbo);
+    capture.next = 0;
+    capture.captured = 0;
+    capture.consumer = consumer;
+    capture.stats = CaptureStats();
+}
+
+
+void destroyFrameCapture(FrameCapture& capture) {
+    for (CaptureSlot& slot : capture.slots) {
+        if (slot.fence)
+            glDeleteSync(slot.fence);
+        glDeleteBuffers(1, &slot.pbo);
+    }
+    capture.slots.clear();
+}
+
+
+void captureFrame(FrameCapture& capture, int width, int height) {
+    CaptureSlot& slot = capture.slots[capture.next];
+    deliverSlot(capture, slot);
+
+    auto start = std::chrono::steady_clock::now();
+    size_t bytes = (size_t)width * height * 4;
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+    if (bytes > slot.capacity) {
+        glBufferData(GL_PIXEL_PACK_BUFFER, (GLsizeiptr)bytes, NULL, GL_STREAM_READ);
+        slot.capacity = bytes;
+    }
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot.width = width;
+    slot.height = height;
+    slot.index = capture.captured++;
+    capture.stats.readMs += millisecondsSince(start);
+
+    capture.next = (capture.next + 1) % capture.slots.size();
+}
+
+
+void flushFrameCapture(FrameCapture& capture) {
+    // Oldest first: the slot captureFrame would reuse next holds the oldest frame.
+    for (size_t i = 0; i < capture.slots.size(); i++)
+        deliverSlot(capture, capture.slots[(capture.next + i) % capture.slots.size()]);
+}
+
+
+double captureOverheadMs(const CaptureStats& stats) {
+    return stats.readMs + stats.mapMs + stats.consumerMs;
+}
+
+
+void resetCaptureStats(FrameCapture& capture) {
+    capture.stats = CaptureStats();
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+
+// Frame readback without stalls. glReadPixels into client memory waits for the
+// GPU to finish the frame; here each frame is read into a pixel buffer object
+// behind a fence instead, and the buffer is only mapped depth frames later,
+// by which time the copy has normally completed.
+const unsigned int FRAME_CAPTURE_DEPTH = 3;
+
+// Points straight into the mapped buffer: valid only for the duration of the
+// consumer call. Rows are tightly packed RGBA8, bottom row first.
+struct CapturedFrame {
+    const unsigned char* pixels;
+    int width, height;
+    size_t stride;
+    unsigned long long index;   // capture order, starting at 0
+};
+
+typedef std::function<void(const CapturedFrame&)> CaptureConsumer;
+
+struct CaptureSlot {
+    GLuint pbo;
+    GLsync fence;               // null when the slot holds no frame
+    int width, height;
+    size_t capacity;
+    unsigned long long index;
+};
+
+// Time spent on the capturing thread since the last resetCaptureStats.
+struct CaptureStats {
+    unsigned long long frames;
+    unsigned int stalls;        // frames whose fence had not signalled when their slot was needed
+    double readMs;              // issuing glReadPixels and the fence
+    double mapMs;               // waiting for fences and mapping
+    double consumerMs;
+};
+
+struct FrameCapture {
+    std::vector<CaptureSlot> slots;
+    unsigned int next;          // slot written by the next captureFrame
+    unsigned long long captured;
+    CaptureConsumer consumer;
+    CaptureStats stats;
+};
+
+void createFrameCapture(FrameCapture& capture, CaptureConsumer consumer, unsigned int depth = FRAME_CAPTURE_DEPTH);
+void destroyFrameCapture(FrameCapture& capture);
+
+// Reads the current read framebuffer (the back buffer before the swap) and
+// hands the frame captured depth calls ago to the consumer.
+void captureFrame(FrameCapture& capture, int width, int height);
+// Delivers every frame still in flight, waiting for the GPU as needed.
+void flushFrameCapture(FrameCapture& capture);
+
+double captureOverheadMs(const CaptureStats& stats);
+void resetCaptureStats(FrameCapture& capture);
@@ -0,0 +1,60 @@
+#include "frame_mailbox.h"
+
+#include <utility>
+
+
+void createFrameMailbox(FrameMailbox& mailbox) {
+    mailbox.writeSlot = 0;
+    mailbox.readySlot = 1;
+    mailbox.readSlot = 2;
+    mailbox.fresh = false;
+    mailbox.closed = false;
+    mailbox.publishedCount = 0;
+    mailbox.droppedCount = 0;
+}
+
+
+FrameSnapshot& beginSnapshot(FrameMailbox& mailbox) {
+    // Only the producer touches writeSlot, so no lock is needed here.
+    return mailbox.slots[mailbox.writeSlot];
+}
+
+
+void publishSnapshot(FrameMailbox& mailbox) {
+    {
+        std::lock_guard<std::mutex> lock(mailbox.mutex);
+        if (mailbox.fresh)
+            mailbox.droppedCount++;
+        mailbox.publishedCount++;
+
+        FrameSnapshot& snapshot = mailbox.slots[mailbox.writeSlot];
+        snapshot.published = std::chrono::steady_clock::now();
+        snapshot.publishedCount = mailbox.publishedCount;
+        snapshot.droppedCount = mailbox.droppedCount;
+
+        std::swap(mailbox.writeSlot, mailbox.readySlot);
+        mailbox.fresh = true;
+    }
+    mailbox.available.notify_one();
+}
+
+
+const FrameSnapshot* acquireSnapshot(FrameMailbox& mailbox) {
+    std::unique_lock<std::mutex> lock(mailbox.mutex);
+    mailbox.available.wait(lock, [&] { return mailbox.fresh || mailbox.closed; });
+    if (mailbox.closed)
+        return nullptr;
+
+    std::swap(mailbox.readSlot, mailbox.readySlot);
+    mailbox.fresh = false;
+    return &mailbox.slots[mailbox.readSlot];
+}
+
+
+void closeFrameMailbox(FrameMailbox& mailbox) {
+    {
+        std::lock_guard<std::mutex> lock(mailbox.mutex);
+        mailbox.closed = true;
+    }
+    mailbox.available.notify_all();
+}
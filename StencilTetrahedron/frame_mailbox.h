@@ -0,0 +1,55 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+
+// Everything the render thread needs for one frame, taken by the simulation
+// thread at a single point in time. A published snapshot is never modified.
+struct FrameSnapshot {
+    unsigned long long sequence;
+    double time;                                        // glfwGetTime() when the snapshot was taken
+    std::chrono::steady_clock::time_point published;
+    unsigned long long publishedCount, droppedCount;   // mailbox totals at publication
+
+    glm::mat4 rotation;
+    std::vector<glm::mat4> instanceModels;              // lattice instances in scene order, lattice mode only
+    int framebufferWidth, framebufferHeight;
+    bool showStats, latticeMode, lodEnabled, cullingEnabled, occlusionEnabled;
+    bool csgMode, csgTorusCut, proceduralMode, capturing, captureYCoCg, dynamicResolution;
+    unsigned int proceduralNumc, proceduralNumt;
+    int swapInterval;
+    bool paused;                                        // animation stopped; only changes are published
+    unsigned long long skippedCount;                    // idle wake-ups that had nothing to redraw
+};
+
+// Triple-buffered hand-over from one producer to one consumer. Each side owns
+// a slot outright and only swaps it with the shared "ready" slot under a short
+// lock, so the producer never waits for the consumer to finish a frame. A
+// snapshot replaced before the consumer picked it up counts as dropped.
+struct FrameMailbox {
+    FrameSnapshot slots[3];
+    unsigned int writeSlot, readySlot, readSlot;
+    bool fresh, closed;
+    unsigned long long publishedCount, droppedCount;
+    std::mutex mutex;
+    std::condition_variable available;
+};
+
+void createFrameMailbox(FrameMailbox& mailbox);
+
+// Producer side: fill the returned snapshot, then publish it.
+FrameSnapshot& beginSnapshot(FrameMailbox& mailbox);
+void publishSnapshot(FrameMailbox& mailbox);
+
+// Consumer side: blocks until a snapshot newer than the previous one is
+// available and returns it; it stays valid until the next call. Returns null
+// once the mailbox is closed.
+const FrameSnapshot* acquireSnapshot(FrameMailbox& mailbox);
+
+// Wakes a waiting consumer for shutdown.
+void closeFrameMailbox(FrameMailbox& mailbox);
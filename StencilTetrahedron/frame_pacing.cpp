@@ -0,0 +1,144 @@
+#include "frame_pacing.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/resource.h>
+#endif
+
+
+// Bounds for the spin margin: enough to absorb a typical wake-up delay, and
+// no more than a few milliseconds of spinning per frame however coarse the
+// system timer is.
+const std::chrono::microseconds MIN_SPIN_MARGIN(100), MAX_SPIN_MARGIN(4000);
+
+
+void parseFramePacingOptions(int argc, char** argv, FramePacingSettings& settings) {
+    settings.swapInterval = 1;
+    settings.fpsLimit = 0.0;
+    settings.idleTimeout = 0.5;
+
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::strcmp(argv[i], "--swap-interval") == 0)
+            settings.swapInterval = std::max(0, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--fps-limit") == 0)
+            settings.fpsLimit = std::max(0.0, std::atof(argv[++i]));
+        else if (std::strcmp(argv[i], "--idle-timeout") == 0)
+            settings.idleTimeout = std::max(0.01, std::atof(argv[++i]));
+    }
+}
+
+
+void setFrameLimit(FrameLimiter& limiter, double fps) {
+    limiter = FrameLimiter();
+    if (fps > 0.0) {
+        limiter.interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(1.0 / fps));
+    }
+    limiter.spinMargin = std::chrono::milliseconds(1);
+    limiter.deadline = std::chrono::steady_clock::now();
+}
+
+
+void waitForFrameSlot(FrameLimiter& limiter) {
+    using clock = std::chrono::steady_clock;
+    if (limiter.interval == clock::duration::zero())
+        return;
+
+    clock::time_point now = clock::now();
+    if (now >= limiter.deadline) {
+        if (now - limiter.deadline > limiter.interval / 10)
+            limiter.missed++;
+        limiter.deadline = now + limiter.interval;
+        return;
+    }
+
+    clock::time_point wake = limiter.deadline - limiter.spinMargin;
+    if (now < wake) {
+        std::this_thread::sleep_until(wake);
+        clock::time_point woke = clock::now();
+        limiter.sleptMs += std::chrono::duration<double, std::milli>(woke - now).count();
+        // Grow straight to a new worst oversleep, shrink back slowly.
+        clock::duration oversleep = woke - wake;
+        limiter.spinMargin = std::max(oversleep + MIN_SPIN_MARGIN, limiter.spinMargin - limiter.spinMargin / 16);
+        limiter.spinMargin = std::clamp(limiter.spinMargin, clock::duration(MIN_SPIN_MARGIN),
+                                        clock::duration(MAX_SPIN_MARGIN));
+        now = woke;
+    }
+
+    clock::time_point spinStart = now;
+    while (now < limiter.deadline)
+        now = clock::now();
+    limiter.spunMs += std::chrono::duration<double, std::milli>(now - spinStart).count();
+    limiter.deadline += limiter.interval;
+}
+
+
+void restartFrameSchedule(FrameLimiter& limiter) {
+    limiter.deadline = std::chrono::steady_clock::now() + limiter.interval;
+}
+
+
+void resetFramePacingStats(FramePacingStats& stats) {
+    std::chrono::steady_clock::time_point lastPresent = stats.lastPresent;
+    stats = FramePacingStats();
+    stats.start = std::chrono::steady_clock::now();
+    stats.lastPresent = lastPresent;
+    stats.cpuStart = processCpuSeconds();
+}
+
+
+void recordFramePresented(FramePacingStats& stats) {
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (stats.lastPresent != std::chrono::steady_clock::time_point()) {
+        double ms = std::chrono::duration<double, std::milli>(now - stats.lastPresent).count();
+        stats.minMs = stats.intervals ? std::min(stats.minMs, ms) : ms;
+        stats.maxMs = std::max(stats.maxMs, ms);
+        stats.sumMs += ms;
+        stats.sumSquaresMs += ms * ms;
+        stats.intervals++;
+    }
+    stats.lastPresent = now;
+}
+
+
+FramePacingReport framePacingReport(const FramePacingStats& stats) {
+    FramePacingReport report = FramePacingReport();
+    if (stats.intervals > 0) {
+        double n = stats.intervals;
+        report.meanMs = stats.sumMs / n;
+        report.jitterMs = std::sqrt(std::max(0.0, stats.sumSquaresMs / n - report.meanMs * report.meanMs));
+        report.minMs = stats.minMs;
+        report.maxMs = stats.maxMs;
+    }
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - stats.start).count();
+    if (wall > 0.0)
+        report.cpuPercent = 100.0 * (processCpuSeconds() - stats.cpuStart) / wall;
+    return report;
+}
+
+
+double processCpuSeconds() {
+#if defined(_WIN32)
+    FILETIME creation, exit, kernel, user;
+    if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user))
+        return 0.0;
+    auto seconds = [](const FILETIME& time) {
+        return (((unsigned long long)time.dwHighDateTime << 32) | time.dwLowDateTime) * 1.0e-7;
+    };
+    return seconds(kernel) + seconds(user);
+#else
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0.0;
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1.0e-6;
+#endif
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <chrono>
+
+
+struct FramePacingSettings {
+    int swapInterval;           // for glfwSwapInterval; 0 turns vsync off
+    double fpsLimit;            // frames per second the renderer is capped at, 0 for none
+    double idleTimeout;         // seconds between wake-ups while the animation is paused
+};
+
+// --swap-interval n, --fps-limit f and --idle-timeout s.
+void parseFramePacingOptions(int argc, char** argv, FramePacingSettings& settings);
+
+// Caps the frame rate. A plain sleep wakes up late by up to the scheduler's
+// granularity, so the limiter sleeps until a margin before the deadline and
+// spins the rest of the way. The margin follows the largest recent oversleep.
+struct FrameLimiter {
+    std::chrono::steady_clock::duration interval;   // zero when the cap is off
+    std::chrono::steady_clock::time_point deadline;
+    std::chrono::steady_clock::duration spinMargin;
+    double sleptMs, spunMs;                         // since the last reset
+    unsigned int missed;                            // frames that started after their deadline
+};
+
+void setFrameLimit(FrameLimiter& limiter, double fps);
+
+// Blocks until the next frame may start. A frame that overran its slot
+// starts right away and the schedule restarts from it, so the renderer
+// never bursts to catch up.
+void waitForFrameSlot(FrameLimiter& limiter);
+
+// Restarts the schedule from a frame starting now, without counting a miss:
+// for a renderer that sat waiting for work, such as an idle pause, past its
+// next deadline.
+void restartFrameSchedule(FrameLimiter& limiter);
+
+// Intervals between presented frames, and the process's CPU time over the
+// same period.
+struct FramePacingStats {
+    std::chrono::steady_clock::time_point start, lastPresent;
+    double cpuStart;
+    unsigned int intervals;
+    double sumMs, sumSquaresMs, minMs, maxMs;
+};
+
+struct FramePacingReport {
+    double meanMs;
+    double jitterMs;            // standard deviation of the frame interval
+    double minMs, maxMs;
+    double cpuPercent;          // of one core, so above 100 with several threads busy
+};
+
+void resetFramePacingStats(FramePacingStats& stats);
+void recordFramePresented(FramePacingStats& stats);
+FramePacingReport framePacingReport(const FramePacingStats& stats);
+
+// User plus system CPU time of the whole process, in seconds.
+double processCpuSeconds();
@@ -0,0 +1,470 @@
+#include "frame_sink.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define FRAME_SINK_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__)
+#define FRAME_SINK_URING 1
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#endif
+
+
+#if FRAME_SINK_URING
+// The rings are used directly through the three io_uring syscalls, so there is
+// no liburing dependency. This thread is the only producer and consumer.
+struct FrameSinkRing {
+    int fd;
+    void* sqRing;
+    void* cqRing;
+    size_t sqRingBytes, cqRingBytes, sqeBytes;
+    unsigned* sqHead;
+    unsigned* sqTail;
+    unsigned sqMask;
+    unsigned* sqArray;
+    io_uring_sqe* sqes;
+    unsigned* cqHead;
+    unsigned* cqTail;
+    unsigned cqMask;
+    io_uring_cqe* cqes;
+    std::vector<unsigned long long> slotOffset;     // file offset of each slot's frame
+    std::vector<size_t> slotWritten;                // bytes already written, for short writes
+};
+
+
+static int uringSetup(unsigned entries, io_uring_params* params) {
+    return (int)syscall(__NR_io_uring_setup, entries, params);
+}
+
+
+static int uringEnter(int fd, unsigned submit, unsigned minComplete, unsigned flags) {
+    return (int)syscall(__NR_io_uring_enter, fd, submit, minComplete, flags, NULL, 0);
+}
+
+
+static int uringRegister(int fd, unsigned opcode, const void* arg, unsigned count) {
+    return (int)syscall(__NR_io_uring_register, fd, opcode, arg, count);
+}
+
+
+static void destroyRing(FrameSinkRing* ring) {
+    if (ring->sqes && ring->sqes != MAP_FAILED)
+        munmap(ring->sqes, ring->sqeBytes);
+    if (ring->cqRing && ring->cqRing != MAP_FAILED && ring->cqRing != ring->sqRing)
+        munmap(ring->cqRing, ring->cqRingBytes);
+    if (ring->sqRing && ring->sqRing != MAP_FAILED)
+        munmap(ring->sqRing, ring->sqRingBytes);
+    if (ring->fd >= 0)
+        close(ring->fd);
+    delete ring;
+}
+
+
+static FrameSinkRing* createRing(unsigned entries) {
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    FrameSinkRing* ring = new FrameSinkRing();
+    ring->fd = uringSetup(entries, &params);
+    if (ring->fd < 0) {
+        delete ring;
+        return nullptr;
+    }
+
+    ring->sqRingBytes = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    ring->cqRingBytes = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (singleMap)
+        ring->sqRingBytes = ring->cqRingBytes = std::max(ring->sqRingBytes, ring->cqRingBytes);
+    ring->sqRing = mmap(NULL, ring->sqRingBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQ_RING);
+    ring->cqRing = singleMap ? ring->sqRing
+        : mmap(NULL, ring->cqRingBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_CQ_RING);
+    ring->sqeBytes = params.sq_entries * sizeof(io_uring_sqe);
+    ring->sqes = (io_uring_sqe*)mmap(NULL, ring->sqeBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES);
+    if (ring->sqRing == MAP_FAILED || ring->cqRing == MAP_FAILED || ring->sqes == MAP_FAILED) {
+        destroyRing(ring);
+        return nullptr;
+    }
+
+    unsigned char* sq = (unsigned char*)ring->sqRing;
+    ring->sqHead = (unsigned*)(sq + params.sq_off.head);
+    ring->sqTail = (unsigned*)(sq + params.sq_off.tail);
+    ring->sqMask = *(unsigned*)(sq + params.sq_off.ring_mask);
+    ring->sqArray = (unsigned*)(sq + params.sq_off.array);
+    unsigned char* cq = (unsigned char*)ring->cqRing;
+    ring->cqHead = (unsigned*)(cq + params.cq_off.head);
+    ring->cqTail = (unsigned*)(cq + params.cq_off.tail);
+    ring->cqMask = *(unsigned*)(cq + params.cq_off.ring_mask);
+    ring->cqes = (io_uring_cqe*)(cq + params.cq_off.cqes);
+    return ring;
+}
+
+
+// Queues the rest of a slot's frame; the kernel picks it up without blocking
+// the caller (buffered writes it cannot complete inline go to its workers).
+// Without SQPOLL the kernel only reads the queue inside io_uring_enter, so an
+// entry a failed enter left behind is taken back rather than submitted later.
+static bool queueWrite(FrameSink& sink, unsigned slot) {
+    FrameSinkRing* ring = sink.ring;
+    unsigned tail = *ring->sqTail;
+    if (tail - __atomic_load_n(ring->sqHead, __ATOMIC_ACQUIRE) > ring->sqMask)
+        return false;
+    unsigned index = tail & ring->sqMask;
+    io_uring_sqe* sqe = &ring->sqes[index];
+    std::memset(sqe, 0, sizeof(*sqe));
+    size_t written = ring->slotWritten[slot];
+    sqe->opcode = sink.registeredBuffers ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+    sqe->fd = sink.fd;
+    sqe->addr = (unsigned long long)(uintptr_t)(sink.buffers[slot] + written);
+    sqe->len = (unsigned)(sink.frameBytes - written);
+    sqe->off = ring->slotOffset[slot] + written;
+    sqe->buf_index = sink.registeredBuffers ? (unsigned short)slot : 0;
+    sqe->user_data = slot;
+    ring->sqArray[index] = index;
+    __atomic_store_n(ring->sqTail, tail + 1, __ATOMIC_RELEASE);
+    for (;;) {
+        int submitted = uringEnter(ring->fd, 1, 0, 0);
+        if (__atomic_load_n(ring->sqHead, __ATOMIC_ACQUIRE) != tail)
+            return true;
+        if (submitted < 0 && errno == EINTR)
+            continue;
+        __atomic_store_n(ring->sqTail, tail, __ATOMIC_RELEASE);
+        return false;
+    }
+}
+
+
+static void reapCompletions(FrameSink& sink) {
+    FrameSinkRing* ring = sink.ring;
+    unsigned head = *ring->cqHead;
+    unsigned tail = __atomic_load_n(ring->cqTail, __ATOMIC_ACQUIRE);
+    for (; head != tail; head++) {
+        const io_uring_cqe& cqe = ring->cqes[head & ring->cqMask];
+        unsigned slot = (unsigned)cqe.user_data;
+        if (cqe.res < 0) {
+            std::cerr << "Frame sink write failed: " << std::strerror(-cqe.res) << std::endl;
+        }
+        else {
+            ring->slotWritten[slot] += (size_t)cqe.res;
+            sink.stats.bytes += (unsigned long long)cqe.res;
+            if (cqe.res > 0 && ring->slotWritten[slot] < sink.frameBytes) {
+                if (queueWrite(sink, slot))
+                    continue;
+                std::cerr << "Frame sink could not queue a write" << std::endl;
+            }
+        }
+        sink.busy[slot] = false;
+        sink.completed++;
+        sink.stats.frames += ring->slotWritten[slot] == sink.frameBytes;
+        sink.lastCompletion = std::chrono::steady_clock::now();
+    }
+    __atomic_store_n(ring->cqHead, head, __ATOMIC_RELEASE);
+}
+
+
+static bool openUringSink(FrameSink& sink) {
+    sink.ring = createRing(sink.depth * 2);
+    if (!sink.ring)
+        return false;
+
+    std::vector<iovec> iovecs(sink.depth);
+    for (unsigned int slot = 0; slot < sink.depth; slot++) {
+        iovecs[slot].iov_base = sink.buffers[slot];
+        iovecs[slot].iov_len = sink.frameBytes;
+    }
+    // Registering pins the buffers once instead of on every write; it can fail
+    // against RLIMIT_MEMLOCK, in which case plain writes still work.
+    sink.registeredBuffers = uringRegister(sink.ring->fd, IORING_REGISTER_BUFFERS, iovecs.data(), sink.depth) == 0;
+    sink.ring->slotOffset.assign(sink.depth, 0);
+    sink.ring->slotWritten.assign(sink.depth, 0);
+    sink.busy.assign(sink.depth, false);
+    return true;
+}
+#else
+struct FrameSinkRing {};
+#endif
+
+
+#if FRAME_SINK_MMAP
+// Writes each finished frame back so dirty pages never pile up beyond depth
+// frames, whatever the length of the job.
+static void writebackThread(FrameSink* sink) {
+    long pageSize = sysconf(_SC_PAGESIZE);
+    for (;;) {
+        unsigned long long frame;
+        {
+            std::unique_lock<std::mutex> lock(sink->mutex);
+            sink->changed.wait(lock, [&] { return sink->quit || sink->submitted > sink->completed; });
+            if (sink->submitted == sink->completed)
+                return;
+            frame = sink->completed;
+        }
+
+        size_t start = (size_t)(frame * sink->frameBytes);
+        size_t alignedStart = start - start % (size_t)pageSize;
+        msync(sink->mapping + alignedStart, start + sink->frameBytes - alignedStart, MS_SYNC);
+
+        std::lock_guard<std::mutex> lock(sink->mutex);
+        sink->completed++;
+        sink->stats.frames++;
+        sink->stats.bytes += sink->frameBytes;
+        sink->lastCompletion = std::chrono::steady_clock::now();
+        sink->changed.notify_all();
+    }
+}
+
+
+static bool openMmapSink(FrameSink& sink) {
+    size_t bytes = (size_t)(sink.frameCount * sink.frameBytes);
+    if (sink.frameCount == 0 || bytes / sink.frameBytes != sink.frameCount || ftruncate(sink.fd, (off_t)bytes) != 0)
+        return false;
+    void* mapping = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, sink.fd, 0);
+    if (mapping == MAP_FAILED)
+        return false;
+    sink.mapping = (unsigned char*)mapping;
+    sink.worker = std::thread(writebackThread, &sink);
+    return true;
+}
+#endif
+
+
+static void writerThread(FrameSink* sink) {
+    for (;;) {
+        unsigned long long frame;
+        {
+            std::unique_lock<std::mutex> lock(sink->mutex);
+            sink->changed.wait(lock, [&] { return sink->quit || sink->submitted > sink->completed; });
+            if (sink->submitted == sink->completed)
+                return;
+            frame = sink->completed;
+        }
+
+        sink->stream.write((const char*)sink->buffers[frame % sink->depth], (std::streamsize)sink->frameBytes);
+        bool written = (bool)sink->stream;
+
+        std::lock_guard<std::mutex> lock(sink->mutex);
+        sink->completed++;
+        if (written) {
+            sink->stats.frames++;
+            sink->stats.bytes += sink->frameBytes;
+        }
+        sink->lastCompletion = std::chrono::steady_clock::now();
+        sink->changed.notify_all();
+    }
+}
+
+
+bool openFrameSink(FrameSink& sink, const char* path, int width, int height, bool ppm,
+                   unsigned long long frameCount, unsigned int depth, FrameSinkBackend backend) {
+    sink.width = width;
+    sink.height = height;
+    sink.ppm = ppm;
+    sink.headerBytes = 0;
+    if (ppm) {
+        char header[64];
+        sink.headerBytes = (size_t)std::snprintf(header, sizeof(header), "P6\n%d %d\n255\n", width, height);
+    }
+    sink.frameBytes = sink.headerBytes + (size_t)width * height * 3;
+    sink.depth = depth < 1 ? 1 : depth;
+    sink.frameCount = frameCount;
+    sink.submitted = 0;
+    sink.completed = 0;
+    sink.fd = -1;
+    sink.ring = nullptr;
+    sink.registeredBuffers = false;
+    sink.mapping = nullptr;
+    sink.quit = false;
+    sink.stats = FrameSinkStats();
+
+#if FRAME_SINK_MMAP
+    if (backend != FrameSinkBackend::Thread) {
+        sink.fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (sink.fd < 0) {
+            std::cerr << "Failed to open " << path << " for writing" << std::endl;
+            return false;
+        }
+    }
+#endif
+
+    // Every backend but Mmap renders into depth private buffers.
+    auto allocateBuffers = [&] {
+        sink.storage.assign(sink.frameBytes * sink.depth, 0);
+        sink.buffers.resize(sink.depth);
+        for (unsigned int slot = 0; slot < sink.depth; slot++)
+            sink.buffers[slot] = sink.storage.data() + slot * sink.frameBytes;
+    };
+
+    sink.backend = FrameSinkBackend::Thread;
+#if FRAME_SINK_URING
+    if (backend == FrameSinkBackend::IoUring) {
+        allocateBuffers();
+        if (openUringSink(sink))
+            sink.backend = FrameSinkBackend::IoUring;
+        else
+            backend = FrameSinkBackend::Mmap;
+    }
+#endif
+#if FRAME_SINK_MMAP
+    if (backend == FrameSinkBackend::Mmap && openMmapSink(sink)) {
+        sink.backend = FrameSinkBackend::Mmap;
+        sink.storage.clear();
+    }
+    if (sink.backend == FrameSinkBackend::Thread && sink.fd >= 0) {
+        close(sink.fd);
+        sink.fd = -1;
+    }
+#endif
+    if (sink.backend == FrameSinkBackend::Thread) {
+        allocateBuffers();
+        sink.stream.open(path, std::ios::binary | std::ios::trunc);
+        if (!sink.stream) {
+            std::cerr << "Failed to open " << path << " for writing" << std::endl;
+            return false;
+        }
+        sink.worker = std::thread(writerThread, &sink);
+    }
+
+    sink.opened = sink.lastCompletion = std::chrono::steady_clock::now();
+    return true;
+}
+
+
+static unsigned char* frameStart(FrameSink& sink) {
+    if (sink.backend == FrameSinkBackend::Mmap)
+        return sink.mapping + sink.submitted * sink.frameBytes;
+    return sink.buffers[sink.submitted % sink.depth];
+}
+
+
+unsigned char* acquireFrameBuffer(FrameSink& sink) {
+    bool available;
+    if (sink.backend == FrameSinkBackend::IoUring) {
+#if FRAME_SINK_URING
+        reapCompletions(sink);
+#endif
+        available = !sink.busy[sink.submitted % sink.depth];
+    }
+    else {
+        std::lock_guard<std::mutex> lock(sink.mutex);
+        available = sink.submitted - sink.completed < sink.depth;
+        if (sink.backend == FrameSinkBackend::Mmap && sink.submitted == sink.frameCount) {
+            std::cerr << "Frame sink is full (" << sink.frameCount << " frames)" << std::endl;
+            return nullptr;
+        }
+    }
+    if (!available) {
+        sink.stats.backpressure++;
+        return nullptr;
+    }
+
+    unsigned char* frame = frameStart(sink);
+    if (sink.ppm)
+        std::snprintf((char*)frame, sink.headerBytes + 1, "P6\n%d %d\n255\n", sink.width, sink.height);
+    return frame + sink.headerBytes;
+}
+
+
+void submitFrameBuffer(FrameSink& sink) {
+    if (sink.backend == FrameSinkBackend::IoUring) {
+#if FRAME_SINK_URING
+        unsigned slot = (unsigned)(sink.submitted % sink.depth);
+        sink.ring->slotOffset[slot] = sink.submitted * sink.frameBytes;
+        sink.ring->slotWritten[slot] = 0;
+        sink.busy[slot] = true;
+        sink.submitted++;
+        if (!queueWrite(sink, slot)) {
+            std::cerr << "Frame sink could not queue a write" << std::endl;
+            sink.busy[slot] = false;
+            sink.completed++;
+        }
+#endif
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(sink.mutex);
+        sink.submitted++;
+    }
+    sink.changed.notify_all();
+}
+
+
+void waitForFrameSink(FrameSink& sink) {
+    if (sink.backend == FrameSinkBackend::IoUring) {
+#if FRAME_SINK_URING
+        while (sink.busy[sink.submitted % sink.depth]) {
+            uringEnter(sink.ring->fd, 0, 1, IORING_ENTER_GETEVENTS);
+            reapCompletions(sink);
+        }
+#endif
+        return;
+    }
+    std::unique_lock<std::mutex> lock(sink.mutex);
+    sink.changed.wait(lock, [&] { return sink.submitted - sink.completed < sink.depth; });
+}
+
+
+void closeFrameSink(FrameSink& sink) {
+    if (sink.backend == FrameSinkBackend::IoUring) {
+#if FRAME_SINK_URING
+        while (sink.completed < sink.submitted) {
+            uringEnter(sink.ring->fd, 0, 1, IORING_ENTER_GETEVENTS);
+            reapCompletions(sink);
+        }
+        destroyRing(sink.ring);
+        sink.ring = nullptr;
+#endif
+    }
+    else {
+        {
+            std::lock_guard<std::mutex> lock(sink.mutex);
+            sink.quit = true;
+        }
+        sink.changed.notify_all();
+        if (sink.worker.joinable())
+            sink.worker.join();
+    }
+
+#if FRAME_SINK_MMAP
+    if (sink.mapping) {
+        munmap(sink.mapping, (size_t)(sink.frameCount * sink.frameBytes));
+        sink.mapping = nullptr;
+        // Frames that were never rendered are cut off again.
+        if (ftruncate(sink.fd, (off_t)(sink.submitted * sink.frameBytes)) != 0)
+            std::cerr << "Failed to trim the frame sink file" << std::endl;
+    }
+    if (sink.fd >= 0) {
+        close(sink.fd);
+        sink.fd = -1;
+    }
+#endif
+    if (sink.stream.is_open())
+        sink.stream.close();
+    sink.stats.seconds = std::chrono::duration<double>(sink.lastCompletion - sink.opened).count();
+}
+
+
+const char* frameSinkBackendName(FrameSinkBackend backend) {
+    switch (backend) {
+    case FrameSinkBackend::IoUring:
+        return "io_uring";
+    case FrameSinkBackend::Mmap:
+        return "mmap";
+    default:
+        return "writer thread";
+    }
+}
+
+
+double frameSinkMegabytesPerSecond(const FrameSinkStats& stats) {
+    return stats.seconds > 0.0 ? stats.bytes / (stats.seconds * 1.0e6) : 0.0;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+// Streams rendered frames into one file (raw RGB24, or a PPM per frame back to
+// back, which ffmpeg reads as a ppm pipe) without writing from the caller:
+//   IoUring: a few registered buffers handed to the kernel with WRITE_FIXED
+//            (Linux; plain WRITE when the buffers cannot be registered).
+//   Mmap:    the file is sized up front and mapped; frames are rendered
+//            straight into it, and a writeback thread msyncs each one (POSIX).
+//   Thread:  buffers written with an ofstream on a writer thread (anywhere).
+// At most depth frames are in flight. acquireFrameBuffer never blocks: it
+// returns null while all of them are, and the caller chooses between waiting
+// (waitForFrameSink) and doing something else.
+enum class FrameSinkBackend { IoUring, Mmap, Thread };
+
+struct FrameSinkStats {
+    unsigned long long frames;
+    unsigned long long bytes;
+    unsigned int backpressure;      // acquires refused because depth frames were in flight
+    double seconds;                 // open to the last completed write
+};
+
+struct FrameSinkRing;               // io_uring state, Linux only
+
+struct FrameSink {
+    FrameSinkBackend backend;
+    int width, height;
+    bool ppm;
+    size_t headerBytes, frameBytes;
+    unsigned int depth;
+    unsigned long long frameCount; // mmap file size in frames
+
+    unsigned long long submitted;
+    unsigned long long completed;   // guarded by mutex for Mmap and Thread
+    std::vector<unsigned char> storage;
+    std::vector<unsigned char*> buffers;
+    std::vector<bool> busy;         // IoUring slots still owned by the kernel
+    bool registeredBuffers;
+
+    int fd;
+    FrameSinkRing* ring;
+    unsigned char* mapping;
+    std::ofstream stream;
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable changed;
+    bool quit;
+
+    std::chrono::steady_clock::time_point opened, lastCompletion;
+    FrameSinkStats stats;
+};
+
+// frameCount is only needed by Mmap, which fails without it; an unavailable
+// backend falls back to the next one in the order above.
+bool openFrameSink(FrameSink& sink, const char* path, int width, int height, bool ppm,
+                   unsigned long long frameCount, unsigned int depth, FrameSinkBackend backend);
+
+// Returns width * height RGB24 pixels to fill, top row first, or null under
+// backpressure. Each acquired buffer must be submitted before the next acquire.
+unsigned char* acquireFrameBuffer(FrameSink& sink);
+void submitFrameBuffer(FrameSink& sink);
+
+// Blocks until a buffer can be acquired.
+void waitForFrameSink(FrameSink& sink);
+
+// Waits for every write and closes the file; stats are final afterwards.
+void closeFrameSink(FrameSink& sink);
+
+const char* frameSinkBackendName(FrameSinkBackend backend);
+double frameSinkMegabytesPerSecond(const FrameSinkStats& stats);
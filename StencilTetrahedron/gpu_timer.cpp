@@ -0,0 +1,67 @@
+#include "gpu_timer.h"
+
+
+void createGpuTimer(GpuTimer& timer) {
+    timer = GpuTimer();
+    glGenQueries(GPU_TIMER_LATENCY, timer.queries);
+}
+
+
+void destroyGpuTimer(GpuTimer& timer) {
+    glDeleteQueries(GPU_TIMER_LATENCY, timer.queries);
+}
+
+
+void beginGpuTimer(GpuTimer& timer) {
+    unsigned int slot = timer.frame % GPU_TIMER_LATENCY;
+    if (timer.pending[slot]) {
+        GLuint64 elapsed = 0;
+        glGetQueryObjectui64v(timer.queries[slot], GL_QUERY_RESULT, &elapsed);
+        timer.lastMs = elapsed / 1.0e6;
+    }
+    glBeginQuery(GL_TIME_ELAPSED, timer.queries[slot]);
+    timer.pending[slot] = true;
+}
+
+
+void endGpuTimer(GpuTimer& timer) {
+    glEndQuery(GL_TIME_ELAPSED);
+    timer.frame++;
+}
+
+
+void createGpuSpanTimer(GpuSpanTimer& timer) {
+    timer = GpuSpanTimer();
+    glGenQueries(2 * GPU_TIMER_LATENCY, &timer.queries[0][0]);
+}
+
+
+void destroyGpuSpanTimer(GpuSpanTimer& timer) {
+    glDeleteQueries(2 * GPU_TIMER_LATENCY, &timer.queries[0][0]);
+}
+
+
+bool beginGpuSpan(GpuSpanTimer& timer) {
+    unsigned int slot = timer.frame % GPU_TIMER_LATENCY;
+    bool resolved = timer.pending[slot];
+    if (resolved) {
+        GLuint64 begin = 0, end = 0;
+        glGetQueryObjectui64v(timer.queries[slot][0], GL_QUERY_RESULT, &begin);
+        glGetQueryObjectui64v(timer.queries[slot][1], GL_QUERY_RESULT, &end);
+        timer.lastMs = (end - begin) / 1.0e6;
+    }
+    // Flushing puts each timestamp at a submission boundary. Drivers that only
+    // rasterize when a batch is flushed (llvmpipe) otherwise stamp both ends
+    // before any of the span's pixels are drawn.
+    glQueryCounter(timer.queries[slot][0], GL_TIMESTAMP);
+    glFlush();
+    timer.pending[slot] = true;
+    return resolved;
+}
+
+
+void endGpuSpan(GpuSpanTimer& timer) {
+    glQueryCounter(timer.queries[timer.frame % GPU_TIMER_LATENCY][1], GL_TIMESTAMP);
+    glFlush();
+    timer.frame++;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <glad/glad.h>
+
+
+// GL_TIME_ELAPSED queries in a small ring so results are read a few frames
+// late instead of stalling on the frame that issued them.
+const unsigned int GPU_TIMER_LATENCY = 3;
+
+struct GpuTimer {
+    GLuint queries[GPU_TIMER_LATENCY];
+    bool pending[GPU_TIMER_LATENCY];
+    unsigned int frame;
+    double lastMs;
+};
+
+void createGpuTimer(GpuTimer& timer);
+void destroyGpuTimer(GpuTimer& timer);
+void beginGpuTimer(GpuTimer& timer);
+void endGpuTimer(GpuTimer& timer);
+
+// The same ring with a GL_TIMESTAMP pair per frame instead, for spans that
+// contain GL_TIME_ELAPSED queries of their own (those cannot nest).
+struct GpuSpanTimer {
+    GLuint queries[GPU_TIMER_LATENCY][2];
+    bool pending[GPU_TIMER_LATENCY];
+    unsigned int frame;
+    double lastMs;
+};
+
+void createGpuSpanTimer(GpuSpanTimer& timer);
+void destroyGpuSpanTimer(GpuSpanTimer& timer);
+// Returns true when lastMs was just updated with the span that last used this
+// slot, GPU_TIMER_LATENCY frames ago.
+bool beginGpuSpan(GpuSpanTimer& timer);
+void endGpuSpan(GpuSpanTimer& timer);
@@ -0,0 +1,77 @@
+#include "lod.h"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
+
+
+TorusLod createTorusLod(float innerRadius, float outerRadius, unsigned int numc, unsigned int numt,
+                        unsigned int levelCount) {
+    return uploadTorusLod(generateTorusLodLevels(innerRadius, outerRadius, numc, numt, levelCount),
+                          innerRadius, outerRadius);
+}
+
+
+std::vector<Torus> generateTorusLodLevels(float innerRadius, float outerRadius, unsigned int numc, unsigned int numt,
+                                          unsigned int levelCount) {
+    std::vector<Torus> levels;
+    for (unsigned int i = 0; i < levelCount; ++i) {
+        unsigned int levelNumc = glm::max(numc >> i, 4u);
+        unsigned int levelNumt = glm::max(numt >> i, 4u);
+        if (!levels.empty() && levels.back().numc == levelNumc && levels.back().numt == levelNumt)
+            break;
+
+        levels.push_back(generateTorus(innerRadius, outerRadius, levelNumc, levelNumt));
+    }
+    return levels;
+}
+
+
+TorusLod uploadTorusLod(const std::vector<Torus>& levels, float innerRadius, float outerRadius) {
+    TorusLod lod;
+    for (const Torus& torus : levels) {
+        TorusLodLevel level;
+        level.numc = torus.numc;
+        level.numt = torus.numt;
+        level.mesh = uploadMesh(torus.vertices, torus.indices);
+        level.geometricError = torusTessellationError(innerRadius, outerRadius, level.numc, level.numt);
+        lod.levels.push_back(level);
+    }
+    return lod;
+}
+
+
+void destroyTorusLod(TorusLod& lod) {
+    for (TorusLodLevel& level : lod.levels)
+        destroyMesh(level.mesh);
+    lod.levels.clear();
+}
+
+
+float torusTessellationError(float innerRadius, float outerRadius, unsigned int numc, unsigned int numt) {
+    // Sagitta of the chords along the widest major circle plus those of the tube.
+    float major = (outerRadius + innerRadius) * (1.0f - glm::cos(glm::pi<float>() / numc));
+    float minor = innerRadius * (1.0f - glm::cos(glm::pi<float>() / numt));
+    return major + minor;
+}
+
+
+float projectedPixelError(float geometricError, float distance, const LodSettings& settings) {
+    distance = glm::max(distance, 1.0e-3f);
+    return geometricError * settings.viewportHeight / (2.0f * distance * glm::tan(0.5f * settings.fovY));
+}
+
+
+unsigned int selectLodLevel(const TorusLod& lod, float distance, const LodSettings& settings,
+                            unsigned int currentLevel) {
+    unsigned int last = (unsigned int)lod.levels.size() - 1;
+    unsigned int level = glm::min(currentLevel, last);
+
+    while (level > 0 && projectedPixelError(lod.levels[level].geometricError, distance, settings) > settings.maxPixelError)
+        level--;
+
+    float coarsenLimit = settings.maxPixelError * (1.0f - settings.hysteresis);
+    while (level < last && projectedPixelError(lod.levels[level + 1].geometricError, distance, settings) <= coarsenLimit)
+        level++;
+
+    return level;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "mesh.h"
+
+#include <vector>
+
+
+// Torus tessellations from finest (level 0) to coarsest, each regenerated with
+// roughly half the segments of the previous one.
+struct TorusLodLevel {
+    unsigned int numc, numt;
+    GpuMesh mesh;
+    float geometricError;   // object-space distance between the facets and the true surface
+};
+
+struct TorusLod {
+    std::vector<TorusLodLevel> levels;
+};
+
+struct LodSettings {
+    float maxPixelError;    // coarsest level whose projected error stays below this wins
+    float hysteresis;       // fraction below maxPixelError required before coarsening
+    float viewportHeight;
+    float fovY;
+};
+
+TorusLod createTorusLod(float innerRadius, float outerRadius, unsigned int numc, unsigned int numt,
+                        unsigned int levelCount);
+
+// The two halves of createTorusLod: generating the level meshes needs no GL
+// context and can run on any thread; uploading them must happen on the GL thread.
+std::vector<Torus> generateTorusLodLevels(float innerRadius, float outerRadius, unsigned int numc, unsigned int numt,
+                                          unsigned int levelCount);
+TorusLod uploadTorusLod(const std::vector<Torus>& levels, float innerRadius, float outerRadius);
+void destroyTorusLod(TorusLod& lod);
+
+float torusTessellationError(float innerRadius, float outerRadius, unsigned int numc, unsigned int numt);
+float projectedPixelError(float geometricError, float distance, const LodSettings& settings);
+
+// Picks a level for an object at the given distance, starting from the level it
+// used last frame. Refinement is immediate; coarsening only happens once the
+// coarser level is comfortably under budget, so objects near a threshold do not
+// pop back and forth between frames.
+unsigned int selectLodLevel(const TorusLod& lod, float distance, const LodSettings& settings,
+                            unsigned int currentLevel);
@@ -4,129 +4,230 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#include "bvh.h"
+#include "csg.h"
+#include "frame_capture.h"
+#include "culling.h"
+#include "dynamic_resolution.h"
+#include "frame_mailbox.h"
+#include "frame_pacing.h"
+#include "gpu_timer.h"
+#include "lod.h"
+#include "mesh.h"
+#include "occlusion.h"
+#include "pool_task.h"
+#include "procedural_torus.h"
+#include "scene.h"
+#include "shader.h"
+#include "simd_benchmark.h"
+#include "software_render.h"
+#include "startup_timeline.h"
+#include "worker_pool.h"
+#include "y4m_writer.h"
+#include "yuv_convert.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <iostream>
+#include <thread>
 #include <vector>
 
 
-const char* vertexShaderSource = R"(
-    #version 330 core
-    layout (location = 0) in vec3 aPos;
+// The simulation thread samples input and publishes a snapshot this often.
+const double SIMULATION_TICK = 1.0 / 240.0;
 
-    uniform mat4 model;
-    uniform mat4 view;
-    uniform mat4 projection;
 
-    void main(){
-        gl_Position = projection * view * model * vec4(aPos, 1.0);
-    }
-)";
-
-const char* fragmentShaderSource = R"(
-    #version 330 core
-    out vec4 FragColor;
-
-    uniform vec4 color;
+struct LodLevelStats {
+    unsigned int instances;
+    float maxPixelError;
+};
 
-    void main(){
-        FragColor = color;
-    }
-)";
 
+// Render-thread view of the snapshot queue, reset with each statistics line.
+struct FrameLatencyStats {
+    unsigned int frames;
+    double waitMs;                      // blocked waiting for a new snapshot
+    double queueMs, maxQueueMs;         // publication to pick-up
+    double presentMs, maxPresentMs;     // publication to swap returning
+};
 
-GLuint compileShader(GLenum type, const char* source) {
-    GLuint shader = glCreateShader(type);
-    glShaderSource(shader, 1, &source, NULL);
-    glCompileShader(shader);
 
-    int success;
-    char infoLog[512];
-    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-    if (!success) {
-        glGetShaderInfoLog(shader, 512, NULL, infoLog);
-        std::cout << "ERROR::SHADER::COMPILATION_FAILED\n" << infoLog << std::endl;
+void drawLattice(const unsigned int* visible, size_t visibleCount, const glm::mat4* instanceModels,
+                 GLuint modelLoc, GLuint colorLoc, GLuint tetraVAO) {
+    glStencilMask(0xFF);
+    glStencilFunc(GL_ALWAYS, 1, 0xFF);
+    glUniform4f(colorLoc, 0.0f, 1.0f, 0.0f, 1.0f);
+    glBindVertexArray(tetraVAO);
+    for (size_t v = 0; v < visibleCount; ++v) {
+        glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(instanceModels[visible[v]]));
+        glDrawElements(GL_TRIANGLES, 12, GL_UNSIGNED_INT, 0);
     }
-    return shader;
+    glBindVertexArray(0);
 }
 
 
-GLuint createShaderProgram() {
-    GLuint vertexShader = compileShader(GL_VERTEX_SHADER, vertexShaderSource);
-    GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentShaderSource);
-
+// Object-space distance from the camera to the instance's bounding sphere.
+float instanceLodDistance(const Scene& scene, const SceneInstance& instance, const glm::vec3& cameraPosition) {
+    float distance = glm::length(instance.position - cameraPosition) - scene.boundingRadius * instance.scale;
+    return glm::max(distance, 0.0f) / instance.scale;
+}
 
-    GLuint shaderProgram = glCreateProgram();
-    glAttachShader(shaderProgram, vertexShader);
-    glAttachShader(shaderProgram, fragmentShader);
-    glLinkProgram(shaderProgram);
-    int success;
-    char infoLog[512];
-    glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
-    if (!success) {
-        glGetProgramInfoLog(shaderProgram, 512, NULL, infoLog);
-        std::cout << "ERROR::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
-    }
 
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
-    return shaderProgram;
+void selectLatticeLods(WorkerPool& pool, const Scene& scene, const unsigned int* visible, size_t visibleCount,
+                       const glm::vec3& cameraPosition, const TorusLod& lod, const LodSettings& settings,
+                       bool lodEnabled, std::vector<unsigned int>& instanceLod) {
+    parallelFor(pool, (unsigned int)visibleCount, [&](unsigned int v) {
+        unsigned int i = visible[v];
+        float distance = instanceLodDistance(scene, scene.instances[i], cameraPosition);
+        instanceLod[i] = lodEnabled ? selectLodLevel(lod, distance, settings, instanceLod[i]) : 0;
+    });
 }
 
 
-void framebuffer_size_callback(GLFWwindow* window, int width, int height) {
-    glViewport(0, 0, width, height);
+void drawLatticeTori(const Scene& scene, const unsigned int* visible, size_t visibleCount,
+                     const glm::mat4* instanceModels, const glm::vec3& cameraPosition,
+                     const TorusLod& lod, const LodSettings& settings,
+                     const std::vector<unsigned int>& instanceLod, GLuint modelLoc, GLuint colorLoc,
+                     std::vector<LodLevelStats>& stats) {
+    for (LodLevelStats& levelStats : stats)
+        levelStats = LodLevelStats();
+
+    glUniform4f(colorLoc, 0.0f, 0.0f, 1.0f, 0.5f);
+    for (size_t v = 0; v < visibleCount; ++v) {
+        unsigned int i = visible[v];
+        unsigned int level = instanceLod[i];
+        float distance = instanceLodDistance(scene, scene.instances[i], cameraPosition);
+
+        const TorusLodLevel& lodLevel = lod.levels[level];
+        stats[level].instances++;
+        stats[level].maxPixelError = glm::max(stats[level].maxPixelError,
+            projectedPixelError(lodLevel.geometricError, distance, settings));
+
+        glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(instanceModels[i]));
+        glBindVertexArray(lodLevel.mesh.vao);
+        glDrawElements(GL_TRIANGLES, lodLevel.mesh.indexCount, GL_UNSIGNED_INT, 0);
+    }
+    glBindVertexArray(0);
 }
 
 
-struct Torus {
-    std::vector<float> vertices;
-    std::vector<unsigned int> indices;
-    unsigned int numc, numt;
+// CPU-side startup work. Each runs on the worker pool while the main thread
+// creates the window and compiles shaders.
+struct CsgMeshes {
+    Mesh tetra, bound, drill;
+    TorusHulls torusHulls;
+};
+
+struct LatticeSetup {
+    Scene scene;
+    SphereBatch spheres;
+    AabbBatch boxes;
 };
 
 
-Torus generateTorus(float innerRadius, float outerRadius, unsigned int numc, unsigned int numt) {
-    Torus torus;
-    torus.numc = numc;
-    torus.numt = numt;
+// The pool parameter only tells the promise where to run the body.
+PoolTask<Torus> generateTorusAsync(WorkerPool&, StartupTimeline& startup) {
+    double start = startupElapsedMs(startup);
+    Torus torus = generateTorus(0.3f, 0.8f, 30, 30);
+    recordStartupStage(startup, "torus mesh", start);
+    co_return torus;
+}
 
-    for (unsigned int i = 0; i <= numc; ++i) {
-        for (unsigned int j = 0; j <= numt; ++j) {
-            float s = (float)i / numc * 2.0f * glm::pi<float>();
-            float t = (float)j / numt * 2.0f * glm::pi<float>();
 
-            float x = (outerRadius + innerRadius * cos(t)) * cos(s);
-            float y = (outerRadius + innerRadius * cos(t)) * sin(s);
-            float z = innerRadius * sin(t);
+PoolTask<CsgMeshes> generateCsgMeshesAsync(WorkerPool&, StartupTimeline& startup) {
+    double start = startupElapsedMs(startup);
+    CsgMeshes meshes;
+    meshes.tetra = generateTetrahedron();
+    meshes.bound = generateCylinder(1.3f, 4.0f, 64);
+    meshes.drill = generateCylinder(0.25f, 0.8f, 32);
+    meshes.torusHulls = generateTorusHulls(0.3f, 0.8f, 16, 12);
+    recordStartupStage(startup, "CSG meshes", start);
+    co_return meshes;
+}
 
-            torus.vertices.push_back(x);
-            torus.vertices.push_back(y);
-            torus.vertices.push_back(z);
-        }
-    }
 
-    for (unsigned int i = 0; i < numc; ++i) {
-        for (unsigned int j = 0; j < numt; ++j) {
-            unsigned int first = i * (numt + 1) + j;
-            unsigned int second = first + numt + 1;
+PoolTask<std::vector<Torus>> generateTorusLodAsync(WorkerPool&, StartupTimeline& startup) {
+    double start = startupElapsedMs(startup);
+    std::vector<Torus> levels = generateTorusLodLevels(0.3f, 0.8f, 30, 30, 4);
+    recordStartupStage(startup, "torus LOD meshes", start);
+    co_return levels;
+}
 
-            torus.indices.push_back(first);
-            torus.indices.push_back(second);
-            torus.indices.push_back(first + 1);
 
-            torus.indices.push_back(second);
-            torus.indices.push_back(second + 1);
-            torus.indices.push_back(first + 1);
-        }
+PoolTask<LatticeSetup> buildLatticeAsync(WorkerPool&, StartupTimeline& startup, PoolTask<Torus>& torusTask) {
+    double start = startupElapsedMs(startup);
+    LatticeSetup setup;
+    setup.scene = buildLatticeScene(10, 4.0f);
+    recordStartupStage(startup, "lattice scene", start);
+
+    // The bounds need the torus; this resumes on a worker once it is generated.
+    const Torus& torus = co_await torusTask;
+    start = startupElapsedMs(startup);
+
+    // Instances only spin in place, so their spheres and boxes never move.
+    BoundingSphere tetraSphere = computeBoundingSphere(generateTetrahedron().vertices);
+    BoundingSphere torusSphere = computeBoundingSphere(torus.vertices);
+    Scene& scene = setup.scene;
+    scene.boundingRadius = glm::max(glm::length(tetraSphere.center) + tetraSphere.radius,
+                                    glm::length(torusSphere.center) + torusSphere.radius);
+
+    resizeSphereBatch(setup.spheres, scene.instances.size());
+    resizeAabbBatch(setup.boxes, scene.instances.size());
+    for (size_t i = 0; i < scene.instances.size(); ++i) {
+        const SceneInstance& instance = scene.instances[i];
+        float radius = scene.boundingRadius * instance.scale;
+        setup.spheres.x[i] = setup.boxes.centerX[i] = instance.position.x;
+        setup.spheres.y[i] = setup.boxes.centerY[i] = instance.position.y;
+        setup.spheres.z[i] = setup.boxes.centerZ[i] = instance.position.z;
+        setup.spheres.radius[i] = radius;
+        setup.boxes.extentX[i] = setup.boxes.extentY[i] = setup.boxes.extentZ[i] = radius;
     }
-
-    return torus;
+    recordStartupStage(startup, "lattice bounds", start);
+    co_return setup;
 }
 
-int main() {
 
+int main(int argc, char** argv) {
+
+    SoftwareRenderOptions softwareOptions;
+    if (parseSoftwareRenderOptions(argc, argv, softwareOptions))
+        return runSoftwareRender(softwareOptions);
+    SimdBenchmarkOptions simdBenchmarkOptions;
+    if (parseSimdBenchmarkOptions(argc, argv, simdBenchmarkOptions))
+        return runSimdBenchmark(simdBenchmarkOptions);
+    DynamicResolutionSettings resolutionSettings;
+    bool dynamicResolution = parseDynamicResolutionOptions(argc, argv, resolutionSettings);
+    FramePacingSettings pacingSettings;
+    parseFramePacingOptions(argc, argv, pacingSettings);
+
+    // Startup: mesh generation starts on the worker pool right away; only the
+    // GL work (context, shader compilation, uploads) is serialized on this
+    // thread, and it waits for the meshes only once it needs to upload them.
+    StartupTimeline startup;
+    beginStartupTimeline(startup);
+
+    WorkerPool workerPool;
+    createWorkerPool(workerPool, defaultWorkerCount());
+    PoolTask<Torus> torusTask = generateTorusAsync(workerPool, startup);
+    PoolTask<CsgMeshes> csgMeshesTask = generateCsgMeshesAsync(workerPool, startup);
+    PoolTask<std::vector<Torus>> torusLodTask = generateTorusLodAsync(workerPool, startup);
+    PoolTask<LatticeSetup> latticeTask = buildLatticeAsync(workerPool, startup, torusTask);
+    // Until the render loop, a failure must still let the tasks finish, as they
+    // use startup and the pool, and join the workers before returning.
+    auto abortStartup = [&] {
+        waitForTask(torusTask);
+        waitForTask(csgMeshesTask);
+        waitForTask(torusLodTask);
+        waitForTask(latticeTask);
+        destroyWorkerPool(workerPool);
+        return -1;
+    };
+
+    double stageStart = startupElapsedMs(startup);
     if (!glfwInit()) {
         std::cerr << "Failed to initialize GLFW" << std::endl;
-        return -1;
+        return abortStartup();
     }
 
 
@@ -139,22 +240,63 @@ int main() {
     if (window == NULL) {
         std::cerr << "Failed to create GLFW window" << std::endl;
         glfwTerminate();
-        return -1;
+        return abortStartup();
     }
     glfwMakeContextCurrent(window);
-    glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
+    recordStartupStage(startup, "GLFW window and context", stageStart);
 
 
+    stageStart = startupElapsedMs(startup);
     if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
         std::cerr << "Failed to initialize GLAD" << std::endl;
-        return -1;
+        return abortStartup();
+    }
+    recordStartupStage(startup, "GL function loading", stageStart);
+
+    // Slow programs are built off the critical path: by the driver's own
+    // threads when it offers parallel shader compile, otherwise on a worker
+    // bound to a hidden context that shares objects with the window's.
+    ShaderCompiler shaderCompiler;
+    createShaderCompiler(shaderCompiler, (GLADloadproc)glfwGetProcAddress);
+    GLFWwindow* compileContext = NULL;
+    if (!shaderCompiler.parallelCompile) {
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        compileContext = glfwCreateWindow(1, 1, "Shader compiler", NULL, window);
+        if (compileContext) {
+            startShaderCompileThread(shaderCompiler, [compileContext](bool current) {
+                glfwMakeContextCurrent(current ? compileContext : NULL);
+            });
+        }
     }
 
     glEnable(GL_DEPTH_TEST);
     glEnable(GL_STENCIL_TEST);
 
 
-    GLuint shaderProgram = createShaderProgram();
+    stageStart = startupElapsedMs(startup);
+    GLuint shaderProgram = createShaderProgram(vertexShaderSource, fragmentShaderSource);
+
+    // CSG mode (C): the tetrahedron is clipped by a cylinder and drilled through
+    // every face; T additionally carves the torus out of it.
+    CsgRenderer csgRenderer;
+    if (!createCsgRenderer(csgRenderer)) {
+        std::cerr << "Failed to create CSG renderer" << std::endl;
+    }
+
+    // Procedural mode (P): the torus is rebuilt from gl_VertexID with no
+    // buffers bound; +/- change its tessellation on the fly. Its program is
+    // built asynchronously, and the buffered torus stands in until it is ready.
+    ProceduralTorus proceduralTorus;
+    if (!createProceduralTorus(proceduralTorus, shaderCompiler)) {
+        std::cerr << "Failed to create procedural torus" << std::endl;
+    }
+    recordStartupStage(startup, "shader compilation", stageStart);
+
+    const Torus& torus = waitForTask(torusTask);
+    const CsgMeshes& csgMeshes = waitForTask(csgMeshesTask);
+    const std::vector<Torus>& torusLodLevels = waitForTask(torusLodTask);
+    LatticeSetup& latticeSetup = waitForTask(latticeTask);
+    stageStart = startupElapsedMs(startup);
 
     float tetrahedronVertices[] = {
         1.0f,  1.0f,  1.0f,  
@@ -189,8 +331,6 @@ int main() {
 
     glBindVertexArray(0);
 
-    Torus torus = generateTorus(0.3f, 0.8f, 30, 30);
-
     GLuint torusVAO, torusVBO, torusEBO;
     glGenVertexArrays(1, &torusVAO);
     glGenBuffers(1, &torusVBO);
@@ -259,65 +399,680 @@ int main() {
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
+    const Mesh& csgTetraMesh = csgMeshes.tetra;
+    const TorusHulls& csgTorusHulls = csgMeshes.torusHulls;
+    GpuMesh csgTetra = uploadMesh(csgTetraMesh.vertices, csgTetraMesh.indices);
+    GpuMesh csgBound = uploadMesh(csgMeshes.bound.vertices, csgMeshes.bound.indices);
+    GpuMesh csgDrill = uploadMesh(csgMeshes.drill.vertices, csgMeshes.drill.indices);
+    GpuMesh csgTorus = uploadMesh(csgTorusHulls.mesh.vertices, csgTorusHulls.mesh.indices);
+
+    glm::mat4 boundTransform = glm::rotate(glm::mat4(1.0f), glm::radians(90.0f), glm::vec3(1.0f, 0.0f, 0.0f));
+    glm::mat4 drillTransforms[4];
+    for (int i = 0; i < 4; ++i) {
+        // The face opposite a vertex v is centred at -v/3 with outward normal -v.
+        glm::vec3 normal = glm::normalize(-holeCenters[i]);
+        glm::vec3 axis = glm::cross(glm::vec3(0.0f, 0.0f, 1.0f), normal);
+        drillTransforms[i] = glm::translate(glm::mat4(1.0f), -holeCenters[i] / 3.0f)
+            * glm::rotate(glm::mat4(1.0f), glm::acos(normal.z), axis);
+    }
+
+    std::vector<CsgPrimitive> csgPrimitives;
+    bool csgMode = false, csgTorusCut = false;
+
+    bool proceduralMode = false;
+    unsigned int proceduralNumc = torus.numc, proceduralNumt = torus.numt;
+
+    GpuTimer torusTimer;
+    createGpuTimer(torusTimer);
+
+    // Lattice mode (L): 10x10x10 instances with a torus LOD chain picked per
+    // instance from projected error; O forces the finest level for comparison.
+    const Scene& lattice = latticeSetup.scene;
+    TorusLod torusLod = uploadTorusLod(torusLodLevels, 0.3f, 0.8f);
+    std::vector<unsigned int> instanceLod(lattice.instances.size(), 0);
+    std::vector<LodLevelStats> lodStats(torusLod.levels.size());
+    LodSettings lodSettings = { 2.0f, 0.25f, 600.0f, glm::radians(45.0f) };
+    glm::vec3 cameraPosition = glm::vec3(glm::inverse(view)[3]);
+    bool latticeMode = false, lodEnabled = true;
+
+    // Frustum culling (F) of the lattice against per-instance bounding spheres.
+    const SphereBatch& latticeSpheres = latticeSetup.spheres;
+    std::vector<unsigned int> latticeVisible(lattice.instances.size());
+    size_t latticeVisibleCount = 0;
+    CullStats cullStats = CullStats();
+    bool cullingEnabled = true;
+
+    // Occlusion culling (H): the frustum-visible tetrahedra are rasterized on
+    // the CPU worker pool while the GPU is still busy with the previous frame,
+    // and instances whose boxes are hidden behind them are not submitted.
+    OcclusionCuller occlusionCuller;
+    createOcclusionCuller(occlusionCuller, 320, 240);
+    const AabbBatch& latticeBoxes = latticeSetup.boxes;
+    std::vector<unsigned int> latticeUnoccluded(lattice.instances.size());
+    std::vector<glm::mat4> occluderModels;
+    bool occlusionEnabled = true;
+
+    // Dynamic resolution (D, or on from the start with --target-ms, --min-scale
+    // or --max-scale): the scene is drawn offscreen at a scale steered by its
+    // GPU time and upscaled into the window.
+    DynamicResolution resolution;
+    createDynamicResolution(resolution, resolutionSettings);
+    recordStartupStage(startup, "GL uploads and state", stageStart);
+
+    // Picking (left click): the cursor's ray is traced through BVHs of the
+    // tetrahedron and the torus, or of the lattice instances and then those.
+    stageStart = startupElapsedMs(startup);
+    Bvh pickMeshes[2];
+    buildTriangleBvh(pickMeshes[0], workerPool, tetrahedronVertices, tetrahedronIndices, 4);
+    buildTriangleBvh(pickMeshes[1], workerPool, torus.vertices.data(), torus.indices.data(), torus.indices.size() / 3);
+    std::vector<Aabb> latticeInstanceBoxes(lattice.instances.size());
+    for (size_t i = 0; i < latticeInstanceBoxes.size(); ++i) {
+        glm::vec3 center(latticeBoxes.centerX[i], latticeBoxes.centerY[i], latticeBoxes.centerZ[i]);
+        glm::vec3 extent(latticeBoxes.extentX[i], latticeBoxes.extentY[i], latticeBoxes.extentZ[i]);
+        latticeInstanceBoxes[i].min = center - extent;
+        latticeInstanceBoxes[i].max = center + extent;
+    }
+    Bvh pickInstances;
+    buildBvh(pickInstances, workerPool, latticeInstanceBoxes.data(), latticeInstanceBoxes.size());
+    std::vector<glm::mat4> pickInverseModels(lattice.instances.size());
+    glm::mat4 inverseViewProjection = glm::inverse(projection * view);
+    bool pickButtonWasPressed = false;
+    recordStartupStage(startup, "pick BVHs", stageStart);
+
+    // The render thread owns the GL context from here on. The main thread,
+    // which GLFW requires for events and input, runs the simulation and hands
+    // each tick to the renderer as an immutable snapshot, so a blocking swap
+    // never holds up input or animation.
+    FrameMailbox frameMailbox;
+    createFrameMailbox(frameMailbox);
+    glfwMakeContextCurrent(NULL);
+    // Video modes may only be queried here, on the main thread.
+    const GLFWvidmode* videoMode = glfwGetVideoMode(glfwGetPrimaryMonitor());
+    int displayRefreshRate = videoMode && videoMode->refreshRate > 0 ? videoMode->refreshRate : 60;
+
+    std::thread renderThread([&] {
+        double firstFrameStart = startupElapsedMs(startup);
+        bool firstFrame = true;
+        glfwMakeContextCurrent(window);
+
+        int viewportWidth = 0, viewportHeight = 0;
+        int swapInterval = -1;
+        unsigned long long lastSkipped = 0;
+
+        // Pacing: the swap interval follows the snapshot (V), frames can be
+        // capped with --fps-limit, and the intervals between swaps are kept
+        // for the jitter and CPU statistics.
+        FrameLimiter frameLimiter;
+        setFrameLimit(frameLimiter, pacingSettings.fpsLimit);
+        FramePacingStats pacing = FramePacingStats();
+        resetFramePacingStats(pacing);
+        double lastStatsTime = 0.0;
+        FrameLatencyStats latency = FrameLatencyStats();
+        unsigned long long lastPublished = 0, lastDropped = 0;
+        std::vector<WorkerUtilization> workerUtilization;
+
+        // Recording (R): every presented frame goes through the readback ring,
+        // is converted to 4:2:0 on the worker pool straight from the mapped
+        // buffer and appended to capture.y4m. The first frame of a recording
+        // is also converted by the glm reference as a cross-check. The stream's
+        // rate is the --fps-limit cap, or else the display's refresh rate over
+        // the swap interval; paused frames are not drawn, so pauses are cut out.
+        // A stream has one frame size, and frames of another are dropped.
+        Y4mWriter captureWriter;
+        YuvFrame captureYuv;
+        YuvColorSpace captureColorSpace = YuvColorSpace::YCbCr709;
+        unsigned long long captureDropped = 0;
+        FrameCapture frameCapture;
+        createFrameCapture(frameCapture, [&](const CapturedFrame& captured) {
+            if (captureWriter.frames == 0 && !captureWriter.file.is_open()) {
+                double fps = pacingSettings.fpsLimit > 0.0 ? pacingSettings.fpsLimit
+                    : (double)displayRefreshRate / std::max(swapInterval, 1);
+                if (!openY4mWriter(captureWriter, "capture.y4m", captured.width, captured.height,
+                                   (int)std::lround(fps * 1000.0), 1000, captureColorSpace))
+                    return;
+                resizeYuvFrame(captureYuv, captured.width, captured.height, captureColorSpace);
+                YuvFrame reference;
+                resizeYuvFrame(reference, captured.width, captured.height, captureColorSpace);
+                convertRgbaToYuv(workerPool, captured.pixels, captured.stride, true, captureYuv);
+                convertRgbaToYuvReference(captured.pixels, captured.stride, true, reference);
+                std::cout << "Capture: " << yuvConvertIsa() << " conversion differs from the glm reference by at most "
+                    << maxYuvDifference(captureYuv, reference) << std::endl;
+            }
+            else if (captured.width != captureYuv.width || captured.height != captureYuv.height) {
+                if (captureDropped++ == 0) {
+                    std::cerr << "Capture: window resized to " << captured.width << "x" << captured.height
+                        << ", dropping frames until it is " << captureYuv.width << "x" << captureYuv.height
+                        << " again" << std::endl;
+                }
+                return;
+            }
+            else {
+                convertRgbaToYuv(workerPool, captured.pixels, captured.stride, true, captureYuv);
+            }
+            writeY4mFrame(captureWriter, captureYuv);
+        });
+        bool capturing = false;
+
+        for (;;) {
+            waitForFrameSlot(frameLimiter);
+            auto waitStart = std::chrono::steady_clock::now();
+            const FrameSnapshot* snapshot = acquireSnapshot(frameMailbox);
+            if (!snapshot)
+                break;
+            const FrameSnapshot& frame = *snapshot;
+            auto acquired = std::chrono::steady_clock::now();
+            // A wait for the simulation, while paused in particular, is not an
+            // overrun: the frame that ends it starts a new schedule.
+            if (acquired > frameLimiter.deadline)
+                restartFrameSchedule(frameLimiter);
+            double queueMs = std::chrono::duration<double, std::milli>(acquired - frame.published).count();
+            latency.waitMs += std::chrono::duration<double, std::milli>(acquired - waitStart).count();
+            latency.queueMs += queueMs;
+            latency.maxQueueMs = glm::max(latency.maxQueueMs, queueMs);
+
+            if (frame.swapInterval != swapInterval) {
+                swapInterval = frame.swapInterval;
+                glfwSwapInterval(swapInterval);
+            }
+
+            viewportWidth = frame.framebufferWidth;
+            viewportHeight = frame.framebufferHeight;
+            int renderHeight = viewportHeight;
+            if (frame.dynamicResolution) {
+                beginDynamicResolution(resolution, viewportWidth, viewportHeight);
+                renderHeight = resolution.height;
+            }
+            else {
+                glViewport(0, 0, viewportWidth, viewportHeight);
+            }
+
+            if (!proceduralTorus.ready && pollProceduralTorus(proceduralTorus, shaderCompiler)) {
+                glUseProgram(proceduralTorus.program);
+                glUniformMatrix4fv(proceduralTorus.viewLoc, 1, GL_FALSE, glm::value_ptr(view));
+                glUniformMatrix4fv(proceduralTorus.projLoc, 1, GL_FALSE, glm::value_ptr(projection));
+                glUniform3f(proceduralTorus.instanceStepLoc, 0.0f, 0.0f, 0.0f);
+                std::cout << "Procedural torus program ready after " << proceduralTorus.build.buildMs
+                    << " ms (" << shaderCompilerMode(shaderCompiler) << ")" << std::endl;
+            }
+            bool drawProcedural = frame.proceduralMode && proceduralTorus.ready;
+
+            const glm::mat4& rotation = frame.rotation;
+            glUseProgram(shaderProgram);
+            glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(rotation));
+
+            glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+
+            if (frame.latticeMode) {
+                lodSettings.viewportHeight = (float)renderHeight;
+
+                // The frame's CPU work as a job graph: frustum culling first,
+                // then occlusion culling and LOD selection side by side; the
+                // draws wait for both.
+                JobCounter frustumCulled, prepared;
+                size_t unoccludedCount = 0;
+                submitJob(workerPool, [&] {
+                    if (frame.cullingEnabled) {
+                        Frustum frustum = extractFrustum(projection * view);
+                        latticeVisibleCount = cullSpheresTimed(frustum, latticeSpheres, latticeVisible.data(), cullStats);
+                    }
+                    else {
+                        for (size_t i = 0; i < lattice.instances.size(); ++i)
+                            latticeVisible[i] = (unsigned int)i;
+                        latticeVisibleCount = lattice.instances.size();
+                    }
+                }, &frustumCulled);
+
+                if (frame.occlusionEnabled) {
+                    submitJob(workerPool, [&] {
+                        occluderModels.resize(latticeVisibleCount);
+                        for (size_t v = 0; v < latticeVisibleCount; ++v)
+                            occluderModels[v] = frame.instanceModels[latticeVisible[v]];
+                        unoccludedCount = cullOccluded(occlusionCuller, workerPool, projection * view, csgTetraMesh,
+                            occluderModels.data(), latticeVisibleCount, latticeBoxes, latticeVisible.data(),
+                            latticeVisibleCount, latticeUnoccluded.data());
+                    }, &prepared, &frustumCulled);
+                }
+                submitJob(workerPool, [&] {
+                    selectLatticeLods(workerPool, lattice, latticeVisible.data(), latticeVisibleCount, cameraPosition,
+                                      torusLod, lodSettings, frame.lodEnabled, instanceLod);
+                }, &prepared, &frustumCulled);
+                waitForCounter(workerPool, prepared);
+
+                if (frame.occlusionEnabled) {
+                    latticeVisible.swap(latticeUnoccluded);
+                    latticeVisibleCount = unoccludedCount;
+                }
+
+                drawLattice(latticeVisible.data(), latticeVisibleCount, frame.instanceModels.data(), modelLoc, colorLoc, tetraVAO);
+
+                glStencilMask(0x00);
+                glStencilFunc(GL_ALWAYS, 0, 0xFF);
+                beginGpuTimer(torusTimer);
+                drawLatticeTori(lattice, latticeVisible.data(), latticeVisibleCount, frame.instanceModels.data(), cameraPosition,
+                                torusLod, lodSettings, instanceLod, modelLoc, colorLoc, lodStats);
+                endGpuTimer(torusTimer);
+            }
+            else {
+                if (frame.csgMode) {
+                    csgPrimitives.clear();
+                    csgPrimitives.push_back({ csgTetra.vao, 0, csgTetra.indexCount, rotation,
+                        glm::vec4(0.0f, 1.0f, 0.0f, 1.0f), CsgOp::Intersect });
+                    csgPrimitives.push_back({ csgBound.vao, 0, csgBound.indexCount, rotation * boundTransform,
+                        glm::vec4(0.0f, 0.7f, 0.0f, 1.0f), CsgOp::Intersect });
+                    for (auto& drill : drillTransforms) {
+                        csgPrimitives.push_back({ csgDrill.vao, 0, csgDrill.indexCount, rotation * drill,
+                            glm::vec4(1.0f, 0.0f, 0.0f, 1.0f), CsgOp::Subtract });
+                    }
+                    if (frame.csgTorusCut) {
+                        for (unsigned int i = 0; i < csgTorusHulls.pieceCount; ++i) {
+                            csgPrimitives.push_back({ csgTorus.vao, (GLsizei)(i * csgTorusHulls.pieceIndexCount),
+                                (GLsizei)csgTorusHulls.pieceIndexCount, rotation,
+                                glm::vec4(0.0f, 0.0f, 0.6f, 1.0f), CsgOp::Subtract });
+                        }
+                    }
+                    renderCsg(csgRenderer, csgPrimitives, view, projection);
+                    glUseProgram(shaderProgram);
+                }
+                else {
+                    glStencilMask(0xFF);
+                    glStencilFunc(GL_ALWAYS, 1, 0xFF);
+                    glUniform4f(colorLoc, 0.0f, 1.0f, 0.0f, 1.0f); 
+                    glBindVertexArray(tetraVAO);
+                    glDrawElements(GL_TRIANGLES, 12, GL_UNSIGNED_INT, 0);
+                    glBindVertexArray(0);
+
+                    glStencilMask(0x00);
+                    glStencilFunc(GL_ALWAYS, 0, 0xFF);
+                    glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+                    glDepthMask(GL_FALSE);
+                    glUniform4f(colorLoc, 1.0f, 0.0f, 0.0f, 1.0f); 
+                    for (auto& center : holeCenters) {
+                        drawCircle(center);
+                    }
+                    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+                    glDepthMask(GL_TRUE);
+                }
+
+                glStencilMask(0x00);
+                glStencilFunc(GL_ALWAYS, 0, 0xFF); 
+                beginGpuTimer(torusTimer);
+                if (drawProcedural) {
+                    glUseProgram(proceduralTorus.program);
+                    glUniformMatrix4fv(proceduralTorus.modelLoc, 1, GL_FALSE, glm::value_ptr(rotation));
+                    glUniform4f(proceduralTorus.colorLoc, 0.0f, 0.0f, 1.0f, 0.5f);
+                    drawProceduralTorus(proceduralTorus, 0.3f, 0.8f, frame.proceduralNumc, frame.proceduralNumt);
+                    glUseProgram(shaderProgram);
+                }
+                else {
+                    glUniform4f(colorLoc, 0.0f, 0.0f, 1.0f, 0.5f); 
+                    glBindVertexArray(torusVAO);
+                    glDrawElements(GL_TRIANGLES, torus.indices.size(), GL_UNSIGNED_INT, 0);
+                    glBindVertexArray(0);
+                }
+                endGpuTimer(torusTimer);
+            }
+
+            if (frame.dynamicResolution)
+                endDynamicResolution(resolution);
+
+            if (frame.capturing != capturing) {
+                if (capturing) {
+                    flushFrameCapture(frameCapture);
+                    closeY4mWriter(captureWriter);
+                    std::cout << "Capture: " << captureWriter.frames << " frames of " << captureWriter.width << "x"
+                        << captureWriter.height << " written to capture.y4m";
+                    if (captureDropped > 0)
+                        std::cout << ", " << captureDropped << " of another size dropped";
+                    std::cout << std::endl;
+                }
+                else {
+                    captureWriter.frames = 0;
+                    captureDropped = 0;
+                    captureColorSpace = frame.captureYCoCg ? YuvColorSpace::YCoCg : YuvColorSpace::YCbCr709;
+                    resetCaptureStats(frameCapture);
+                }
+                capturing = frame.capturing;
+            }
+            if (capturing)
+                captureFrame(frameCapture, viewportWidth, viewportHeight);
+
+            if (frame.showStats && frame.time - lastStatsTime >= 1.0) {
+                if (frame.latticeMode) {
+                    unsigned int triangles = 0;
+                    for (size_t level = 0; level < torusLod.levels.size(); ++level) {
+                        const TorusLodLevel& lodLevel = torusLod.levels[level];
+                        const LodLevelStats& levelStats = lodStats[level];
+                        triangles += levelStats.instances * lodLevel.mesh.indexCount / 3;
+                        std::cout << "LOD " << level << ": " << lodLevel.numc << "x" << lodLevel.numt
+                            << ", " << lodLevel.mesh.indexCount / 3 << " triangles, error " << lodLevel.geometricError
+                            << ", " << levelStats.instances << " instances, max " << levelStats.maxPixelError << " px" << std::endl;
+                    }
+                    std::cout << "Lattice: " << lattice.instances.size() << " instances, "
+                        << triangles << " torus triangles, GPU " << torusTimer.lastMs << " ms";
+                    if (torusTimer.lastMs > 0.0)
+                        std::cout << ", " << triangles / (torusTimer.lastMs * 1.0e3) << " Mtri/s";
+                    std::cout << std::endl;
+                    if (frame.cullingEnabled) {
+                        std::cout << "Culling (" << cullingIsa() << "): " << cullStats.visible << " visible, "
+                            << cullStats.tested - cullStats.visible << " culled, "
+                            << cullStats.microsecondsPer1k << " us per 1k instances" << std::endl;
+                    }
+                    if (frame.occlusionEnabled) {
+                        const OcclusionStats& stats = occlusionCuller.stats;
+                        std::cout << "Occlusion (" << workerPool.threads.size() + 1 << " threads): "
+                            << stats.occluded << " of " << stats.tested << " occluded ("
+                            << (stats.tested ? 100.0 * stats.occluded / stats.tested : 0.0) << "%), "
+                            << stats.occluderTriangles << " occluder triangles, raster " << stats.rasterMs
+                            << " ms, test " << stats.testMs << " ms" << std::endl;
+                    }
+                }
+                else {
+                    if (frame.csgMode) {
+                        const CsgStats& stats = csgRenderer.stats;
+                        std::cout << "CSG: " << stats.intersectCount << " intersected, "
+                            << stats.subtractCount << " subtracted, depth complexity " << stats.depthComplexity
+                            << ", sequence " << stats.sequenceLength << ", passes " << stats.passes
+                            << ", GPU " << stats.gpuTimeMs << " ms" << std::endl;
+                    }
+
+                    unsigned int numc = drawProcedural ? frame.proceduralNumc : torus.numc;
+                    unsigned int numt = drawProcedural ? frame.proceduralNumt : torus.numt;
+                    double triangles = 2.0 * numc * numt;
+                    std::cout << "Torus: " << (drawProcedural ? "procedural " : frame.proceduralMode ? "placeholder " : "buffered ")
+                        << numc << "x" << numt << ", " << (drawProcedural ? 0 : bufferedTorusBytes(numc, numt)) << " bytes"
+                        << " (buffered would be " << bufferedTorusBytes(numc, numt) << ")"
+                        << ", GPU " << torusTimer.lastMs << " ms";
+                    if (torusTimer.lastMs > 0.0)
+                        std::cout << ", " << triangles / (torusTimer.lastMs * 1.0e3) << " Mtri/s";
+                    std::cout << std::endl;
+                }
+
+                double seconds = frame.time - lastStatsTime;
+                double frames = latency.frames ? (double)latency.frames : 1.0;
+                std::cout << "Threads: simulation " << (frame.publishedCount - lastPublished) / seconds
+                    << " snapshots/s (" << frame.droppedCount - lastDropped << " superseded), render "
+                    << latency.frames / seconds << " frames/s, queue " << latency.queueMs / frames
+                    << " ms (max " << latency.maxQueueMs << "), wait " << latency.waitMs / frames
+                    << " ms, snapshot to swap " << latency.presentMs / frames
+                    << " ms (max " << latency.maxPresentMs << ")" << std::endl;
+                FramePacingReport pacingReport = framePacingReport(pacing);
+                std::cout << "Pacing: swap interval " << swapInterval << ", ";
+                if (pacingSettings.fpsLimit > 0.0) {
+                    std::cout << "limit " << pacingSettings.fpsLimit << " fps (slept " << frameLimiter.sleptMs / frames
+                        << " ms, spun " << frameLimiter.spunMs / frames << " ms per frame, " << frameLimiter.missed
+                        << " late), ";
+                }
+                std::cout << "frame time " << pacingReport.meanMs << " ms, jitter " << pacingReport.jitterMs
+                    << " ms (" << pacingReport.minMs << " to " << pacingReport.maxMs << "), "
+                    << frame.skippedCount - lastSkipped << " idle redraws skipped, CPU " << pacingReport.cpuPercent
+                    << "% of a core" << std::endl;
+                if (frame.dynamicResolution) {
+                    std::cout << "Resolution: scale " << resolution.scale << ", " << resolution.width << "x"
+                        << resolution.height << " upscaled to " << viewportWidth << "x" << viewportHeight << ", GPU "
+                        << resolution.timer.lastMs << " ms for a target of " << resolution.settings.targetMs
+                        << " ms (scale " << resolution.settings.minScale << " to " << resolution.settings.maxScale
+                        << "), " << resolution.changes << " changes" << std::endl;
+                }
+                if (capturing) {
+                    const CaptureStats& stats = frameCapture.stats;
+                    double overheadMs = captureOverheadMs(stats);
+                    std::cout << "Capture: " << viewportWidth << "x" << viewportHeight << ", "
+                        << frameCapture.slots.size() << " buffers, " << overheadMs / frames << " ms per frame ("
+                        << 100.0 * overheadMs / (seconds * 1000.0) << "% of frame time; read " << stats.readMs / frames
+                        << ", map " << stats.mapMs / frames << ", consumer " << stats.consumerMs / frames
+                        << "), " << stats.stalls << " stalls" << std::endl;
+                    resetCaptureStats(frameCapture);
+                }
+                collectWorkerUtilization(workerPool, workerUtilization);
+                std::cout << "Jobs (" << workerUtilization.size() << " threads):";
+                for (const WorkerUtilization& worker : workerUtilization)
+                    std::cout << " " << (int)(100.0 * worker.utilization + 0.5) << "%/" << worker.jobs << "/" << worker.steals;
+                std::cout << " (busy/jobs/steals, caller first)" << std::endl;
+                lastPublished = frame.publishedCount;
+                lastDropped = frame.droppedCount;
+                lastSkipped = frame.skippedCount;
+                frameLimiter.sleptMs = frameLimiter.spunMs = 0.0;
+                frameLimiter.missed = 0;
+                resetFramePacingStats(pacing);
+                latency = FrameLatencyStats();
+                lastStatsTime = frame.time;
+            }
+
+            glfwSwapBuffers(window);
+            // Frames drawn while paused come on demand; their gaps are not
+            // frame intervals.
+            if (frame.paused)
+                pacing.lastPresent = std::chrono::steady_clock::time_point();
+            else
+                recordFramePresented(pacing);
+
+            if (firstFrame) {
+                recordStartupStage(startup, "first frame", firstFrameStart);
+                printStartupTimeline(startup, startupElapsedMs(startup));
+                firstFrame = false;
+            }
+
+            double presentMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frame.published).count();
+            latency.frames++;
+            latency.presentMs += presentMs;
+            latency.maxPresentMs = glm::max(latency.maxPresentMs, presentMs);
+        }
+
+        if (capturing) {
+            flushFrameCapture(frameCapture);
+            closeY4mWriter(captureWriter);
+        }
+        destroyFrameCapture(frameCapture);
+        glfwMakeContextCurrent(NULL);
+    });
+
+
+    bool keyWasPressed[GLFW_KEY_LAST + 1] = {};
+    bool inputChanged = false;
+    auto keyPressedOnce = [&](int key) {
+        bool pressed = glfwGetKey(window, key) == GLFW_PRESS;
+        bool once = pressed && !keyWasPressed[key];
+        keyWasPressed[key] = pressed;
+        inputChanged = inputChanged || once;
+        return once;
+    };
+    bool showStats = false, capturing = false, captureYCoCg = false;
+
+    // Idle mode (Space pauses the animation): the loop sleeps until input
+    // arrives or the idle timeout passes, and publishes a snapshot only when
+    // something changed, so a paused scene costs no rendering at all. Expose
+    // events still need a frame.
+    bool paused = false, redrawRequested = false;
+    int swapInterval = pacingSettings.swapInterval;
+    unsigned long long skippedRedraws = 0;
+    int publishedWidth = 0, publishedHeight = 0;
+    glfwSetWindowUserPointer(window, &redrawRequested);
+    glfwSetWindowRefreshCallback(window, [](GLFWwindow* refreshed) {
+        *(bool*)glfwGetWindowUserPointer(refreshed) = true;
+    });
+
 
     float angle = 0.0f;
     double previousTime = glfwGetTime();
+    unsigned long long sequence = 0;
 
 
     while (!glfwWindowShouldClose(window)) {
+        // Waiting on events rather than polling keeps input latency low
+        // without spinning a core between ticks.
+        glfwWaitEventsTimeout(paused ? pacingSettings.idleTimeout : SIMULATION_TICK);
+        inputChanged = false;
+
         if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
             glfwSetWindowShouldClose(window, true);
 
+        if (keyPressedOnce(GLFW_KEY_I))
+            showStats = !showStats;
+        if (keyPressedOnce(GLFW_KEY_L))
+            latticeMode = !latticeMode;
+        if (keyPressedOnce(GLFW_KEY_O))
+            lodEnabled = !lodEnabled;
+        if (keyPressedOnce(GLFW_KEY_F))
+            cullingEnabled = !cullingEnabled;
+        if (keyPressedOnce(GLFW_KEY_H))
+            occlusionEnabled = !occlusionEnabled;
+        if (keyPressedOnce(GLFW_KEY_C))
+            csgMode = !csgMode;
+        if (keyPressedOnce(GLFW_KEY_T))
+            csgTorusCut = !csgTorusCut;
+        if (keyPressedOnce(GLFW_KEY_R))
+            capturing = !capturing;
+        if (keyPressedOnce(GLFW_KEY_Y) && !capturing)
+            captureYCoCg = !captureYCoCg;
+        if (keyPressedOnce(GLFW_KEY_P))
+            proceduralMode = !proceduralMode;
+        if (keyPressedOnce(GLFW_KEY_D))
+            dynamicResolution = !dynamicResolution;
+        if (keyPressedOnce(GLFW_KEY_SPACE))
+            paused = !paused;
+        if (keyPressedOnce(GLFW_KEY_V))
+            swapInterval = swapInterval ? 0 : std::max(1, pacingSettings.swapInterval);
+        if (keyPressedOnce(GLFW_KEY_EQUAL) && proceduralNumc < 512) {
+            proceduralNumc *= 2;
+            proceduralNumt *= 2;
+        }
+        if (keyPressedOnce(GLFW_KEY_MINUS) && proceduralNumc > 4) {
+            proceduralNumc /= 2;
+            proceduralNumt /= 2;
+        }
+
+        bool pickButtonPressed = glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS;
+        if (pickButtonPressed && !pickButtonWasPressed) {
+            // The cursor's ray through the fixed camera, against the scene in
+            // the pose the animation has reached.
+            double cursorX, cursorY;
+            int windowWidth, windowHeight;
+            glfwGetCursorPos(window, &cursorX, &cursorY);
+            glfwGetWindowSize(window, &windowWidth, &windowHeight);
+            glm::vec2 ndc(2.0f * (float)cursorX / std::max(windowWidth, 1) - 1.0f,
+                          1.0f - 2.0f * (float)cursorY / std::max(windowHeight, 1));
+            glm::vec4 nearPoint = inverseViewProjection * glm::vec4(ndc, -1.0f, 1.0f);
+            glm::vec4 farPoint = inverseViewProjection * glm::vec4(ndc, 1.0f, 1.0f);
+            Ray ray;
+            ray.origin = glm::vec3(nearPoint) / nearPoint.w;
+            ray.direction = glm::normalize(glm::vec3(farPoint) / farPoint.w - ray.origin);
+            ray.maxDistance = 1.0e30f;
+
+            glm::mat4 rotation = glm::rotate(glm::mat4(1.0f), glm::radians(angle), glm::vec3(0.5f, 1.0f, 0.0f));
+            auto pickStart = std::chrono::steady_clock::now();
+            RayHit hit;
+            bool picked;
+            if (latticeMode) {
+                for (size_t i = 0; i < lattice.instances.size(); ++i)
+                    pickInverseModels[i] = glm::inverse(instanceModel(lattice.instances[i], rotation));
+                picked = intersectInstances(pickInstances, pickInverseModels.data(), pickMeshes, 2, ray, hit);
+            }
+            else {
+                // The rotation is rigid, so distances carry over from object space.
+                glm::mat4 inverseRotation = glm::transpose(rotation);
+                Ray local = ray;
+                local.origin = glm::vec3(inverseRotation * glm::vec4(ray.origin, 1.0f));
+                local.direction = glm::vec3(inverseRotation * glm::vec4(ray.direction, 0.0f));
+                picked = false;
+                for (unsigned int mesh = 0; mesh < 2; ++mesh) {
+                    RayHit meshHit;
+                    if (intersectBvh(pickMeshes[mesh], local, meshHit)) {
+                        hit = meshHit;
+                        hit.mesh = mesh;
+                        local.maxDistance = hit.distance;
+                        picked = true;
+                    }
+                }
+            }
+            double pickUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - pickStart).count();
+            const char* meshNames[2] = { "tetrahedron", "torus" };
+            if (picked) {
+                std::cout << "Pick (" << bvhIsa() << "): " << meshNames[hit.mesh] << " triangle " << hit.triangle;
+                if (latticeMode)
+                    std::cout << " of instance " << hit.instance;
+                std::cout << " at distance " << hit.distance << ", " << pickUs << " us" << std::endl;
+            }
+            else {
+                std::cout << "Pick (" << bvhIsa() << "): nothing, " << pickUs << " us" << std::endl;
+            }
+        }
+        pickButtonWasPressed = pickButtonPressed;
+
 
         double currentTime = glfwGetTime();
         double deltaTime = currentTime - previousTime;
         previousTime = currentTime;
-        angle += 50.0f * deltaTime; 
-        if (angle > 360.0f)
-            angle -= 360.0f;
-
-        glm::mat4 rotation = glm::rotate(glm::mat4(1.0f), glm::radians(angle), glm::vec3(0.5f, 1.0f, 0.0f));
-        glUseProgram(shaderProgram);
-        glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(rotation));
-
-        glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+        if (!paused) {
+            angle += 50.0f * deltaTime;
+            if (angle > 360.0f)
+                angle -= 360.0f;
+        }
 
-        glStencilMask(0xFF);
-        glStencilFunc(GL_ALWAYS, 1, 0xFF);
-        glUniform4f(colorLoc, 0.0f, 1.0f, 0.0f, 1.0f); 
-        glBindVertexArray(tetraVAO);
-        glDrawElements(GL_TRIANGLES, 12, GL_UNSIGNED_INT, 0);
-        glBindVertexArray(0);
-
-        glStencilMask(0x00);
-        glStencilFunc(GL_ALWAYS, 0, 0xFF);
-        glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
-        glDepthMask(GL_FALSE);
-        glUniform4f(colorLoc, 1.0f, 0.0f, 0.0f, 1.0f); 
-        for (auto& center : holeCenters) {
-            drawCircle(center);
+        int framebufferWidth, framebufferHeight;
+        glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+        bool resized = framebufferWidth != publishedWidth || framebufferHeight != publishedHeight;
+        if (paused && !inputChanged && !resized && !redrawRequested) {
+            skippedRedraws++;
+            continue;
         }
-        glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
-        glDepthMask(GL_TRUE);
-
-        glStencilMask(0x00);
-        glStencilFunc(GL_ALWAYS, 0, 0xFF); 
-        glUniform4f(colorLoc, 0.0f, 0.0f, 1.0f, 0.5f); 
-        glBindVertexArray(torusVAO);
-        glDrawElements(GL_TRIANGLES, torus.indices.size(), GL_UNSIGNED_INT, 0);
-        glBindVertexArray(0);
-
-        glfwSwapBuffers(window);
-        glfwPollEvents();
+        redrawRequested = false;
+        publishedWidth = framebufferWidth;
+        publishedHeight = framebufferHeight;
+
+        FrameSnapshot& snapshot = beginSnapshot(frameMailbox);
+        snapshot.sequence = ++sequence;
+        snapshot.time = currentTime;
+        snapshot.rotation = glm::rotate(glm::mat4(1.0f), glm::radians(angle), glm::vec3(0.5f, 1.0f, 0.0f));
+        snapshot.instanceModels.clear();
+        if (latticeMode) {
+            for (const SceneInstance& instance : lattice.instances)
+                snapshot.instanceModels.push_back(instanceModel(instance, snapshot.rotation));
+        }
+        snapshot.framebufferWidth = framebufferWidth;
+        snapshot.framebufferHeight = framebufferHeight;
+        snapshot.showStats = showStats;
+        snapshot.latticeMode = latticeMode;
+        snapshot.lodEnabled = lodEnabled;
+        snapshot.cullingEnabled = cullingEnabled;
+        snapshot.occlusionEnabled = occlusionEnabled;
+        snapshot.csgMode = csgMode;
+        snapshot.csgTorusCut = csgTorusCut;
+        snapshot.proceduralMode = proceduralMode;
+        snapshot.proceduralNumc = proceduralNumc;
+        snapshot.proceduralNumt = proceduralNumt;
+        snapshot.capturing = capturing;
+        snapshot.captureYCoCg = captureYCoCg;
+        snapshot.dynamicResolution = dynamicResolution;
+        snapshot.swapInterval = swapInterval;
+        snapshot.paused = paused;
+        snapshot.skippedCount = skippedRedraws;
+        publishSnapshot(frameMailbox);
     }
 
+    closeFrameMailbox(frameMailbox);
+    renderThread.join();
+    glfwMakeContextCurrent(window);
+
     glDeleteVertexArrays(1, &tetraVAO);
     glDeleteBuffers(1, &tetraVBO);
     glDeleteBuffers(1, &tetraEBO);
     glDeleteVertexArrays(1, &torusVAO);
     glDeleteBuffers(1, &torusVBO);
     glDeleteBuffers(1, &torusEBO);
+    destroyMesh(csgTetra);
+    destroyMesh(csgBound);
+    destroyMesh(csgDrill);
+    destroyMesh(csgTorus);
+    destroyTorusLod(torusLod);
+    destroyWorkerPool(workerPool);
+    destroyCsgRenderer(csgRenderer);
+    destroyShaderCompiler(shaderCompiler);
+    if (compileContext)
+        glfwDestroyWindow(compileContext);
+    destroyProceduralTorus(proceduralTorus);
+    destroyGpuTimer(torusTimer);
+    destroyDynamicResolution(resolution);
     glDeleteProgram(shaderProgram);
 
     glfwTerminate();
@@ -0,0 +1,185 @@
+#include "mesh.h"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
+
+
+Torus generateTorus(float innerRadius, float outerRadius, unsigned int numc, unsigned int numt) {
+    Torus torus;
+    torus.numc = numc;
+    torus.numt = numt;
+
+    for (unsigned int i = 0; i <= numc; ++i) {
+        for (unsigned int j = 0; j <= numt; ++j) {
+            float s = (float)i / numc * 2.0f * glm::pi<float>();
+            float t = (float)j / numt * 2.0f * glm::pi<float>();
+
+            float x = (outerRadius + innerRadius * cos(t)) * cos(s);
+            float y = (outerRadius + innerRadius * cos(t)) * sin(s);
+            float z = innerRadius * sin(t);
+
+            torus.vertices.push_back(x);
+            torus.vertices.push_back(y);
+            torus.vertices.push_back(z);
+        }
+    }
+
+    for (unsigned int i = 0; i < numc; ++i) {
+        for (unsigned int j = 0; j < numt; ++j) {
+            unsigned int first = i * (numt + 1) + j;
+            unsigned int second = first + numt + 1;
+
+            torus.indices.push_back(first);
+            torus.indices.push_back(second);
+            torus.indices.push_back(first + 1);
+
+            torus.indices.push_back(second);
+            torus.indices.push_back(second + 1);
+            torus.indices.push_back(first + 1);
+        }
+    }
+
+    return torus;
+}
+
+
+Mesh generateTetrahedron() {
+    Mesh mesh;
+    mesh.vertices = {
+        1.0f,  1.0f,  1.0f,
+       -1.0f, -1.0f,  1.0f,
+       -1.0f,  1.0f, -1.0f,
+        1.0f, -1.0f, -1.0f
+    };
+    mesh.indices = {
+        0, 2, 1,
+        0, 1, 3,
+        0, 3, 2,
+        1, 2, 3
+    };
+    return mesh;
+}
+
+
+Mesh generateCylinder(float radius, float height, unsigned int segments) {
+    Mesh mesh;
+    float halfHeight = 0.5f * height;
+
+    // Ring vertices: bottom ring at [0, segments), top ring at [segments, 2 * segments).
+    for (unsigned int k = 0; k < 2; ++k) {
+        float z = k == 0 ? -halfHeight : halfHeight;
+        for (unsigned int i = 0; i < segments; ++i) {
+            float a = (float)i / segments * 2.0f * glm::pi<float>();
+            mesh.vertices.push_back(radius * cos(a));
+            mesh.vertices.push_back(radius * sin(a));
+            mesh.vertices.push_back(z);
+        }
+    }
+
+    for (unsigned int i = 0; i < segments; ++i) {
+        unsigned int next = (i + 1) % segments;
+        unsigned int b0 = i, b1 = next;
+        unsigned int t0 = i + segments, t1 = next + segments;
+
+        mesh.indices.push_back(b0);
+        mesh.indices.push_back(b1);
+        mesh.indices.push_back(t1);
+
+        mesh.indices.push_back(b0);
+        mesh.indices.push_back(t1);
+        mesh.indices.push_back(t0);
+    }
+
+    for (unsigned int i = 1; i + 1 < segments; ++i) {
+        mesh.indices.push_back(0);
+        mesh.indices.push_back(i + 1);
+        mesh.indices.push_back(i);
+
+        mesh.indices.push_back(segments);
+        mesh.indices.push_back(segments + i);
+        mesh.indices.push_back(segments + i + 1);
+    }
+
+    return mesh;
+}
+
+
+TorusHulls generateTorusHulls(float innerRadius, float outerRadius, unsigned int numc, unsigned int numt) {
+    TorusHulls hulls;
+    hulls.pieceCount = numc;
+    hulls.pieceIndexCount = 6 * numt + 6 * (numt - 2);
+
+    Mesh& mesh = hulls.mesh;
+    for (unsigned int i = 0; i < numc; ++i) {
+        // Each piece owns its two tube rings so the pieces can be drawn independently.
+        unsigned int base = (unsigned int)mesh.vertices.size() / 3;
+        for (unsigned int k = 0; k < 2; ++k) {
+            float s = (float)(i + k) / numc * 2.0f * glm::pi<float>();
+            for (unsigned int j = 0; j < numt; ++j) {
+                float t = (float)j / numt * 2.0f * glm::pi<float>();
+                mesh.vertices.push_back((outerRadius + innerRadius * cos(t)) * cos(s));
+                mesh.vertices.push_back((outerRadius + innerRadius * cos(t)) * sin(s));
+                mesh.vertices.push_back(innerRadius * sin(t));
+            }
+        }
+
+        for (unsigned int j = 0; j < numt; ++j) {
+            unsigned int next = (j + 1) % numt;
+            unsigned int a0 = base + j, a1 = base + next;
+            unsigned int b0 = base + numt + j, b1 = base + numt + next;
+
+            mesh.indices.push_back(a0);
+            mesh.indices.push_back(b0);
+            mesh.indices.push_back(a1);
+
+            mesh.indices.push_back(b0);
+            mesh.indices.push_back(b1);
+            mesh.indices.push_back(a1);
+        }
+
+        for (unsigned int j = 1; j + 1 < numt; ++j) {
+            mesh.indices.push_back(base);
+            mesh.indices.push_back(base + j);
+            mesh.indices.push_back(base + j + 1);
+
+            mesh.indices.push_back(base + numt);
+            mesh.indices.push_back(base + numt + j + 1);
+            mesh.indices.push_back(base + numt + j);
+        }
+    }
+
+    return hulls;
+}
+
+
+GpuMesh uploadMesh(const std::vector<float>& vertices, const std::vector<unsigned int>& indices) {
+    GpuMesh mesh;
+    mesh.indexCount = (GLsizei)indices.size();
+
+    glGenVertexArrays(1, &mesh.vao);
+    glGenBuffers(1, &mesh.vbo);
+    glGenBuffers(1, &mesh.ebo);
+
+    glBindVertexArray(mesh.vao);
+
+    glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), &vertices[0], GL_STATIC_DRAW);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ebo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), &indices[0], GL_STATIC_DRAW);
+
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+
+    glBindVertexArray(0);
+    return mesh;
+}
+
+
+void destroyMesh(GpuMesh& mesh) {
+    glDeleteVertexArrays(1, &mesh.vao);
+    glDeleteBuffers(1, &mesh.vbo);
+    glDeleteBuffers(1, &mesh.ebo);
+    mesh.vao = mesh.vbo = mesh.ebo = 0;
+    mesh.indexCount = 0;
+}
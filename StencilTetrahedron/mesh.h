@@ -0,0 +1,40 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <vector>
+
+
+struct Torus {
+    std::vector<float> vertices;
+    std::vector<unsigned int> indices;
+    unsigned int numc, numt;
+};
+
+// Closed, convex meshes with counter-clockwise outward-facing triangles, as
+// required by the stencil CSG renderer (front/back faces are culled separately).
+struct Mesh {
+    std::vector<float> vertices;
+    std::vector<unsigned int> indices;
+};
+
+// A torus split into numc convex pieces, one per major segment. Every piece has
+// the same index count, so piece k starts at index k * pieceIndexCount.
+struct TorusHulls {
+    Mesh mesh;
+    unsigned int pieceCount;
+    unsigned int pieceIndexCount;
+};
+
+struct GpuMesh {
+    GLuint vao, vbo, ebo;
+    GLsizei indexCount;
+};
+
+Torus generateTorus(float innerRadius, float outerRadius, unsigned int numc, unsigned int numt);
+Mesh generateTetrahedron();
+Mesh generateCylinder(float radius, float height, unsigned int segments);
+TorusHulls generateTorusHulls(float innerRadius, float outerRadius, unsigned int numc, unsigned int numt);
+
+GpuMesh uploadMesh(const std::vector<float>& vertices, const std::vector<unsigned int>& indices);
+void destroyMesh(GpuMesh& mesh);
@@ -0,0 +1,124 @@
+#include "morton_order.h"
+
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/simd_dispatch.hpp>
+
+#include <algorithm>
+
+
+static const unsigned int MORTON_CELLS = 1024;      // per axis: 10 bits, 30-bit codes
+static const size_t MORTON_CHUNK = 1024;            // points quantized per dispatched span
+
+
+static Aabb pointBounds(const float* points, size_t stride, size_t count) {
+    Aabb box;
+    box.min = glm::vec3(points[0], points[1], points[2]);
+    box.max = box.min;
+    for (size_t i = 1; i < count; ++i) {
+        glm::vec3 p(points[i * stride], points[i * stride + 1], points[i * stride + 2]);
+        box.min = glm::min(box.min, p);
+        box.max = glm::max(box.max, p);
+    }
+    return box;
+}
+
+
+void mortonCodes(const float* points, size_t stride, size_t count, const Aabb& bounds, uint64_t* codes) {
+    glm::vec3 extent = bounds.max - bounds.min;
+    glm::vec3 scale(0.0f);
+    for (int c = 0; c < 3; ++c) {
+        if (extent[c] > 0.0f)
+            scale[c] = MORTON_CELLS / extent[c];
+    }
+
+    // Quantized a chunk at a time so the cells stay in L1 for the interleave.
+    glm::u32vec3 cells[MORTON_CHUNK];
+    for (size_t first = 0; first < count; first += MORTON_CHUNK) {
+        size_t n = std::min(MORTON_CHUNK, count - first);
+        for (size_t i = 0; i < n; ++i) {
+            const float* p = points + (first + i) * stride;
+            glm::vec3 cell = (glm::vec3(p[0], p[1], p[2]) - bounds.min) * scale;
+            cells[i] = glm::u32vec3(glm::clamp(cell, glm::vec3(0.0f), glm::vec3(MORTON_CELLS - 1)));
+        }
+        glm::dispatchBitfieldInterleave(cells, codes + first, n);
+    }
+}
+
+
+std::vector<unsigned int> mortonOrder(const float* points, size_t stride, size_t count) {
+    std::vector<unsigned int> order(count);
+    if (count == 0)
+        return order;
+    std::vector<uint64_t> codes(count), sortedCodes(count);
+    mortonCodes(points, stride, count, pointBounds(points, stride, count), codes.data());
+
+    // LSD radix sort of the 30 code bits, 10 a pass; every pass is stable.
+    std::vector<unsigned int> sortedOrder(count);
+    for (size_t i = 0; i < count; ++i)
+        order[i] = (unsigned int)i;
+    for (unsigned int shift = 0; shift < 30; shift += 10) {
+        size_t offsets[MORTON_CELLS + 1] = {};
+        for (size_t i = 0; i < count; ++i)
+            ++offsets[((codes[i] >> shift) & (MORTON_CELLS - 1)) + 1];
+        for (unsigned int digit = 1; digit <= MORTON_CELLS; ++digit)
+            offsets[digit] += offsets[digit - 1];
+        for (size_t i = 0; i < count; ++i) {
+            size_t slot = offsets[(codes[i] >> shift) & (MORTON_CELLS - 1)]++;
+            sortedCodes[slot] = codes[i];
+            sortedOrder[slot] = order[i];
+        }
+        codes.swap(sortedCodes);
+        order.swap(sortedOrder);
+    }
+    return order;
+}
+
+
+void mortonSortInstances(Scene& scene) {
+    if (scene.instances.empty())
+        return;
+    static_assert(sizeof(SceneInstance) % sizeof(float) == 0, "instances must be a whole number of floats apart");
+    std::vector<unsigned int> order = mortonOrder(&scene.instances[0].position.x, sizeof(SceneInstance) / sizeof(float),
+                                                  scene.instances.size());
+    std::vector<SceneInstance> sorted(scene.instances.size());
+    for (size_t k = 0; k < order.size(); ++k)
+        sorted[k] = scene.instances[order[k]];
+    scene.instances.swap(sorted);
+}
+
+
+void mortonSortVertices(Mesh& mesh) {
+    size_t count = mesh.vertices.size() / 3;
+    std::vector<unsigned int> order = mortonOrder(mesh.vertices.data(), 3, count);
+    std::vector<float> vertices(mesh.vertices.size());
+    std::vector<unsigned int> remap(count);
+    for (size_t k = 0; k < count; ++k) {
+        std::copy_n(&mesh.vertices[3 * (size_t)order[k]], 3, &vertices[3 * k]);
+        remap[order[k]] = (unsigned int)k;
+    }
+    for (unsigned int& index : mesh.indices)
+        index = remap[index];
+    mesh.vertices.swap(vertices);
+}
+
+
+void mortonSortTriangles(Mesh& mesh) {
+    size_t triangles = mesh.indices.size() / 3;
+    std::vector<float> centroids(3 * triangles);
+    for (size_t t = 0; t < triangles; ++t) {
+        glm::vec3 sum(0.0f);
+        for (int corner = 0; corner < 3; ++corner) {
+            const float* p = &mesh.vertices[3 * (size_t)mesh.indices[3 * t + corner]];
+            sum += glm::vec3(p[0], p[1], p[2]);
+        }
+        sum /= 3.0f;
+        centroids[3 * t] = sum.x;
+        centroids[3 * t + 1] = sum.y;
+        centroids[3 * t + 2] = sum.z;
+    }
+    std::vector<unsigned int> order = mortonOrder(centroids.data(), 3, triangles);
+    std::vector<unsigned int> indices(mesh.indices.size());
+    for (size_t k = 0; k < triangles; ++k)
+        std::copy_n(&mesh.indices[3 * (size_t)order[k]], 3, &indices[3 * k]);
+    mesh.indices.swap(indices);
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "culling.h"
+#include "mesh.h"
+#include "scene.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+// Z-order (Morton) layouts. Points are quantized to a 1024^3 grid over their
+// bounding box and sorted by the interleaved bits of their cell, so points
+// that are close in space end up close in memory: culling, BVH builds and
+// vertex fetch then touch fewer cache lines and pages.
+
+// Morton codes of count points stride floats apart, each axis of bounds
+// split into 1024 cells. Codes use the low 30 bits.
+void mortonCodes(const float* points, size_t stride, size_t count, const Aabb& bounds, uint64_t* codes);
+
+// The permutation that sorts the points by Morton code: order[k] is the index
+// of the point that goes k-th. Stable, so points sharing a cell keep their order.
+std::vector<unsigned int> mortonOrder(const float* points, size_t stride, size_t count);
+
+// Puts the instances in Morton order of their positions.
+void mortonSortInstances(Scene& scene);
+
+// Puts the vertices in Morton order of their positions and renumbers the
+// indices to match. Triangles keep their order, so TorusHulls pieces stay put.
+void mortonSortVertices(Mesh& mesh);
+
+// Puts the triangles in Morton order of their centroids, keeping their
+// winding. After mortonSortVertices the index buffer then walks the vertex
+// buffer nearly in order.
+void mortonSortTriangles(Mesh& mesh);
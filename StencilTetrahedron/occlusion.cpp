@@ -0,0 +1,260 @@
+#include "occlusion.h"
+
+#include <algorithm>
+#include <chrono>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OCCLUSION_SSE2 1
+#include <emmintrin.h>
+#endif
+
+
+// Work is handed out in chunks so tasks stay large compared to their dispatch cost.
+const unsigned int OCCLUSION_SETUP_CHUNK = 64;
+const unsigned int OCCLUSION_TEST_CHUNK = 64;
+const int OCCLUSION_BAND_TILES = 2;
+
+
+void createOcclusionCuller(OcclusionCuller& culler, int width, int height) {
+    culler.width = width;
+    culler.height = height;
+    culler.tilesX = (width + OCCLUSION_TILE_SIZE - 1) / OCCLUSION_TILE_SIZE;
+    culler.tilesY = (height + OCCLUSION_TILE_SIZE - 1) / OCCLUSION_TILE_SIZE;
+    culler.depth.assign((size_t)width * height, 1.0f);
+    culler.tileMax.assign((size_t)culler.tilesX * culler.tilesY, 1.0f);
+    culler.stats = OcclusionStats();
+}
+
+
+static glm::vec3 toScreen(const OcclusionCuller& culler, const glm::vec4& clip) {
+    glm::vec3 ndc = glm::vec3(clip) / clip.w;
+    return glm::vec3((ndc.x * 0.5f + 0.5f) * culler.width, (ndc.y * 0.5f + 0.5f) * culler.height, ndc.z * 0.5f + 0.5f);
+}
+
+
+static void setupTriangle(const OcclusionCuller& culler, const glm::vec4 clip[3], OcclusionTriangle& triangle) {
+    triangle.valid = false;
+
+    // Triangles reaching behind the near plane are dropped: skipping an occluder
+    // only makes the test more conservative.
+    for (int i = 0; i < 3; ++i) {
+        if (clip[i].w <= 1.0e-5f || clip[i].z < -clip[i].w)
+            return;
+    }
+
+    glm::vec3 v[3];
+    for (int i = 0; i < 3; ++i)
+        v[i] = toScreen(culler, clip[i]);
+
+    float area = (v[1].x - v[0].x) * (v[2].y - v[0].y) - (v[1].y - v[0].y) * (v[2].x - v[0].x);
+    if (area <= 0.0f)
+        return;     // back-facing or degenerate
+
+    float minX = std::min(v[0].x, std::min(v[1].x, v[2].x));
+    float maxX = std::max(v[0].x, std::max(v[1].x, v[2].x));
+    float minY = std::min(v[0].y, std::min(v[1].y, v[2].y));
+    float maxY = std::max(v[0].y, std::max(v[1].y, v[2].y));
+    triangle.minX = std::max((int)minX, 0);
+    triangle.minY = std::max((int)minY, 0);
+    triangle.maxX = std::min((int)maxX, culler.width - 1);
+    triangle.maxY = std::min((int)maxY, culler.height - 1);
+    if (triangle.minX > triangle.maxX || triangle.minY > triangle.maxY)
+        return;
+
+    // Edge i runs from v[i] to v[i + 1]; E(p) = A * p.x + B * p.y + C.
+    for (int i = 0; i < 3; ++i) {
+        const glm::vec3& a = v[i];
+        const glm::vec3& b = v[(i + 1) % 3];
+        triangle.edgeA[i] = -(b.y - a.y);
+        triangle.edgeB[i] = b.x - a.x;
+        triangle.edgeC[i] = -(triangle.edgeA[i] * a.x + triangle.edgeB[i] * a.y);
+    }
+
+    // z = z0 + (z1 - z0) * E2(p) / area + (z2 - z0) * E0(p) / area, where E2 is
+    // the edge opposite v1 and E0 the edge opposite v2.
+    float d1 = (v[1].z - v[0].z) / area;
+    float d2 = (v[2].z - v[0].z) / area;
+    triangle.depthA = d1 * triangle.edgeA[2] + d2 * triangle.edgeA[0];
+    triangle.depthB = d1 * triangle.edgeB[2] + d2 * triangle.edgeB[0];
+    triangle.depthC = v[0].z + d1 * triangle.edgeC[2] + d2 * triangle.edgeC[0];
+    triangle.valid = true;
+}
+
+
+static void rasterizeBand(OcclusionCuller& culler, const OcclusionTriangle& triangle, int bandMinY, int bandMaxY) {
+    int minY = std::max(triangle.minY, bandMinY);
+    int maxY = std::min(triangle.maxY, bandMaxY);
+    int minX = triangle.minX & ~3;
+
+    for (int y = minY; y <= maxY; ++y) {
+        float py = y + 0.5f;
+        float* row = &culler.depth[(size_t)y * culler.width];
+        int x = minX;
+
+#if OCCLUSION_SSE2
+        __m128 offsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+        __m128 e0Step = _mm_set1_ps(triangle.edgeA[0]), e1Step = _mm_set1_ps(triangle.edgeA[1]);
+        __m128 e2Step = _mm_set1_ps(triangle.edgeA[2]), zStep = _mm_set1_ps(triangle.depthA);
+        __m128 e0Row = _mm_set1_ps(triangle.edgeB[0] * py + triangle.edgeC[0]);
+        __m128 e1Row = _mm_set1_ps(triangle.edgeB[1] * py + triangle.edgeC[1]);
+        __m128 e2Row = _mm_set1_ps(triangle.edgeB[2] * py + triangle.edgeC[2]);
+        __m128 zRow = _mm_set1_ps(triangle.depthB * py + triangle.depthC);
+        __m128 zero = _mm_setzero_ps();
+        for (; x <= triangle.maxX; x += 4) {
+            __m128 px = _mm_add_ps(_mm_set1_ps((float)x), offsets);
+            __m128 e0 = _mm_add_ps(_mm_mul_ps(e0Step, px), e0Row);
+            __m128 e1 = _mm_add_ps(_mm_mul_ps(e1Step, px), e1Row);
+            __m128 e2 = _mm_add_ps(_mm_mul_ps(e2Step, px), e2Row);
+            __m128 inside = _mm_and_ps(_mm_cmpge_ps(e0, zero), _mm_and_ps(_mm_cmpge_ps(e1, zero), _mm_cmpge_ps(e2, zero)));
+            if (_mm_movemask_ps(inside) == 0)
+                continue;
+
+            __m128 z = _mm_add_ps(_mm_mul_ps(zStep, px), zRow);
+            __m128 old = _mm_loadu_ps(row + x);
+            __m128 nearer = _mm_min_ps(old, z);
+            _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearer), _mm_andnot_ps(inside, old)));
+        }
+#else
+        for (; x <= triangle.maxX; ++x) {
+            float px = x + 0.5f;
+            if (triangle.edgeA[0] * px + triangle.edgeB[0] * py + triangle.edgeC[0] < 0.0f ||
+                triangle.edgeA[1] * px + triangle.edgeB[1] * py + triangle.edgeC[1] < 0.0f ||
+                triangle.edgeA[2] * px + triangle.edgeB[2] * py + triangle.edgeC[2] < 0.0f)
+                continue;
+            float z = triangle.depthA * px + triangle.depthB * py + triangle.depthC;
+            row[x] = std::min(row[x], z);
+        }
+#endif
+    }
+}
+
+
+static void buildTileMax(OcclusionCuller& culler, int tileY) {
+    for (int tileX = 0; tileX < culler.tilesX; ++tileX) {
+        float farthest = 0.0f;
+        int endY = std::min((tileY + 1) * OCCLUSION_TILE_SIZE, culler.height);
+        int endX = std::min((tileX + 1) * OCCLUSION_TILE_SIZE, culler.width);
+        for (int y = tileY * OCCLUSION_TILE_SIZE; y < endY; ++y) {
+            const float* row = &culler.depth[(size_t)y * culler.width];
+            for (int x = tileX * OCCLUSION_TILE_SIZE; x < endX; ++x)
+                farthest = std::max(farthest, row[x]);
+        }
+        culler.tileMax[(size_t)tileY * culler.tilesX + tileX] = farthest;
+    }
+}
+
+
+static bool boxOccluded(const OcclusionCuller& culler, const glm::mat4& viewProjection,
+                        const glm::vec3& center, const glm::vec3& extent) {
+    float minX = 1.0e30f, minY = 1.0e30f, maxX = -1.0e30f, maxY = -1.0e30f, nearest = 1.0f;
+    for (int corner = 0; corner < 8; ++corner) {
+        glm::vec3 sign((corner & 1) ? 1.0f : -1.0f, (corner & 2) ? 1.0f : -1.0f, (corner & 4) ? 1.0f : -1.0f);
+        glm::vec4 clip = viewProjection * glm::vec4(center + sign * extent, 1.0f);
+        if (clip.w <= 1.0e-5f || clip.z < -clip.w)
+            return false;   // straddles the near plane
+        glm::vec3 screen = toScreen(culler, clip);
+        minX = std::min(minX, screen.x);
+        maxX = std::max(maxX, screen.x);
+        minY = std::min(minY, screen.y);
+        maxY = std::max(maxY, screen.y);
+        nearest = std::min(nearest, screen.z);
+    }
+
+    int x0 = std::max((int)minX, 0), x1 = std::min((int)maxX, culler.width - 1);
+    int y0 = std::max((int)minY, 0), y1 = std::min((int)maxY, culler.height - 1);
+    if (x0 > x1 || y0 > y1)
+        return false;   // off screen: left to the frustum test
+
+    // Coarse level first: a tile whose farthest occluder is nearer than the box
+    // hides its part of the box. Otherwise fall back to the covered pixels.
+    for (int tileY = y0 / OCCLUSION_TILE_SIZE; tileY <= y1 / OCCLUSION_TILE_SIZE; ++tileY) {
+        for (int tileX = x0 / OCCLUSION_TILE_SIZE; tileX <= x1 / OCCLUSION_TILE_SIZE; ++tileX) {
+            if (culler.tileMax[(size_t)tileY * culler.tilesX + tileX] < nearest)
+                continue;
+
+            int py0 = std::max(y0, tileY * OCCLUSION_TILE_SIZE), py1 = std::min(y1, (tileY + 1) * OCCLUSION_TILE_SIZE - 1);
+            int px0 = std::max(x0, tileX * OCCLUSION_TILE_SIZE), px1 = std::min(x1, (tileX + 1) * OCCLUSION_TILE_SIZE - 1);
+            for (int y = py0; y <= py1; ++y) {
+                const float* row = &culler.depth[(size_t)y * culler.width];
+                for (int x = px0; x <= px1; ++x) {
+                    if (row[x] >= nearest)
+                        return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+
+size_t cullOccluded(OcclusionCuller& culler, WorkerPool& pool, const glm::mat4& viewProjection,
+                    const Mesh& occluder, const glm::mat4* occluderModels, size_t occluderCount,
+                    const AabbBatch& bounds, const unsigned int* candidates, size_t candidateCount,
+                    unsigned int* visible) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    size_t trianglesPerOccluder = occluder.indices.size() / 3;
+    culler.triangles.resize(occluderCount * trianglesPerOccluder);
+    unsigned int setupTasks = (unsigned int)((occluderCount + OCCLUSION_SETUP_CHUNK - 1) / OCCLUSION_SETUP_CHUNK);
+    parallelFor(pool, setupTasks, [&](unsigned int task) {
+        size_t end = std::min(occluderCount, (size_t)(task + 1) * OCCLUSION_SETUP_CHUNK);
+        for (size_t o = (size_t)task * OCCLUSION_SETUP_CHUNK; o < end; ++o) {
+            glm::mat4 mvp = viewProjection * occluderModels[o];
+            for (size_t t = 0; t < trianglesPerOccluder; ++t) {
+                glm::vec4 clip[3];
+                for (int k = 0; k < 3; ++k) {
+                    unsigned int index = occluder.indices[t * 3 + k];
+                    clip[k] = mvp * glm::vec4(occluder.vertices[index * 3], occluder.vertices[index * 3 + 1],
+                                              occluder.vertices[index * 3 + 2], 1.0f);
+                }
+                setupTriangle(culler, clip, culler.triangles[o * trianglesPerOccluder + t]);
+            }
+        }
+    });
+
+    int bandHeight = OCCLUSION_BAND_TILES * OCCLUSION_TILE_SIZE;
+    unsigned int bands = (unsigned int)((culler.height + bandHeight - 1) / bandHeight);
+    parallelFor(pool, bands, [&](unsigned int band) {
+        int bandMinY = (int)band * bandHeight;
+        int bandMaxY = std::min(bandMinY + bandHeight, culler.height) - 1;
+        std::fill(culler.depth.begin() + (size_t)bandMinY * culler.width,
+                  culler.depth.begin() + (size_t)(bandMaxY + 1) * culler.width, 1.0f);
+        for (const OcclusionTriangle& triangle : culler.triangles) {
+            if (triangle.valid && triangle.maxY >= bandMinY && triangle.minY <= bandMaxY)
+                rasterizeBand(culler, triangle, bandMinY, bandMaxY);
+        }
+        for (int tileY = bandMinY / OCCLUSION_TILE_SIZE; tileY <= bandMaxY / OCCLUSION_TILE_SIZE; ++tileY)
+            buildTileMax(culler, tileY);
+    });
+
+    auto rasterized = std::chrono::high_resolution_clock::now();
+
+    culler.occluded.resize(candidateCount);
+    unsigned int testTasks = (unsigned int)((candidateCount + OCCLUSION_TEST_CHUNK - 1) / OCCLUSION_TEST_CHUNK);
+    parallelFor(pool, testTasks, [&](unsigned int task) {
+        size_t end = std::min(candidateCount, (size_t)(task + 1) * OCCLUSION_TEST_CHUNK);
+        for (size_t c = (size_t)task * OCCLUSION_TEST_CHUNK; c < end; ++c) {
+            unsigned int i = candidates[c];
+            glm::vec3 center(bounds.centerX[i], bounds.centerY[i], bounds.centerZ[i]);
+            glm::vec3 extent(bounds.extentX[i], bounds.extentY[i], bounds.extentZ[i]);
+            culler.occluded[c] = boxOccluded(culler, viewProjection, center, extent) ? 1 : 0;
+        }
+    });
+
+    size_t visibleCount = 0;
+    for (size_t c = 0; c < candidateCount; ++c) {
+        if (!culler.occluded[c])
+            visible[visibleCount++] = candidates[c];
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    OcclusionStats& stats = culler.stats;
+    stats.occluderTriangles = 0;
+    for (const OcclusionTriangle& triangle : culler.triangles)
+        stats.occluderTriangles += triangle.valid ? 1 : 0;
+    stats.tested = candidateCount;
+    stats.occluded = candidateCount - visibleCount;
+    stats.rasterMs = std::chrono::duration<double, std::milli>(rasterized - start).count();
+    stats.testMs = std::chrono::duration<double, std::milli>(end - rasterized).count();
+    return visibleCount;
+}
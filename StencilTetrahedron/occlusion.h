@@ -0,0 +1,53 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "culling.h"
+#include "mesh.h"
+#include "worker_pool.h"
+
+#include <cstddef>
+#include <vector>
+
+
+// Software occlusion culling: occluder meshes are rasterized depth-only at low
+// resolution into a CPU depth buffer, an 8x8-tile max-depth level is built on
+// top, and occludee bounding boxes are tested against it before any GL draw.
+// Triangle setup, rasterization (one band of tile rows per task) and the box
+// tests all run on the worker pool.
+const int OCCLUSION_TILE_SIZE = 8;
+
+struct OcclusionTriangle {
+    float edgeA[3], edgeB[3], edgeC[3];     // edge functions, >= 0 inside
+    float depthA, depthB, depthC;           // depth plane in screen space
+    int minX, minY, maxX, maxY;             // pixel bounds, inclusive
+    bool valid;
+};
+
+struct OcclusionStats {
+    size_t occluderTriangles;
+    size_t tested;
+    size_t occluded;
+    double rasterMs;
+    double testMs;
+};
+
+struct OcclusionCuller {
+    int width, height;
+    int tilesX, tilesY;
+    std::vector<float> depth;       // 0 at the near plane, 1 at the far plane
+    std::vector<float> tileMax;     // farthest depth in each tile
+    std::vector<OcclusionTriangle> triangles;
+    std::vector<unsigned char> occluded;
+    OcclusionStats stats;
+};
+
+// width must be a multiple of 4 (one SSE register of pixels).
+void createOcclusionCuller(OcclusionCuller& culler, int width, int height);
+
+// Rasterizes occluder (closed, outward CCW) once per model matrix, then tests the
+// candidate boxes and writes the unoccluded candidates to visible in order.
+size_t cullOccluded(OcclusionCuller& culler, WorkerPool& pool, const glm::mat4& viewProjection,
+                    const Mesh& occluder, const glm::mat4* occluderModels, size_t occluderCount,
+                    const AabbBatch& bounds, const unsigned int* candidates, size_t candidateCount,
+                    unsigned int* visible);
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "worker_pool.h"
+
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+
+// Coroutine that runs on a WorkerPool, passed as its first parameter. Calling
+// it queues the body as a pool job and returns at once. Other pool tasks can
+// co_await it, which parks them on the task's job counter until it finishes;
+// threads outside the pool use waitForTask. The result stays in the task.
+template <typename T>
+struct PoolTask {
+    struct promise_type {
+        WorkerPool* pool;
+        JobCounter done;
+        T result;
+
+        template <typename... Args>
+        promise_type(WorkerPool& pool, Args&&...) : pool(&pool) {
+            done.pending = 1;
+        }
+
+        PoolTask get_return_object() {
+            return PoolTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        struct Start {
+            bool await_ready() noexcept { return false; }
+            void await_suspend(std::coroutine_handle<promise_type> handle) noexcept {
+                submitJob(*handle.promise().pool, [handle] { handle.resume(); });
+            }
+            void await_resume() noexcept {}
+        };
+
+        // The frame stays alive after the body so the result can be read.
+        struct Finish {
+            bool await_ready() noexcept { return false; }
+            void await_suspend(std::coroutine_handle<promise_type> handle) noexcept {
+                promise_type& promise = handle.promise();
+                signalCounter(*promise.pool, promise.done);
+            }
+            void await_resume() noexcept {}
+        };
+
+        Start initial_suspend() noexcept { return {}; }
+        Finish final_suspend() noexcept { return {}; }
+        void return_value(T value) { result = std::move(value); }
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    explicit PoolTask(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+    PoolTask(PoolTask&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+    PoolTask(const PoolTask&) = delete;
+    PoolTask& operator=(const PoolTask&) = delete;
+
+    ~PoolTask() {
+        if (handle) {
+            waitForCounter(*handle.promise().pool, handle.promise().done);
+            handle.destroy();
+        }
+    }
+
+    bool await_ready() const noexcept {
+        return handle.promise().done.pending.load() == 0;
+    }
+
+    void await_suspend(std::coroutine_handle<> awaiting) const {
+        promise_type& promise = handle.promise();
+        submitJob(*promise.pool, [awaiting] { awaiting.resume(); }, nullptr, &promise.done);
+    }
+
+    const T& await_resume() const noexcept {
+        return handle.promise().result;
+    }
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+// Blocks a thread outside the pool until the task has finished, running other
+// pool jobs meanwhile, and hands out its result.
+template <typename T>
+T& waitForTask(PoolTask<T>& task) {
+    waitForCounter(*task.handle.promise().pool, task.handle.promise().done);
+    return task.handle.promise().result;
+}
@@ -0,0 +1,107 @@
+#include "procedural_torus.h"
+#include "shader.h"
+
+
+static const char* proceduralTorusVertexSource = R"(
+    #version 330 core
+
+    uniform mat4 model;
+    uniform mat4 view;
+    uniform mat4 projection;
+
+    uniform int numc;
+    uniform int numt;
+    uniform float innerRadius;
+    uniform float outerRadius;
+    uniform vec3 instanceStep;
+
+    out vec3 Normal;
+
+    void main(){
+        // Strip k covers rings k and k + 1: 2 * (numt + 1) vertices, then the
+        // last vertex repeated and the first vertex of strip k + 1 to stitch.
+        int stripLength = 2 * numt + 4;
+        int strip = gl_VertexID / stripLength;
+        int k = gl_VertexID % stripLength;
+        if (k == stripLength - 1) {
+            strip += 1;
+            k = 0;
+        }
+        k = min(k, 2 * numt + 1);
+
+        int i = strip + (k & 1);
+        int j = k >> 1;
+        float s = float(i) / float(numc) * 6.28318530718;
+        float t = float(j) / float(numt) * 6.28318530718;
+
+        vec3 pos = vec3((outerRadius + innerRadius * cos(t)) * cos(s),
+                        (outerRadius + innerRadius * cos(t)) * sin(s),
+                        innerRadius * sin(t));
+        pos += float(gl_InstanceID) * instanceStep;
+        Normal = mat3(model) * vec3(cos(t) * cos(s), cos(t) * sin(s), sin(t));
+
+        gl_Position = projection * view * model * vec4(pos, 1.0);
+    }
+)";
+
+
+bool createProceduralTorus(ProceduralTorus& torus, ShaderCompiler& compiler) {
+    torus.ready = false;
+    torus.program = 0;
+    beginShaderProgram(compiler, torus.build, proceduralTorusVertexSource, fragmentShaderSource);
+    glGenVertexArrays(1, &torus.vao);
+    return pollShaderProgram(compiler, torus.build) != ShaderBuildState::Failed;
+}
+
+
+bool pollProceduralTorus(ProceduralTorus& torus, ShaderCompiler& compiler) {
+    if (torus.ready)
+        return true;
+    if (pollShaderProgram(compiler, torus.build) != ShaderBuildState::Ready)
+        return false;
+
+    torus.program = torus.build.program;
+    torus.modelLoc = glGetUniformLocation(torus.program, "model");
+    torus.viewLoc = glGetUniformLocation(torus.program, "view");
+    torus.projLoc = glGetUniformLocation(torus.program, "projection");
+    torus.colorLoc = glGetUniformLocation(torus.program, "color");
+    torus.numcLoc = glGetUniformLocation(torus.program, "numc");
+    torus.numtLoc = glGetUniformLocation(torus.program, "numt");
+    torus.innerRadiusLoc = glGetUniformLocation(torus.program, "innerRadius");
+    torus.outerRadiusLoc = glGetUniformLocation(torus.program, "outerRadius");
+    torus.instanceStepLoc = glGetUniformLocation(torus.program, "instanceStep");
+    torus.ready = true;
+    return true;
+}
+
+
+void destroyProceduralTorus(ProceduralTorus& torus) {
+    glDeleteVertexArrays(1, &torus.vao);
+    glDeleteProgram(torus.build.program);
+}
+
+
+void drawProceduralTorus(const ProceduralTorus& torus, float innerRadius, float outerRadius,
+                         unsigned int numc, unsigned int numt, GLsizei instances) {
+    glUniform1i(torus.numcLoc, (GLint)numc);
+    glUniform1i(torus.numtLoc, (GLint)numt);
+    glUniform1f(torus.innerRadiusLoc, innerRadius);
+    glUniform1f(torus.outerRadiusLoc, outerRadius);
+
+    glBindVertexArray(torus.vao);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, proceduralTorusVertexCount(numc, numt), instances);
+    glBindVertexArray(0);
+}
+
+
+GLsizei proceduralTorusVertexCount(unsigned int numc, unsigned int numt) {
+    // The stitching vertices after the final strip are dropped.
+    return (GLsizei)(numc * (2 * numt + 4) - 2);
+}
+
+
+std::size_t bufferedTorusBytes(unsigned int numc, unsigned int numt) {
+    std::size_t vertexBytes = (std::size_t)(numc + 1) * (numt + 1) * 3 * sizeof(float);
+    std::size_t indexBytes = (std::size_t)numc * numt * 6 * sizeof(unsigned int);
+    return vertexBytes + indexBytes;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include "shader.h"
+
+#include <cstddef>
+
+
+// Draws the same surface as generateTorus without any vertex or index buffers:
+// the vertex shader rebuilds every position (and normal) from gl_VertexID and
+// the tessellation uniforms, so numc/numt can change on every draw for free.
+// Rings are emitted as one triangle strip joined by degenerate triangles, which
+// keeps vertex shader work near two invocations per quad.
+struct ProceduralTorus {
+    AsyncShaderProgram build;
+    bool ready;     // program built and uniform locations fetched
+    GLuint program;
+    GLuint vao;     // empty; core profile still requires one to be bound
+    GLint modelLoc, viewLoc, projLoc, colorLoc;
+    GLint numcLoc, numtLoc, innerRadiusLoc, outerRadiusLoc, instanceStepLoc;
+};
+
+// The program is built asynchronously; until pollProceduralTorus returns true
+// the caller draws something else in its place.
+bool createProceduralTorus(ProceduralTorus& torus, ShaderCompiler& compiler);
+bool pollProceduralTorus(ProceduralTorus& torus, ShaderCompiler& compiler);
+void destroyProceduralTorus(ProceduralTorus& torus);
+
+// Expects torus.program to be current with model/view/projection/color set.
+// Instance k is offset by k * instanceStep (set through instanceStepLoc).
+void drawProceduralTorus(const ProceduralTorus& torus, float innerRadius, float outerRadius,
+                         unsigned int numc, unsigned int numt, GLsizei instances = 1);
+
+GLsizei proceduralTorusVertexCount(unsigned int numc, unsigned int numt);
+std::size_t bufferedTorusBytes(unsigned int numc, unsigned int numt);
@@ -0,0 +1,30 @@
+#include "scene.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+
+Scene buildLatticeScene(unsigned int n, float spacing) {
+    Scene scene;
+    // Tetrahedron corners sit at sqrt(3); the torus reaches outerRadius + innerRadius = 1.1.
+    scene.boundingRadius = glm::sqrt(3.0f);
+
+    float offset = 0.5f * (n - 1) * spacing;
+    scene.instances.reserve((size_t)n * n * n);
+    for (unsigned int k = 0; k < n; ++k) {
+        for (unsigned int j = 0; j < n; ++j) {
+            for (unsigned int i = 0; i < n; ++i) {
+                SceneInstance instance;
+                instance.position = glm::vec3(i * spacing - offset, j * spacing - offset, -(float)k * spacing);
+                instance.scale = 1.0f;
+                scene.instances.push_back(instance);
+            }
+        }
+    }
+    return scene;
+}
+
+
+glm::mat4 instanceModel(const SceneInstance& instance, const glm::mat4& rotation) {
+    glm::mat4 model = glm::translate(glm::mat4(1.0f), instance.position) * rotation;
+    return glm::scale(model, glm::vec3(instance.scale));
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+
+// One holed tetrahedron with its torus. Instances share the scene rotation and
+// differ only by placement.
+struct SceneInstance {
+    glm::vec3 position;
+    float scale;
+};
+
+struct Scene {
+    std::vector<SceneInstance> instances;
+    float boundingRadius;   // object-space radius enclosing the tetrahedron and torus
+};
+
+// n * n * n instances on a grid, centred in x and y and receding from the camera in z.
+Scene buildLatticeScene(unsigned int n, float spacing);
+
+glm::mat4 instanceModel(const SceneInstance& instance, const glm::mat4& rotation);
@@ -0,0 +1,255 @@
+#include "shader.h"
+
+#include <cstring>
+#include <iostream>
+
+
+const char* vertexShaderSource = R"(
+    #version 330 core
+    layout (location = 0) in vec3 aPos;
+
+    uniform mat4 model;
+    uniform mat4 view;
+    uniform mat4 projection;
+
+    void main(){
+        gl_Position = projection * view * model * vec4(aPos, 1.0);
+    }
+)";
+
+const char* fragmentShaderSource = R"(
+    #version 330 core
+    out vec4 FragColor;
+
+    uniform vec4 color;
+
+    void main(){
+        FragColor = color;
+    }
+)";
+
+
+GLuint compileShader(GLenum type, const char* source) {
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, NULL);
+    glCompileShader(shader);
+
+    int success;
+    char infoLog[512];
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (!success) {
+        glGetShaderInfoLog(shader, 512, NULL, infoLog);
+        std::cout << "ERROR::SHADER::COMPILATION_FAILED\n" << infoLog << std::endl;
+    }
+    return shader;
+}
+
+
+GLuint createShaderProgram(const char* vertexSource, const char* fragmentSource) {
+    GLuint vertexShader = compileShader(GL_VERTEX_SHADER, vertexSource);
+    GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentSource);
+
+
+    GLuint shaderProgram = glCreateProgram();
+    glAttachShader(shaderProgram, vertexShader);
+    glAttachShader(shaderProgram, fragmentShader);
+    glLinkProgram(shaderProgram);
+    int success;
+    char infoLog[512];
+    glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
+    if (!success) {
+        glGetProgramInfoLog(shaderProgram, 512, NULL, infoLog);
+        std::cout << "ERROR::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
+    }
+
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+    return shaderProgram;
+}
+
+
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
+
+static bool hasExtension(const char* name) {
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (GLint i = 0; i < count; i++) {
+        const char* extension = (const char*)glGetStringi(GL_EXTENSIONS, (GLuint)i);
+        if (extension && std::strcmp(extension, name) == 0)
+            return true;
+    }
+    return false;
+}
+
+
+static double millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+
+static void printShaderLog(GLuint shader) {
+    int success;
+    char infoLog[512];
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (!success) {
+        glGetShaderInfoLog(shader, 512, NULL, infoLog);
+        std::cout << "ERROR::SHADER::COMPILATION_FAILED\n" << infoLog << std::endl;
+    }
+}
+
+
+static bool linkSucceeded(GLuint program) {
+    int success;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    return success != 0;
+}
+
+
+static void compileThread(ShaderCompiler* compiler) {
+    compiler->makeContextCurrent(true);
+    for (;;) {
+        AsyncShaderProgram* program;
+        {
+            std::unique_lock<std::mutex> lock(compiler->mutex);
+            compiler->wake.wait(lock, [&] { return compiler->quit || !compiler->queue.empty(); });
+            if (compiler->queue.empty())
+                break;
+            program = compiler->queue.front();
+            compiler->queue.pop_front();
+        }
+
+        GLuint shaderProgram = createShaderProgram(program->vertexSource, program->fragmentSource);
+        bool linked = linkSucceeded(shaderProgram);
+        // Objects built in one context are only guaranteed visible to the
+        // others in the share group once the commands creating them finish.
+        glFinish();
+
+        std::lock_guard<std::mutex> lock(compiler->mutex);
+        program->program = shaderProgram;
+        program->state = linked ? ShaderBuildState::Ready : ShaderBuildState::Failed;
+        program->buildMs = millisecondsSince(program->started);
+    }
+    compiler->makeContextCurrent(false);
+}
+
+
+void createShaderCompiler(ShaderCompiler& compiler, GLADloadproc load) {
+    compiler.maxCompilerThreads = NULL;
+    if (hasExtension("GL_KHR_parallel_shader_compile"))
+        compiler.maxCompilerThreads = (void (APIENTRYP)(GLuint))load("glMaxShaderCompilerThreadsKHR");
+    else if (hasExtension("GL_ARB_parallel_shader_compile"))
+        compiler.maxCompilerThreads = (void (APIENTRYP)(GLuint))load("glMaxShaderCompilerThreadsARB");
+    compiler.parallelCompile = compiler.maxCompilerThreads != NULL;
+    // 0xFFFFFFFF lets the implementation pick its own thread count.
+    if (compiler.parallelCompile)
+        compiler.maxCompilerThreads(0xFFFFFFFFu);
+
+    compiler.running = false;
+    compiler.quit = false;
+}
+
+
+void startShaderCompileThread(ShaderCompiler& compiler, std::function<void(bool)> makeContextCurrent) {
+    if (compiler.parallelCompile || compiler.running)
+        return;
+    compiler.makeContextCurrent = std::move(makeContextCurrent);
+    compiler.running = true;
+    compiler.worker = std::thread(compileThread, &compiler);
+}
+
+
+void destroyShaderCompiler(ShaderCompiler& compiler) {
+    if (!compiler.running)
+        return;
+    {
+        std::lock_guard<std::mutex> lock(compiler.mutex);
+        compiler.quit = true;
+    }
+    compiler.wake.notify_all();
+    compiler.worker.join();
+    compiler.running = false;
+}
+
+
+const char* shaderCompilerMode(const ShaderCompiler& compiler) {
+    if (compiler.parallelCompile)
+        return "parallel shader compile";
+    return compiler.running ? "compile thread" : "synchronous";
+}
+
+
+void beginShaderProgram(ShaderCompiler& compiler, AsyncShaderProgram& program,
+                        const char* vertexSource, const char* fragmentSource) {
+    program.program = 0;
+    program.vertexShader = 0;
+    program.fragmentShader = 0;
+    program.vertexSource = vertexSource;
+    program.fragmentSource = fragmentSource;
+    program.state = ShaderBuildState::Pending;
+    program.started = std::chrono::steady_clock::now();
+    program.buildMs = 0.0;
+
+    if (compiler.parallelCompile) {
+        // Compile and link back to back: linking does not need the compile
+        // results yet, and asking for them here would wait on the compile.
+        program.vertexShader = glCreateShader(GL_VERTEX_SHADER);
+        glShaderSource(program.vertexShader, 1, &vertexSource, NULL);
+        glCompileShader(program.vertexShader);
+        program.fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
+        glShaderSource(program.fragmentShader, 1, &fragmentSource, NULL);
+        glCompileShader(program.fragmentShader);
+
+        program.program = glCreateProgram();
+        glAttachShader(program.program, program.vertexShader);
+        glAttachShader(program.program, program.fragmentShader);
+        glLinkProgram(program.program);
+    }
+    else if (compiler.running) {
+        {
+            std::lock_guard<std::mutex> lock(compiler.mutex);
+            compiler.queue.push_back(&program);
+        }
+        compiler.wake.notify_one();
+    }
+    else {
+        program.program = createShaderProgram(vertexSource, fragmentSource);
+        program.state = linkSucceeded(program.program) ? ShaderBuildState::Ready : ShaderBuildState::Failed;
+        program.buildMs = millisecondsSince(program.started);
+    }
+}
+
+
+ShaderBuildState pollShaderProgram(ShaderCompiler& compiler, AsyncShaderProgram& program) {
+    if (!compiler.parallelCompile || program.state != ShaderBuildState::Pending) {
+        std::lock_guard<std::mutex> lock(compiler.mutex);
+        return program.state;
+    }
+
+    GLint complete = GL_FALSE;
+    glGetProgramiv(program.program, GL_COMPLETION_STATUS_KHR, &complete);
+    if (!complete)
+        return ShaderBuildState::Pending;
+
+    program.buildMs = millisecondsSince(program.started);
+    if (linkSucceeded(program.program)) {
+        program.state = ShaderBuildState::Ready;
+    }
+    else {
+        printShaderLog(program.vertexShader);
+        printShaderLog(program.fragmentShader);
+        char infoLog[512];
+        glGetProgramInfoLog(program.program, 512, NULL, infoLog);
+        std::cout << "ERROR::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
+        program.state = ShaderBuildState::Failed;
+    }
+    glDetachShader(program.program, program.vertexShader);
+    glDetachShader(program.program, program.fragmentShader);
+    glDeleteShader(program.vertexShader);
+    glDeleteShader(program.fragmentShader);
+    program.vertexShader = 0;
+    program.fragmentShader = 0;
+    return program.state;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+
+extern const char* vertexShaderSource;
+extern const char* fragmentShaderSource;
+
+GLuint compileShader(GLenum type, const char* source);
+GLuint createShaderProgram(const char* vertexSource, const char* fragmentSource);
+
+
+// Asynchronous program builds. Querying GL_COMPILE_STATUS right after
+// glCompileShader forces the driver to finish the compile on the spot, so a
+// program built through createShaderProgram stalls the calling thread. The
+// compiler below never asks for a status before the build is known to be done:
+//   - with GL_KHR_parallel_shader_compile (or the ARB twin) the driver compiles
+//     on its own threads and pollShaderProgram only reads
+//     GL_COMPLETION_STATUS_KHR;
+//   - otherwise, once startShaderCompileThread has been given a hidden context
+//     in the same share group, a worker thread builds the program there;
+//   - failing both, beginShaderProgram builds synchronously.
+enum class ShaderBuildState { Pending, Ready, Failed };
+
+struct AsyncShaderProgram {
+    GLuint program;
+    GLuint vertexShader, fragmentShader;    // parallel compile only, until done
+    const char* vertexSource;               // must outlive the build
+    const char* fragmentSource;
+    ShaderBuildState state;                 // guarded by ShaderCompiler::mutex
+    std::chrono::steady_clock::time_point started;
+    double buildMs;
+};
+
+struct ShaderCompiler {
+    bool parallelCompile;
+    void (APIENTRYP maxCompilerThreads)(GLuint count);
+
+    // Compile thread fallback; makeContextCurrent(true/false) binds and
+    // releases the shared context on the worker.
+    std::function<void(bool)> makeContextCurrent;
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<AsyncShaderProgram*> queue;
+    bool running;
+    bool quit;
+};
+
+// load is the same loader handed to gladLoadGLLoader; it resolves
+// glMaxShaderCompilerThreadsKHR, which glad was not generated with.
+void createShaderCompiler(ShaderCompiler& compiler, GLADloadproc load);
+void startShaderCompileThread(ShaderCompiler& compiler, std::function<void(bool)> makeContextCurrent);
+void destroyShaderCompiler(ShaderCompiler& compiler);
+const char* shaderCompilerMode(const ShaderCompiler& compiler);
+
+// The program must stay alive (and in place) until it is no longer Pending.
+void beginShaderProgram(ShaderCompiler& compiler, AsyncShaderProgram& program,
+                        const char* vertexSource, const char* fragmentSource);
+// Never blocks; the program is usable once this returns Ready.
+ShaderBuildState pollShaderProgram(ShaderCompiler& compiler, AsyncShaderProgram& program);
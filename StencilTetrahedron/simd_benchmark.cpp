@@ -0,0 +1,1394 @@
+#include "simd_benchmark.h"
+#include "bvh.h"
+#include "culling.h"
+#include "mesh.h"
+#include "morton_order.h"
+#include "scene.h"
+#include "worker_pool.h"
+
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/glm.hpp>
+#include <glm/gtc/bitfield.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/noise.hpp>
+#include <glm/gtc/packing.hpp>
+#include <glm/gtc/random.hpp>
+#include <glm/gtx/intersect.hpp>
+#include <glm/gtx/transform_batch.hpp>
+#include <glm/gtx/exponential_batch.hpp>
+#include <glm/gtx/simd_dispatch.hpp>
+
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+
+// Relative to the largest component; float rounding in a different order
+// stays well below it.
+const double TRANSFORM_TOLERANCE = 1e-5;
+// Relative to the largest element of a long double reference, for matrices
+// kept well conditioned.
+const double DMAT4_TOLERANCE = 1e-12;
+// Relative to a double reference, with FLT_MIN as the smallest scale so that
+// subnormal results count by their absolute error. 2 ULPs is at most 2.4e-7.
+const double EXPONENTIAL_TOLERANCE = 3e-7;
+const double EXPONENTIAL_LOWP_TOLERANCE = 1e-4;
+// The noise and random kernels repeat the scalar code's float operations, so
+// they must agree exactly. Where GCC may contract multiply-adds into FMA
+// (-mfma) it does so on both sides, differently: values then count as
+// mismatches beyond SPANS_TOLERANCE, relative to magnitudes above one. A
+// contracted fract can also round into the neighbouring noise cell, next to
+// whose border the kernels have faded out: one value in NOISE_OUTLIER_SHARE
+// may move by up to NOISE_OUTLIER_TOLERANCE that way.
+#if defined(__FMA__) && !defined(_MSC_VER)
+const bool SPANS_EXACT = false;
+#else
+const bool SPANS_EXACT = true;
+#endif
+const double SPANS_TOLERANCE = SPANS_EXACT ? 0.0 : 1e-5;
+const char* const SPANS_NOTE = SPANS_EXACT ? "" : ", FMA contraction: mismatches beyond 1e-5";
+const double NOISE_OUTLIER_TOLERANCE = 1e-2;
+const unsigned int NOISE_OUTLIER_SHARE = 4096;
+// Largest error of the gaussRand spans' sample mean and standard deviation,
+// in standard deviations: about five standard errors at 65536 values.
+const double GAUSS_TOLERANCE = 0.02;
+// Barycentric distance from an edge within which FMA builds let a BVH hit
+// differ from glm::intersectRayTriangle's.
+const float BVH_EDGE_TOLERANCE = 1e-4f;
+
+
+bool parseSimdBenchmarkOptions(int argc, char** argv, SimdBenchmarkOptions& options) {
+    options.points = 1 << 16;
+    options.seconds = 0.25;
+
+    bool benchmark = false;
+    for (int i = 1; i < argc; ++i) {
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--simd-bench") == 0)
+            benchmark = true;
+        else if (std::strcmp(argv[i], "--points") == 0 && hasValue)
+            options.points = (unsigned int)std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--seconds") == 0 && hasValue)
+            options.seconds = std::max(0.01, std::atof(argv[++i]));
+    }
+    return benchmark;
+}
+
+
+// Best time of one call over repeated runs, in milliseconds. The best run is
+// the one least disturbed by the rest of the system.
+template <typename Kernel>
+static double bestTimeMs(double seconds, Kernel kernel) {
+    using clock = std::chrono::steady_clock;
+    kernel();
+    double best = 1e30;
+    clock::time_point end = clock::now() + std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(seconds));
+    do {
+        clock::time_point start = clock::now();
+        kernel();
+        best = std::min(best, std::chrono::duration<double, std::milli>(clock::now() - start).count());
+    } while (clock::now() < end);
+    return best;
+}
+
+
+static void printHeader(const char* section) {
+    std::printf("\n%s\n", section);
+    std::printf("  %-24s %12s %12s %10s %10s %9s %11s\n", "kernel", "batch Mel/s", "loop Mel/s", "batch GF/s",
+                "loop GF/s", "speedup", "max error");
+}
+
+
+// flops counts one multiply-add as two operations, the way peak GFLOP/s figures do.
+static bool printRow(const char* kernel, unsigned int count, double flops, double batchMs, double loopMs,
+                     double error, double tolerance) {
+    double batchRate = count / (batchMs * 1e3), loopRate = count / (loopMs * 1e3);
+    std::printf("  %-24s %12.1f %12.1f %10.2f %10.2f %8.2fx %11.2e%s\n", kernel, batchRate, loopRate,
+                batchRate * flops * 1e-3, loopRate * flops * 1e-3, loopMs / batchMs, error,
+                error <= tolerance ? "" : "  FAILED");
+    return error <= tolerance;
+}
+
+
+static double relativeError(const glm::vec3& value, const glm::vec3& reference) {
+    glm::vec3 d = glm::abs(value - reference);
+    return std::max(std::max(d.x, d.y), d.z) / std::max(1.0f, glm::max(glm::max(std::abs(reference.x), std::abs(reference.y)), std::abs(reference.z)));
+}
+
+
+// One vec3 transform in its AoS and SoA forms, both against a loop over
+// reference, which is what the batch call replaces.
+template <typename Reference>
+static bool benchmarkTransform(const SimdBenchmarkOptions& options, const char* kernel, double flops,
+                               const std::vector<glm::vec3>& points, const std::vector<float>& x,
+                               const std::vector<float>& y, const std::vector<float>& z,
+                               void (*aos)(const glm::mat4&, const glm::vec3*, glm::vec3*, std::size_t),
+                               void (*soa)(const glm::mat4&, const float*, const float*, const float*,
+                                           float*, float*, float*, std::size_t),
+                               Reference reference, const glm::mat4& m) {
+    const unsigned int n = (unsigned int)points.size();
+    std::vector<glm::vec3> batch(n), loop(n);
+    std::vector<float> outX(n), outY(n), outZ(n);
+    double loopMs = bestTimeMs(options.seconds, [&] {
+        for (unsigned int i = 0; i < n; ++i)
+            loop[i] = reference(points[i]);
+    });
+    double aosMs = bestTimeMs(options.seconds, [&] { aos(m, points.data(), batch.data(), n); });
+    double soaMs = bestTimeMs(options.seconds, [&] {
+        soa(m, x.data(), y.data(), z.data(), outX.data(), outY.data(), outZ.data(), n);
+    });
+
+    double aosError = 0.0, soaError = 0.0;
+    for (unsigned int i = 0; i < n; ++i) {
+        aosError = std::max(aosError, relativeError(batch[i], loop[i]));
+        soaError = std::max(soaError, relativeError(glm::vec3(outX[i], outY[i], outZ[i]), loop[i]));
+    }
+    char name[32];
+    std::snprintf(name, sizeof(name), "%s AoS", kernel);
+    bool ok = printRow(name, n, flops, aosMs, loopMs, aosError, TRANSFORM_TOLERANCE);
+    std::snprintf(name, sizeof(name), "%s SoA", kernel);
+    return printRow(name, n, flops, soaMs, loopMs, soaError, TRANSFORM_TOLERANCE) && ok;
+}
+
+
+static bool benchmarkTransforms(const SimdBenchmarkOptions& options) {
+    const unsigned int n = options.points;
+    std::printf("\nglm/gtx/transform_batch.hpp, %u points, %s\n", n, glm::transformBatchIsa());
+    printHeader("Transforms (one mat4, relative error against operator*)");
+
+    // Points in front of a perspective camera, so the projective divide never
+    // comes near w = 0.
+    glm::mat4 m = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 100.0f)
+        * glm::lookAt(glm::vec3(0.0f, 2.0f, 30.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f))
+        * glm::rotate(glm::mat4(1.0f), 0.7f, glm::vec3(1.0f, 2.0f, 3.0f));
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> coordinate(-10.0f, 10.0f);
+    std::vector<glm::vec3> points(n);
+    std::vector<glm::vec4> vectors(n), batch(n), loop(n);
+    std::vector<float> x(n), y(n), z(n);
+    for (unsigned int i = 0; i < n; ++i) {
+        points[i] = glm::vec3(coordinate(random), coordinate(random), coordinate(random));
+        vectors[i] = glm::vec4(points[i], coordinate(random));
+        x[i] = points[i].x;
+        y[i] = points[i].y;
+        z[i] = points[i].z;
+    }
+
+    bool ok = true;
+    ok &= benchmarkTransform(options, "positions", 18.0, points, x, y, z, glm::transformPositions, glm::transformPositions,
+                             [m](const glm::vec3& p) { return glm::vec3(m * glm::vec4(p, 1.0f)); }, m);
+    ok &= benchmarkTransform(options, "directions", 15.0, points, x, y, z, glm::transformDirections, glm::transformDirections,
+                             [m](const glm::vec3& p) { return glm::vec3(m * glm::vec4(p, 0.0f)); }, m);
+    ok &= benchmarkTransform(options, "projective", 27.0, points, x, y, z, glm::transformProjective, glm::transformProjective,
+                             [m](const glm::vec3& p) { glm::vec4 r = m * glm::vec4(p, 1.0f); return glm::vec3(r) / r.w; }, m);
+
+    double loopMs = bestTimeMs(options.seconds, [&] {
+        for (unsigned int i = 0; i < n; ++i)
+            loop[i] = m * vectors[i];
+    });
+    double batchMs = bestTimeMs(options.seconds, [&] { glm::transformVectors(m, vectors.data(), batch.data(), n); });
+    double error = 0.0;
+    for (unsigned int i = 0; i < n; ++i) {
+        glm::vec4 d = glm::abs(batch[i] - loop[i]);
+        glm::vec4 a = glm::abs(loop[i]);
+        error = std::max(error, (double)glm::max(glm::max(d.x, d.y), glm::max(d.z, d.w))
+                         / std::max(1.0f, glm::max(glm::max(a.x, a.y), glm::max(a.z, a.w))));
+    }
+    ok &= printRow("vec4", n, 28.0, batchMs, loopMs, error, TRANSFORM_TOLERANCE);
+    return ok;
+}
+
+
+typedef glm::mat<4, 4, long double> ldmat4;
+typedef glm::vec<4, long double> ldvec4;
+
+
+static double relativeError(const glm::dvec4& value, const ldvec4& reference) {
+    long double error = 0.0L, scale = 1.0L;
+    for (int i = 0; i < 4; ++i) {
+        error = std::max(error, std::abs(value[i] - reference[i]));
+        scale = std::max(scale, std::abs(reference[i]));
+    }
+    return (double)(error / scale);
+}
+
+
+static double relativeError(const glm::dmat4& value, const ldmat4& reference) {
+    long double error = 0.0L, scale = 1.0L;
+    for (int c = 0; c < 4; ++c) {
+        for (int r = 0; r < 4; ++r) {
+            error = std::max(error, std::abs(value[c][r] - reference[c][r]));
+            scale = std::max(scale, std::abs(reference[c][r]));
+        }
+    }
+    return (double)(error / scale);
+}
+
+
+static const char* dmat4Isa() {
+#if GLM_ARCH & GLM_ARCH_AVX2_BIT
+    return "AVX2";
+#elif GLM_ARCH & GLM_ARCH_AVX_BIT
+    return "AVX";
+#else
+    return "scalar";
+#endif
+}
+
+
+static bool printDoubleRow(const char* kernel, unsigned int count, double ms, double error) {
+    std::printf("  %-24s %12.1f %11.2e%s\n", kernel, count / (ms * 1e3), error, error <= DMAT4_TOLERANCE ? "" : "  FAILED");
+    return error <= DMAT4_TOLERANCE;
+}
+
+
+// glm::dmat4 operators one matrix at a time, the way mesh preprocessing
+// calls them, against the same operations in long double.
+static bool benchmarkDoubleMatrices(const SimdBenchmarkOptions& options) {
+    const unsigned int n = std::max(1u, options.points / 16);
+    std::printf("\nglm::dmat4, %u matrices, %s\n", n, dmat4Isa());
+    std::printf("  %-24s %12s %11s\n", "kernel", "Mop/s", "max error");
+
+    // Diagonally dominant, so the inverse stays well conditioned.
+    std::mt19937 random(7);
+    std::uniform_real_distribution<double> element(-1.0, 1.0);
+    std::vector<glm::dmat4> a(n), b(n), result(n);
+    std::vector<glm::dvec4> v(n), vectors(n);
+    std::vector<double> determinants(n);
+    for (unsigned int i = 0; i < n; ++i) {
+        for (int c = 0; c < 4; ++c) {
+            for (int r = 0; r < 4; ++r) {
+                a[i][c][r] = element(random) + (c == r ? 4.0 : 0.0);
+                b[i][c][r] = element(random);
+            }
+            v[i][c] = element(random) * 10.0;
+        }
+    }
+
+    bool ok = true;
+    double error = 0.0;
+    double ms = bestTimeMs(options.seconds, [&] {
+        for (unsigned int i = 0; i < n; ++i)
+            result[i] = a[i] * b[i];
+    });
+    for (unsigned int i = 0; i < n; ++i)
+        error = std::max(error, relativeError(result[i], ldmat4(a[i]) * ldmat4(b[i])));
+    ok &= printDoubleRow("dmat4 * dmat4", n, ms, error);
+
+    error = 0.0;
+    ms = bestTimeMs(options.seconds, [&] {
+        for (unsigned int i = 0; i < n; ++i)
+            vectors[i] = a[i] * v[i];
+    });
+    for (unsigned int i = 0; i < n; ++i)
+        error = std::max(error, relativeError(vectors[i], ldmat4(a[i]) * ldvec4(v[i])));
+    ok &= printDoubleRow("dmat4 * dvec4", n, ms, error);
+
+    error = 0.0;
+    ms = bestTimeMs(options.seconds, [&] {
+        for (unsigned int i = 0; i < n; ++i)
+            result[i] = glm::transpose(a[i]);
+    });
+    for (unsigned int i = 0; i < n; ++i)
+        error = std::max(error, relativeError(result[i], glm::transpose(ldmat4(a[i]))));
+    ok &= printDoubleRow("transpose", n, ms, error);
+
+    error = 0.0;
+    ms = bestTimeMs(options.seconds, [&] {
+        for (unsigned int i = 0; i < n; ++i)
+            determinants[i] = glm::determinant(a[i]);
+    });
+    for (unsigned int i = 0; i < n; ++i) {
+        long double reference = glm::determinant(ldmat4(a[i]));
+        error = std::max(error, (double)(std::abs(determinants[i] - reference) / std::max(1.0L, std::abs(reference))));
+    }
+    ok &= printDoubleRow("determinant", n, ms, error);
+
+    error = 0.0;
+    ms = bestTimeMs(options.seconds, [&] {
+        for (unsigned int i = 0; i < n; ++i)
+            result[i] = glm::inverse(a[i]);
+    });
+    for (unsigned int i = 0; i < n; ++i)
+        error = std::max(error, relativeError(result[i], glm::inverse(ldmat4(a[i]))));
+    ok &= printDoubleRow("inverse", n, ms, error);
+    return ok;
+}
+
+
+// Zeros, infinities and NaNs must match the reference exactly.
+static double relativeError(float value, double reference) {
+    float rounded = (float)reference;
+    if (std::isnan(reference))
+        return std::isnan(value) ? 0.0 : HUGE_VAL;
+    if (std::isinf(rounded))
+        return value == rounded ? 0.0 : HUGE_VAL;
+    if (!std::isfinite(value))
+        return HUGE_VAL;
+    return std::abs(value - reference) / std::max(std::abs(reference), (double)FLT_MIN);
+}
+
+
+static bool printExponentialRow(const char* kernel, unsigned int count, double batchMs, double loopMs, double error,
+                                double tolerance) {
+    std::printf("  %-24s %12.1f %12.1f %8.2fx %11.2e%s\n", kernel, count / (batchMs * 1e3), count / (loopMs * 1e3),
+                loopMs / batchMs, error, error <= tolerance ? "" : "  FAILED");
+    return error <= tolerance;
+}
+
+
+// One span function in both accuracy tiers, against a loop over the float
+// std:: function for time and a double one for error.
+template <typename Batch, typename LowpBatch, typename Loop, typename Reference>
+static bool benchmarkExponentialKernel(const SimdBenchmarkOptions& options, const char* kernel,
+                                       const std::vector<float>& in, Batch batch, LowpBatch lowpBatch, Loop loop,
+                                       Reference reference) {
+    const unsigned int n = (unsigned int)in.size();
+    std::vector<float> out(n), lowpOut(n), loopOut(n);
+    double loopMs = bestTimeMs(options.seconds, [&] {
+        for (unsigned int i = 0; i < n; ++i)
+            loopOut[i] = loop(in[i]);
+    });
+    double batchMs = bestTimeMs(options.seconds, [&] { batch(in.data(), out.data(), n); });
+    double lowpMs = bestTimeMs(options.seconds, [&] { lowpBatch(in.data(), lowpOut.data(), n); });
+
+    double error = 0.0, lowpError = 0.0;
+    for (unsigned int i = 0; i < n; ++i) {
+        double r = reference((double)in[i]);
+        error = std::max(error, relativeError(out[i], r));
+        lowpError = std::max(lowpError, relativeError(lowpOut[i], r));
+    }
+    bool ok = printExponentialRow(kernel, n, batchMs, loopMs, error, EXPONENTIAL_TOLERANCE);
+    char name[32];
+    std::snprintf(name, sizeof(name), "%s lowp", kernel);
+    return printExponentialRow(name, n, lowpMs, loopMs, lowpError, EXPONENTIAL_LOWP_TOLERANCE) && ok;
+}
+
+
+// Inputs cover every finite result: exp and exp2 from the first subnormal to
+// the last finite float, log and log2 over every positive float bit pattern,
+// pow with exponents chosen so that log2 of the result spans the same range.
+// A few zeros, infinities, NaNs and negative bases go in too.
+static bool benchmarkExponential(const SimdBenchmarkOptions& options) {
+    const unsigned int n = options.points;
+    std::printf("\nglm/gtx/exponential_batch.hpp, %u values, %s, against libm\n", n, glm::exponentialBatchIsa());
+    std::printf("  %-24s %12s %12s %9s %11s\n", "kernel", "batch Mel/s", "loop Mel/s", "speedup", "max error");
+
+    const float specials[] = {0.0f, -0.0f, 1.0f, -1.0f, -2.5f, INFINITY, -INFINITY, NAN};
+    const unsigned int specialCount = (unsigned int)(sizeof(specials) / sizeof(specials[0]));
+    std::mt19937 random(13);
+    std::uniform_real_distribution<float> expRange(-103.9f, 88.7f), exp2Range(-149.9f, 127.9f);
+    std::uniform_int_distribution<unsigned int> positiveBits(1u, 0x7f7fffffu);
+    std::vector<float> expIn(n), exp2In(n), logIn(n), base(n), exponent(n);
+    for (unsigned int i = 0; i < n; ++i) {
+        expIn[i] = expRange(random);
+        exp2In[i] = exp2Range(random);
+        unsigned int bits = positiveBits(random);
+        std::memcpy(&logIn[i], &bits, sizeof(bits));
+        bits = positiveBits(random);
+        std::memcpy(&base[i], &bits, sizeof(bits));
+        float log2Base = std::log2(base[i]);
+        exponent[i] = log2Base != 0.0f ? exp2Range(random) / log2Base : exp2Range(random);
+    }
+    for (unsigned int i = 0; i < specialCount * specialCount && i < n; ++i) {
+        expIn[i] = exp2In[i] = logIn[i] = specials[i % specialCount];
+        base[i] = specials[i % specialCount];
+        exponent[i] = specials[i / specialCount];
+    }
+
+    bool ok = benchmarkExponentialKernel(options, "exp", expIn,
+        [](const float* in, float* out, std::size_t count) { glm::expBatch(in, out, count); },
+        [](const float* in, float* out, std::size_t count) { glm::expBatch<glm::lowp>(in, out, count); },
+        [](float x) { return std::exp(x); }, [](double x) { return std::exp(x); });
+    ok &= benchmarkExponentialKernel(options, "exp2", exp2In,
+        [](const float* in, float* out, std::size_t count) { glm::exp2Batch(in, out, count); },
+        [](const float* in, float* out, std::size_t count) { glm::exp2Batch<glm::lowp>(in, out, count); },
+        [](float x) { return std::exp2(x); }, [](double x) { return std::exp2(x); });
+    ok &= benchmarkExponentialKernel(options, "log", logIn,
+        [](const float* in, float* out, std::size_t count) { glm::logBatch(in, out, count); },
+        [](const float* in, float* out, std::size_t count) { glm::logBatch<glm::lowp>(in, out, count); },
+        [](float x) { return std::log(x); }, [](double x) { return std::log(x); });
+    ok &= benchmarkExponentialKernel(options, "log2", logIn,
+        [](const float* in, float* out, std::size_t count) { glm::log2Batch(in, out, count); },
+        [](const float* in, float* out, std::size_t count) { glm::log2Batch<glm::lowp>(in, out, count); },
+        [](float x) { return std::log2(x); }, [](double x) { return std::log2(x); });
+
+    // pow: the lowp tier rounds log2 of the result to about 1e-5 absolute,
+    // which is more than 1e-4 relative once the result is a subnormal or
+    // within a few ULPs of overflow, so those are left out of its error.
+    std::vector<float> out(n), lowpOut(n), loopOut(n);
+    double loopMs = bestTimeMs(options.seconds, [&] {
+        for (unsigned int i = 0; i < n; ++i)
+            loopOut[i] = std::pow(base[i], exponent[i]);
+    });
+    double batchMs = bestTimeMs(options.seconds, [&] { glm::powBatch(base.data(), exponent.data(), out.data(), n); });
+    double lowpMs = bestTimeMs(options.seconds, [&] {
+        glm::powBatch<glm::lowp>(base.data(), exponent.data(), lowpOut.data(), n);
+    });
+    double error = 0.0, lowpError = 0.0;
+    for (unsigned int i = 0; i < n; ++i) {
+        double r = std::pow((double)base[i], (double)exponent[i]);
+        error = std::max(error, relativeError(out[i], r));
+        if (!std::isfinite(r) || r == 0.0 || (std::abs(r) >= FLT_MIN && std::abs(r) <= FLT_MAX * 0.999))
+            lowpError = std::max(lowpError, relativeError(lowpOut[i], r));
+    }
+    ok &= printExponentialRow("pow", n, batchMs, loopMs, error, EXPONENTIAL_TOLERANCE);
+    ok &= printExponentialRow("pow lowp", n, lowpMs, loopMs, lowpError, EXPONENTIAL_LOWP_TOLERANCE);
+
+    // glm::exp on vec4 goes through the same polynomial, four lanes at a time.
+    std::vector<glm::vec4> vectors(n / 4 + 1), vectorsOut(vectors.size());
+    for (std::size_t i = 0; i < vectors.size(); ++i)
+        vectors[i] = glm::vec4(expRange(random), expRange(random), expRange(random), expRange(random));
+    const unsigned int lanes = (unsigned int)vectors.size() * 4;
+    double vectorMs = bestTimeMs(options.seconds, [&] {
+        for (std::size_t i = 0; i < vectors.size(); ++i)
+            vectorsOut[i] = glm::exp(vectors[i]);
+    });
+    double vectorLoopMs = bestTimeMs(options.seconds, [&] {
+        for (std::size_t i = 0; i < vectors.size(); ++i)
+            vectorsOut[i] = glm::vec4(std::exp(vectors[i].x), std::exp(vectors[i].y), std::exp(vectors[i].z),
+                                      std::exp(vectors[i].w));
+    });
+    for (std::size_t i = 0; i < vectors.size(); ++i)
+        vectorsOut[i] = glm::exp(vectors[i]);
+    error = 0.0;
+    for (std::size_t i = 0; i < vectors.size(); ++i)
+        for (int c = 0; c < 4; ++c)
+            error = std::max(error, relativeError(vectorsOut[i][c], std::exp((double)vectors[i][c])));
+    ok &= printExponentialRow("glm::exp(vec4)", lanes, vectorMs, vectorLoopMs, error, EXPONENTIAL_TOLERANCE);
+    return ok;
+}
+
+
+static bool printHalfRow(const char* kernel, unsigned int count, double spanMs, double loopMs, unsigned int mismatches) {
+    std::printf("  %-24s %12.1f %12.1f %8.2fx %11u%s\n", kernel, count / (spanMs * 1e3), count / (loopMs * 1e3),
+                loopMs / spanMs, mismatches, mismatches == 0 ? "" : "  FAILED");
+    return mismatches == 0;
+}
+
+
+// Half-float spans against loops over packHalf1x16 and unpackHalf1x16.
+// Timing uses vertex-like values; the bit-exact check packs random bit
+// patterns, NaNs and denormals included, and unpacks every half.
+static bool benchmarkHalf(const SimdBenchmarkOptions& options) {
+    const unsigned int n = options.points;
+    std::printf("\nglm/gtc/packing.hpp half spans, %u values, %s\n", n, glm::packHalfIsa());
+    std::printf("  %-24s %12s %12s %9s %11s\n", "kernel", "span Mconv/s", "loop Mconv/s", "speedup", "mismatches");
+
+    std::mt19937 random(17);
+    std::uniform_real_distribution<float> coordinate(-100.0f, 100.0f);
+    std::uniform_int_distribution<unsigned int> anyBits;
+    std::vector<float> values(n), patterns(n), unpacked(n), reference(n);
+    std::vector<glm::uint16> halves(n), referenceHalves(n);
+    for (unsigned int i = 0; i < n; ++i) {
+        values[i] = coordinate(random);
+        unsigned int bits = anyBits(random);
+        std::memcpy(&patterns[i], &bits, sizeof(bits));
+    }
+
+    double loopMs = bestTimeMs(options.seconds, [&] {
+        for (unsigned int i = 0; i < n; ++i)
+            referenceHalves[i] = glm::packHalf1x16(values[i]);
+    });
+    double spanMs = bestTimeMs(options.seconds, [&] { glm::packHalf(values.data(), halves.data(), n); });
+    unsigned int mismatches = 0;
+    glm::packHalf(patterns.data(), halves.data(), n);
+    for (unsigned int i = 0; i < n; ++i)
+        mismatches += halves[i] != glm::packHalf1x16(patterns[i]);
+    bool ok = printHalfRow("pack", n, spanMs, loopMs, mismatches);
+
+    glm::packHalf(values.data(), halves.data(), n);
+    loopMs = bestTimeMs(options.seconds, [&] {
+        for (unsigned int i = 0; i < n; ++i)
+            reference[i] = glm::unpackHalf1x16(halves[i]);
+    });
+    spanMs = bestTimeMs(options.seconds, [&] { glm::unpackHalf(halves.data(), unpacked.data(), n); });
+    std::vector<glm::uint16> every(1 << 16);
+    std::vector<float> everyOut(every.size());
+    for (std::size_t i = 0; i < every.size(); ++i)
+        every[i] = (glm::uint16)i;
+    glm::unpackHalf(every.data(), everyOut.data(), every.size());
+    mismatches = 0;
+    for (std::size_t i = 0; i < every.size(); ++i) {
+        float expected = glm::unpackHalf1x16(every[i]);
+        mismatches += std::memcmp(&everyOut[i], &expected, sizeof(float)) != 0;
+    }
+    return printHalfRow("unpack", n, spanMs, loopMs, mismatches) && ok;
+}
+
+
+// Values further than SPANS_TOLERANCE from the reference, relative to
+// magnitudes above one; zeros of either sign count as equal.
+static unsigned int noiseMismatches(const std::vector<float>& values, const std::vector<float>& reference, double& maxError) {
+    unsigned int mismatches = 0;
+    maxError = 0.0;
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        double error = std::abs(values[i] - reference[i]) / std::max(1.0f, std::abs(reference[i]));
+        mismatches += !(error <= SPANS_TOLERANCE);
+        maxError = std::max(maxError, error);
+    }
+    return mismatches;
+}
+
+
+static bool noiseAgrees(unsigned int mismatches, double maxError, unsigned int count) {
+    unsigned int outliers = (count + NOISE_OUTLIER_SHARE - 1) / NOISE_OUTLIER_SHARE;
+    return mismatches == 0 || (!SPANS_EXACT && mismatches <= outliers && maxError <= NOISE_OUTLIER_TOLERANCE);
+}
+
+
+static bool printNoiseRow(const char* kernel, unsigned int count, double spanMs, double loopMs,
+                          const std::vector<float>& values, const std::vector<float>& reference) {
+    double maxError;
+    unsigned int mismatches = noiseMismatches(values, reference, maxError);
+    bool ok = noiseAgrees(mismatches, maxError, count);
+    std::printf("  %-24s %12.1f %12.1f %8.2fx %11u %11.2e%s\n", kernel, count / (spanMs * 1e3),
+                count / (loopMs * 1e3), loopMs / spanMs, mismatches, maxError, ok ? "" : "  FAILED");
+    return ok;
+}
+
+
+// Noise spans over random points and grids over a volume, against loops over
+// glm::perlin and glm::simplex. The last row fills the volume from every
+// thread of a job pool, a band of slices per job, through the dispatched
+// kernels.
+static bool benchmarkNoise(const SimdBenchmarkOptions& options) {
+    const unsigned int side = 64, depth = std::max(1u, options.points / (side * side)), n = side * side * depth;
+    std::printf("\nglm/gtc/noise.hpp, %u points, %ux%ux%u grid, %s%s\n", n, side, side, depth, glm::noiseIsa(), SPANS_NOTE);
+    std::printf("  %-24s %12s %12s %9s %11s %11s\n", "kernel", "span Msmp/s", "loop Msmp/s", "speedup", "mismatches",
+                "max error");
+
+    std::mt19937 random(23);
+    std::uniform_real_distribution<float> coordinate(-64.0f, 64.0f);
+    std::vector<float> x(n), y(n), z(n), out(n), reference(n);
+    for (unsigned int i = 0; i < n; ++i) {
+        x[i] = coordinate(random);
+        y[i] = coordinate(random);
+        z[i] = coordinate(random);
+    }
+
+    bool ok = true;
+    double loopMs = bestTimeMs(options.seconds, [&] {
+        for (unsigned int i = 0; i < n; ++i)
+            reference[i] = glm::perlin(glm::vec2(x[i], y[i]));
+    });
+    double spanMs = bestTimeMs(options.seconds, [&] { glm::perlin(x.data(), y.data(), out.data(), n); });
+    ok &= printNoiseRow("perlin 2D", n, spanMs, loopMs, out, reference);
+
+    loopMs = bestTimeMs(options.seconds, [&] {
+        for (unsigned int i = 0; i < n; ++i)
+            reference[i] = glm::perlin(glm::vec3(x[i], y[i], z[i]));
+    });
+    spanMs = bestTimeMs(options.seconds, [&] { glm::perlin(x.data(), y.data(), z.data(), out.data(), n); });
+    ok &= printNoiseRow("perlin 3D", n, spanMs, loopMs, out, reference);
+
+    loopMs = bestTimeMs(options.seconds, [&] {
+        for (unsigned int i = 0; i < n; ++i)
+            reference[i] = glm::simplex(glm::vec2(x[i], y[i]));
+    });
+    spanMs = bestTimeMs(options.seconds, [&] { glm::simplex(x.data(), y.data(), out.data(), n); });
+    ok &= printNoiseRow("simplex 2D", n, spanMs, loopMs, out, reference);
+
+    loopMs = bestTimeMs(options.seconds, [&] {
+        for (unsigned int i = 0; i < n; ++i)
+            reference[i] = glm::simplex(glm::vec3(x[i], y[i], z[i]));
+    });
+    spanMs = bestTimeMs(options.seconds, [&] { glm::simplex(x.data(), y.data(), z.data(), out.data(), n); });
+    ok &= printNoiseRow("simplex 3D", n, spanMs, loopMs, out, reference);
+
+    const glm::vec3 origin(-7.3f, 2.1f, 0.4f), step(0.173f, 0.173f, 0.25f);
+    const glm::uvec3 size(side, side, depth);
+    auto gridLoop = [&](bool simplex) {
+        for (unsigned int k = 0; k < depth; ++k)
+            for (unsigned int j = 0; j < side; ++j)
+                for (unsigned int i = 0; i < side; ++i) {
+                    glm::vec3 p = origin + step * glm::vec3((float)i, (float)j, (float)k);
+                    reference[(k * side + j) * side + i] = simplex ? glm::simplex(p) : glm::perlin(p);
+                }
+    };
+    loopMs = bestTimeMs(options.seconds, [&] { gridLoop(false); });
+    spanMs = bestTimeMs(options.seconds, [&] { glm::perlinGrid(origin, step, glm::uvec3(0), size, out.data()); });
+    ok &= printNoiseRow("perlin 3D grid", n, spanMs, loopMs, out, reference);
+    double perlinLoopMs = loopMs;
+
+    loopMs = bestTimeMs(options.seconds, [&] { gridLoop(true); });
+    spanMs = bestTimeMs(options.seconds, [&] { glm::simplexGrid(origin, step, glm::uvec3(0), size, out.data()); });
+    ok &= printNoiseRow("simplex 3D grid", n, spanMs, loopMs, out, reference);
+
+    // Slices depend only on their index in the whole grid, so any split
+    // gives the single-threaded values.
+    gridLoop(false);
+    WorkerPool pool;
+    createWorkerPool(pool, defaultWorkerCount());
+    spanMs = bestTimeMs(options.seconds, [&] {
+        parallelFor(pool, depth, 1, [&](unsigned int k) {
+            glm::dispatchPerlinGrid(origin, step, glm::uvec3(0, 0, k), glm::uvec3(side, side, 1),
+                                    out.data() + (std::size_t)k * side * side);
+        });
+    });
+    destroyWorkerPool(pool);
+    char name[40];
+    std::snprintf(name, sizeof(name), "perlin 3D grid, %u thr", (unsigned int)pool.threads.size() + 1);
+    ok &= printNoiseRow(name, n, spanMs, perlinLoopMs, out, reference);
+    return ok;
+}
+
+
+static bool printRandomRow(const char* kernel, unsigned int count, double spanMs, double loopMs, unsigned int mismatches,
+                           bool inRange) {
+    bool ok = mismatches == 0 && inRange;
+    std::printf("  %-24s %12.1f %12.1f %8.2fx %11u%s\n", kernel, count / (spanMs * 1e3), count / (loopMs * 1e3),
+                loopMs / spanMs, mismatches, ok ? "" : "  FAILED");
+    return ok;
+}
+
+
+static unsigned int pointMismatches(const std::vector<glm::vec3>& values, const std::vector<glm::vec3>& reference) {
+    unsigned int mismatches = 0;
+    for (std::size_t i = 0; i < values.size(); ++i)
+        mismatches += !(relativeError(values[i], reference[i]) <= SPANS_TOLERANCE);
+    return mismatches;
+}
+
+
+// glm/gtc/random.hpp spans against loops over the per-value functions, which
+// draw from the calling thread's stream; the scalar dispatch level gives the
+// reference values. The last row fills the ball span on the job pool, each
+// job moving a copy of the stream to its first block.
+static bool benchmarkRandom(const SimdBenchmarkOptions& options) {
+    const unsigned int n = options.points;
+    std::printf("\nglm/gtc/random.hpp, %u values, %s%s\n", n, glm::randIsa(), SPANS_NOTE);
+    std::printf("  %-24s %12s %12s %9s %11s\n", "kernel", "span Mval/s", "loop Mval/s", "speedup", "mismatches");
+
+    const glm::rand_stream stream(2024, 1);
+    std::vector<float> values(n), reference(n);
+    std::vector<glm::vec3> points(n), pointsReference(n);
+    glm::randSeed(7);
+    auto spanMs = [&](auto span) {
+        return bestTimeMs(options.seconds, [&] {
+            glm::rand_stream copy = stream;
+            span(copy);
+        });
+    };
+    auto scalarReference = [&](auto span) {
+        glm::rand_stream copy = stream;
+        glm::simdDispatchSelect(glm::simd_scalar);
+        span(copy);
+        glm::simdDispatchSelect(glm::simdSupportedIsa());
+    };
+
+    bool ok = true;
+    double maxError;
+    double loopMs = bestTimeMs(options.seconds, [&] {
+        for (unsigned int i = 0; i < n; ++i)
+            values[i] = glm::linearRand(-5.0f, 5.0f);
+    });
+    scalarReference([&](glm::rand_stream& s) { glm::dispatchLinearRand(s, -5.0f, 5.0f, reference.data(), n); });
+    double ms = spanMs([&](glm::rand_stream& s) { glm::linearRand(s, -5.0f, 5.0f, values.data(), n); });
+    auto range = std::minmax_element(values.begin(), values.end());
+    ok &= printRandomRow("linearRand", n, ms, loopMs, noiseMismatches(values, reference, maxError),
+                         *range.first >= -5.0f && *range.second < 5.0f);
+
+    loopMs = bestTimeMs(options.seconds, [&] {
+        for (unsigned int i = 0; i < n; ++i)
+            values[i] = glm::gaussRand(1.0f, 1.0f);
+    });
+    scalarReference([&](glm::rand_stream& s) { glm::dispatchGaussRand(s, 1.0f, 2.0f, reference.data(), n); });
+    ms = spanMs([&](glm::rand_stream& s) { glm::gaussRand(s, 1.0f, 2.0f, values.data(), n); });
+    double mean = 0.0, variance = 0.0;
+    for (float value : values)
+        mean += value;
+    mean /= n;
+    for (float value : values)
+        variance += (value - mean) * (value - mean);
+    // Deviation 2 means a standard deviation of 4, as for the per-value call.
+    double deviation = std::sqrt(variance / n);
+    ok &= printRandomRow("gaussRand", n, ms, loopMs, noiseMismatches(values, reference, maxError),
+                         std::abs(mean - 1.0) < 4.0 * GAUSS_TOLERANCE && std::abs(deviation - 4.0) < 4.0 * GAUSS_TOLERANCE);
+
+    loopMs = bestTimeMs(options.seconds, [&] {
+        for (unsigned int i = 0; i < n; ++i)
+            points[i] = glm::sphericalRand(3.0f);
+    });
+    scalarReference([&](glm::rand_stream& s) { glm::dispatchSphericalRand(s, 3.0f, pointsReference.data(), n); });
+    ms = spanMs([&](glm::rand_stream& s) { glm::sphericalRand(s, 3.0f, points.data(), n); });
+    bool inRange = true;
+    for (const glm::vec3& point : points)
+        inRange &= std::abs(glm::length(point) - 3.0f) < 3.0f * TRANSFORM_TOLERANCE;
+    ok &= printRandomRow("sphericalRand", n, ms, loopMs, pointMismatches(points, pointsReference), inRange);
+
+    loopMs = bestTimeMs(options.seconds, [&] {
+        for (unsigned int i = 0; i < n; ++i)
+            points[i] = glm::ballRand(3.0f);
+    });
+    scalarReference([&](glm::rand_stream& s) { glm::dispatchBallRand(s, 3.0f, pointsReference.data(), n); });
+    ms = spanMs([&](glm::rand_stream& s) { glm::ballRand(s, 3.0f, points.data(), n); });
+    inRange = true;
+    for (const glm::vec3& point : points)
+        inRange &= glm::length(point) <= 3.0f * (1.0f + TRANSFORM_TOLERANCE);
+    ok &= printRandomRow("ballRand", n, ms, loopMs, pointMismatches(points, pointsReference), inRange);
+
+    // One block per ball point, so job k starts at block k * grain.
+    const unsigned int grain = 4096, jobs = (n + grain - 1) / grain;
+    WorkerPool pool;
+    createWorkerPool(pool, defaultWorkerCount());
+    std::vector<glm::vec3> single = points;
+    ms = bestTimeMs(options.seconds, [&] {
+        parallelFor(pool, jobs, 1, [&](unsigned int k) {
+            glm::rand_stream copy = stream;
+            copy.seek(stream.block + (glm::uint64)k * grain);
+            glm::dispatchBallRand(copy, 3.0f, points.data() + (std::size_t)k * grain, std::min(grain, n - k * grain));
+        });
+    });
+    destroyWorkerPool(pool);
+    char name[40];
+    std::snprintf(name, sizeof(name), "ballRand, %u thr", (unsigned int)pool.threads.size() + 1);
+    ok &= printRandomRow(name, n, ms, loopMs, pointMismatches(points, single), true);
+    return ok;
+}
+
+
+static bool printLayoutRow(const char* layout, double ms, double shuffledMs, double sortMs, bool same) {
+    char sort[16] = "";
+    if (sortMs > 0.0)
+        std::snprintf(sort, sizeof(sort), "%.2f", sortMs);
+    std::printf("  %-24s %10.2f %9.2fx %10s%s\n", layout, ms, shuffledMs / ms, sort, same ? "" : "  FAILED");
+    return same;
+}
+
+
+static void fillSphereBatch(const Scene& scene, SphereBatch& spheres) {
+    resizeSphereBatch(spheres, scene.instances.size());
+    for (size_t i = 0; i < scene.instances.size(); ++i) {
+        const SceneInstance& instance = scene.instances[i];
+        spheres.x[i] = instance.position.x;
+        spheres.y[i] = instance.position.y;
+        spheres.z[i] = instance.position.z;
+        spheres.radius[i] = scene.boundingRadius * instance.scale;
+    }
+}
+
+
+// Vertices renumbered and triangles reordered at random, each keeping its
+// winding: what an imported or procedurally merged mesh tends to look like.
+static void shuffleMesh(Mesh& mesh, std::mt19937& random) {
+    size_t count = mesh.vertices.size() / 3, triangles = mesh.indices.size() / 3;
+    std::vector<unsigned int> order(count), remap(count);
+    for (size_t i = 0; i < count; ++i)
+        order[i] = (unsigned int)i;
+    std::shuffle(order.begin(), order.end(), random);
+    std::vector<float> vertices(mesh.vertices.size());
+    for (size_t k = 0; k < count; ++k) {
+        std::copy_n(&mesh.vertices[3 * (size_t)order[k]], 3, &vertices[3 * k]);
+        remap[order[k]] = (unsigned int)k;
+    }
+    mesh.vertices.swap(vertices);
+
+    std::vector<unsigned int> triangleOrder(triangles), indices(mesh.indices.size());
+    for (size_t t = 0; t < triangles; ++t)
+        triangleOrder[t] = (unsigned int)t;
+    std::shuffle(triangleOrder.begin(), triangleOrder.end(), random);
+    for (size_t t = 0; t < triangles; ++t) {
+        for (int corner = 0; corner < 3; ++corner)
+            indices[3 * t + corner] = remap[mesh.indices[3 * (size_t)triangleOrder[t] + corner]];
+    }
+    mesh.indices.swap(indices);
+}
+
+
+// glm/gtc/bitfield.hpp Morton spans against loops over the per-cell
+// bitfieldInterleave, then the morton_order.h layouts on the same frame work
+// with the data in generation order, shuffled, and shuffled then Morton
+// sorted. Speedups are against the shuffled layout; sort ms is what putting
+// it in Morton order cost. The lattice frame culls every instance and builds
+// the model matrices of the visible ones; the torus frame fetches and
+// projects every triangle's corners through the index buffer and counts the
+// front-facing ones. Both results must not depend on the layout.
+static bool benchmarkMorton(const SimdBenchmarkOptions& options) {
+    const unsigned int n = options.points;
+    std::printf("\nglm/gtc/bitfield.hpp Morton codes, %u values, %s\n", n, glm::bitfieldIsa());
+    std::printf("  %-24s %12s %12s %9s %11s\n", "kernel", "span Mval/s", "loop Mval/s", "speedup", "mismatches");
+
+    std::mt19937 random(19);
+    std::uniform_int_distribution<glm::uint32> cell(0, (1u << 21) - 1);
+    std::vector<glm::u32vec3> cells(n), cellsBack(n);
+    std::vector<glm::uint64> codes(n), reference(n);
+    for (unsigned int i = 0; i < n; ++i)
+        cells[i] = glm::u32vec3(cell(random), cell(random), cell(random));
+
+    bool ok = true;
+    double loopMs = bestTimeMs(options.seconds, [&] {
+        for (unsigned int i = 0; i < n; ++i)
+            reference[i] = glm::bitfieldInterleave(cells[i].x, cells[i].y, cells[i].z);
+    });
+    double ms = bestTimeMs(options.seconds, [&] { glm::bitfieldInterleave(cells.data(), codes.data(), n); });
+    unsigned int mismatches = 0;
+    for (unsigned int i = 0; i < n; ++i)
+        mismatches += codes[i] != reference[i];
+    ok &= printRandomRow("interleave 3D", n, ms, loopMs, mismatches, true);
+
+    // There is no per-code 3D deinterleave to loop over: the scalar dispatch
+    // level runs the shifts the spans replace.
+    glm::simdDispatchSelect(glm::simd_scalar);
+    loopMs = bestTimeMs(options.seconds, [&] { glm::dispatchBitfieldDeinterleave(reference.data(), cellsBack.data(), n); });
+    glm::simdDispatchSelect(glm::simdSupportedIsa());
+    ms = bestTimeMs(options.seconds, [&] { glm::bitfieldDeinterleave(reference.data(), cellsBack.data(), n); });
+    mismatches = 0;
+    for (unsigned int i = 0; i < n; ++i)
+        mismatches += cellsBack[i] != cells[i];
+    ok &= printRandomRow("deinterleave 3D", n, ms, loopMs, mismatches, true);
+
+    const unsigned int side = 100;
+    Scene grid = buildLatticeScene(side, 4.0f);
+    Scene shuffled = grid;
+    std::shuffle(shuffled.instances.begin(), shuffled.instances.end(), random);
+    Scene sorted = shuffled;
+    double instanceSortMs = bestTimeMs(options.seconds, [&] {
+        sorted.instances = shuffled.instances;
+        mortonSortInstances(sorted);
+    });
+
+    // A narrow view down the lattice keeps about a tenth of it.
+    glm::mat4 projection = glm::perspective(glm::radians(30.0f), 4.0f / 3.0f, 0.1f, 1000.0f);
+    glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 0.0f, 20.0f), glm::vec3(0.0f, 0.0f, -400.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    Frustum frustum = extractFrustum(projection * view);
+    glm::mat4 rotation = glm::rotate(glm::mat4(1.0f), 0.7f, glm::vec3(0.3f, 1.0f, 0.2f));
+    std::vector<unsigned int> visible(grid.instances.size());
+    std::vector<glm::mat4> instanceModels(grid.instances.size()), drawModels(grid.instances.size());
+    SphereBatch spheres;
+    size_t visibleCount = 0;
+    // As in the windowed lattice frame: the model matrices are kept per
+    // instance and the visible ones gathered for the draws.
+    auto latticeMs = [&](const Scene& scene) {
+        fillSphereBatch(scene, spheres);
+        for (size_t i = 0; i < scene.instances.size(); ++i)
+            instanceModels[i] = instanceModel(scene.instances[i], rotation);
+        return bestTimeMs(options.seconds, [&] {
+            visibleCount = cullSpheres(frustum, spheres, visible.data());
+            for (size_t v = 0; v < visibleCount; ++v)
+                drawModels[v] = instanceModels[visible[v]];
+        });
+    };
+    double gridMs = latticeMs(grid);
+    size_t gridVisible = visibleCount;
+    double shuffledMs = latticeMs(shuffled);
+    size_t shuffledVisible = visibleCount;
+    double sortedMs = latticeMs(sorted);
+    std::printf("\nmorton_order.h, %u^3 lattice, %zu of %zu instances visible; torus, ", side, gridVisible,
+                grid.instances.size());
+
+    Torus torus = generateTorus(0.3f, 0.8f, 1024, 1024);
+    Mesh generated = { torus.vertices, torus.indices };
+    Mesh shuffledMesh = generated;
+    shuffleMesh(shuffledMesh, random);
+    Mesh sortedMesh = shuffledMesh;
+    double meshSortMs = bestTimeMs(options.seconds, [&] {
+        sortedMesh = shuffledMesh;
+        mortonSortVertices(sortedMesh);
+        mortonSortTriangles(sortedMesh);
+    });
+    std::printf("%zu vertices, %zu triangles\n", generated.vertices.size() / 3, generated.indices.size() / 3);
+    std::printf("  %-24s %10s %10s %10s\n", "layout", "frame ms", "speedup", "sort ms");
+    ok &= printLayoutRow("lattice, grid", gridMs, shuffledMs, 0.0, true);
+    ok &= printLayoutRow("lattice, shuffled", shuffledMs, shuffledMs, 0.0, shuffledVisible == gridVisible);
+    ok &= printLayoutRow("lattice, Morton", sortedMs, shuffledMs, instanceSortMs, visibleCount == gridVisible);
+
+    glm::mat4 viewProjection = glm::perspective(glm::radians(60.0f), 4.0f / 3.0f, 0.1f, 100.0f)
+        * glm::lookAt(glm::vec3(0.0f, 1.5f, 2.5f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    size_t frontFacing = 0;
+    auto meshMs = [&](const Mesh& mesh) {
+        return bestTimeMs(options.seconds, [&] {
+            frontFacing = 0;
+            for (size_t t = 0; t + 3 <= mesh.indices.size(); t += 3) {
+                glm::vec2 corners[3];
+                for (int corner = 0; corner < 3; ++corner) {
+                    const float* p = &mesh.vertices[3 * (size_t)mesh.indices[t + corner]];
+                    glm::vec4 clip = viewProjection * glm::vec4(p[0], p[1], p[2], 1.0f);
+                    corners[corner] = glm::vec2(clip) / clip.w;
+                }
+                glm::vec2 u = corners[1] - corners[0], v = corners[2] - corners[0];
+                frontFacing += u.x * v.y - u.y * v.x > 0.0f;
+            }
+        });
+    };
+    gridMs = meshMs(generated);
+    size_t generatedFront = frontFacing;
+    shuffledMs = meshMs(shuffledMesh);
+    size_t shuffledFront = frontFacing;
+    sortedMs = meshMs(sortedMesh);
+    ok &= printLayoutRow("torus, generated", gridMs, shuffledMs, 0.0, true);
+    ok &= printLayoutRow("torus, shuffled", shuffledMs, shuffledMs, 0.0, shuffledFront == generatedFront);
+    ok &= printLayoutRow("torus, Morton", sortedMs, shuffledMs, meshSortMs, frontFacing == generatedFront);
+    return ok;
+}
+
+
+static glm::vec3 rayGridOrigin(const glm::vec3& center, float radius) {
+    return center + radius * glm::vec3(0.25f, 0.4f, 2.5f);
+}
+
+
+// A side x side pinhole grid of rays over a square of half-width radius
+// around center, seen from a little off its axis, as a picking camera would.
+static std::vector<Ray> rayGrid(const glm::vec3& center, float radius, unsigned int side) {
+    std::vector<Ray> rays((size_t)side * side);
+    glm::vec3 origin = rayGridOrigin(center, radius);
+    for (unsigned int j = 0; j < side; ++j) {
+        for (unsigned int i = 0; i < side; ++i) {
+            glm::vec3 target = center + radius * glm::vec3(-1.1f + 2.2f * i / (side - 1), -1.1f + 2.2f * j / (side - 1), 0.0f);
+            Ray& ray = rays[(size_t)j * side + i];
+            ray.origin = origin;
+            ray.direction = glm::normalize(target - origin);
+            ray.maxDistance = 1e30f;
+        }
+    }
+    return rays;
+}
+
+
+// Every triangle through glm::intersectRayTriangle, keeping the nearest hit
+// in (0, hit.distance) as the BVH does.
+static bool intersectMeshLoop(const Mesh& mesh, const Ray& ray, RayHit& hit) {
+    bool found = false;
+    for (size_t t = 0; t + 3 <= mesh.indices.size(); t += 3) {
+        glm::vec3 corners[3];
+        for (int corner = 0; corner < 3; ++corner) {
+            const float* p = &mesh.vertices[3 * (size_t)mesh.indices[t + corner]];
+            corners[corner] = glm::vec3(p[0], p[1], p[2]);
+        }
+        glm::vec2 barycentric;
+        float distance;
+        if (glm::intersectRayTriangle(ray.origin, ray.direction, corners[0], corners[1], corners[2], barycentric, distance)
+            && distance > 0.0f && distance < hit.distance) {
+            hit.distance = distance;
+            hit.barycentric = barycentric;
+            hit.triangle = (unsigned int)(t / 3);
+            found = true;
+        }
+    }
+    return found;
+}
+
+
+// The loop's triangle tests for every ray of rayGrid(center, radius, side),
+// with mesh placed by model, lowering hits as intersectMeshLoop does. A
+// triangle in front of the rays projects onto the grid's plane inside the
+// box of its projected corners, so only the rays through that box, padded
+// by one for rounding, are tested against it.
+static void intersectGridLoop(const Mesh& mesh, const glm::mat4& model, const glm::vec3& center, float radius,
+                              unsigned int side, const std::vector<Ray>& rays, std::vector<RayHit>& hits) {
+    glm::vec3 origin = rayGridOrigin(center, radius);
+    float cellsPerUnit = (side - 1) / (2.2f * radius);
+    for (size_t t = 0; t + 3 <= mesh.indices.size(); t += 3) {
+        glm::vec3 corners[3];
+        glm::vec2 low(FLT_MAX), high(-FLT_MAX);
+        bool inFront = true;
+        for (int corner = 0; corner < 3; ++corner) {
+            const float* p = &mesh.vertices[3 * (size_t)mesh.indices[t + corner]];
+            corners[corner] = glm::vec3(model * glm::vec4(p[0], p[1], p[2], 1.0f));
+            glm::vec3 d = corners[corner] - origin;
+            inFront &= d.z < 0.0f;
+            glm::vec2 cell = (glm::vec2(origin - center) + glm::vec2(d) * ((center.z - origin.z) / d.z)) * cellsPerUnit
+                + 0.5f * (side - 1);
+            low = glm::min(low, cell);
+            high = glm::max(high, cell);
+        }
+        glm::ivec2 first(0), last((int)side - 1);
+        if (inFront) {
+            first = glm::max(first, glm::ivec2(glm::floor(glm::max(low, -2.0f))) - 1);
+            last = glm::min(last, glm::ivec2(glm::ceil(glm::min(high, (float)side + 1.0f))) + 1);
+        }
+        for (int j = first.y; j <= last.y; ++j) {
+            for (int i = first.x; i <= last.x; ++i) {
+                const Ray& ray = rays[(size_t)j * side + i];
+                RayHit& hit = hits[(size_t)j * side + i];
+                glm::vec2 barycentric;
+                float distance;
+                if (glm::intersectRayTriangle(ray.origin, ray.direction, corners[0], corners[1], corners[2], barycentric,
+                                              distance)
+                    && distance > 0.0f && distance < hit.distance) {
+                    hit.distance = distance;
+                    hit.barycentric = barycentric;
+                    hit.triangle = (unsigned int)(t / 3);
+                }
+            }
+        }
+    }
+}
+
+
+// The speedup is the single-threaded BVH's over the loop's, per ray.
+static bool printBvhRow(const char* scene, size_t primitives, size_t nodes, double buildMs, size_t rays,
+                        double singleMs, double poolMs, double loopRayMs, unsigned int checked, unsigned int mismatches) {
+    char speedup[16] = "-", check[24] = "-";
+    if (loopRayMs > 0.0)
+        std::snprintf(speedup, sizeof(speedup), "%.1fx", loopRayMs * rays / singleMs);
+    if (checked > 0)
+        std::snprintf(check, sizeof(check), "%u of %u", mismatches, checked);
+    bool ok = mismatches == 0;
+    std::printf("  %-24s %10zu %8zu %9.1f %10.2f %10.2f %10s %13s%s\n", scene, primitives, nodes, buildMs,
+                rays / (singleMs * 1e3), rays / (poolMs * 1e3), speedup, check, ok ? "" : "  FAILED");
+    return ok;
+}
+
+
+// bvh.h on the meshes the app draws: the tetrahedron, the torus, the dense
+// torus of the Morton section and the lattice of both, whose instance BVH
+// leads to the two mesh BVHs. Rays come from a 256 x 256 picking grid over
+// each scene; build ms is on the pool. Every ray's BVH hit must match
+// intersectGridLoop's, except on the million-instance lattice. The loop
+// traces rays spread over the grid against every triangle with
+// glm::intersectRayTriangle, for the speedup and to check the reference.
+// Instances are traced with inverse model matrices kept beside the model
+// ones.
+static bool benchmarkBvh(const SimdBenchmarkOptions& options) {
+    WorkerPool pool;
+    createWorkerPool(pool, defaultWorkerCount());
+    unsigned int threads = (unsigned int)pool.threads.size() + 1;
+    const unsigned int side = 256;
+    std::printf("\nbvh.h, binned SAH over %u thr, %u-wide %s nodes and triangle leaves, %u rays a scene%s\n", threads,
+                BVH_WIDTH, bvhIsa(), side * side, SPANS_EXACT ? "" : ", FMA contraction: edge hits may differ");
+    std::printf("  %-24s %10s %8s %9s %10s %10s %10s %13s\n", "scene", "primitives", "nodes", "build ms", "1 thr Mr/s",
+                "pool Mr/s", "vs loop", "mismatches");
+
+    // Loop rays are capped so that each scene's loop tests about 2^24
+    // ray-triangle pairs.
+    const double loopPairs = 1 << 24;
+    // Under FMA contraction glm::intersectRayTriangle rounds differently from
+    // the SSE tests, so a ray through an edge may hit on one side of it only.
+    // The hit that was found then lies within BVH_EDGE_TOLERANCE of an edge.
+    auto nearEdge = [](bool found, const RayHit& hit) {
+        float weight = std::min(std::min(hit.barycentric.x, hit.barycentric.y), 1.0f - hit.barycentric.x - hit.barycentric.y);
+        return !SPANS_EXACT && found && weight < BVH_EDGE_TOLERANCE;
+    };
+    auto sameHit = [&](bool found, const RayHit& hit, bool expected, const RayHit& reference) {
+        if (found == expected && (!found || glm::abs(hit.distance - reference.distance) <= 1e-4f * reference.distance))
+            return true;
+        return nearEdge(found, hit) || nearEdge(expected, reference);
+    };
+    auto clearHits = [](const std::vector<Ray>& rays, std::vector<RayHit>& hits) {
+        hits.resize(rays.size());
+        for (size_t r = 0; r < rays.size(); ++r) {
+            hits[r].distance = rays[r].maxDistance;
+            hits[r].triangle = BVH_MISS;
+        }
+    };
+
+    bool ok = true;
+    Torus torus = generateTorus(0.3f, 0.8f, 30, 30);
+    Torus denseTorus = generateTorus(0.3f, 0.8f, 1024, 1024);
+    Mesh meshes[3] = { generateTetrahedron(), { torus.vertices, torus.indices }, { denseTorus.vertices, denseTorus.indices } };
+    const char* names[3] = { "tetrahedron", "torus 30x30", "torus 1024x1024" };
+    Bvh meshBvhs[3];
+    for (int m = 0; m < 3; ++m) {
+        const Mesh& mesh = meshes[m];
+        size_t triangles = mesh.indices.size() / 3;
+        buildTriangleBvh(meshBvhs[m], pool, mesh.vertices.data(), mesh.indices.data(), triangles);
+        float radius = m == 0 ? glm::sqrt(3.0f) : 1.1f;
+        std::vector<Ray> rays = rayGrid(glm::vec3(0.0f), radius, side);
+        std::vector<RayHit> hits(rays.size());
+        double singleMs = bestTimeMs(options.seconds, [&] {
+            for (size_t r = 0; r < rays.size(); ++r)
+                intersectBvh(meshBvhs[m], rays[r], hits[r]);
+        });
+        double poolMs = bestTimeMs(options.seconds, [&] {
+            intersectBvh(meshBvhs[m], pool, rays.data(), rays.size(), hits.data());
+        });
+
+        std::vector<RayHit> reference;
+        clearHits(rays, reference);
+        intersectGridLoop(mesh, glm::mat4(1.0f), glm::vec3(0.0f), radius, side, rays, reference);
+        unsigned int mismatches = 0;
+        for (size_t r = 0; r < rays.size(); ++r)
+            mismatches += !sameHit(hits[r].triangle != BVH_MISS, hits[r], reference[r].triangle != BVH_MISS, reference[r]);
+
+        unsigned int timed = (unsigned int)glm::clamp(loopPairs / triangles, 16.0, (double)rays.size());
+        auto start = std::chrono::steady_clock::now();
+        for (unsigned int k = 0; k < timed; ++k) {
+            size_t r = (size_t)k * rays.size() / timed;
+            RayHit loopHit;
+            loopHit.distance = rays[r].maxDistance;
+            bool found = intersectMeshLoop(mesh, rays[r], loopHit);
+            mismatches += !sameHit(found, loopHit, reference[r].triangle != BVH_MISS, reference[r]);
+        }
+        double loopMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        ok &= printBvhRow(names[m], triangles, meshBvhs[m].nodes.size(), meshBvhs[m].buildMs, rays.size(), singleMs,
+                          poolMs, loopMs / timed, (unsigned int)rays.size(), mismatches);
+    }
+
+    // The lattice draws the tetrahedron and the coarse torus per instance,
+    // inside boxes that hold them at any rotation.
+    glm::mat4 rotation = glm::rotate(glm::mat4(1.0f), 0.7f, glm::vec3(0.3f, 1.0f, 0.2f));
+    const unsigned int latticeSides[2] = { 10, 100 };
+    for (unsigned int latticeSide : latticeSides) {
+        Scene lattice = buildLatticeScene(latticeSide, 4.0f);
+        size_t count = lattice.instances.size();
+        std::vector<Aabb> boxes(count);
+        std::vector<glm::mat4> models(count), inverseModels(count);
+        Aabb bounds = { glm::vec3(FLT_MAX), glm::vec3(-FLT_MAX) };
+        for (size_t i = 0; i < count; ++i) {
+            const SceneInstance& instance = lattice.instances[i];
+            glm::vec3 extent(lattice.boundingRadius * instance.scale);
+            boxes[i].min = instance.position - extent;
+            boxes[i].max = instance.position + extent;
+            bounds.min = glm::min(bounds.min, boxes[i].min);
+            bounds.max = glm::max(bounds.max, boxes[i].max);
+            models[i] = instanceModel(instance, rotation);
+            inverseModels[i] = glm::inverse(models[i]);
+        }
+        Bvh instances;
+        buildBvh(instances, pool, boxes.data(), count);
+
+        glm::vec3 center(0.5f * (bounds.min.x + bounds.max.x), 0.5f * (bounds.min.y + bounds.max.y), bounds.max.z);
+        float radius = 0.5f * (bounds.max.x - bounds.min.x);
+        std::vector<Ray> rays = rayGrid(center, radius, side);
+        std::vector<RayHit> hits(rays.size());
+        double singleMs = bestTimeMs(options.seconds, [&] {
+            for (size_t r = 0; r < rays.size(); ++r)
+                intersectInstances(instances, inverseModels.data(), meshBvhs, 2, rays[r], hits[r]);
+        });
+        const unsigned int grain = 256;
+        double poolMs = bestTimeMs(options.seconds, [&] {
+            parallelFor(pool, (unsigned int)((rays.size() + grain - 1) / grain), 1, [&](unsigned int chunk) {
+                size_t end = std::min(rays.size(), (size_t)(chunk + 1) * grain);
+                for (size_t r = (size_t)chunk * grain; r < end; ++r)
+                    intersectInstances(instances, inverseModels.data(), meshBvhs, 2, rays[r], hits[r]);
+            });
+        });
+
+        // Only the smaller lattice is checked: the loop over a million
+        // instances would take minutes. The reference places every
+        // triangle in world space, so its distances round differently from
+        // the object-space ones by far less than sameHit allows.
+        size_t triangles = count * (meshes[0].indices.size() + meshes[1].indices.size()) / 3;
+        unsigned int checked = 0, mismatches = 0;
+        double loopRayMs = 0.0;
+        if (latticeSide <= 10) {
+            std::vector<RayHit> reference;
+            clearHits(rays, reference);
+            for (size_t i = 0; i < count; ++i) {
+                for (int m = 0; m < 2; ++m)
+                    intersectGridLoop(meshes[m], models[i], center, radius, side, rays, reference);
+            }
+            checked = (unsigned int)rays.size();
+            for (size_t r = 0; r < rays.size(); ++r)
+                mismatches += !sameHit(hits[r].triangle != BVH_MISS, hits[r], reference[r].triangle != BVH_MISS, reference[r]);
+
+            unsigned int timed = (unsigned int)glm::clamp(loopPairs / triangles, 16.0, (double)rays.size());
+            auto start = std::chrono::steady_clock::now();
+            for (unsigned int k = 0; k < timed; ++k) {
+                size_t r = (size_t)k * rays.size() / timed;
+                RayHit loopHit;
+                loopHit.distance = rays[r].maxDistance;
+                bool found = false;
+                for (size_t i = 0; i < count; ++i) {
+                    Ray local;
+                    local.origin = glm::vec3(inverseModels[i] * glm::vec4(rays[r].origin, 1.0f));
+                    local.direction = glm::vec3(inverseModels[i] * glm::vec4(rays[r].direction, 0.0f));
+                    local.maxDistance = loopHit.distance;
+                    for (int m = 0; m < 2; ++m)
+                        found |= intersectMeshLoop(meshes[m], local, loopHit);
+                }
+                mismatches += !sameHit(found, loopHit, reference[r].triangle != BVH_MISS, reference[r]);
+            }
+            loopRayMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / timed;
+        }
+        char name[40];
+        std::snprintf(name, sizeof(name), "lattice %u^3, instances", latticeSide);
+        ok &= printBvhRow(name, count, instances.nodes.size(), instances.buildMs, rays.size(), singleMs, poolMs,
+                          loopRayMs, checked, mismatches);
+    }
+    destroyWorkerPool(pool);
+    return ok;
+}
+
+
+static double relativeError(const glm::mat4& value, const glm::mat4& reference) {
+    float error = 0.0f, scale = 1.0f;
+    for (int c = 0; c < 4; ++c) {
+        for (int r = 0; r < 4; ++r) {
+            error = std::max(error, std::abs(value[c][r] - reference[c][r]));
+            scale = std::max(scale, std::abs(reference[c][r]));
+        }
+    }
+    return error / scale;
+}
+
+
+// Speedup is against the scalar row of the same kernel, which comes first
+// and sets scalarMs.
+static bool printDispatchRow(const char* kernel, glm::simd_isa isa, unsigned int count, double ms, double& scalarMs,
+                             double error) {
+    if (isa == glm::simd_scalar)
+        scalarMs = ms;
+    std::printf("  %-16s %-8s %12.1f %8.2fx %11.2e%s\n", kernel, glm::simdIsaName(isa), count / (ms * 1e3),
+                scalarMs / ms, error, error <= TRANSFORM_TOLERANCE ? "" : "  FAILED");
+    return error <= TRANSFORM_TOLERANCE;
+}
+
+
+// The glm/gtx/simd_dispatch.hpp kernels at every instruction set this CPU
+// runs, whatever GLM_ARCH the benchmark was compiled for, each checked
+// against the per-element operators.
+static bool benchmarkDispatch(const SimdBenchmarkOptions& options) {
+    const unsigned int n = options.points, matrices = std::max(1u, options.points / 16);
+    const glm::simd_isa supported = glm::simdSupportedIsa();
+    std::printf("\nglm/gtx/simd_dispatch.hpp, %u points, %u matrices, CPU supports %s\n", n, matrices,
+                glm::simdIsaName(supported));
+    std::printf("  %-16s %-8s %12s %9s %11s\n", "kernel", "isa", "Mel/s", "speedup", "max error");
+
+    glm::mat4 m = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 100.0f)
+        * glm::lookAt(glm::vec3(0.0f, 2.0f, 30.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    std::mt19937 random(11);
+    std::uniform_real_distribution<float> element(-1.0f, 1.0f);
+    std::vector<glm::vec3> points(n), pointsLoop(n), pointsOut(n);
+    std::vector<glm::vec4> vectors(n), vectorsLoop(n), vectorsOut(n);
+    std::vector<float> values(n), exponents(n), valuesLoop(n), powLoop(n), valuesOut(n), halvesBack(n);
+    std::vector<glm::uint16> halves(n), halvesLoop(n);
+    std::vector<float> coordinates(3 * n), noiseLoop(n), noiseOut(n), randomReference(n), randomOut(n);
+    std::vector<glm::u32vec3> cells(n);
+    std::vector<glm::uint64> codesLoop(n), codesOut(n);
+    std::uniform_int_distribution<glm::uint32> cell(0, (1u << 21) - 1);
+    for (unsigned int i = 0; i < n; ++i) {
+        points[i] = glm::vec3(element(random), element(random), element(random)) * 10.0f;
+        vectors[i] = glm::vec4(points[i], element(random));
+        values[i] = (element(random) + 1.0f) * 8.0f;
+        exponents[i] = element(random) * 4.0f;
+    }
+    for (unsigned int i = 0; i < 3 * n; ++i)
+        coordinates[i] = element(random) * 32.0f;
+    const float* noiseX = coordinates.data();
+    const float* noiseY = noiseX + n;
+    const float* noiseZ = noiseY + n;
+    // Diagonally dominant, so the inverse stays well conditioned.
+    std::vector<glm::mat4> a(matrices), b(matrices), products(matrices), inverses(matrices), out(matrices);
+    for (unsigned int i = 0; i < matrices; ++i) {
+        for (int c = 0; c < 4; ++c) {
+            for (int r = 0; r < 4; ++r) {
+                a[i][c][r] = element(random) + (c == r ? 4.0f : 0.0f);
+                b[i][c][r] = element(random);
+            }
+        }
+    }
+
+    for (unsigned int i = 0; i < n; ++i) {
+        pointsLoop[i] = glm::vec3(m * glm::vec4(points[i], 1.0f));
+        vectorsLoop[i] = m * vectors[i];
+        valuesLoop[i] = std::exp(values[i]);
+        powLoop[i] = std::pow(values[i], exponents[i]);
+        halvesLoop[i] = glm::packHalf1x16(values[i]);
+        noiseLoop[i] = glm::perlin(glm::vec3(noiseX[i], noiseY[i], noiseZ[i]));
+        cells[i] = glm::u32vec3(cell(random), cell(random), cell(random));
+        codesLoop[i] = glm::bitfieldInterleave(cells[i].x, cells[i].y, cells[i].z);
+    }
+    for (unsigned int i = 0; i < matrices; ++i) {
+        products[i] = a[i] * b[i];
+        inverses[i] = glm::inverse(a[i]);
+    }
+    glm::rand_stream reference(5);
+    glm::gaussRand(reference, 0.0f, 1.0f, randomReference.data(), n);
+
+    bool ok = true;
+    double scalarMs[11] = {};
+    for (int isa = glm::simd_scalar; isa <= supported; ++isa) {
+        glm::simdDispatchSelect(glm::simd_isa(isa));
+
+        double ms = bestTimeMs(options.seconds, [&] { glm::dispatchTransformPositions(m, points.data(), pointsOut.data(), n); });
+        double error = 0.0;
+        for (unsigned int i = 0; i < n; ++i)
+            error = std::max(error, relativeError(pointsOut[i], pointsLoop[i]));
+        ok &= printDispatchRow("positions AoS", glm::simd_isa(isa), n, ms, scalarMs[0], error);
+
+        ms = bestTimeMs(options.seconds, [&] { glm::dispatchTransformVectors(m, vectors.data(), vectorsOut.data(), n); });
+        error = 0.0;
+        for (unsigned int i = 0; i < n; ++i)
+            error = std::max(error, relativeError(glm::vec3(vectorsOut[i]), glm::vec3(vectorsLoop[i])));
+        ok &= printDispatchRow("vec4", glm::simd_isa(isa), n, ms, scalarMs[1], error);
+
+        ms = bestTimeMs(options.seconds, [&] { glm::dispatchMultiply(a.data(), b.data(), out.data(), matrices); });
+        error = 0.0;
+        for (unsigned int i = 0; i < matrices; ++i)
+            error = std::max(error, relativeError(out[i], products[i]));
+        ok &= printDispatchRow("mat4 * mat4", glm::simd_isa(isa), matrices, ms, scalarMs[2], error);
+
+        ms = bestTimeMs(options.seconds, [&] { glm::dispatchInverse(a.data(), out.data(), matrices); });
+        error = 0.0;
+        for (unsigned int i = 0; i < matrices; ++i)
+            error = std::max(error, relativeError(out[i], inverses[i]));
+        ok &= printDispatchRow("inverse", glm::simd_isa(isa), matrices, ms, scalarMs[3], error);
+
+        ms = bestTimeMs(options.seconds, [&] { glm::dispatchExp(values.data(), valuesOut.data(), n); });
+        error = 0.0;
+        for (unsigned int i = 0; i < n; ++i)
+            error = std::max(error, relativeError(valuesOut[i], valuesLoop[i]));
+        ok &= printDispatchRow("exp", glm::simd_isa(isa), n, ms, scalarMs[4], error);
+
+        ms = bestTimeMs(options.seconds, [&] { glm::dispatchPow(values.data(), exponents.data(), valuesOut.data(), n); });
+        error = 0.0;
+        for (unsigned int i = 0; i < n; ++i)
+            error = std::max(error, relativeError(valuesOut[i], powLoop[i]));
+        ok &= printDispatchRow("pow", glm::simd_isa(isa), n, ms, scalarMs[5], error);
+
+        // The half conversions must match bit for bit: the error is the
+        // number of mismatches.
+        ms = bestTimeMs(options.seconds, [&] { glm::dispatchPackHalf(values.data(), halves.data(), n); });
+        error = 0.0;
+        for (unsigned int i = 0; i < n; ++i)
+            error += halves[i] != halvesLoop[i];
+        ok &= printDispatchRow("pack half", glm::simd_isa(isa), n, ms, scalarMs[6], error);
+
+        ms = bestTimeMs(options.seconds, [&] { glm::dispatchUnpackHalf(halvesLoop.data(), halvesBack.data(), n); });
+        error = 0.0;
+        for (unsigned int i = 0; i < n; ++i)
+            error += halvesBack[i] != glm::unpackHalf1x16(halvesLoop[i]);
+        ok &= printDispatchRow("unpack half", glm::simd_isa(isa), n, ms, scalarMs[7], error);
+
+        // Noise and gaussRand count mismatches too, none of which may be left
+        // once FMA builds' tolerance is applied.
+        ms = bestTimeMs(options.seconds, [&] { glm::dispatchPerlin(noiseX, noiseY, noiseZ, noiseOut.data(), n); });
+        double noiseError;
+        unsigned int mismatches = noiseMismatches(noiseOut, noiseLoop, noiseError);
+        error = noiseAgrees(mismatches, noiseError, n) ? 0.0 : mismatches;
+        ok &= printDispatchRow("perlin 3D", glm::simd_isa(isa), n, ms, scalarMs[8], error);
+
+        glm::rand_stream stream(5);
+        ms = bestTimeMs(options.seconds, [&] { glm::dispatchGaussRand(stream, 0.0f, 1.0f, randomOut.data(), n); });
+        stream = glm::rand_stream(5);
+        glm::dispatchGaussRand(stream, 0.0f, 1.0f, randomOut.data(), n);
+        error = noiseMismatches(randomOut, randomReference, noiseError);
+        ok &= printDispatchRow("gaussRand", glm::simd_isa(isa), n, ms, scalarMs[9], error);
+
+        ms = bestTimeMs(options.seconds, [&] { glm::dispatchBitfieldInterleave(cells.data(), codesOut.data(), n); });
+        error = 0.0;
+        for (unsigned int i = 0; i < n; ++i)
+            error += codesOut[i] != codesLoop[i];
+        ok &= printDispatchRow("morton encode", glm::simd_isa(isa), n, ms, scalarMs[10], error);
+    }
+    glm::simdDispatchSelect(supported);
+    std::printf("  selected at run time: %s, Morton codes with %s\n", glm::simdIsaName(glm::simdDispatchIsa()),
+                glm::dispatchBitfieldIsa());
+    return ok;
+}
+
+
+int runSimdBenchmark(const SimdBenchmarkOptions& options) {
+    bool ok = benchmarkTransforms(options);
+    ok &= benchmarkDoubleMatrices(options);
+    ok &= benchmarkExponential(options);
+    ok &= benchmarkHalf(options);
+    ok &= benchmarkNoise(options);
+    ok &= benchmarkRandom(options);
+    ok &= benchmarkMorton(options);
+    ok &= benchmarkBvh(options);
+    ok &= benchmarkDispatch(options);
+    if (!ok)
+        std::cerr << "SIMD benchmark: a batched kernel disagrees with the per-element reference" << std::endl;
+    return ok ? 0 : 1;
+}
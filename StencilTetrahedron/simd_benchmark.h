@@ -0,0 +1,16 @@
+#pragma once
+
+
+// Throughput of the batched GLM math kernels against the plain per-element
+// GLM calls they replace, with each result checked against the plain one.
+struct SimdBenchmarkOptions {
+    unsigned int points;        // elements per span
+    double seconds;             // time spent on each measurement
+};
+
+// Recognises --simd-bench [--points n] [--seconds s].
+// Returns false when --simd-bench is absent.
+bool parseSimdBenchmarkOptions(int argc, char** argv, SimdBenchmarkOptions& options);
+
+// Returns non-zero when a kernel disagrees with the reference.
+int runSimdBenchmark(const SimdBenchmarkOptions& options);
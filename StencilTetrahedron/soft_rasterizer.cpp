@@ -0,0 +1,717 @@
+#include "soft_rasterizer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SOFT_SSE2 1
+#include <emmintrin.h>
+#endif
+
+
+// 28.4 fixed point keeps every edge value inside a partially covered tile within
+// 32 bits, as long as vertices stay inside the guard band below.
+const int SOFT_SUBPIXEL_BITS = 4;
+const int SOFT_SUBPIXEL = 1 << SOFT_SUBPIXEL_BITS;
+const float SOFT_GUARD_BAND = 2.0f;
+const int SOFT_MAX_CLIP_VERTICES = 9;
+
+
+void createSoftContext(SoftContext& ctx, int width, int height) {
+    if (width > SOFT_MAX_DIMENSION || height > SOFT_MAX_DIMENSION) {
+        std::cout << "ERROR::SOFT_RASTERIZER::VIEWPORT_TOO_LARGE " << width << "x" << height << std::endl;
+        width = std::min(width, SOFT_MAX_DIMENSION);
+        height = std::min(height, SOFT_MAX_DIMENSION);
+    }
+
+    ctx.width = width;
+    ctx.height = height;
+    ctx.tilesX = (width + SOFT_TILE_SIZE - 1) / SOFT_TILE_SIZE;
+    ctx.tilesY = (height + SOFT_TILE_SIZE - 1) / SOFT_TILE_SIZE;
+    ctx.color.assign((size_t)width * height, 0);
+    ctx.depth.assign((size_t)width * height, 1.0f);
+    ctx.stencil.assign((size_t)width * height, 0);
+    ctx.bins.assign((size_t)ctx.tilesX * ctx.tilesY, std::vector<uint32_t>());
+
+    // GL's initial state.
+    SoftDrawState& state = ctx.state;
+    state.depthTest = false;
+    state.stencilTest = false;
+    state.blend = false;
+    state.cullFace = false;
+    state.depthFunc = GL_LESS;
+    state.depthMask = true;
+    state.stencilFunc = GL_ALWAYS;
+    state.stencilRef = 0;
+    state.stencilValueMask = 0xFF;
+    state.stencilWriteMask = 0xFF;
+    state.stencilFail = GL_KEEP;
+    state.stencilDepthFail = GL_KEEP;
+    state.stencilDepthPass = GL_KEEP;
+    for (int i = 0; i < 4; ++i) {
+        state.colorMask[i] = true;
+    }
+    state.cullFaceMode = GL_BACK;
+    state.frontFace = GL_CCW;
+
+    ctx.clearColor = glm::vec4(0.0f);
+    ctx.clearDepth = 1.0f;
+    ctx.clearStencil = 0;
+    ctx.model = glm::mat4(1.0f);
+    ctx.view = glm::mat4(1.0f);
+    ctx.projection = glm::mat4(1.0f);
+    ctx.drawColor = glm::vec4(1.0f);
+    ctx.stats = SoftStats();
+}
+
+
+static bool* capability(SoftContext& ctx, GLenum cap) {
+    switch (cap) {
+    case GL_DEPTH_TEST: return &ctx.state.depthTest;
+    case GL_STENCIL_TEST: return &ctx.state.stencilTest;
+    case GL_BLEND: return &ctx.state.blend;
+    case GL_CULL_FACE: return &ctx.state.cullFace;
+    default: return nullptr;
+    }
+}
+
+
+void softEnable(SoftContext& ctx, GLenum cap) {
+    if (bool* flag = capability(ctx, cap)) {
+        *flag = true;
+    }
+}
+
+
+void softDisable(SoftContext& ctx, GLenum cap) {
+    if (bool* flag = capability(ctx, cap)) {
+        *flag = false;
+    }
+}
+
+
+void softDepthFunc(SoftContext& ctx, GLenum func) {
+    ctx.state.depthFunc = func;
+}
+
+
+void softDepthMask(SoftContext& ctx, bool flag) {
+    ctx.state.depthMask = flag;
+}
+
+
+void softStencilFunc(SoftContext& ctx, GLenum func, GLint ref, GLuint mask) {
+    ctx.state.stencilFunc = func;
+    ctx.state.stencilRef = std::clamp(ref, 0, 0xFF);
+    ctx.state.stencilValueMask = mask & 0xFF;
+}
+
+
+void softStencilOp(SoftContext& ctx, GLenum fail, GLenum depthFail, GLenum depthPass) {
+    ctx.state.stencilFail = fail;
+    ctx.state.stencilDepthFail = depthFail;
+    ctx.state.stencilDepthPass = depthPass;
+}
+
+
+void softStencilMask(SoftContext& ctx, GLuint mask) {
+    ctx.state.stencilWriteMask = mask & 0xFF;
+}
+
+
+void softColorMask(SoftContext& ctx, bool red, bool green, bool blue, bool alpha) {
+    ctx.state.colorMask[0] = red;
+    ctx.state.colorMask[1] = green;
+    ctx.state.colorMask[2] = blue;
+    ctx.state.colorMask[3] = alpha;
+}
+
+
+void softCullFace(SoftContext& ctx, GLenum mode) {
+    ctx.state.cullFaceMode = mode;
+}
+
+
+void softClearColor(SoftContext& ctx, float red, float green, float blue, float alpha) {
+    ctx.clearColor = glm::vec4(red, green, blue, alpha);
+}
+
+
+void softClear(SoftContext& ctx, GLbitfield mask) {
+    // Like glClear, clearing honours the colour, depth and stencil write masks.
+    SoftClear clear;
+    clear.mask = mask;
+    clear.color = glm::clamp(ctx.clearColor, 0.0f, 1.0f);
+    clear.depth = ctx.clearDepth;
+    clear.stencil = ctx.clearStencil;
+    for (int i = 0; i < 4; ++i) {
+        clear.colorMask[i] = ctx.state.colorMask[i];
+    }
+    clear.depthMask = ctx.state.depthMask;
+    clear.stencilWriteMask = ctx.state.stencilWriteMask;
+
+    ctx.commands.push_back((uint32_t)ctx.clears.size() | SOFT_CLEAR_BIT);
+    ctx.clears.push_back(clear);
+}
+
+
+void softSetTransform(SoftContext& ctx, const glm::mat4& model, const glm::mat4& view, const glm::mat4& projection) {
+    ctx.model = model;
+    ctx.view = view;
+    ctx.projection = projection;
+}
+
+
+void softSetColor(SoftContext& ctx, const glm::vec4& color) {
+    ctx.drawColor = color;
+}
+
+
+static uint8_t toUnorm8(float value) {
+    return (uint8_t)(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
+
+static void recordDraw(SoftContext& ctx, GLenum mode, const float* vertices, const unsigned int* indices, size_t first, size_t count) {
+    if (mode != GL_TRIANGLES && mode != GL_TRIANGLE_STRIP && mode != GL_TRIANGLE_FAN) {
+        std::cout << "ERROR::SOFT_RASTERIZER::UNSUPPORTED_PRIMITIVE " << mode << std::endl;
+        return;
+    }
+
+    SoftDraw draw;
+    draw.state = ctx.state;
+    draw.mvp = ctx.projection * ctx.view * ctx.model;
+    draw.color = ctx.drawColor;
+    draw.packedColor = 0;
+    draw.colorWriteMask = 0;
+    for (int c = 0; c < 4; ++c) {
+        draw.packedColor |= (uint32_t)toUnorm8(draw.color[c]) << (8 * c);
+        if (draw.state.colorMask[c]) {
+            draw.colorWriteMask |= 0xFFu << (8 * c);
+        }
+    }
+    draw.mode = mode;
+    draw.vertices = vertices;
+    draw.indices = indices;
+    draw.first = first;
+    draw.count = count;
+
+    ctx.commands.push_back((uint32_t)ctx.draws.size());
+    ctx.draws.push_back(draw);
+}
+
+
+void softDrawElements(SoftContext& ctx, GLenum mode, const float* vertices, const unsigned int* indices, size_t count) {
+    recordDraw(ctx, mode, vertices, indices, 0, count);
+}
+
+
+void softDrawArrays(SoftContext& ctx, GLenum mode, const float* vertices, size_t first, size_t count) {
+    recordDraw(ctx, mode, vertices, nullptr, first, count);
+}
+
+
+static size_t vertexIndex(const SoftDraw& draw, size_t i) {
+    return draw.indices ? draw.indices[draw.first + i] : draw.first + i;
+}
+
+
+// Clip-space planes as dot(plane, position) >= 0: near and far exactly as GL
+// does, the sides at the guard band so only huge triangles get split.
+static const glm::vec4 clipPlanes[6] = {
+    glm::vec4(0.0f, 0.0f, 1.0f, 1.0f),
+    glm::vec4(0.0f, 0.0f, -1.0f, 1.0f),
+    glm::vec4(1.0f, 0.0f, 0.0f, SOFT_GUARD_BAND),
+    glm::vec4(-1.0f, 0.0f, 0.0f, SOFT_GUARD_BAND),
+    glm::vec4(0.0f, 1.0f, 0.0f, SOFT_GUARD_BAND),
+    glm::vec4(0.0f, -1.0f, 0.0f, SOFT_GUARD_BAND),
+};
+
+
+static int clipPolygon(glm::vec4* polygon, int count) {
+    glm::vec4 scratch[SOFT_MAX_CLIP_VERTICES];
+
+    for (const glm::vec4& plane : clipPlanes) {
+        int outCount = 0;
+        for (int i = 0; i < count; ++i) {
+            const glm::vec4& a = polygon[i];
+            const glm::vec4& b = polygon[(i + 1) % count];
+            float da = glm::dot(plane, a);
+            float db = glm::dot(plane, b);
+
+            if (da >= 0.0f) {
+                scratch[outCount++] = a;
+            }
+            if ((da >= 0.0f) != (db >= 0.0f)) {
+                scratch[outCount++] = a + (b - a) * (da / (da - db));
+            }
+        }
+
+        count = outCount;
+        std::copy(scratch, scratch + count, polygon);
+        if (count < 3) {
+            return 0;
+        }
+    }
+
+    return count;
+}
+
+
+static void setupTriangle(const SoftContext& ctx, const SoftDraw& draw, unsigned int drawIndex, const glm::vec4 clip[3], std::vector<SoftTriangle>& out) {
+    SoftTriangle t;
+    float sz[3];
+
+    for (int i = 0; i < 3; ++i) {
+        glm::vec3 ndc = glm::vec3(clip[i]) / clip[i].w;
+        float sx = (ndc.x * 0.5f + 0.5f) * ctx.width;
+        float sy = (ndc.y * 0.5f + 0.5f) * ctx.height;
+        t.x[i] = (int32_t)std::lround(sx * SOFT_SUBPIXEL);
+        t.y[i] = (int32_t)std::lround(sy * SOFT_SUBPIXEL);
+        sz[i] = ndc.z * 0.5f + 0.5f;
+    }
+
+    int64_t area = (int64_t)(t.x[1] - t.x[0]) * (t.y[2] - t.y[0]) - (int64_t)(t.x[2] - t.x[0]) * (t.y[1] - t.y[0]);
+    if (area == 0) {
+        return;
+    }
+
+    if (draw.state.cullFace) {
+        bool front = (draw.state.frontFace == GL_CCW) == (area > 0);
+        if (draw.state.cullFaceMode == GL_FRONT_AND_BACK ||
+            (draw.state.cullFaceMode == GL_BACK && !front) ||
+            (draw.state.cullFaceMode == GL_FRONT && front)) {
+            return;
+        }
+    }
+
+    // Rasterize everything counter-clockwise so "inside" is E >= 0 on all edges.
+    if (area < 0) {
+        std::swap(t.x[1], t.x[2]);
+        std::swap(t.y[1], t.y[2]);
+        std::swap(sz[1], sz[2]);
+        area = -area;
+    }
+
+    // Pixels exactly on an edge belong to one side only. A shared edge appears
+    // with opposite directions in its two triangles, so exactly one owns it.
+    for (int e = 0; e < 3; ++e) {
+        int n = (e + 1) % 3;
+        int32_t a = t.y[e] - t.y[n];
+        int32_t b = t.x[n] - t.x[e];
+        t.bias[e] = (a > 0 || (a == 0 && b > 0)) ? 0 : -1;
+    }
+
+    double x1 = (double)(t.x[1] - t.x[0]) / SOFT_SUBPIXEL, y1 = (double)(t.y[1] - t.y[0]) / SOFT_SUBPIXEL;
+    double x2 = (double)(t.x[2] - t.x[0]) / SOFT_SUBPIXEL, y2 = (double)(t.y[2] - t.y[0]) / SOFT_SUBPIXEL;
+    double z1 = (double)sz[1] - sz[0], z2 = (double)sz[2] - sz[0];
+    double pixelArea = (double)area / (SOFT_SUBPIXEL * SOFT_SUBPIXEL);
+    t.depthRef = sz[0];
+    t.depthDx = (float)((z1 * y2 - z2 * y1) / pixelArea);
+    t.depthDy = (float)((x1 * z2 - x2 * z1) / pixelArea);
+    t.refX = (float)t.x[0] / SOFT_SUBPIXEL;
+    t.refY = (float)t.y[0] / SOFT_SUBPIXEL;
+
+    // Pixel centres sit at half-pixel offsets.
+    int32_t minX = std::min({ t.x[0], t.x[1], t.x[2] }), maxX = std::max({ t.x[0], t.x[1], t.x[2] });
+    int32_t minY = std::min({ t.y[0], t.y[1], t.y[2] }), maxY = std::max({ t.y[0], t.y[1], t.y[2] });
+    t.minX = std::max(0, (int)std::floor((minX - SOFT_SUBPIXEL / 2) / (float)SOFT_SUBPIXEL));
+    t.minY = std::max(0, (int)std::floor((minY - SOFT_SUBPIXEL / 2) / (float)SOFT_SUBPIXEL));
+    t.maxX = std::min(ctx.width - 1, (int)std::ceil((maxX - SOFT_SUBPIXEL / 2) / (float)SOFT_SUBPIXEL));
+    t.maxY = std::min(ctx.height - 1, (int)std::ceil((maxY - SOFT_SUBPIXEL / 2) / (float)SOFT_SUBPIXEL));
+    if (t.minX > t.maxX || t.minY > t.maxY) {
+        return;
+    }
+
+    t.draw = drawIndex;
+    out.push_back(t);
+}
+
+
+static bool insideAllPlanes(const glm::vec4& v) {
+    for (const glm::vec4& plane : clipPlanes) {
+        if (glm::dot(plane, v) < 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+static void setupDraw(const SoftContext& ctx, unsigned int drawIndex, std::vector<SoftTriangle>& out) {
+    const SoftDraw& draw = ctx.draws[drawIndex];
+    out.clear();
+    if (draw.count < 3) {
+        return;
+    }
+
+    // Transform each referenced vertex once, as the vertex shader would.
+    size_t lowest = vertexIndex(draw, 0), highest = lowest;
+    for (size_t i = 1; i < draw.count; ++i) {
+        size_t v = vertexIndex(draw, i);
+        lowest = std::min(lowest, v);
+        highest = std::max(highest, v);
+    }
+
+    std::vector<glm::vec4> clip(highest - lowest + 1);
+    std::vector<char> inside(clip.size());
+    for (size_t v = lowest; v <= highest; ++v) {
+        const float* p = draw.vertices + v * 3;
+        clip[v - lowest] = draw.mvp * glm::vec4(p[0], p[1], p[2], 1.0f);
+        inside[v - lowest] = insideAllPlanes(clip[v - lowest]);
+    }
+
+    size_t triangleCount = draw.mode == GL_TRIANGLES ? draw.count / 3 : draw.count - 2;
+    for (size_t t = 0; t < triangleCount; ++t) {
+        size_t corner[3];
+        if (draw.mode == GL_TRIANGLES) {
+            corner[0] = 3 * t; corner[1] = 3 * t + 1; corner[2] = 3 * t + 2;
+        } else if (draw.mode == GL_TRIANGLE_STRIP) {
+            // Odd strip triangles swap their first two vertices to keep the winding.
+            corner[0] = t + (t & 1); corner[1] = t + 1 - (t & 1); corner[2] = t + 2;
+        } else {
+            corner[0] = 0; corner[1] = t + 1; corner[2] = t + 2;
+        }
+
+        size_t v[3];
+        for (int i = 0; i < 3; ++i) {
+            v[i] = vertexIndex(draw, corner[i]) - lowest;
+        }
+
+        if (inside[v[0]] && inside[v[1]] && inside[v[2]]) {
+            glm::vec4 triangle[3] = { clip[v[0]], clip[v[1]], clip[v[2]] };
+            setupTriangle(ctx, draw, drawIndex, triangle, out);
+            continue;
+        }
+
+        glm::vec4 polygon[SOFT_MAX_CLIP_VERTICES] = { clip[v[0]], clip[v[1]], clip[v[2]] };
+        int count = clipPolygon(polygon, 3);
+        for (int i = 1; i + 1 < count; ++i) {
+            glm::vec4 triangle[3] = { polygon[0], polygon[i], polygon[i + 1] };
+            setupTriangle(ctx, draw, drawIndex, triangle, out);
+        }
+    }
+}
+
+
+template <typename T>
+static bool passes(GLenum func, T incoming, T stored) {
+    switch (func) {
+    case GL_NEVER: return false;
+    case GL_LESS: return incoming < stored;
+    case GL_EQUAL: return incoming == stored;
+    case GL_LEQUAL: return incoming <= stored;
+    case GL_GREATER: return incoming > stored;
+    case GL_NOTEQUAL: return incoming != stored;
+    case GL_GEQUAL: return incoming >= stored;
+    default: return true;
+    }
+}
+
+
+static uint8_t applyStencilOp(GLenum op, uint8_t value, GLint ref) {
+    switch (op) {
+    case GL_ZERO: return 0;
+    case GL_REPLACE: return (uint8_t)ref;
+    case GL_INCR: return value == 0xFF ? value : (uint8_t)(value + 1);
+    case GL_INCR_WRAP: return (uint8_t)(value + 1);
+    case GL_DECR: return value == 0 ? value : (uint8_t)(value - 1);
+    case GL_DECR_WRAP: return (uint8_t)(value - 1);
+    case GL_INVERT: return (uint8_t)~value;
+    default: return value;
+    }
+}
+
+
+static void shadePixel(SoftContext& ctx, const SoftDraw& draw, size_t pixel, float z) {
+    const SoftDrawState& state = draw.state;
+    z = std::clamp(z, 0.0f, 1.0f);
+
+    uint8_t stencil = ctx.stencil[pixel];
+    if (state.stencilTest) {
+        GLuint mask = state.stencilValueMask;
+        if (!passes<GLuint>(state.stencilFunc, (GLuint)state.stencilRef & mask, stencil & mask)) {
+            uint8_t updated = applyStencilOp(state.stencilFail, stencil, state.stencilRef);
+            ctx.stencil[pixel] = (uint8_t)((stencil & ~state.stencilWriteMask) | (updated & state.stencilWriteMask));
+            return;
+        }
+    }
+
+    // With the depth test disabled GL neither tests nor writes depth.
+    bool depthPass = !state.depthTest || passes(state.depthFunc, z, ctx.depth[pixel]);
+    if (state.stencilTest) {
+        uint8_t updated = applyStencilOp(depthPass ? state.stencilDepthPass : state.stencilDepthFail, stencil, state.stencilRef);
+        ctx.stencil[pixel] = (uint8_t)((stencil & ~state.stencilWriteMask) | (updated & state.stencilWriteMask));
+    }
+    if (!depthPass) {
+        return;
+    }
+    if (state.depthTest && state.depthMask) {
+        ctx.depth[pixel] = z;
+    }
+
+    if (!draw.colorWriteMask) {
+        return;
+    }
+
+    // The fragment colour is converted to the framebuffer's 8 bits before
+    // blending, as GL implementations with RGBA8 targets do.
+    uint32_t dst = ctx.color[pixel];
+    uint32_t source = draw.packedColor;
+    if (state.blend) {
+        uint32_t alpha = source >> 24;
+        uint32_t blended = 0;
+        for (int c = 0; c < 32; c += 8) {
+            uint32_t value = ((source >> c) & 0xFF) * alpha + ((dst >> c) & 0xFF) * (255 - alpha);
+            blended |= ((value + 127) / 255) << c;
+        }
+        source = blended;
+    }
+    uint32_t result = (dst & ~draw.colorWriteMask) | (source & draw.colorWriteMask);
+    ctx.color[pixel] = result;
+}
+
+
+static int64_t edgeValue(const SoftTriangle& t, int e, int64_t px, int64_t py) {
+    int n = (e + 1) % 3;
+    return (int64_t)(t.y[e] - t.y[n]) * (px - t.x[e]) + (int64_t)(t.x[n] - t.x[e]) * (py - t.y[e]) + t.bias[e];
+}
+
+
+static void rasterizeTriangle(SoftContext& ctx, const SoftTriangle& t, int tileX0, int tileY0, int tileX1, int tileY1) {
+    int minX = std::max(t.minX, tileX0), maxX = std::min(t.maxX, tileX1);
+    int minY = std::max(t.minY, tileY0), maxY = std::min(t.maxY, tileY1);
+    if (minX > maxX || minY > maxY) {
+        return;
+    }
+
+    // Edges that cover the whole region drop out of the per-pixel test; the
+    // rest are bounded by the region's extent and fit in 32 bits.
+    const int64_t half = SOFT_SUBPIXEL / 2;
+    int64_t cx0 = (int64_t)minX * SOFT_SUBPIXEL + half, cx1 = (int64_t)maxX * SOFT_SUBPIXEL + half;
+    int64_t cy0 = (int64_t)minY * SOFT_SUBPIXEL + half, cy1 = (int64_t)maxY * SOFT_SUBPIXEL + half;
+    int32_t rowStart[3] = { 0, 0, 0 }, stepX[3] = { 0, 0, 0 }, stepY[3] = { 0, 0, 0 };
+
+    for (int e = 0; e < 3; ++e) {
+        int64_t corners[4] = { edgeValue(t, e, cx0, cy0), edgeValue(t, e, cx1, cy0), edgeValue(t, e, cx0, cy1), edgeValue(t, e, cx1, cy1) };
+        int64_t low = std::min({ corners[0], corners[1], corners[2], corners[3] });
+        int64_t high = std::max({ corners[0], corners[1], corners[2], corners[3] });
+        if (high < 0) {
+            return;
+        }
+        if (low < 0) {
+            int n = (e + 1) % 3;
+            rowStart[e] = (int32_t)corners[0];
+            stepX[e] = (t.y[e] - t.y[n]) * SOFT_SUBPIXEL;
+            stepY[e] = (t.x[n] - t.x[e]) * SOFT_SUBPIXEL;
+        }
+    }
+
+    const SoftDraw& draw = ctx.draws[t.draw];
+    float rowDepth = t.depthRef + t.depthDx * (minX + 0.5f - t.refX) + t.depthDy * (minY + 0.5f - t.refY);
+
+#if SOFT_SSE2
+    const __m128i lane = _mm_set_epi32(3, 2, 1, 0);
+    __m128i e0Step = _mm_set1_epi32(stepX[0] * 4), e1Step = _mm_set1_epi32(stepX[1] * 4), e2Step = _mm_set1_epi32(stepX[2] * 4);
+    __m128i e0Lane = _mm_set_epi32(stepX[0] * 3, stepX[0] * 2, stepX[0], 0);
+    __m128i e1Lane = _mm_set_epi32(stepX[1] * 3, stepX[1] * 2, stepX[1], 0);
+    __m128i e2Lane = _mm_set_epi32(stepX[2] * 3, stepX[2] * 2, stepX[2], 0);
+    __m128 depthLane = _mm_set_ps(t.depthDx * 3.0f, t.depthDx * 2.0f, t.depthDx, 0.0f);
+    __m128 depthStep = _mm_set1_ps(t.depthDx * 4.0f);
+#endif
+
+    for (int y = minY; y <= maxY; ++y) {
+        size_t row = (size_t)y * ctx.width;
+
+#if SOFT_SSE2
+        __m128i e0 = _mm_add_epi32(_mm_set1_epi32(rowStart[0]), e0Lane);
+        __m128i e1 = _mm_add_epi32(_mm_set1_epi32(rowStart[1]), e1Lane);
+        __m128i e2 = _mm_add_epi32(_mm_set1_epi32(rowStart[2]), e2Lane);
+        __m128 z = _mm_add_ps(_mm_set1_ps(rowDepth), depthLane);
+
+        for (int x = minX; x <= maxX; x += 4) {
+            __m128i limit = _mm_set1_epi32(maxX - x);
+            __m128i outside = _mm_or_si128(_mm_or_si128(e0, e1), _mm_or_si128(e2, _mm_cmpgt_epi32(lane, limit)));
+            int covered = ~_mm_movemask_ps(_mm_castsi128_ps(outside)) & 0xF;
+
+            if (covered) {
+                alignas(16) float depths[4];
+                _mm_store_ps(depths, z);
+                while (covered) {
+                    int i = 0;
+                    while (!(covered & (1 << i))) {
+                        ++i;
+                    }
+                    covered &= covered - 1;
+                    shadePixel(ctx, draw, row + x + i, depths[i]);
+                }
+            }
+
+            e0 = _mm_add_epi32(e0, e0Step);
+            e1 = _mm_add_epi32(e1, e1Step);
+            e2 = _mm_add_epi32(e2, e2Step);
+            z = _mm_add_ps(z, depthStep);
+        }
+#else
+        int32_t e0 = rowStart[0], e1 = rowStart[1], e2 = rowStart[2];
+        float z = rowDepth;
+        for (int x = minX; x <= maxX; ++x) {
+            if ((e0 | e1 | e2) >= 0) {
+                shadePixel(ctx, draw, row + x, z);
+            }
+            e0 += stepX[0];
+            e1 += stepX[1];
+            e2 += stepX[2];
+            z += t.depthDx;
+        }
+#endif
+
+        rowStart[0] += stepY[0];
+        rowStart[1] += stepY[1];
+        rowStart[2] += stepY[2];
+        rowDepth += t.depthDy;
+    }
+}
+
+
+static void clearTile(SoftContext& ctx, const SoftClear& clear, int x0, int y0, int x1, int y1) {
+    uint32_t colorValue = 0, colorKeep = 0;
+    for (int c = 0; c < 4; ++c) {
+        if (clear.colorMask[c]) {
+            colorValue |= (uint32_t)toUnorm8(clear.color[c]) << (8 * c);
+        } else {
+            colorKeep |= 0xFFu << (8 * c);
+        }
+    }
+    uint8_t stencilValue = (uint8_t)(clear.stencil & clear.stencilWriteMask);
+    uint8_t stencilKeep = (uint8_t)~clear.stencilWriteMask;
+    float depthValue = std::clamp(clear.depth, 0.0f, 1.0f);
+
+    bool clearColor = (clear.mask & GL_COLOR_BUFFER_BIT) && colorKeep != 0xFFFFFFFFu;
+    bool clearDepth = (clear.mask & GL_DEPTH_BUFFER_BIT) && clear.depthMask;
+    bool clearStencil = (clear.mask & GL_STENCIL_BUFFER_BIT) && stencilKeep != 0xFF;
+
+    for (int y = y0; y <= y1; ++y) {
+        size_t begin = (size_t)y * ctx.width + x0, end = (size_t)y * ctx.width + x1 + 1;
+        if (clearColor) {
+            if (colorKeep == 0) {
+                std::fill(ctx.color.begin() + begin, ctx.color.begin() + end, colorValue);
+            } else {
+                for (size_t pixel = begin; pixel < end; ++pixel) {
+                    ctx.color[pixel] = (ctx.color[pixel] & colorKeep) | colorValue;
+                }
+            }
+        }
+        if (clearDepth) {
+            std::fill(ctx.depth.begin() + begin, ctx.depth.begin() + end, depthValue);
+        }
+        if (clearStencil) {
+            for (size_t pixel = begin; pixel < end; ++pixel) {
+                ctx.stencil[pixel] = (uint8_t)((ctx.stencil[pixel] & stencilKeep) | stencilValue);
+            }
+        }
+    }
+}
+
+
+static void rasterizeTile(SoftContext& ctx, unsigned int tile) {
+    int x0 = (int)(tile % ctx.tilesX) * SOFT_TILE_SIZE;
+    int y0 = (int)(tile / ctx.tilesX) * SOFT_TILE_SIZE;
+    int x1 = std::min(x0 + SOFT_TILE_SIZE, ctx.width) - 1;
+    int y1 = std::min(y0 + SOFT_TILE_SIZE, ctx.height) - 1;
+
+    for (uint32_t entry : ctx.bins[tile]) {
+        if (entry & SOFT_CLEAR_BIT) {
+            clearTile(ctx, ctx.clears[entry & ~SOFT_CLEAR_BIT], x0, y0, x1, y1);
+        } else {
+            rasterizeTriangle(ctx, *ctx.triangleTable[entry], x0, y0, x1, y1);
+        }
+    }
+}
+
+
+void softFinish(SoftContext& ctx, WorkerPool& pool) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    // Vertex processing, clipping and triangle setup, one task per draw.
+    ctx.drawTriangles.resize(std::max(ctx.drawTriangles.size(), ctx.draws.size()));
+    parallelFor(pool, (unsigned int)ctx.draws.size(), [&](unsigned int i) {
+        setupDraw(ctx, i, ctx.drawTriangles[i]);
+    });
+
+    auto setup = std::chrono::high_resolution_clock::now();
+
+    // Binning keeps submission order within every tile.
+    for (std::vector<uint32_t>& bin : ctx.bins) {
+        bin.clear();
+    }
+    ctx.triangleTable.clear();
+    size_t binned = 0;
+    for (uint32_t command : ctx.commands) {
+        if (command & SOFT_CLEAR_BIT) {
+            for (std::vector<uint32_t>& bin : ctx.bins) {
+                bin.push_back(command);
+            }
+            binned += ctx.bins.size();
+            continue;
+        }
+
+        for (const SoftTriangle& t : ctx.drawTriangles[command]) {
+            uint32_t id = (uint32_t)ctx.triangleTable.size();
+            ctx.triangleTable.push_back(&t);
+            for (int ty = t.minY / SOFT_TILE_SIZE; ty <= t.maxY / SOFT_TILE_SIZE; ++ty) {
+                for (int tx = t.minX / SOFT_TILE_SIZE; tx <= t.maxX / SOFT_TILE_SIZE; ++tx) {
+                    ctx.bins[(size_t)ty * ctx.tilesX + tx].push_back(id);
+                }
+            }
+            binned += (size_t)(t.maxY / SOFT_TILE_SIZE - t.minY / SOFT_TILE_SIZE + 1) * (t.maxX / SOFT_TILE_SIZE - t.minX / SOFT_TILE_SIZE + 1);
+        }
+    }
+
+    auto binnedTime = std::chrono::high_resolution_clock::now();
+
+    // Tiles own disjoint pixels, so workers never touch the same memory. Their
+    // cost varies a lot, so each tile is its own job.
+    parallelFor(pool, (unsigned int)ctx.bins.size(), 1, [&](unsigned int tile) {
+        rasterizeTile(ctx, tile);
+    });
+
+    auto end = std::chrono::high_resolution_clock::now();
+
+    ctx.stats.draws = ctx.draws.size();
+    ctx.stats.triangles = ctx.triangleTable.size();
+    ctx.stats.binnedEntries = binned;
+    ctx.stats.setupMs = std::chrono::duration<double, std::milli>(setup - start).count();
+    ctx.stats.binMs = std::chrono::duration<double, std::milli>(binnedTime - setup).count();
+    ctx.stats.rasterMs = std::chrono::duration<double, std::milli>(end - binnedTime).count();
+
+    ctx.draws.clear();
+    ctx.clears.clear();
+    ctx.commands.clear();
+}
+
+
+bool writeSoftPPM(const SoftContext& ctx, const char* path) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Failed to open " << path << " for writing" << std::endl;
+        return false;
+    }
+
+    // PPM rows run top to bottom.
+    file << "P6\n" << ctx.width << " " << ctx.height << "\n255\n";
+    std::vector<unsigned char> row((size_t)ctx.width * 3);
+    for (int y = ctx.height - 1; y >= 0; --y) {
+        for (int x = 0; x < ctx.width; ++x) {
+            uint32_t pixel = ctx.color[(size_t)y * ctx.width + x];
+            row[(size_t)x * 3] = (unsigned char)pixel;
+            row[(size_t)x * 3 + 1] = (unsigned char)(pixel >> 8);
+            row[(size_t)x * 3 + 2] = (unsigned char)(pixel >> 16);
+        }
+        file.write((const char*)row.data(), row.size());
+    }
+    return (bool)file;
+}
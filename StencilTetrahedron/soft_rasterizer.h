@@ -0,0 +1,125 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "worker_pool.h"
+
+#include <cstdint>
+#include <vector>
+
+
+// CPU reference implementation of the fixed-function subset main.cpp relies on:
+// depth test, 8-bit stencil with glStencilFunc/glStencilOp/glStencilMask
+// semantics, face culling, colour mask and SRC_ALPHA/ONE_MINUS_SRC_ALPHA
+// blending, with the single flat-colour shader (projection * view * model).
+//
+// The soft* calls mirror their GL namesakes and take the same GL enums. Draws
+// and clears are only recorded; softFinish transforms and clips them on the
+// worker pool, bins the triangles into 64x64 tiles and rasterizes the tiles in
+// parallel. Each tile replays its commands in submission order, so the image is
+// identical whatever the thread count. Vertex and index arrays passed to draws
+// must stay alive until softFinish returns.
+const int SOFT_TILE_SIZE = 64;
+// Larger viewports are clamped; callers should reject them up front.
+const int SOFT_MAX_DIMENSION = 4096;
+
+struct SoftDrawState {
+    bool depthTest, stencilTest, blend, cullFace;
+    GLenum depthFunc;
+    bool depthMask;
+    GLenum stencilFunc;
+    GLint stencilRef;
+    GLuint stencilValueMask, stencilWriteMask;
+    GLenum stencilFail, stencilDepthFail, stencilDepthPass;
+    bool colorMask[4];
+    GLenum cullFaceMode, frontFace;
+};
+
+struct SoftClear {
+    GLbitfield mask;
+    glm::vec4 color;
+    float depth;
+    GLint stencil;
+    bool colorMask[4];
+    bool depthMask;
+    GLuint stencilWriteMask;
+};
+
+// Screen-space triangle in 28.4 fixed point, ready for the tile rasterizer.
+struct SoftTriangle {
+    int32_t x[3], y[3];
+    int32_t bias[3];                // 0 for edges that own their boundary pixels, -1 otherwise
+    float depthRef, depthDx, depthDy, refX, refY;
+    int minX, minY, maxX, maxY;     // inclusive pixel bounds
+    unsigned int draw;
+};
+
+struct SoftDraw {
+    SoftDrawState state;
+    glm::mat4 mvp;
+    glm::vec4 color;
+    uint32_t packedColor;       // color as RGBA8
+    uint32_t colorWriteMask;    // bits of the colour buffer glColorMask lets through
+    GLenum mode;
+    const float* vertices;
+    const unsigned int* indices;    // null for array draws
+    size_t first, count;
+};
+
+struct SoftStats {
+    size_t draws, triangles, binnedEntries;
+    double setupMs, binMs, rasterMs;
+};
+
+struct SoftContext {
+    int width, height;
+    int tilesX, tilesY;
+    std::vector<uint32_t> color;    // RGBA8, row 0 at the bottom like glReadPixels
+    std::vector<float> depth;
+    std::vector<uint8_t> stencil;
+
+    SoftDrawState state;
+    glm::vec4 clearColor;
+    float clearDepth;
+    GLint clearStencil;
+    glm::mat4 model, view, projection;
+    glm::vec4 drawColor;
+
+    std::vector<SoftDraw> draws;
+    std::vector<SoftClear> clears;
+    std::vector<uint32_t> commands;             // draw index, or clear index | SOFT_CLEAR_BIT
+    std::vector<std::vector<SoftTriangle>> drawTriangles;
+    std::vector<std::vector<uint32_t>> bins;    // per tile: triangle references in order
+    std::vector<const SoftTriangle*> triangleTable;
+    SoftStats stats;
+};
+
+const uint32_t SOFT_CLEAR_BIT = 0x80000000u;
+
+void createSoftContext(SoftContext& ctx, int width, int height);
+
+void softEnable(SoftContext& ctx, GLenum cap);
+void softDisable(SoftContext& ctx, GLenum cap);
+void softDepthFunc(SoftContext& ctx, GLenum func);
+void softDepthMask(SoftContext& ctx, bool flag);
+void softStencilFunc(SoftContext& ctx, GLenum func, GLint ref, GLuint mask);
+void softStencilOp(SoftContext& ctx, GLenum fail, GLenum depthFail, GLenum depthPass);
+void softStencilMask(SoftContext& ctx, GLuint mask);
+void softColorMask(SoftContext& ctx, bool red, bool green, bool blue, bool alpha);
+void softCullFace(SoftContext& ctx, GLenum mode);
+void softClearColor(SoftContext& ctx, float red, float green, float blue, float alpha);
+void softClear(SoftContext& ctx, GLbitfield mask);
+
+// Shader inputs: the model/view/projection and color uniforms.
+void softSetTransform(SoftContext& ctx, const glm::mat4& model, const glm::mat4& view, const glm::mat4& projection);
+void softSetColor(SoftContext& ctx, const glm::vec4& color);
+
+// mode is GL_TRIANGLES, GL_TRIANGLE_STRIP or GL_TRIANGLE_FAN; vertices are
+// tightly packed xyz floats as in the GL vertex buffers.
+void softDrawElements(SoftContext& ctx, GLenum mode, const float* vertices, const unsigned int* indices, size_t count);
+void softDrawArrays(SoftContext& ctx, GLenum mode, const float* vertices, size_t first, size_t count);
+
+void softFinish(SoftContext& ctx, WorkerPool& pool);
+
+bool writeSoftPPM(const SoftContext& ctx, const char* path);
@@ -0,0 +1,296 @@
+#include "software_render.h"
+
+#include "mesh.h"
+#include "scene.h"
+#include "soft_rasterizer.h"
+#include "tiled_render.h"
+#include "worker_pool.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+
+bool parseSoftwareRenderOptions(int argc, char** argv, SoftwareRenderOptions& options) {
+    options.outputPath = "software.ppm";
+    options.width = 800;
+    options.height = 600;
+    options.frames = 1;
+    options.threads = defaultWorkerCount();
+    options.lattice = false;
+    options.streamPath = nullptr;
+    options.sinkBackend = FrameSinkBackend::IoUring;
+    options.processes = 1;
+
+    bool software = false;
+    for (int i = 1; i < argc; ++i) {
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--software") == 0) {
+            software = true;
+        } else if (std::strcmp(argv[i], "--lattice") == 0) {
+            options.lattice = true;
+        } else if (std::strcmp(argv[i], "--output") == 0 && hasValue) {
+            options.outputPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--size") == 0 && hasValue) {
+            if (std::sscanf(argv[++i], "%dx%d", &options.width, &options.height) != 2 || options.width <= 0 || options.height <= 0
+                || options.width > SOFT_MAX_DIMENSION || options.height > SOFT_MAX_DIMENSION) {
+                std::cerr << "Invalid --size, expected WxH of at most " << SOFT_MAX_DIMENSION << " a side" << std::endl;
+                options.width = 800;
+                options.height = 600;
+            }
+        } else if (std::strcmp(argv[i], "--frames") == 0 && hasValue) {
+            options.frames = (unsigned int)std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--threads") == 0 && hasValue) {
+            options.threads = (unsigned int)std::max(0, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--processes") == 0 && hasValue) {
+            options.processes = (unsigned int)std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--stream") == 0 && hasValue) {
+            options.streamPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--sink") == 0 && hasValue) {
+            const char* backend = argv[++i];
+            if (std::strcmp(backend, "mmap") == 0)
+                options.sinkBackend = FrameSinkBackend::Mmap;
+            else if (std::strcmp(backend, "thread") == 0)
+                options.sinkBackend = FrameSinkBackend::Thread;
+            else
+                options.sinkBackend = FrameSinkBackend::IoUring;
+        }
+    }
+    return software;
+}
+
+
+// Circle fans as main.cpp's drawCircle builds them. main draws numSegments + 2
+// vertices from a buffer of numSegments + 1; the extra vertex is outside the
+// buffer, so it is left out here.
+static std::vector<float> buildCircle(const glm::vec3& center) {
+    int numSegments = 100;
+    float radius = 0.2f;
+    std::vector<float> vertices;
+    for (int i = 0; i <= numSegments; ++i) {
+        float angle = 2.0f * glm::pi<float>() * i / numSegments;
+        vertices.push_back(center.x + radius * cos(angle));
+        vertices.push_back(center.y + radius * sin(angle));
+        vertices.push_back(center.z);
+    }
+    return vertices;
+}
+
+
+void createSoftwareScene(SoftwareScene& scene) {
+    scene.tetra = generateTetrahedron();
+    scene.torus = generateTorus(0.3f, 0.8f, 30, 30);
+    glm::vec3 holeCenters[] = {
+        glm::vec3(1.0f, 1.0f, 1.0f),
+        glm::vec3(-1.0f, -1.0f, 1.0f),
+        glm::vec3(-1.0f, 1.0f, -1.0f),
+        glm::vec3(1.0f, -1.0f, -1.0f)
+    };
+    for (int i = 0; i < 4; ++i) {
+        scene.circles[i] = buildCircle(holeCenters[i]);
+    }
+    scene.lattice = buildLatticeScene(10, 4.0f);
+
+    BoundingSphere tetraSphere = computeBoundingSphere(scene.tetra.vertices);
+    BoundingSphere torusSphere = computeBoundingSphere(scene.torus.vertices);
+    float boundingRadius = glm::max(glm::length(tetraSphere.center) + tetraSphere.radius,
+                                    glm::length(torusSphere.center) + torusSphere.radius);
+    resizeSphereBatch(scene.latticeSpheres, scene.lattice.instances.size());
+    for (size_t i = 0; i < scene.lattice.instances.size(); ++i) {
+        const SceneInstance& instance = scene.lattice.instances[i];
+        scene.latticeSpheres.x[i] = instance.position.x;
+        scene.latticeSpheres.y[i] = instance.position.y;
+        scene.latticeSpheres.z[i] = instance.position.z;
+        scene.latticeSpheres.radius[i] = boundingRadius * instance.scale;
+    }
+    scene.view = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -5.0f));
+}
+
+
+glm::mat4 softwareFrameRotation(unsigned int frame) {
+    // Accumulated step by step, as the interactive loop does, so every frame
+    // matches bit for bit however it is reached.
+    float angle = 0.0f;
+    for (unsigned int i = 0; i <= frame; ++i) {
+        angle += 50.0f / 60.0f;
+        if (angle > 360.0f)
+            angle -= 360.0f;
+    }
+    return glm::rotate(glm::mat4(1.0f), glm::radians(angle), glm::vec3(0.5f, 1.0f, 0.0f));
+}
+
+
+void renderSoftwareFrame(SoftContext& ctx, WorkerPool& pool, const SoftwareScene& scene, bool lattice,
+                         const glm::mat4& rotation, const glm::mat4& projection) {
+    const Mesh& tetra = scene.tetra;
+    const Torus& torus = scene.torus;
+    const glm::mat4& view = scene.view;
+
+    softEnable(ctx, GL_DEPTH_TEST);
+    softEnable(ctx, GL_STENCIL_TEST);
+    softEnable(ctx, GL_BLEND);
+    softClearColor(ctx, 0.1f, 0.1f, 0.1f, 1.0f);
+    softClear(ctx, GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+
+    if (lattice) {
+        // Lattice mode with every instance at the finest torus level.
+        std::vector<unsigned int> visible(scene.lattice.instances.size());
+        visible.resize(cullSpheres(extractFrustum(projection * view), scene.latticeSpheres, visible.data()));
+
+        softStencilMask(ctx, 0xFF);
+        softStencilFunc(ctx, GL_ALWAYS, 1, 0xFF);
+        softSetColor(ctx, glm::vec4(0.0f, 1.0f, 0.0f, 1.0f));
+        for (unsigned int index : visible) {
+            softSetTransform(ctx, instanceModel(scene.lattice.instances[index], rotation), view, projection);
+            softDrawElements(ctx, GL_TRIANGLES, tetra.vertices.data(), tetra.indices.data(), tetra.indices.size());
+        }
+
+        softStencilMask(ctx, 0x00);
+        softStencilFunc(ctx, GL_ALWAYS, 0, 0xFF);
+        softSetColor(ctx, glm::vec4(0.0f, 0.0f, 1.0f, 0.5f));
+        for (unsigned int index : visible) {
+            softSetTransform(ctx, instanceModel(scene.lattice.instances[index], rotation), view, projection);
+            softDrawElements(ctx, GL_TRIANGLES, torus.vertices.data(), torus.indices.data(), torus.indices.size());
+        }
+    }
+    else {
+        softSetTransform(ctx, rotation, view, projection);
+        softStencilMask(ctx, 0xFF);
+        softStencilFunc(ctx, GL_ALWAYS, 1, 0xFF);
+        softSetColor(ctx, glm::vec4(0.0f, 1.0f, 0.0f, 1.0f));
+        softDrawElements(ctx, GL_TRIANGLES, tetra.vertices.data(), tetra.indices.data(), tetra.indices.size());
+
+        softStencilMask(ctx, 0x00);
+        softStencilFunc(ctx, GL_ALWAYS, 0, 0xFF);
+        softColorMask(ctx, false, false, false, false);
+        softDepthMask(ctx, false);
+        softSetColor(ctx, glm::vec4(1.0f, 0.0f, 0.0f, 1.0f));
+        for (const std::vector<float>& circle : scene.circles) {
+            softDrawArrays(ctx, GL_TRIANGLE_FAN, circle.data(), 0, circle.size() / 3);
+        }
+        softColorMask(ctx, true, true, true, true);
+        softDepthMask(ctx, true);
+
+        softStencilMask(ctx, 0x00);
+        softStencilFunc(ctx, GL_ALWAYS, 0, 0xFF);
+        softSetColor(ctx, glm::vec4(0.0f, 0.0f, 1.0f, 0.5f));
+        softDrawElements(ctx, GL_TRIANGLES, torus.vertices.data(), torus.indices.data(), torus.indices.size());
+    }
+
+    softFinish(ctx, pool);
+}
+
+
+void copySoftColorToRgb(WorkerPool& pool, const uint32_t* color, int width, int height, unsigned char* rgb) {
+    parallelFor(pool, (unsigned int)height, [&](unsigned int row) {
+        const uint32_t* source = color + (size_t)(height - 1 - row) * width;
+        unsigned char* target = rgb + (size_t)row * width * 3;
+        for (int x = 0; x < width; ++x) {
+            target[x * 3] = (unsigned char)source[x];
+            target[x * 3 + 1] = (unsigned char)(source[x] >> 8);
+            target[x * 3 + 2] = (unsigned char)(source[x] >> 16);
+        }
+    });
+}
+
+
+bool openSoftwareStream(const SoftwareRenderOptions& options, int width, int height, FrameSink& sink) {
+    size_t length = std::strlen(options.streamPath);
+    bool ppm = length >= 4 && std::strcmp(options.streamPath + length - 4, ".ppm") == 0;
+    return openFrameSink(sink, options.streamPath, width, height, ppm,
+                         options.frames, 4, options.sinkBackend);
+}
+
+
+// Hands one frame to the sink, waiting only when it is full. Returns the wait.
+double streamSoftwareFrame(FrameSink& sink, WorkerPool& pool, const uint32_t* color) {
+    double waitMs = 0.0;
+    unsigned char* pixels = acquireFrameBuffer(sink);
+    if (!pixels) {
+        auto waitStart = std::chrono::high_resolution_clock::now();
+        waitForFrameSink(sink);
+        waitMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - waitStart).count();
+        pixels = acquireFrameBuffer(sink);
+    }
+    if (pixels) {
+        copySoftColorToRgb(pool, color, sink.width, sink.height, pixels);
+        submitFrameBuffer(sink);
+    }
+    return waitMs;
+}
+
+
+void printSoftwareStreamStats(const SoftwareRenderOptions& options, FrameSink& sink, double waitMs) {
+    const FrameSinkStats& stats = sink.stats;
+    std::cout << "Frame sink (" << frameSinkBackendName(sink.backend)
+        << (sink.registeredBuffers ? ", registered buffers" : "") << "): " << stats.frames << " frames, "
+        << stats.bytes / 1.0e6 << " MB to " << options.streamPath << ", " << frameSinkMegabytesPerSecond(stats)
+        << " MB/s sustained, " << stats.backpressure << " backpressure waits (" << waitMs << " ms)" << std::endl;
+}
+
+
+int runSoftwareRender(const SoftwareRenderOptions& options) {
+    if (options.processes > 1)
+        return runTiledSoftwareRender(options);
+
+    WorkerPool pool;
+    createWorkerPool(pool, options.threads);
+    SoftContext ctx;
+    createSoftContext(ctx, options.width, options.height);
+
+    SoftwareScene scene;
+    createSoftwareScene(scene);
+    glm::mat4 projection = glm::perspective(glm::radians(45.0f),
+        (float)options.width / (float)options.height, 0.1f, 100.0f);
+
+    // Each frame is copied out as RGB24 straight into the sink's buffer; the
+    // write happens off this thread, which only waits when the sink is full.
+    FrameSink sink;
+    if (options.streamPath && !openSoftwareStream(options, ctx.width, ctx.height, sink)) {
+        destroyWorkerPool(pool);
+        return -1;
+    }
+    double sinkWaitMs = 0.0;
+
+    double totalMs = 0.0, setupMs = 0.0, binMs = 0.0, rasterMs = 0.0;
+    for (unsigned int frame = 0; frame < options.frames; ++frame) {
+        auto start = std::chrono::high_resolution_clock::now();
+
+        renderSoftwareFrame(ctx, pool, scene, options.lattice, softwareFrameRotation(frame), projection);
+        if (options.streamPath)
+            sinkWaitMs += streamSoftwareFrame(sink, pool, ctx.color.data());
+
+        auto end = std::chrono::high_resolution_clock::now();
+        totalMs += std::chrono::duration<double, std::milli>(end - start).count();
+        setupMs += ctx.stats.setupMs;
+        binMs += ctx.stats.binMs;
+        rasterMs += ctx.stats.rasterMs;
+    }
+
+    double frames = options.frames;
+    std::cout << "Software rasterizer (" << pool.threads.size() + 1 << " threads, " << options.width << "x" << options.height
+        << ", " << ctx.tilesX * ctx.tilesY << " tiles): " << ctx.stats.draws << " draws, " << ctx.stats.triangles
+        << " triangles, " << ctx.stats.binnedEntries << " bin entries" << std::endl;
+    std::cout << "Per frame: " << totalMs / frames << " ms (setup " << setupMs / frames << ", bin " << binMs / frames
+        << ", raster " << rasterMs / frames << "), " << (double)options.width * options.height * frames / (totalMs * 1.0e3)
+        << " Mpixel/s" << std::endl;
+
+    if (options.streamPath) {
+        closeFrameSink(sink);
+        printSoftwareStreamStats(options, sink, sinkWaitMs);
+    }
+
+    bool written = writeSoftPPM(ctx, options.outputPath);
+    if (written) {
+        std::cout << "Wrote " << options.outputPath << std::endl;
+    }
+
+    destroyWorkerPool(pool);
+    return written ? 0 : -1;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "culling.h"
+#include "frame_sink.h"
+#include "mesh.h"
+#include "scene.h"
+#include "soft_rasterizer.h"
+#include "worker_pool.h"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+
+// Headless rendering of the scene with the CPU rasterizer (soft_rasterizer.h),
+// for machines without a GPU or display. Frames advance by a fixed 1/60 s so
+// the output is reproducible.
+struct SoftwareRenderOptions {
+    const char* outputPath;
+    int width, height;
+    unsigned int frames;
+    unsigned int threads;   // worker threads besides the caller
+    bool lattice;
+    const char* streamPath;         // every frame, through a FrameSink; null for none
+    FrameSinkBackend sinkBackend;
+    unsigned int processes;         // > 1 renders screen tiles in that many processes (tiled_render.h)
+};
+
+// Recognises --software [--output file.ppm] [--size WxH] [--frames n]
+// [--threads n] [--lattice] [--stream file] [--sink uring|mmap|thread]
+// [--processes n].
+// A stream ending in .ppm holds one PPM per frame, anything else raw RGB24.
+// Returns false when --software is absent.
+bool parseSoftwareRenderOptions(int argc, char** argv, SoftwareRenderOptions& options);
+
+int runSoftwareRender(const SoftwareRenderOptions& options);
+
+
+// Pieces shared with the multi-process tiled renderer.
+struct SoftwareScene {
+    Mesh tetra;
+    Torus torus;
+    std::vector<float> circles[4];
+    Scene lattice;
+    SphereBatch latticeSpheres;
+    glm::mat4 view;
+};
+
+void createSoftwareScene(SoftwareScene& scene);
+glm::mat4 softwareFrameRotation(unsigned int frame);
+// Lattice instances outside projection's frustum are skipped, which is what
+// keeps per-tile geometry work down in the tiled renderer.
+void renderSoftwareFrame(SoftContext& ctx, WorkerPool& pool, const SoftwareScene& scene, bool lattice,
+                         const glm::mat4& rotation, const glm::mat4& projection);
+
+// color is laid out like SoftContext::color; rgb receives top-down RGB24.
+void copySoftColorToRgb(WorkerPool& pool, const uint32_t* color, int width, int height, unsigned char* rgb);
+// The stream's frames are width x height, the size of the color buffers later
+// handed to streamSoftwareFrame.
+bool openSoftwareStream(const SoftwareRenderOptions& options, int width, int height, FrameSink& sink);
+double streamSoftwareFrame(FrameSink& sink, WorkerPool& pool, const uint32_t* color);
+void printSoftwareStreamStats(const SoftwareRenderOptions& options, FrameSink& sink, double waitMs);
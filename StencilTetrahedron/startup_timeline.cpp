@@ -0,0 +1,45 @@
+#include "startup_timeline.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+
+void beginStartupTimeline(StartupTimeline& timeline) {
+    timeline.origin = std::chrono::steady_clock::now();
+    timeline.mainThread = std::this_thread::get_id();
+    timeline.stages.clear();
+}
+
+
+double startupElapsedMs(const StartupTimeline& timeline) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - timeline.origin).count();
+}
+
+
+void recordStartupStage(StartupTimeline& timeline, const char* name, double startMs) {
+    StartupStage stage = { name, startMs, startupElapsedMs(timeline), std::this_thread::get_id() == timeline.mainThread };
+    std::lock_guard<std::mutex> lock(timeline.mutex);
+    timeline.stages.push_back(stage);
+}
+
+
+void printStartupTimeline(StartupTimeline& timeline, double firstFrameMs) {
+    std::lock_guard<std::mutex> lock(timeline.mutex);
+    std::vector<StartupStage> stages = timeline.stages;
+    std::sort(stages.begin(), stages.end(), [](const StartupStage& a, const StartupStage& b) {
+        return a.startMs < b.startMs;
+    });
+
+    double serialMs = 0.0;
+    std::cout << std::fixed << std::setprecision(2);
+    for (const StartupStage& stage : stages) {
+        serialMs += stage.endMs - stage.startMs;
+        std::cout << "Startup: " << std::setw(8) << stage.startMs << " - " << std::setw(8) << stage.endMs
+            << " ms  " << std::setw(7) << stage.endMs - stage.startMs << " ms  "
+            << (stage.mainThread ? "main  " : "worker") << "  " << stage.name << std::endl;
+    }
+    std::cout << "Startup: time to first frame " << firstFrameMs << " ms, stages add up to " << serialMs
+        << " ms" << std::endl;
+    std::cout << std::defaultfloat;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+// Wall-clock record of the startup stages, possibly overlapping on several
+// threads, for the time-to-first-frame breakdown.
+struct StartupStage {
+    const char* name;
+    double startMs, endMs;     // since the timeline began
+    bool mainThread;
+};
+
+struct StartupTimeline {
+    std::chrono::steady_clock::time_point origin;
+    std::thread::id mainThread;
+    std::mutex mutex;
+    std::vector<StartupStage> stages;
+};
+
+void beginStartupTimeline(StartupTimeline& timeline);
+double startupElapsedMs(const StartupTimeline& timeline);
+
+// Records a stage from startMs until now on the calling thread. Thread-safe.
+void recordStartupStage(StartupTimeline& timeline, const char* name, double startMs);
+
+void printStartupTimeline(StartupTimeline& timeline, double firstFrameMs);
@@ -0,0 +1,288 @@
+#include "tiled_render.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <new>
+
+#if defined(__linux__)
+#define TILED_RENDER_PROCESSES 1
+#include <fcntl.h>
+#include <semaphore.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+
+glm::mat4 tileProjection(float fovy, float aspect, float zNear, float zFar, int height, int y0, int y1) {
+    float top = zNear * std::tan(fovy * 0.5f);
+    float right = top * aspect;
+    float bottom = -top;
+    return glm::frustum(-right, right,
+                        bottom + (top - bottom) * (float)y0 / (float)height,
+                        bottom + (top - bottom) * (float)y1 / (float)height,
+                        zNear, zFar);
+}
+
+
+#if TILED_RENDER_PROCESSES
+const unsigned int TILED_MAX_PROCESSES = 64;
+const unsigned int TILED_BANDS_PER_PROCESS = 4;
+
+// Lives at the start of the shared mapping, followed by two frames of colour.
+// The launcher posts start once per process for every frame; a process that
+// gets a post claims bands until none are left and then posts done. With all
+// posts answered every band has been claimed and finished, whichever
+// processes took them.
+struct TiledShared {
+    sem_t start;
+    sem_t done;
+    std::atomic<unsigned int> nextBand;
+    unsigned int frame;                         // written before start is posted
+    bool quit;
+    unsigned int bands[TILED_MAX_PROCESSES];    // per-process totals
+    double renderMs[TILED_MAX_PROCESSES];
+};
+
+
+static size_t sharedHeaderBytes() {
+    return (sizeof(TiledShared) + 63) / 64 * 64;
+}
+
+
+struct TiledLayout {
+    int width, height;
+    int bandHeight;
+    unsigned int bands;
+};
+
+
+static void bandRows(const TiledLayout& layout, unsigned int band, int& y0, int& y1) {
+    y0 = (int)band * layout.bandHeight;
+    y1 = std::min(layout.height, y0 + layout.bandHeight);
+}
+
+
+static void rendererProcess(TiledShared* shared, uint32_t* frames, unsigned int process, const TiledLayout& layout,
+                            const SoftwareRenderOptions& options, const SoftwareScene& scene, unsigned int threads) {
+    WorkerPool pool;
+    createWorkerPool(pool, threads);
+    // Bands are all one height except possibly the last.
+    SoftContext bandContext, lastContext;
+    createSoftContext(bandContext, layout.width, layout.bandHeight);
+    int lastY0, lastY1;
+    bandRows(layout, layout.bands - 1, lastY0, lastY1);
+    createSoftContext(lastContext, layout.width, lastY1 - lastY0);
+
+    for (;;) {
+        while (sem_wait(&shared->start) != 0) {}
+        if (shared->quit)
+            break;
+        unsigned int frame = shared->frame;
+        uint32_t* color = frames + (size_t)(frame % 2) * layout.width * layout.height;
+        glm::mat4 rotation = softwareFrameRotation(frame);
+
+        auto start = std::chrono::high_resolution_clock::now();
+        for (;;) {
+            unsigned int band = shared->nextBand.fetch_add(1);
+            if (band >= layout.bands)
+                break;
+            int y0, y1;
+            bandRows(layout, band, y0, y1);
+            SoftContext& ctx = y1 - y0 == layout.bandHeight ? bandContext : lastContext;
+            glm::mat4 projection = tileProjection(glm::radians(45.0f), (float)layout.width / (float)layout.height,
+                                                  0.1f, 100.0f, layout.height, y0, y1);
+            renderSoftwareFrame(ctx, pool, scene, options.lattice, rotation, projection);
+            std::memcpy(color + (size_t)y0 * layout.width, ctx.color.data(), ctx.color.size() * sizeof(uint32_t));
+            shared->bands[process]++;
+        }
+        shared->renderMs[process] += std::chrono::duration<double, std::milli>(
+            std::chrono::high_resolution_clock::now() - start).count();
+        sem_post(&shared->done);
+    }
+    destroyWorkerPool(pool);
+}
+
+
+// Waits for every renderer to post done. One that dies never would, so the
+// children are checked each second and the wait gives up on the first exit.
+static bool waitForRenderers(TiledShared* shared, const std::vector<pid_t>& children) {
+    for (size_t posted = 0; posted < children.size();) {
+        timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec += 1;
+        if (sem_timedwait(&shared->done, &deadline) == 0) {
+            ++posted;
+            continue;
+        }
+        if (errno != ETIMEDOUT)
+            continue;
+        for (size_t i = 0; i < children.size(); ++i) {
+            if (waitpid(children[i], NULL, WNOHANG) == children[i]) {
+                std::cerr << "Renderer process " << i << " exited mid-frame; stopping" << std::endl;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+
+static bool writeColorPPM(WorkerPool& pool, const uint32_t* color, int width, int height, const char* path) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Failed to open " << path << " for writing" << std::endl;
+        return false;
+    }
+    std::vector<unsigned char> rgb((size_t)width * height * 3);
+    copySoftColorToRgb(pool, color, width, height, rgb.data());
+    file << "P6\n" << width << " " << height << "\n255\n";
+    file.write((const char*)rgb.data(), rgb.size());
+    return (bool)file;
+}
+
+
+int runTiledSoftwareRender(const SoftwareRenderOptions& options) {
+    unsigned int processes = std::min(options.processes, TILED_MAX_PROCESSES);
+    TiledLayout layout;
+    layout.width = options.width;
+    layout.height = options.height;
+    layout.bands = std::max(1u, std::min(processes * TILED_BANDS_PER_PROCESS, (unsigned int)options.height / 8));
+    layout.bandHeight = (options.height + (int)layout.bands - 1) / (int)layout.bands;
+    layout.bands = (unsigned int)((options.height + layout.bandHeight - 1) / layout.bandHeight);
+    // The thread budget is split between the processes; each renders on its
+    // own thread plus its share of workers.
+    unsigned int threads = (options.threads + 1) / processes;
+    threads = threads > 0 ? threads - 1 : 0;
+
+    char name[64];
+    std::snprintf(name, sizeof(name), "/stencil-tetrahedron-tiles-%d", (int)getpid());
+    int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0) {
+        std::cerr << "Failed to create shared memory " << name << std::endl;
+        return -1;
+    }
+    size_t frameBytes = (size_t)layout.width * layout.height * sizeof(uint32_t);
+    size_t bytes = sharedHeaderBytes() + 2 * frameBytes;
+    void* mapping = ftruncate(fd, (off_t)bytes) == 0
+        ? mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+    close(fd);
+    // The mapping outlives the name; forked renderers inherit it.
+    shm_unlink(name);
+    if (mapping == MAP_FAILED) {
+        std::cerr << "Failed to map " << bytes << " bytes of shared memory" << std::endl;
+        return -1;
+    }
+
+    TiledShared* shared = new (mapping) TiledShared();
+    uint32_t* frames = (uint32_t*)((unsigned char*)mapping + sharedHeaderBytes());
+    sem_init(&shared->start, 1, 0);
+    sem_init(&shared->done, 1, 0);
+
+    // Built before forking, with no threads running yet; the renderers share
+    // the pages copy-on-write.
+    SoftwareScene scene;
+    createSoftwareScene(scene);
+
+    std::vector<pid_t> children;
+    for (unsigned int process = 0; process < processes; ++process) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            rendererProcess(shared, frames, process, layout, options, scene, threads);
+            _exit(0);
+        }
+        if (pid < 0) {
+            std::cerr << "Failed to start renderer process " << process << std::endl;
+            break;
+        }
+        children.push_back(pid);
+    }
+
+    WorkerPool pool;
+    createWorkerPool(pool, 0);
+    FrameSink sink;
+    bool running = !children.empty();
+    bool streaming = running && options.streamPath;
+    if (streaming && !openSoftwareStream(options, layout.width, layout.height, sink))
+        running = streaming = false;
+    double sinkWaitMs = 0.0, compositeWaitMs = 0.0;
+    bool written = false;
+
+    auto kick = [&](unsigned int frame) {
+        shared->frame = frame;
+        shared->nextBand.store(0);
+        for (size_t i = 0; i < children.size(); ++i)
+            sem_post(&shared->start);
+    };
+
+    auto start = std::chrono::high_resolution_clock::now();
+    if (running)
+        kick(0);
+    for (unsigned int frame = 0; frame < options.frames && running; ++frame) {
+        auto waitStart = std::chrono::high_resolution_clock::now();
+        if (!waitForRenderers(shared, children)) {
+            running = false;
+            break;
+        }
+        compositeWaitMs += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - waitStart).count();
+
+        // Frame n + 1 renders into the other buffer while frame n goes out.
+        if (frame + 1 < options.frames)
+            kick(frame + 1);
+        const uint32_t* color = frames + (size_t)(frame % 2) * layout.width * layout.height;
+        if (streaming)
+            sinkWaitMs += streamSoftwareFrame(sink, pool, color);
+        if (frame + 1 == options.frames)
+            written = writeColorPPM(pool, color, layout.width, layout.height, options.outputPath);
+    }
+    double totalMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+    shared->quit = true;
+    for (size_t i = 0; i < children.size(); ++i)
+        sem_post(&shared->start);
+    for (pid_t child : children)
+        waitpid(child, NULL, 0);
+
+    bool rendered = running;
+    if (rendered) {
+        double frameCount = options.frames;
+        std::cout << "Tiled software rasterizer (" << children.size() << " processes x " << threads + 1 << " threads, "
+            << options.width << "x" << options.height << ", " << layout.bands << " bands of " << layout.bandHeight
+            << " rows): " << frameCount * 1000.0 / totalMs << " frames/s, " << totalMs / frameCount
+            << " ms per frame, " << compositeWaitMs / frameCount << " ms waiting for bands" << std::endl;
+        std::cout << "Processes (bands/busy):";
+        for (size_t i = 0; i < children.size(); ++i)
+            std::cout << " " << shared->bands[i] << "/" << (int)(100.0 * shared->renderMs[i] / totalMs + 0.5) << "%";
+        std::cout << std::endl;
+        if (written)
+            std::cout << "Wrote " << options.outputPath << std::endl;
+    }
+    if (streaming) {
+        closeFrameSink(sink);
+        printSoftwareStreamStats(options, sink, sinkWaitMs);
+    }
+
+    destroyWorkerPool(pool);
+    sem_destroy(&shared->start);
+    sem_destroy(&shared->done);
+    munmap(mapping, bytes);
+    return rendered && written ? 0 : -1;
+}
+#else
+int runTiledSoftwareRender(const SoftwareRenderOptions& options) {
+    std::cerr << "Multi-process rendering needs fork and POSIX shared memory; rendering in one process" << std::endl;
+    SoftwareRenderOptions single = options;
+    single.processes = 1;
+    return runSoftwareRender(single);
+}
+#endif
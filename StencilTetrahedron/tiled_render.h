@@ -0,0 +1,20 @@
+#pragma once
+
+#include "software_render.h"
+
+
+// Sort-first rendering across processes. The frame is cut into horizontal
+// bands, several per process, and options.processes renderer processes are
+// forked, each with its own SoftContext the size of one band. Processes claim
+// bands from a shared counter and render each through a glm::frustum cut out
+// of the full perspective, straight into a framebuffer in POSIX shared memory,
+// so composition is just waiting for the last band. The launcher streams or
+// saves frame n while the renderers are already on frame n + 1.
+//
+// Needs fork, shm_open and process-shared semaphores (Linux); elsewhere it
+// reports that and renders in a single process.
+int runTiledSoftwareRender(const SoftwareRenderOptions& options);
+
+// The part of the full-frame perspective that lands on rows [y0, y1) of a
+// frame height rows tall, counted from the bottom like SoftContext::color.
+glm::mat4 tileProjection(float fovy, float aspect, float zNear, float zFar, int height, int y0, int y1);
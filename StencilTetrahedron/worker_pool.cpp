@@ -0,0 +1,219 @@
+#include "worker_pool.h"
+
+#include <algorithm>
+
+
+// Set on pool threads so jobs they submit land on their own deque.
+static thread_local const WorkerPool* currentPool = nullptr;
+static thread_local unsigned int currentQueue = 0;
+static thread_local unsigned int jobDepth = 0;
+
+
+unsigned int defaultWorkerCount() {
+    unsigned int hardware = std::thread::hardware_concurrency();
+    return hardware > 1 ? hardware - 1 : 0;
+}
+
+
+static unsigned int queueIndex(const WorkerPool& pool) {
+    return currentPool == &pool ? currentQueue : 0;
+}
+
+
+static void pushJob(WorkerPool& pool, Job job) {
+    WorkerQueue& queue = *pool.queues[queueIndex(pool)];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(std::move(job));
+    }
+
+    // Paired with the sleeper's increment-then-check, one side always sees the other.
+    pool.queuedJobs.fetch_add(1);
+    if (pool.sleepingWorkers.load() > 0) {
+        std::lock_guard<std::mutex> lock(pool.sleepMutex);
+        pool.wake.notify_one();
+    }
+}
+
+
+static bool findJob(WorkerPool& pool, unsigned int index, Job& job) {
+    {
+        WorkerQueue& own = *pool.queues[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty()) {
+            job = std::move(own.jobs.back());
+            own.jobs.pop_back();
+            pool.queuedJobs.fetch_sub(1);
+            return true;
+        }
+    }
+
+    unsigned int queueCount = (unsigned int)pool.queues.size();
+    for (unsigned int offset = 1; offset < queueCount; ++offset) {
+        WorkerQueue& victim = *pool.queues[(index + offset) % queueCount];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            job = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+            pool.queuedJobs.fetch_sub(1);
+            pool.queues[index]->steals.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+
+static void runJob(WorkerPool& pool, unsigned int index, Job& job) {
+    WorkerQueue& queue = *pool.queues[index];
+
+    // Jobs run while an outer job waits are already inside its busy time.
+    bool outermost = jobDepth++ == 0;
+    auto start = std::chrono::steady_clock::now();
+    job.work();
+    if (outermost) {
+        auto busy = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        queue.busyNanoseconds.fetch_add((unsigned long long)busy.count(), std::memory_order_relaxed);
+    }
+    jobDepth--;
+    queue.jobsRun.fetch_add(1, std::memory_order_relaxed);
+
+    if (job.signal)
+        signalCounter(pool, *job.signal);
+}
+
+
+static void workerMain(WorkerPool* pool, unsigned int index) {
+    currentPool = pool;
+    currentQueue = index;
+
+    for (;;) {
+        Job job;
+        if (findJob(*pool, index, job)) {
+            runJob(*pool, index, job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(pool->sleepMutex);
+        pool->sleepingWorkers.fetch_add(1);
+        pool->wake.wait(lock, [&] { return pool->quit || pool->queuedJobs.load() > 0; });
+        pool->sleepingWorkers.fetch_sub(1);
+        if (pool->quit)
+            return;
+    }
+}
+
+
+void createWorkerPool(WorkerPool& pool, unsigned int workerCount) {
+    pool.quit = false;
+    pool.queuedJobs = 0;
+    pool.sleepingWorkers = 0;
+    pool.statsStart = std::chrono::steady_clock::now();
+    pool.queues.clear();
+    for (unsigned int i = 0; i <= workerCount; ++i)
+        pool.queues.push_back(std::make_unique<WorkerQueue>());
+    for (unsigned int i = 0; i < workerCount; ++i)
+        pool.threads.emplace_back(workerMain, &pool, i + 1);
+}
+
+
+void destroyWorkerPool(WorkerPool& pool) {
+    {
+        std::lock_guard<std::mutex> lock(pool.sleepMutex);
+        pool.quit = true;
+    }
+    pool.wake.notify_all();
+    for (std::thread& thread : pool.threads)
+        thread.join();
+    pool.threads.clear();
+    pool.queues.clear();
+}
+
+
+void submitJob(WorkerPool& pool, std::function<void()> work, JobCounter* signal, JobCounter* dependency) {
+    Job job = { std::move(work), signal };
+    if (signal)
+        signal->pending.fetch_add(1);
+
+    if (dependency) {
+        std::lock_guard<std::mutex> lock(dependency->mutex);
+        if (dependency->pending.load() > 0) {
+            dependency->continuations.push_back(std::move(job));
+            return;
+        }
+    }
+    pushJob(pool, std::move(job));
+}
+
+
+void waitForCounter(WorkerPool& pool, JobCounter& counter) {
+    unsigned int index = queueIndex(pool);
+    while (counter.pending.load() > 0) {
+        Job job;
+        if (findJob(pool, index, job))
+            runJob(pool, index, job);
+        else
+            std::this_thread::yield();
+    }
+
+    // The last signalCounter may still hold the lock; the counter must not go away under it.
+    std::lock_guard<std::mutex> lock(counter.mutex);
+}
+
+
+void signalCounter(WorkerPool& pool, JobCounter& counter) {
+    std::vector<Job> released;
+    {
+        std::lock_guard<std::mutex> lock(counter.mutex);
+        if (counter.pending.fetch_sub(1) == 1)
+            released.swap(counter.continuations);
+    }
+    for (Job& job : released)
+        pushJob(pool, std::move(job));
+}
+
+
+void parallelFor(WorkerPool& pool, unsigned int count, const std::function<void(unsigned int)>& task) {
+    unsigned int chunks = (unsigned int)pool.queues.size() * 8;
+    parallelFor(pool, count, (count + chunks - 1) / chunks, task);
+}
+
+
+void parallelFor(WorkerPool& pool, unsigned int count, unsigned int grain, const std::function<void(unsigned int)>& task) {
+    grain = std::max(grain, 1u);
+    if (count <= grain || pool.threads.empty()) {
+        for (unsigned int i = 0; i < count; ++i)
+            task(i);
+        return;
+    }
+
+    // The caller keeps the first chunk for itself.
+    JobCounter counter;
+    for (unsigned int begin = grain; begin < count; begin += grain) {
+        unsigned int end = std::min(begin + grain, count);
+        submitJob(pool, [&task, begin, end] {
+            for (unsigned int i = begin; i < end; ++i)
+                task(i);
+        }, &counter);
+    }
+    for (unsigned int i = 0; i < grain; ++i)
+        task(i);
+    waitForCounter(pool, counter);
+}
+
+
+void collectWorkerUtilization(WorkerPool& pool, std::vector<WorkerUtilization>& utilization) {
+    auto now = std::chrono::steady_clock::now();
+    double elapsedMs = std::chrono::duration<double, std::milli>(now - pool.statsStart).count();
+    pool.statsStart = now;
+
+    utilization.resize(pool.queues.size());
+    for (size_t i = 0; i < pool.queues.size(); ++i) {
+        WorkerQueue& queue = *pool.queues[i];
+        WorkerUtilization& worker = utilization[i];
+        worker.jobs = queue.jobsRun.exchange(0);
+        worker.steals = queue.steals.exchange(0);
+        worker.busyMs = queue.busyNanoseconds.exchange(0) * 1.0e-6;
+        worker.utilization = elapsedMs > 0.0 ? worker.busyMs / elapsedMs : 0.0;
+    }
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+// Work-stealing job scheduler. Every thread has its own deque: the owner pushes
+// and pops at the back, idle threads steal from the front of others'. Threads
+// outside the pool share one extra deque and help run jobs while they wait, so
+// waiting inside a job (nested parallelFor) cannot deadlock.
+struct JobCounter;
+
+struct Job {
+    std::function<void()> work;
+    JobCounter* signal;     // decremented when the job has run, may be null
+};
+
+// Number of unfinished jobs signalling this counter. A job can also be made to
+// wait for a counter to reach zero, which is how a frame is described as a DAG.
+// A counter must outlive the jobs that signal or wait on it.
+struct JobCounter {
+    std::atomic<unsigned int> pending{ 0 };
+    std::mutex mutex;
+    std::vector<Job> continuations;     // released when pending reaches zero
+};
+
+struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<Job> jobs;
+    std::atomic<unsigned long long> jobsRun{ 0 }, steals{ 0 }, busyNanoseconds{ 0 };
+};
+
+struct WorkerUtilization {
+    unsigned long long jobs, steals;
+    double busyMs;
+    double utilization;     // busy fraction of the time since the previous collection
+};
+
+struct WorkerPool {
+    std::vector<std::thread> threads;
+    std::vector<std::unique_ptr<WorkerQueue>> queues;   // [0] external threads, [i + 1] threads[i]
+    std::atomic<unsigned int> queuedJobs{ 0 }, sleepingWorkers{ 0 };
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    bool quit;
+    std::chrono::steady_clock::time_point statsStart;
+};
+
+// One worker per hardware thread besides the caller's.
+unsigned int defaultWorkerCount();
+
+void createWorkerPool(WorkerPool& pool, unsigned int workerCount);
+void destroyWorkerPool(WorkerPool& pool);
+
+// Queues work on the calling thread's deque. When dependency is given the job
+// is held back until that counter reaches zero.
+void submitJob(WorkerPool& pool, std::function<void()> work, JobCounter* signal = nullptr, JobCounter* dependency = nullptr);
+
+// Runs queued jobs until the counter reaches zero.
+void waitForCounter(WorkerPool& pool, JobCounter& counter);
+
+// Decrements a counter by hand, releasing its waiting jobs at zero. For work
+// that finishes outside a job, such as a coroutine reaching its end.
+void signalCounter(WorkerPool& pool, JobCounter& counter);
+
+// Calls task(i) for every i in [0, count) across the pool and returns once all
+// calls have finished. Indices are handed out in chunks of grain; without one,
+// the grain aims at eight chunks per thread. May be called from inside jobs.
+void parallelFor(WorkerPool& pool, unsigned int count, const std::function<void(unsigned int)>& task);
+void parallelFor(WorkerPool& pool, unsigned int count, unsigned int grain, const std::function<void(unsigned int)>& task);
+
+// Per-thread counters since the previous call, external threads first. Resets them.
+void collectWorkerUtilization(WorkerPool& pool, std::vector<WorkerUtilization>& utilization);
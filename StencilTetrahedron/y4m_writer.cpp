@@ -0,0 +1,43 @@
+#include "y4m_writer.h"
+
+#include <iostream>
+
+
+bool openY4mWriter(Y4mWriter& writer, const std::string& path, int width, int height,
+                   int fpsNumerator, int fpsDenominator, YuvColorSpace colorSpace) {
+    writer.file.open(path, std::ios::binary | std::ios::trunc);
+    if (!writer.file) {
+        std::cerr << "Failed to open " << path << " for writing" << std::endl;
+        return false;
+    }
+    writer.width = width;
+    writer.height = height;
+    writer.frames = 0;
+
+    // C420jpeg: centre-sited chroma, matching the 2x2 block average. The
+    // colour range is a non-standard X tag that ffmpeg reads; YCoCg has no tag
+    // of its own and must be declared to the encoder separately.
+    writer.file << "YUV4MPEG2 W" << width << " H" << height << " F" << fpsNumerator << ":" << fpsDenominator
+        << " Ip A1:1 C420jpeg XCOLORRANGE=" << (colorSpace == YuvColorSpace::YCbCr709 ? "LIMITED" : "FULL") << "\n";
+    return (bool)writer.file;
+}
+
+
+bool writeY4mFrame(Y4mWriter& writer, const YuvFrame& frame) {
+    if (frame.width != writer.width || frame.height != writer.height) {
+        std::cerr << "Y4M frame is " << frame.width << "x" << frame.height << ", stream is "
+            << writer.width << "x" << writer.height << std::endl;
+        return false;
+    }
+    writer.file << "FRAME\n";
+    writer.file.write((const char*)frame.y.data(), (std::streamsize)frame.y.size());
+    writer.file.write((const char*)frame.u.data(), (std::streamsize)frame.u.size());
+    writer.file.write((const char*)frame.v.data(), (std::streamsize)frame.v.size());
+    writer.frames++;
+    return (bool)writer.file;
+}
+
+
+void closeY4mWriter(Y4mWriter& writer) {
+    writer.file.close();
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "yuv_convert.h"
+
+#include <fstream>
+#include <string>
+
+
+// Streams 4:2:0 frames as YUV4MPEG2, the raw format ffmpeg and x264 read from
+// a file or pipe. Every frame must match the size given at open.
+struct Y4mWriter {
+    std::ofstream file;
+    int width, height;
+    unsigned long long frames;
+};
+
+bool openY4mWriter(Y4mWriter& writer, const std::string& path, int width, int height,
+                   int fpsNumerator, int fpsDenominator, YuvColorSpace colorSpace);
+bool writeY4mFrame(Y4mWriter& writer, const YuvFrame& frame);
+void closeY4mWriter(Y4mWriter& writer);
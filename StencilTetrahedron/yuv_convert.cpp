@@ -0,0 +1,248 @@
+#include "yuv_convert.h"
+
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/glm.hpp>
+#include <glm/gtx/color_space_YCoCg.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define YUV_SSE2 1
+#include <emmintrin.h>
+#endif
+
+
+// Rows of 2x2 blocks handed to one job.
+const unsigned int YUV_BAND_ROWS = 8;
+
+// Matrix rows in 1.15 fixed point, already scaled to the output range. Each
+// chroma row sums to zero so grey maps exactly to 128.
+struct YuvMatrix {
+    int16_t y[3], u[3], v[3];
+    int yOffset;
+};
+
+static const YuvMatrix YCBCR709_MATRIX = {
+    {  5983, 20127,  2032 },    // (0.2126, 0.7152, 0.0722) * 219 / 255
+    { -3298, -11094, 14392 },   // (-0.1146, -0.3854, 0.5) * 224 / 255
+    { 14392, -13073, -1319 },   // (0.5, -0.4542, -0.0458) * 224 / 255
+    16
+};
+
+static const YuvMatrix YCOCG_MATRIX = {
+    {  8192, 16384,  8192 },    // rgb2YCoCg: Y  =  r/4 + g/2 + b/4
+    { 16384,     0, -16384 },   //            Co =  r/2       - b/2
+    { -8192, 16384, -8192 },    //            Cg = -r/4 + g/2 - b/4
+    0
+};
+
+
+static const YuvMatrix& yuvMatrix(YuvColorSpace colorSpace) {
+    return colorSpace == YuvColorSpace::YCoCg ? YCOCG_MATRIX : YCBCR709_MATRIX;
+}
+
+
+static uint8_t clampSample(int value) {
+    return (uint8_t)std::min(255, std::max(0, value));
+}
+
+
+// The scalar forms of the SIMD arithmetic, for row tails.
+static uint8_t lumaFixed(const YuvMatrix& m, int r, int g, int b) {
+    return clampSample((m.y[0] * r + m.y[1] * g + m.y[2] * b + (m.yOffset << 15) + (1 << 14)) >> 15);
+}
+
+
+// r, g and b are sums over a 2x2 block, hence the two extra bits of shift.
+static uint8_t chromaFixed(const int16_t* row, int r, int g, int b) {
+    return clampSample((row[0] * r + row[1] * g + row[2] * b + (128 << 17) + (1 << 16)) >> 17);
+}
+
+
+#if YUV_SSE2
+// r/g/b as 16-bit lanes; returns one int32 per pixel of c0 * r + c1 * g + c2 * b + offset.
+static inline void dotRgb(__m128i r, __m128i g, __m128i b, const int16_t* c, __m128i offset,
+                          __m128i& lo, __m128i& hi) {
+    __m128i rgCoeff = _mm_set1_epi32((int)(uint16_t)c[0] | ((int)c[1] << 16));
+    __m128i bCoeff = _mm_set1_epi32((int)(uint16_t)c[2]);
+    lo = _mm_add_epi32(_mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(r, g), rgCoeff),
+                                     _mm_madd_epi16(_mm_unpacklo_epi16(b, _mm_setzero_si128()), bCoeff)), offset);
+    hi = _mm_add_epi32(_mm_add_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(r, g), rgCoeff),
+                                     _mm_madd_epi16(_mm_unpackhi_epi16(b, _mm_setzero_si128()), bCoeff)), offset);
+}
+
+
+// Splits 8 RGBA pixels into 16-bit r, g and b lanes.
+static inline void loadRgb(const unsigned char* pixels, __m128i& r, __m128i& g, __m128i& b) {
+    __m128i p0 = _mm_loadu_si128((const __m128i*)pixels);
+    __m128i p1 = _mm_loadu_si128((const __m128i*)(pixels + 16));
+    __m128i mask = _mm_set1_epi32(0xFF);
+    r = _mm_packs_epi32(_mm_and_si128(p0, mask), _mm_and_si128(p1, mask));
+    g = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(p0, 8), mask), _mm_and_si128(_mm_srli_epi32(p1, 8), mask));
+    b = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(p0, 16), mask), _mm_and_si128(_mm_srli_epi32(p1, 16), mask));
+}
+
+
+static inline void storeLuma(const YuvMatrix& m, __m128i r, __m128i g, __m128i b, uint8_t* out) {
+    __m128i lo, hi;
+    dotRgb(r, g, b, m.y, _mm_set1_epi32((m.yOffset << 15) + (1 << 14)), lo, hi);
+    __m128i luma = _mm_packs_epi32(_mm_srai_epi32(lo, 15), _mm_srai_epi32(hi, 15));
+    _mm_storel_epi64((__m128i*)out, _mm_packus_epi16(luma, luma));
+}
+
+
+static inline void storeChroma(const int16_t* row, __m128i r, __m128i g, __m128i b, uint8_t* out) {
+    __m128i lo, hi;
+    dotRgb(r, g, b, row, _mm_set1_epi32((128 << 17) + (1 << 16)), lo, hi);
+    // Only the low four lanes hold blocks; hi repeats them.
+    __m128i chroma = _mm_srai_epi32(lo, 17);
+    chroma = _mm_packs_epi32(chroma, chroma);
+    chroma = _mm_packus_epi16(chroma, chroma);
+    int packed = _mm_cvtsi128_si32(chroma);
+    std::memcpy(out, &packed, 4);
+}
+#endif
+
+
+// Converts source rows top and bottom (bottom may equal top) into luma rows
+// and one chroma row.
+static void convertRowPair(const YuvMatrix& m, const unsigned char* top, const unsigned char* bottom, int width,
+                           uint8_t* yTop, uint8_t* yBottom, uint8_t* u, uint8_t* v) {
+    int x = 0;
+#if YUV_SSE2
+    // 8 pixels across both rows give 16 luma and 4 chroma samples.
+    __m128i ones = _mm_set1_epi16(1);
+    for (; x + 8 <= width; x += 8) {
+        __m128i r0, g0, b0, r1, g1, b1;
+        loadRgb(top + x * 4, r0, g0, b0);
+        loadRgb(bottom + x * 4, r1, g1, b1);
+        storeLuma(m, r0, g0, b0, yTop + x);
+        if (yBottom)
+            storeLuma(m, r1, g1, b1, yBottom + x);
+
+        // Vertical sums, then horizontal pairs: four 2x2 block sums (up to 1020).
+        __m128i r = _mm_madd_epi16(_mm_add_epi16(r0, r1), ones);
+        __m128i g = _mm_madd_epi16(_mm_add_epi16(g0, g1), ones);
+        __m128i b = _mm_madd_epi16(_mm_add_epi16(b0, b1), ones);
+        r = _mm_packs_epi32(r, r);
+        g = _mm_packs_epi32(g, g);
+        b = _mm_packs_epi32(b, b);
+        storeChroma(m.u, r, g, b, u + x / 2);
+        storeChroma(m.v, r, g, b, v + x / 2);
+    }
+#endif
+    for (; x < width; x += 2) {
+        int sumR = 0, sumG = 0, sumB = 0;
+        for (int dx = 0; dx < 2; dx++) {
+            // An odd last column stands in for its missing neighbour.
+            const unsigned char* p0 = top + std::min(x + dx, width - 1) * 4;
+            const unsigned char* p1 = bottom + std::min(x + dx, width - 1) * 4;
+            if (x + dx < width) {
+                yTop[x + dx] = lumaFixed(m, p0[0], p0[1], p0[2]);
+                if (yBottom)
+                    yBottom[x + dx] = lumaFixed(m, p1[0], p1[1], p1[2]);
+            }
+            sumR += p0[0] + p1[0];
+            sumG += p0[1] + p1[1];
+            sumB += p0[2] + p1[2];
+        }
+        u[x / 2] = chromaFixed(m.u, sumR, sumG, sumB);
+        v[x / 2] = chromaFixed(m.v, sumR, sumG, sumB);
+    }
+}
+
+
+void resizeYuvFrame(YuvFrame& frame, int width, int height, YuvColorSpace colorSpace) {
+    frame.width = width;
+    frame.height = height;
+    frame.chromaWidth = (width + 1) / 2;
+    frame.chromaHeight = (height + 1) / 2;
+    frame.colorSpace = colorSpace;
+    frame.y.resize((size_t)width * height);
+    frame.u.resize((size_t)frame.chromaWidth * frame.chromaHeight);
+    frame.v.resize((size_t)frame.chromaWidth * frame.chromaHeight);
+}
+
+
+static const unsigned char* sourceRow(const unsigned char* rgba, size_t stride, bool bottomUp, int height, int row) {
+    return rgba + (size_t)(bottomUp ? height - 1 - row : row) * stride;
+}
+
+
+void convertRgbaToYuv(WorkerPool& pool, const unsigned char* rgba, size_t stride, bool bottomUp, YuvFrame& frame) {
+    const YuvMatrix& m = yuvMatrix(frame.colorSpace);
+    parallelFor(pool, (unsigned int)frame.chromaHeight, YUV_BAND_ROWS, [&](unsigned int pair) {
+        int row = (int)pair * 2;
+        // An odd last row pairs with itself and writes a single luma row.
+        bool single = row + 1 >= frame.height;
+        const unsigned char* top = sourceRow(rgba, stride, bottomUp, frame.height, row);
+        const unsigned char* bottom = single ? top : sourceRow(rgba, stride, bottomUp, frame.height, row + 1);
+        uint8_t* yTop = frame.y.data() + (size_t)row * frame.width;
+        convertRowPair(m, top, bottom, frame.width, yTop, single ? nullptr : yTop + frame.width,
+                       frame.u.data() + (size_t)pair * frame.chromaWidth, frame.v.data() + (size_t)pair * frame.chromaWidth);
+    });
+}
+
+
+static glm::vec3 referenceYuv(YuvColorSpace colorSpace, glm::vec3 rgb) {
+    if (colorSpace == YuvColorSpace::YCoCg) {
+        glm::vec3 yCoCg = glm::rgb2YCoCg(rgb);
+        return glm::vec3(yCoCg.x * 255.0f, yCoCg.y * 255.0f + 128.0f, yCoCg.z * 255.0f + 128.0f);
+    }
+    float luma = glm::dot(glm::vec3(0.2126f, 0.7152f, 0.0722f), rgb);
+    return glm::vec3(16.0f + 219.0f * luma,
+                     128.0f + 224.0f * (rgb.b - luma) / 1.8556f,
+                     128.0f + 224.0f * (rgb.r - luma) / 1.5748f);
+}
+
+
+static uint8_t roundSample(float value) {
+    return clampSample((int)std::floor(value + 0.5f));
+}
+
+
+void convertRgbaToYuvReference(const unsigned char* rgba, size_t stride, bool bottomUp, YuvFrame& frame) {
+    auto pixel = [&](int x, int y) {
+        const unsigned char* p = sourceRow(rgba, stride, bottomUp, frame.height, std::min(y, frame.height - 1))
+            + std::min(x, frame.width - 1) * 4;
+        return glm::vec3(p[0], p[1], p[2]) / 255.0f;
+    };
+    for (int y = 0; y < frame.height; y++) {
+        for (int x = 0; x < frame.width; x++)
+            frame.y[(size_t)y * frame.width + x] = roundSample(referenceYuv(frame.colorSpace, pixel(x, y)).x);
+    }
+    for (int y = 0; y < frame.chromaHeight; y++) {
+        for (int x = 0; x < frame.chromaWidth; x++) {
+            glm::vec3 average = (pixel(2 * x, 2 * y) + pixel(2 * x + 1, 2 * y)
+                + pixel(2 * x, 2 * y + 1) + pixel(2 * x + 1, 2 * y + 1)) * 0.25f;
+            glm::vec3 yuv = referenceYuv(frame.colorSpace, average);
+            frame.u[(size_t)y * frame.chromaWidth + x] = roundSample(yuv.y);
+            frame.v[(size_t)y * frame.chromaWidth + x] = roundSample(yuv.z);
+        }
+    }
+}
+
+
+int maxYuvDifference(const YuvFrame& a, const YuvFrame& b) {
+    int difference = 0;
+    auto compare = [&](const std::vector<uint8_t>& pa, const std::vector<uint8_t>& pb) {
+        for (size_t i = 0; i < pa.size() && i < pb.size(); i++)
+            difference = std::max(difference, std::abs((int)pa[i] - (int)pb[i]));
+    };
+    compare(a.y, b.y);
+    compare(a.u, b.u);
+    compare(a.v, b.v);
+    return difference;
+}
+
+
+const char* yuvConvertIsa() {
+#if YUV_SSE2
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+}
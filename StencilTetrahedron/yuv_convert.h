@@ -0,0 +1,37 @@
+#pragma once
+
+#include "worker_pool.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+// RGBA8 to planar YUV 4:2:0 for video encoders. Luma is per pixel; each chroma
+// sample is taken from the average of a 2x2 block (centre sited, as in JPEG).
+//   YCbCr709: BT.709 matrix, limited range (Y 16-235, Cb/Cr 16-240).
+//   YCoCg:    glm::rgb2YCoCg scaled to full range, Co/Cg offset by 128.
+enum class YuvColorSpace { YCbCr709, YCoCg };
+
+struct YuvFrame {
+    int width, height;
+    int chromaWidth, chromaHeight;      // half size, rounded up
+    YuvColorSpace colorSpace;
+    std::vector<uint8_t> y, u, v;       // top row first; u is Cb or Co, v is Cr or Cg
+};
+
+void resizeYuvFrame(YuvFrame& frame, int width, int height, YuvColorSpace colorSpace);
+
+// rgba points at the first source row, rows are stride bytes apart; with
+// bottomUp the rows are in glReadPixels order and come out flipped. Row pairs
+// are converted in bands across the pool with fixed-point SIMD.
+void convertRgbaToYuv(WorkerPool& pool, const unsigned char* rgba, size_t stride, bool bottomUp, YuvFrame& frame);
+
+// Single-threaded floating-point reference built on glm (rgb2YCoCg for YCoCg),
+// for cross-checking convertRgbaToYuv.
+void convertRgbaToYuvReference(const unsigned char* rgba, size_t stride, bool bottomUp, YuvFrame& frame);
+
+// Largest per-sample difference between two frames of the same size.
+int maxYuvDifference(const YuvFrame& a, const YuvFrame& b);
+
+const char* yuvConvertIsa();